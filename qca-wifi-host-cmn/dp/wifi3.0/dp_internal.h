@@ -2927,4 +2927,17 @@ void dp_accumulate_delay_tid_stats(struct dp_soc *soc,
 				   struct cdp_hist_stats *dst_hstats,
 				   uint8_t tid, uint32_t mode);
 #endif /* QCA_PEER_EXT_STATS */
+
+#ifdef WLAN_DP_RING_PERF_TEST
+/**
+ * dp_srng_perf_update_test() - Account a ring handler run in ring perf stats
+ * @perf: perf stats of the ring
+ * @start_ns: time at which the ring handler was called
+ * @work_done: number of entries reaped by the ring handler
+ *
+ * Return: None
+ */
+void dp_srng_perf_update_test(struct dp_srng_perf_stats *perf,
+			      uint64_t start_ns, uint32_t work_done);
+#endif
 #endif /* #ifndef _DP_INTERNAL_H_ */
@@ -33,6 +33,7 @@
 #include "dp_tx.h"
 #include "dp_tx_desc.h"
 #include "dp_rx.h"
+#include "dp_rx_defrag.h"
 #ifdef DP_RATETABLE_SUPPORT
 #include "dp_ratetable.h"
 #endif
@@ -2483,6 +2484,615 @@ static uint32_t dp_service_near_full_srngs(void *dp_ctx, uint32_t dp_budget)
 
 #ifndef QCA_HOST_MODE_WIFI_DISABLED
 
+/**
+ * dp_srng_work_hist_update() - Account the work done by a ring in a poll
+ * @hist: work/quota histogram of the ring
+ * @work_done: number of entries reaped from the ring
+ * @quota: number of entries the ring was allowed to reap
+ *
+ * Return: None
+ */
+static inline void dp_srng_work_hist_update(uint32_t *hist,
+					    uint32_t work_done, int quota)
+{
+	uint32_t pct;
+
+	if (!work_done || quota <= 0)
+		return;
+
+	if (work_done >= quota) {
+		hist[DP_SRNG_WORK_FULL]++;
+		return;
+	}
+
+	pct = (work_done * 100) / quota;
+	if (pct <= 25)
+		hist[DP_SRNG_WORK_25]++;
+	else if (pct <= 50)
+		hist[DP_SRNG_WORK_50]++;
+	else if (pct <= 75)
+		hist[DP_SRNG_WORK_75]++;
+	else
+		hist[DP_SRNG_WORK_99]++;
+}
+
+#ifdef WLAN_DP_FEATURE_RING_PERF_STATS
+/**
+ * dp_srng_perf_start() - Get the start time of a ring handler run
+ *
+ * Return: current time in ns
+ */
+static inline uint64_t dp_srng_perf_start(void)
+{
+	return qdf_ktime_to_ns(qdf_ktime_get());
+}
+
+/**
+ * dp_srng_perf_update() - Account the cost of a ring handler run
+ * @perf: perf stats of the ring
+ * @start_ns: time at which the ring handler was called
+ * @work_done: number of entries reaped by the ring handler
+ *
+ * Return: None
+ */
+static inline void dp_srng_perf_update(struct dp_srng_perf_stats *perf,
+				       uint64_t start_ns, uint32_t work_done)
+{
+	uint64_t delta_ns;
+
+	if (!work_done)
+		return;
+
+	delta_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+	perf->num_calls++;
+	perf->num_entries += work_done;
+	perf->time_ns += delta_ns;
+	if (delta_ns > perf->max_time_ns)
+		perf->max_time_ns = delta_ns;
+}
+
+#define DP_SRNG_PERF_UPDATE(intr_stats, ring_perf, ring, start_ns, work) \
+	dp_srng_perf_update(&(intr_stats)->ring_perf[ring], start_ns, work)
+
+#ifdef WLAN_DP_RING_PERF_TEST
+void dp_srng_perf_update_test(struct dp_srng_perf_stats *perf,
+			      uint64_t start_ns, uint32_t work_done)
+{
+	dp_srng_perf_update(perf, start_ns, work_done);
+}
+#endif
+#else
+static inline uint64_t dp_srng_perf_start(void)
+{
+	return 0;
+}
+
+#define DP_SRNG_PERF_UPDATE(intr_stats, ring_perf, ring, start_ns, work) \
+	((void)(start_ns))
+#endif /* WLAN_DP_FEATURE_RING_PERF_STATS */
+
+/**
+ * dp_tx_comp_ring_in_mask() - Check if a TX completion ring is serviced by
+ *			       an interrupt context
+ * @soc: DP soc handle
+ * @index: TCL data ring index
+ * @tx_mask: TX ring mask of the interrupt context
+ *
+ * Return: true if the ring is part of @tx_mask
+ */
+static inline bool dp_tx_comp_ring_in_mask(struct dp_soc *soc, int index,
+					   uint8_t tx_mask)
+{
+	return !!((1 << wlan_cfg_get_wbm_ring_num_for_index(soc->wlan_cfg_ctx,
+							    index)) & tx_mask);
+}
+
+/**
+ * dp_srng_service_class_backlog() - Get the pending entries of a ring class
+ * @int_ctx: interrupt context
+ * @tx_backlog: filled with the entries pending on the TX completion rings
+ * @rx_backlog: filled with the entries pending on the REO destination rings
+ *
+ * Return: None
+ */
+static void dp_srng_service_class_backlog(struct dp_intr *int_ctx,
+					  uint32_t *tx_backlog,
+					  uint32_t *rx_backlog)
+{
+	struct dp_soc *soc = int_ctx->soc;
+	int i;
+
+	*tx_backlog = 0;
+	*rx_backlog = 0;
+
+	for (i = 0; i < soc->num_tcl_data_rings; i++) {
+		if (!dp_tx_comp_ring_in_mask(soc, i, int_ctx->tx_ring_mask))
+			continue;
+		*tx_backlog += hal_srng_dst_num_valid(soc->hal_soc,
+						soc->tx_comp_ring[i].hal_srng,
+						1);
+	}
+
+	for (i = 0; i < soc->num_reo_dest_rings; i++) {
+		if (!(int_ctx->rx_ring_mask & (1 << i)))
+			continue;
+		*rx_backlog += hal_srng_dst_num_valid(soc->hal_soc,
+						soc->reo_dest_ring[i].hal_srng,
+						1);
+	}
+}
+
+/**
+ * dp_srng_service_class_quota() - Split the poll budget between the TX
+ *				   completion and REO destination rings
+ * @int_ctx: interrupt context
+ * @budget: budget of this poll
+ * @tx_quota: filled with the budget of the TX completion rings
+ * @rx_quota: filled with the budget of the REO destination rings
+ *
+ * With WLAN_CFG_SRNG_SERVICE_FIXED both classes may use the whole budget and
+ * the TX completion rings, serviced first, take what they need.
+ *
+ * With WLAN_CFG_SRNG_SERVICE_WRR the budget is split as per the configured
+ * weights.
+ *
+ * With WLAN_CFG_SRNG_SERVICE_DEFICIT each class earns a share of the budget
+ * proportional to weight * backlog on top of what it could not use in the
+ * previous polls, so a class which keeps getting starved catches up.
+ *
+ * Return: None
+ */
+static void dp_srng_service_class_quota(struct dp_intr *int_ctx, int budget,
+					int *tx_quota, int *rx_quota)
+{
+	struct wlan_cfg_dp_soc_ctxt *cfg = int_ctx->soc->wlan_cfg_ctx;
+	uint32_t tx_weight = wlan_cfg_get_srng_service_tx_weight(cfg);
+	uint32_t rx_weight = wlan_cfg_get_srng_service_rx_weight(cfg);
+	uint32_t tx_backlog, rx_backlog;
+	uint32_t tx_demand, rx_demand;
+	int tx_share;
+
+	*tx_quota = budget;
+	*rx_quota = budget;
+
+	/* Nothing to split if only one class is serviced by this context */
+	if (!int_ctx->tx_ring_mask || !int_ctx->rx_ring_mask)
+		return;
+
+	switch (wlan_cfg_get_srng_service_policy(cfg)) {
+	case WLAN_CFG_SRNG_SERVICE_WRR:
+		*tx_quota = (budget * tx_weight) / (tx_weight + rx_weight);
+		*rx_quota = budget - *tx_quota;
+		break;
+	case WLAN_CFG_SRNG_SERVICE_DEFICIT:
+		dp_srng_service_class_backlog(int_ctx, &tx_backlog,
+					      &rx_backlog);
+		tx_demand = tx_backlog * tx_weight;
+		rx_demand = rx_backlog * rx_weight;
+		if (!tx_demand && !rx_demand) {
+			/* Rings look empty, fall back to the static split */
+			tx_demand = tx_weight;
+			rx_demand = rx_weight;
+		}
+
+		tx_share = qdf_do_div((uint64_t)budget * tx_demand,
+				      tx_demand + rx_demand);
+		int_ctx->tx_comp_deficit += tx_share;
+		int_ctx->rx_deficit += budget - tx_share;
+
+		/* Never let a class earn more than a poll worth of budget */
+		int_ctx->tx_comp_deficit = qdf_min(int_ctx->tx_comp_deficit,
+						   budget);
+		int_ctx->rx_deficit = qdf_min(int_ctx->rx_deficit, budget);
+
+		*tx_quota = int_ctx->tx_comp_deficit;
+		*rx_quota = int_ctx->rx_deficit;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * dp_srng_service_class_done() - Update the deficit of a ring class
+ * @deficit: deficit of the ring class
+ * @quota: quota the ring class was given in this poll
+ * @avail: budget the ring class could actually use in this poll, 0 if it
+ *	   was not serviced
+ * @work_done: entries reaped by the ring class in this poll
+ *
+ * A class which had its full quota available and did not use it has
+ * drained its rings, so it does not carry any deficit to the next poll.
+ * A class which was cut short by the overall poll budget, or not serviced
+ * at all, keeps the part of its quota it could not use. Work done beyond
+ * the quota, out of the budget left by the other class, is not held
+ * against it.
+ *
+ * Return: None
+ */
+static inline void dp_srng_service_class_done(int *deficit, int quota,
+					      int avail, int work_done)
+{
+	if (avail >= quota && work_done < quota)
+		*deficit = 0;
+	else
+		*deficit = qdf_max(*deficit - work_done, 0);
+}
+
+/**
+ * dp_service_tx_comp_rings() - Service the TX completion rings of an
+ *				interrupt context
+ * @int_ctx: interrupt context
+ * @quota: number of entries which can be reaped
+ *
+ * Return: number of entries reaped
+ */
+static int dp_service_tx_comp_rings(struct dp_intr *int_ctx, int quota)
+{
+	struct dp_intr_stats *intr_stats = &int_ctx->intr_stats;
+	struct dp_soc *soc = int_ctx->soc;
+	uint8_t tx_mask = int_ctx->tx_ring_mask;
+	uint32_t work_done;
+	uint64_t start_ns;
+	int total_work = 0;
+	int index;
+
+	for (index = 0; index < soc->num_tcl_data_rings; index++) {
+		if (!dp_tx_comp_ring_in_mask(soc, index, tx_mask))
+			continue;
+		start_ns = dp_srng_perf_start();
+		work_done = dp_tx_comp_handler(int_ctx,
+					       soc,
+					       soc->tx_comp_ring[index].hal_srng,
+					       index, quota);
+		DP_SRNG_PERF_UPDATE(intr_stats, tx_comp_perf, index, start_ns,
+				    work_done);
+		if (work_done) {
+			intr_stats->num_tx_ring_masks[index]++;
+			dp_srng_work_hist_update(
+				intr_stats->tx_comp_work_hist[index],
+				work_done, quota);
+			dp_verbose_debug("tx mask 0x%x index %d, budget %d, work_done %d",
+					 tx_mask, index, quota,
+					 work_done);
+		}
+		total_work += work_done;
+		quota -= work_done;
+		if (quota <= 0)
+			break;
+	}
+
+	return total_work;
+}
+
+/**
+ * dp_service_reo_dst_rings() - Service the REO destination rings of an
+ *				interrupt context
+ * @int_ctx: interrupt context
+ * @quota: number of entries which can be reaped
+ *
+ * Return: number of entries reaped
+ */
+static int dp_service_reo_dst_rings(struct dp_intr *int_ctx, int quota)
+{
+	struct dp_intr_stats *intr_stats = &int_ctx->intr_stats;
+	struct dp_soc *soc = int_ctx->soc;
+	uint8_t rx_mask = int_ctx->rx_ring_mask;
+	uint32_t work_done;
+	uint64_t start_ns;
+	int total_work = 0;
+	int ring;
+
+	for (ring = 0; ring < soc->num_reo_dest_rings; ring++) {
+		if (!(rx_mask & (1 << ring)))
+			continue;
+		start_ns = dp_srng_perf_start();
+		work_done = soc->arch_ops.dp_rx_process(int_ctx,
+					  soc->reo_dest_ring[ring].hal_srng,
+					  ring,
+					  quota);
+		DP_SRNG_PERF_UPDATE(intr_stats, rx_perf, ring, start_ns,
+				    work_done);
+		if (work_done) {
+			intr_stats->num_rx_ring_masks[ring]++;
+			dp_srng_work_hist_update(intr_stats->rx_work_hist[ring],
+						 work_done, quota);
+			dp_verbose_debug("rx mask 0x%x ring %d, work_done %d budget %d",
+					 rx_mask, ring,
+					 work_done, quota);
+			total_work += work_done;
+			quota -= work_done;
+			if (quota <= 0)
+				break;
+		}
+	}
+
+	return total_work;
+}
+
+/* Length of the adaptive interrupt moderation sample window */
+#define DP_INTR_MOD_SAMPLE_MS 100
+
+/*
+ * Packet rate, in packets per second, above which the interrupt context
+ * moves from level n to level n + 1. It moves back down once the rate
+ * falls below half of the threshold which got it to its current level.
+ */
+static const uint32_t dp_intr_mod_up_rate[DP_INTR_MOD_LEVELS - 1] = {
+	20000, 80000, 200000
+};
+
+/**
+ * dp_intr_mod_level_thres() - Interrupt threshold of a moderation level
+ * @base: static threshold of the ring, used at level 0
+ * @max: configured upper bound of the threshold
+ * @level: moderation level
+ *
+ * Return: threshold scaled linearly between @base and @max
+ */
+static inline uint32_t dp_intr_mod_level_thres(uint32_t base, uint32_t max,
+					       uint8_t level)
+{
+	if (max <= base)
+		return base;
+
+	return base + ((max - base) * level) / (DP_INTR_MOD_LEVELS - 1);
+}
+
+/**
+ * dp_intr_mod_read_base() - Read the static interrupt thresholds of the
+ *			     rings of an interrupt context
+ * @int_ctx: interrupt context
+ *
+ * Return: None
+ */
+static void dp_intr_mod_read_base(struct dp_intr *int_ctx)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+	struct dp_soc *soc = int_ctx->soc;
+	struct hal_srng_params params;
+	int i;
+
+	for (i = 0; i < soc->num_tcl_data_rings; i++) {
+		if (!dp_tx_comp_ring_in_mask(soc, i, int_ctx->tx_ring_mask))
+			continue;
+		qdf_mem_zero(&params, sizeof(params));
+		hal_get_srng_params(soc->hal_soc,
+				    soc->tx_comp_ring[i].hal_srng, &params);
+		mod->tx_base_timer_us = params.intr_timer_thres_us;
+		mod->tx_base_batch = params.intr_batch_cntr_thres_entries;
+		break;
+	}
+
+	for (i = 0; i < soc->num_reo_dest_rings; i++) {
+		if (!(int_ctx->rx_ring_mask & (1 << i)))
+			continue;
+		qdf_mem_zero(&params, sizeof(params));
+		hal_get_srng_params(soc->hal_soc,
+				    soc->reo_dest_ring[i].hal_srng, &params);
+		mod->rx_base_timer_us = params.intr_timer_thres_us;
+		mod->rx_base_batch = params.intr_batch_cntr_thres_entries;
+		break;
+	}
+
+	mod->base_valid = true;
+}
+
+/**
+ * dp_intr_mod_apply() - Program the interrupt thresholds of the applied
+ *			 moderation level on the rings of an interrupt context
+ * @int_ctx: interrupt context
+ *
+ * Return: None
+ */
+static void dp_intr_mod_apply(struct dp_intr *int_ctx)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+	struct dp_soc *soc = int_ctx->soc;
+	struct wlan_cfg_dp_soc_ctxt *cfg = soc->wlan_cfg_ctx;
+	uint32_t timer_max = wlan_cfg_get_intr_mod_timer_max(cfg);
+	uint32_t batch_max = wlan_cfg_get_intr_mod_batch_max(cfg);
+	uint32_t timer, batch;
+	int i;
+
+	timer = dp_intr_mod_level_thres(mod->tx_base_timer_us, timer_max,
+					mod->applied_level);
+	batch = dp_intr_mod_level_thres(mod->tx_base_batch, batch_max,
+					mod->applied_level);
+	for (i = 0; i < soc->num_tcl_data_rings; i++) {
+		if (!dp_tx_comp_ring_in_mask(soc, i, int_ctx->tx_ring_mask))
+			continue;
+		hal_srng_dst_set_intr_thresholds(soc->hal_soc,
+						 soc->tx_comp_ring[i].hal_srng,
+						 timer, batch);
+	}
+
+	timer = dp_intr_mod_level_thres(mod->rx_base_timer_us, timer_max,
+					mod->applied_level);
+	batch = dp_intr_mod_level_thres(mod->rx_base_batch, batch_max,
+					mod->applied_level);
+	for (i = 0; i < soc->num_reo_dest_rings; i++) {
+		if (!(int_ctx->rx_ring_mask & (1 << i)))
+			continue;
+		hal_srng_dst_set_intr_thresholds(soc->hal_soc,
+						 soc->reo_dest_ring[i].hal_srng,
+						 timer, batch);
+	}
+
+	mod->level_changes++;
+}
+
+/**
+ * dp_intr_mod_apply_work() - Work programming the interrupt thresholds of
+ *			      the moderation level decided by the poll
+ * @arg: interrupt context
+ *
+ * hal_srng_dst_set_intr_thresholds() may need to wake the target up before
+ * writing the ring registers, which can sleep, hence it is done here rather
+ * than from the NAPI poll. The bus is kept runtime resumed across the writes.
+ * If it cannot be resumed the level is left unapplied and the update is
+ * retried on the next level change or on bus resume.
+ *
+ * Return: None
+ */
+static void dp_intr_mod_apply_work(void *arg)
+{
+	struct dp_intr *int_ctx = (struct dp_intr *)arg;
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+	struct dp_soc *soc = int_ctx->soc;
+	uint8_t level = mod->level;
+
+	if (level == mod->applied_level)
+		return;
+
+	if (hif_pm_runtime_get_sync(soc->hif_handle, RTPM_ID_DP_INTR_MOD))
+		return;
+
+	if (qdf_unlikely(!mod->base_valid))
+		dp_intr_mod_read_base(int_ctx);
+
+	mod->applied_level = level;
+	dp_intr_mod_apply(int_ctx);
+
+	hif_pm_runtime_put(soc->hif_handle, RTPM_ID_DP_INTR_MOD);
+}
+
+/**
+ * dp_intr_mod_init() - Initialize the adaptive interrupt moderation state
+ *			of an interrupt context
+ * @int_ctx: interrupt context
+ *
+ * Return: None
+ */
+static void dp_intr_mod_init(struct dp_intr *int_ctx)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+
+	qdf_mem_zero(mod, sizeof(*mod));
+	mod->window_start = qdf_system_ticks();
+	if (QDF_IS_STATUS_SUCCESS(qdf_create_work(0, &mod->apply_work,
+						  dp_intr_mod_apply_work,
+						  int_ctx)))
+		mod->work_valid = true;
+}
+
+/**
+ * dp_intr_mod_deinit() - Wait for and disable the pending threshold update
+ *			  of an interrupt context
+ * @int_ctx: interrupt context
+ *
+ * Return: None
+ */
+static void dp_intr_mod_deinit(struct dp_intr *int_ctx)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+
+	if (!mod->work_valid)
+		return;
+
+	qdf_flush_work(&mod->apply_work);
+	qdf_disable_work(&mod->apply_work);
+	mod->work_valid = false;
+}
+
+/**
+ * dp_intr_mod_suspend() - Cancel the pending threshold updates of all
+ *			   interrupt contexts for bus suspend
+ * @soc: DP soc handle
+ *
+ * A cancelled update is rescheduled by dp_intr_mod_resume().
+ *
+ * Return: None
+ */
+static void dp_intr_mod_suspend(struct dp_soc *soc)
+{
+	int i;
+
+	for (i = 0; i < wlan_cfg_get_num_contexts(soc->wlan_cfg_ctx); i++) {
+		if (soc->intr_ctx[i].intr_mod.work_valid)
+			qdf_cancel_work(&soc->intr_ctx[i].intr_mod.apply_work);
+	}
+}
+
+/**
+ * dp_intr_mod_resume() - Reschedule the threshold updates left unapplied
+ *			  over bus suspend
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+static void dp_intr_mod_resume(struct dp_soc *soc)
+{
+	struct dp_intr_mod *mod;
+	int i;
+
+	for (i = 0; i < wlan_cfg_get_num_contexts(soc->wlan_cfg_ctx); i++) {
+		mod = &soc->intr_ctx[i].intr_mod;
+		if (mod->work_valid && mod->level != mod->applied_level)
+			qdf_sched_work(0, &mod->apply_work);
+	}
+}
+
+/**
+ * dp_intr_mod_sample() - Account a poll of an interrupt context for the
+ *			  adaptive interrupt moderation
+ * @int_ctx: interrupt context
+ * @work_done: entries reaped from the TX completion and REO destination
+ *	       rings in this poll
+ *
+ * Once per DP_INTR_MOD_SAMPLE_MS the packet rate of the context is computed
+ * and the moderation level moved one step up or down. Higher levels raise
+ * the interrupt timer and batch thresholds of the rings towards the
+ * configured maximum, trading latency for fewer interrupts under bulk
+ * traffic, while low rate (latency sensitive) traffic keeps the static
+ * thresholds of level 0.
+ *
+ * Return: None
+ */
+static void dp_intr_mod_sample(struct dp_intr *int_ctx, uint32_t work_done)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+	unsigned long now = qdf_system_ticks();
+	uint32_t elapsed_ms;
+	uint8_t level;
+
+	if (!wlan_cfg_is_intr_mod_enabled(int_ctx->soc->wlan_cfg_ctx) ||
+	    (!int_ctx->tx_ring_mask && !int_ctx->rx_ring_mask))
+		return;
+
+	mod->num_pkts += work_done;
+	mod->num_polls++;
+
+	elapsed_ms = qdf_system_ticks_to_msecs(now - mod->window_start);
+	if (elapsed_ms < DP_INTR_MOD_SAMPLE_MS)
+		return;
+
+	mod->pkt_rate = qdf_do_div((uint64_t)mod->num_pkts * 1000,
+				   elapsed_ms);
+	mod->poll_rate = qdf_do_div((uint64_t)mod->num_polls * 1000,
+				    elapsed_ms);
+	mod->num_pkts = 0;
+	mod->num_polls = 0;
+	mod->window_start = now;
+
+	level = mod->level;
+	if (level < DP_INTR_MOD_LEVELS - 1 &&
+	    mod->pkt_rate >= dp_intr_mod_up_rate[level])
+		level++;
+
+	/* Step down as far as the rate allows, for quick latency recovery */
+	while (level && mod->pkt_rate < dp_intr_mod_up_rate[level - 1] / 2)
+		level--;
+
+	if (level != mod->level) {
+		mod->level = level;
+		if (qdf_likely(mod->work_valid))
+			qdf_sched_work(0, &mod->apply_work);
+	}
+
+	mod->level_samples[mod->level]++;
+}
+
 /*
  * dp_service_srngs() - Top level interrupt handler for DP Ring interrupts
  * @dp_ctx: DP SOC handle
@@ -2495,8 +3105,6 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 	struct dp_intr *int_ctx = (struct dp_intr *)dp_ctx;
 	struct dp_intr_stats *intr_stats = &int_ctx->intr_stats;
 	struct dp_soc *soc = int_ctx->soc;
-	int ring = 0;
-	int index;
 	uint32_t work_done  = 0;
 	int budget = dp_budget;
 	uint8_t tx_mask = int_ctx->tx_ring_mask;
@@ -2505,6 +3113,9 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 	uint8_t rx_wbm_rel_mask = int_ctx->rx_wbm_rel_ring_mask;
 	uint8_t reo_status_mask = int_ctx->reo_status_ring_mask;
 	uint32_t remaining_quota = dp_budget;
+	int tx_quota, rx_quota;
+	int tx_avail = 0, rx_avail = 0;
+	int tx_work = 0, rx_work = 0;
 
 	dp_verbose_debug("tx %x rx %x rx_err %x rx_wbm_rel %x reo_status %x rx_mon_ring %x host2rxdma %x rxdma2host %x\n",
 			 tx_mask, rx_mask, rx_err_mask, rx_wbm_rel_mask,
@@ -2513,21 +3124,13 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 			 int_ctx->host2rxdma_ring_mask,
 			 int_ctx->rxdma2host_ring_mask);
 
+	dp_srng_service_class_quota(int_ctx, budget, &tx_quota, &rx_quota);
+
 	/* Process Tx completion interrupts first to return back buffers */
-	for (index = 0; index < soc->num_tcl_data_rings; index++) {
-		if (!(1 << wlan_cfg_get_wbm_ring_num_for_index(soc->wlan_cfg_ctx, index) & tx_mask))
-			continue;
-		work_done = dp_tx_comp_handler(int_ctx,
-					       soc,
-					       soc->tx_comp_ring[index].hal_srng,
-					       index, remaining_quota);
-		if (work_done) {
-			intr_stats->num_tx_ring_masks[index]++;
-			dp_verbose_debug("tx mask 0x%x index %d, budget %d, work_done %d",
-					 tx_mask, index, budget,
-					 work_done);
-		}
-		budget -= work_done;
+	if (tx_mask && tx_quota > 0) {
+		tx_avail = qdf_min(tx_quota, budget);
+		tx_work = dp_service_tx_comp_rings(int_ctx, tx_avail);
+		budget -= tx_work;
 		if (budget <= 0)
 			goto budget_done;
 
@@ -2572,26 +3175,31 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 		remaining_quota = budget;
 	}
 
-	/* Process Rx interrupts */
+	/* Process Rx interrupts, with the TX completion leftover if any */
 	if (rx_mask) {
-		for (ring = 0; ring < soc->num_reo_dest_rings; ring++) {
-			if (!(rx_mask & (1 << ring)))
-				continue;
-			work_done = soc->arch_ops.dp_rx_process(int_ctx,
-						  soc->reo_dest_ring[ring].hal_srng,
-						  ring,
-						  remaining_quota);
-			if (work_done) {
-				intr_stats->num_rx_ring_masks[ring]++;
-				dp_verbose_debug("rx mask 0x%x ring %d, work_done %d budget %d",
-						 rx_mask, ring,
-						 work_done, budget);
-				budget -=  work_done;
-				if (budget <= 0)
-					goto budget_done;
-				remaining_quota = budget;
-			}
-		}
+		if (tx_quota > tx_work)
+			rx_quota += tx_quota - tx_work;
+
+		rx_avail = qdf_min(rx_quota, budget);
+		rx_work = dp_service_reo_dst_rings(int_ctx, rx_avail);
+		budget -= rx_work;
+		if (budget <= 0)
+			goto budget_done;
+		remaining_quota = budget;
+	}
+
+	/*
+	 * TX completion rings which were cut short by their quota get
+	 * whatever the REO destination rings left unused.
+	 */
+	if (tx_mask && tx_work >= tx_quota && budget > 0 &&
+	    tx_quota < (int)dp_budget) {
+		work_done = dp_service_tx_comp_rings(int_ctx, budget);
+		tx_work += work_done;
+		budget -= work_done;
+		if (budget <= 0)
+			goto budget_done;
+		remaining_quota = budget;
 	}
 
 	if (reo_status_mask) {
@@ -2613,6 +3221,16 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 	intr_stats->num_masks++;
 
 budget_done:
+	if (wlan_cfg_get_srng_service_policy(soc->wlan_cfg_ctx) ==
+	    WLAN_CFG_SRNG_SERVICE_DEFICIT) {
+		dp_srng_service_class_done(&int_ctx->tx_comp_deficit,
+					   tx_quota, tx_avail, tx_work);
+		dp_srng_service_class_done(&int_ctx->rx_deficit,
+					   rx_quota, rx_avail, rx_work);
+	}
+
+	dp_intr_mod_sample(int_ctx, tx_work + rx_work);
+
 	return dp_budget - budget;
 }
 
@@ -2804,6 +3422,7 @@ static QDF_STATUS dp_soc_attach_poll(struct cdp_soc_t *txrx_soc)
 		soc->intr_ctx[i].rxdma2host_ring_mask =
 			wlan_cfg_get_rxdma2host_ring_mask(soc->wlan_cfg_ctx, i);
 		soc->intr_ctx[i].soc = soc;
+		dp_intr_mod_init(&soc->intr_ctx[i]);
 		soc->intr_ctx[i].lro_ctx = qdf_lro_init();
 
 		if (dp_is_mon_mask_valid(soc, &soc->intr_ctx[i])) {
@@ -3108,6 +3727,7 @@ static void dp_soc_interrupt_detach(struct cdp_soc_t *txrx_soc)
 
 		hif_event_history_deinit(soc->hif_handle, i);
 		qdf_lro_deinit(soc->intr_ctx[i].lro_ctx);
+		dp_intr_mod_deinit(&soc->intr_ctx[i]);
 	}
 
 	qdf_mem_set(&soc->mon_intr_id_lmac_map,
@@ -3194,6 +3814,7 @@ static QDF_STATUS dp_soc_interrupt_attach(struct cdp_soc_t *txrx_soc)
 						tx_ring_near_full_mask;
 
 		soc->intr_ctx[i].soc = soc;
+		dp_intr_mod_init(&soc->intr_ctx[i]);
 
 		num_irq = 0;
 
@@ -5692,6 +6313,7 @@ static void dp_soc_deinit(void *txrx_soc)
 
 	qdf_nbuf_queue_free(&soc->invalid_buf_queue);
 
+	dp_rx_defrag_wheel_deinit(soc);
 	qdf_spinlock_destroy(&soc->rx.defrag.defrag_lock);
 
 	qdf_spinlock_destroy(&soc->vdev_map_lock);
@@ -12756,11 +13378,15 @@ static QDF_STATUS dp_bus_suspend(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 	if (soc->intr_mode == DP_INTR_POLL)
 		qdf_timer_stop(&soc->int_timer);
 
+	dp_rx_defrag_wheel_suspend(soc);
+
 	/* Stop monitor reap timer and reap any pending frames in ring */
 	dp_monitor_pktlog_reap_pending_frames(pdev);
 
 	dp_suspend_fse_cache_flush(soc);
 
+	dp_intr_mod_suspend(soc);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -12778,6 +13404,8 @@ static QDF_STATUS dp_bus_resume(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 	if (soc->intr_mode == DP_INTR_POLL)
 		qdf_timer_mod(&soc->int_timer, DP_INTR_POLL_TIMER_MS);
 
+	dp_rx_defrag_wheel_resume(soc);
+
 	/* Start monitor reap timer */
 	dp_monitor_pktlog_start_reap_timer(pdev);
 
@@ -12786,6 +13414,8 @@ static QDF_STATUS dp_bus_resume(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 	for (i = 0; i < soc->num_tcl_data_rings; i++)
 		dp_flush_ring_hptp(soc, soc->tcl_data_ring[i].hal_srng);
 
+	dp_intr_mod_resume(soc);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -13278,7 +13908,7 @@ void *dp_soc_init(struct dp_soc *soc, HTC_HANDLE htc_handle,
 	}
 
 	/* setup the global rx defrag waitlist */
-	TAILQ_INIT(&soc->rx.defrag.waitlist);
+	dp_rx_defrag_wheel_init(soc);
 	soc->rx.defrag.timeout_ms =
 		wlan_cfg_get_rx_defrag_min_timeout(soc->wlan_cfg_ctx);
 	soc->rx.defrag.next_flush_ms = 0;
@@ -3734,6 +3734,7 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 
 		rx_tid->defrag_waitlist_elem.tqe_next = NULL;
 		rx_tid->defrag_waitlist_elem.tqe_prev = NULL;
+		rx_tid->defrag_wheel_slot = 0;
 		rx_tid->defrag_peer =
 			IS_MLO_DP_LINK_PEER(peer) ? peer->mld_peer : peer;
 	}
@@ -3756,6 +3757,7 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 
 		rx_tid->defrag_waitlist_elem.tqe_next = NULL;
 		rx_tid->defrag_waitlist_elem.tqe_prev = NULL;
+		rx_tid->defrag_wheel_slot = 0;
 		rx_tid->defrag_peer = peer;
 	}
 }
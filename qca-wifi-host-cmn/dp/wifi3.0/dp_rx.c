@@ -544,6 +544,9 @@ bool dp_rx_intrabss_mcbc_fwd(struct dp_soc *soc, struct dp_peer *ta_peer,
 	if (!nbuf_copy)
 		return false;
 
+	/* cb still holds the RX context, not a TX classification */
+	qdf_nbuf_tx_cls_reset(nbuf_copy);
+
 	len = QDF_NBUF_CB_RX_PKT_LEN(nbuf);
 	if (dp_tx_send((struct cdp_soc_t *)soc,
 		       ta_peer->vdev->vdev_id, nbuf_copy)) {
@@ -603,6 +606,8 @@ bool dp_rx_intrabss_ucast_fwd(struct dp_soc *soc, struct dp_peer *ta_peer,
 		}
 	}
 
+	qdf_nbuf_tx_cls_reset(nbuf);
+
 	if (!dp_tx_send((struct cdp_soc_t *)soc,
 			tx_vdev_id, nbuf)) {
 		DP_STATS_INC_PKT(ta_peer, rx.intra_bss.pkts, 1,
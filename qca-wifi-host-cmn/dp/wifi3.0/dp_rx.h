@@ -299,6 +299,22 @@ struct dp_rx_cached_buf {
 
 #endif /* QCA_HOST_MODE_WIFI_DISABLED */
 
+/**
+ * struct dp_rx_unaligned_u32 - 32 bit word at an arbitrary byte address
+ * @v: word value
+ */
+struct dp_rx_unaligned_u32 {
+	uint32_t v;
+} qdf_packed;
+
+/**
+ * struct dp_rx_unaligned_ul - machine word at an arbitrary byte address
+ * @v: word value
+ */
+struct dp_rx_unaligned_ul {
+	unsigned long v;
+} qdf_packed;
+
 /*
  *dp_rx_xor_block() - xor block of data
  *@b: destination data block
@@ -309,9 +325,13 @@ struct dp_rx_cached_buf {
  */
 static inline void dp_rx_xor_block(uint8_t *b, const uint8_t *a, qdf_size_t len)
 {
-	qdf_size_t i;
+	qdf_size_t i = 0;
 
-	for (i = 0; i < len; i++)
+	for (; i + sizeof(unsigned long) <= len; i += sizeof(unsigned long))
+		((struct dp_rx_unaligned_ul *)&b[i])->v ^=
+			((const struct dp_rx_unaligned_ul *)&a[i])->v;
+
+	for (; i < len; i++)
 		b[i] ^= a[i];
 }
 
@@ -386,16 +406,16 @@ static inline uint32_t dp_rx_get_le32_split(uint8_t b0, uint8_t b1, uint8_t b2,
 
 /*
  *dp_rx_get_le32() - get little endian 32 bits
- *@b0: byte 0
- *@b1: byte 1
- *@b2: byte 2
- *@b3: byte 3
+ *@p: source char array, need not be 4 byte aligned
+ *
+ * Reads the word with a single unaligned safe load, followed by a byte
+ * swap on big endian hosts only.
  *
  *Returns: Integer with little endian 32 bits
  */
 static inline uint32_t dp_rx_get_le32(const uint8_t *p)
 {
-	return dp_rx_get_le32_split(p[0], p[1], p[2], p[3]);
+	return qdf_le32_to_cpu(((const struct dp_rx_unaligned_u32 *)p)->v);
 }
 
 /*
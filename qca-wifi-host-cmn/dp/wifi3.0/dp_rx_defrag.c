@@ -164,11 +164,71 @@ void dp_rx_reorder_flush_frag(struct dp_peer *peer,
 	dp_rx_defrag_cleanup(peer, tid);
 }
 
+/*
+ * dp_rx_defrag_wheel_unlink(): Take a TID off the defrag timing wheel
+ * @soc: DP SOC
+ * @rx_reorder: rx TID on the wheel
+ *
+ * Caller holds the defrag_lock
+ *
+ * Returns: None
+ */
+static void dp_rx_defrag_wheel_unlink(struct dp_soc *soc,
+				      struct dp_rx_tid *rx_reorder)
+{
+	uint8_t slot = rx_reorder->defrag_wheel_slot - 1;
+
+	TAILQ_REMOVE(&soc->rx.defrag.wheel[slot], rx_reorder,
+		     defrag_waitlist_elem);
+	rx_reorder->defrag_wheel_slot = 0;
+	soc->rx.defrag.occupancy--;
+	DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
+}
+
+/*
+ * dp_rx_defrag_wheel_arm(): Arm the flush timer for the next busy slot
+ * @soc: DP SOC
+ * @now_ms: current time in msecs
+ *
+ * Looks ahead of the current wheel tick for the first occupied slot and
+ * programs the SOC defrag flush timer for it. Caller holds the
+ * defrag_lock.
+ *
+ * Returns: None
+ */
+static void dp_rx_defrag_wheel_arm(struct dp_soc *soc, uint32_t now_ms)
+{
+	uint32_t tick = soc->rx.defrag.cur_tick;
+	uint32_t next_ms;
+	uint32_t i;
+
+	if (!soc->rx.defrag.occupancy) {
+		soc->rx.defrag.next_flush_ms =
+			now_ms + soc->rx.defrag.timeout_ms;
+		return;
+	}
+
+	for (i = 1; i < DP_RX_DEFRAG_WHEEL_SLOTS; i++) {
+		if (!TAILQ_EMPTY(&soc->rx.defrag.wheel[(tick + i) &
+				 (DP_RX_DEFRAG_WHEEL_SLOTS - 1)]))
+			break;
+	}
+
+	next_ms = (tick + i) * DP_RX_DEFRAG_WHEEL_TICK_MS;
+	soc->rx.defrag.next_flush_ms = next_ms;
+	qdf_timer_mod(&soc->rx.defrag.flush_timer,
+		      (int32_t)(next_ms - now_ms) > 0 ? next_ms - now_ms : 1);
+}
+
 /*
  * dp_rx_defrag_waitlist_flush(): Flush SOC defrag wait list
  * @soc: DP SOC
  *
- * Flush fragments of all waitlisted TID's
+ * Sweeps the wheel slots for the ticks elapsed since the last flush and
+ * flushes the fragments of the TIDs whose defrag timeout has passed.
+ * Entries hashed into a swept slot for a later revolution are left in
+ * place, so the cost is bounded by the expired TIDs plus one slot visit
+ * per elapsed tick.
  *
  * Returns: None
  */
@@ -177,6 +237,8 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 	struct dp_rx_tid *rx_reorder = NULL;
 	struct dp_rx_tid *tmp;
 	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+	uint32_t now_tick = now_ms / DP_RX_DEFRAG_WHEEL_TICK_MS;
+	uint32_t ticks, slot;
 	TAILQ_HEAD(, dp_rx_tid) temp_list;
 
 	TAILQ_INIT(&temp_list);
@@ -184,34 +246,34 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 	dp_debug("Current time  %u", now_ms);
 
 	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
-	TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.waitlist,
-			   defrag_waitlist_elem, tmp) {
-		uint32_t tid;
+	ticks = now_tick - soc->rx.defrag.cur_tick;
+	if (ticks > DP_RX_DEFRAG_WHEEL_SLOTS)
+		ticks = DP_RX_DEFRAG_WHEEL_SLOTS;
+
+	while (ticks-- && soc->rx.defrag.occupancy) {
+		slot = (now_tick - ticks) & (DP_RX_DEFRAG_WHEEL_SLOTS - 1);
+
+		TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.wheel[slot],
+				   defrag_waitlist_elem, tmp) {
+			if ((int32_t)(now_ms -
+				      rx_reorder->defrag_timeout_ms) < 0)
+				continue;
+
+			if (rx_reorder->tid >= DP_MAX_TIDS) {
+				qdf_assert(0);
+				continue;
+			}
 
-		if (rx_reorder->defrag_timeout_ms > now_ms)
-			break;
+			dp_rx_defrag_wheel_unlink(soc, rx_reorder);
+			DP_STATS_INC(soc, rx.rx_frag_expired, 1);
 
-		tid = rx_reorder->tid;
-		if (tid >= DP_MAX_TIDS) {
-			qdf_assert(0);
-			continue;
+			/* Move to temp list and clean-up later */
+			TAILQ_INSERT_TAIL(&temp_list, rx_reorder,
+					  defrag_waitlist_elem);
 		}
-
-		TAILQ_REMOVE(&soc->rx.defrag.waitlist, rx_reorder,
-			     defrag_waitlist_elem);
-		DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
-
-		/* Move to temp list and clean-up later */
-		TAILQ_INSERT_TAIL(&temp_list, rx_reorder,
-				  defrag_waitlist_elem);
-	}
-	if (rx_reorder) {
-		soc->rx.defrag.next_flush_ms =
-			rx_reorder->defrag_timeout_ms;
-	} else {
-		soc->rx.defrag.next_flush_ms =
-			now_ms + soc->rx.defrag.timeout_ms;
 	}
+	soc->rx.defrag.cur_tick = now_tick;
+	dp_rx_defrag_wheel_arm(soc, now_ms);
 
 	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
 
@@ -240,12 +302,26 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 	}
 }
 
+/*
+ * dp_rx_defrag_flush_timer(): SOC defrag flush timer handler
+ * @arg: DP SOC
+ *
+ * Returns: None
+ */
+static void dp_rx_defrag_flush_timer(void *arg)
+{
+	struct dp_soc *soc = (struct dp_soc *)arg;
+
+	dp_rx_defrag_waitlist_flush(soc);
+}
+
 /*
  * dp_rx_defrag_waitlist_add(): Update per-PDEV defrag wait list
  * @peer: Pointer to the peer data structure
  * @tid: Transmit ID (TID)
  *
- * Appends per-tid fragments to global fragment wait list
+ * Hashes the per-tid fragments into the SOC defrag timing wheel by
+ * the tick of their defrag timeout
  *
  * Returns: None
  */
@@ -253,17 +329,40 @@ static void dp_rx_defrag_waitlist_add(struct dp_peer *peer, unsigned tid)
 {
 	struct dp_soc *psoc = peer->vdev->pdev->soc;
 	struct dp_rx_tid *rx_reorder = &peer->rx_tid[tid];
+	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+	uint32_t tick;
+	uint8_t slot;
 
 	dp_debug("Adding TID %u to waitlist for peer %pK at MAC address "QDF_MAC_ADDR_FMT,
 		 tid, peer, QDF_MAC_ADDR_REF(peer->mac_addr.raw));
 
-	/* TODO: use LIST macros instead of TAIL macros */
 	qdf_spin_lock_bh(&psoc->rx.defrag.defrag_lock);
-	if (TAILQ_EMPTY(&psoc->rx.defrag.waitlist))
-		psoc->rx.defrag.next_flush_ms = rx_reorder->defrag_timeout_ms;
-	TAILQ_INSERT_TAIL(&psoc->rx.defrag.waitlist, rx_reorder,
-				defrag_waitlist_elem);
+	if (rx_reorder->defrag_wheel_slot)
+		dp_rx_defrag_wheel_unlink(psoc, rx_reorder);
+
+	if (!psoc->rx.defrag.occupancy)
+		psoc->rx.defrag.cur_tick = now_ms / DP_RX_DEFRAG_WHEEL_TICK_MS;
+
+	/* round up so that the whole slot has expired when it is swept */
+	tick = (rx_reorder->defrag_timeout_ms +
+		DP_RX_DEFRAG_WHEEL_TICK_MS - 1) / DP_RX_DEFRAG_WHEEL_TICK_MS;
+	if ((int32_t)(tick - psoc->rx.defrag.cur_tick) <= 0)
+		tick = psoc->rx.defrag.cur_tick + 1;
+
+	slot = tick & (DP_RX_DEFRAG_WHEEL_SLOTS - 1);
+	TAILQ_INSERT_TAIL(&psoc->rx.defrag.wheel[slot], rx_reorder,
+			  defrag_waitlist_elem);
+	rx_reorder->defrag_wheel_slot = slot + 1;
+	psoc->rx.defrag.occupancy++;
 	DP_STATS_INC(psoc, rx.rx_frag_wait, 1);
+	if (psoc->rx.defrag.occupancy > psoc->stats.rx.rx_frag_wait_max)
+		DP_STATS_UPD(psoc, rx.rx_frag_wait_max,
+			     psoc->rx.defrag.occupancy);
+
+	if (psoc->rx.defrag.occupancy == 1 ||
+	    (int32_t)(tick * DP_RX_DEFRAG_WHEEL_TICK_MS -
+		      psoc->rx.defrag.next_flush_ms) < 0)
+		dp_rx_defrag_wheel_arm(psoc, now_ms);
 	qdf_spin_unlock_bh(&psoc->rx.defrag.defrag_lock);
 }
 
@@ -281,7 +380,6 @@ void dp_rx_defrag_waitlist_remove(struct dp_peer *peer, unsigned tid)
 	struct dp_pdev *pdev = peer->vdev->pdev;
 	struct dp_soc *soc = pdev->soc;
 	struct dp_rx_tid *rx_reorder;
-	struct dp_rx_tid *tmp;
 
 	dp_debug("Removing TID %u to waitlist for peer %pK at MAC address "QDF_MAC_ADDR_FMT,
 		 tid, peer, QDF_MAC_ADDR_REF(peer->mac_addr.raw));
@@ -291,21 +389,71 @@ void dp_rx_defrag_waitlist_remove(struct dp_peer *peer, unsigned tid)
 		qdf_assert_always(0);
 	}
 
+	rx_reorder = &peer->rx_tid[tid];
+
 	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
-	TAILQ_FOREACH_SAFE(rx_reorder, &soc->rx.defrag.waitlist,
-			   defrag_waitlist_elem, tmp) {
-		struct dp_peer *peer_on_waitlist;
+	if (rx_reorder->defrag_wheel_slot) {
+		dp_rx_defrag_wheel_unlink(soc, rx_reorder);
+		DP_STATS_INC(soc, rx.rx_frag_wait_removed, 1);
+	}
+	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
+}
 
-		/* get address of current peer */
-		peer_on_waitlist = rx_reorder->defrag_peer;
+/*
+ * dp_rx_defrag_wheel_init(): Set up the SOC defrag timing wheel
+ * @soc: DP SOC
+ *
+ * Returns: None
+ */
+void dp_rx_defrag_wheel_init(struct dp_soc *soc)
+{
+	uint32_t i;
 
-		/* Ensure it is TID for same peer */
-		if (peer_on_waitlist == peer && rx_reorder->tid == tid) {
-			TAILQ_REMOVE(&soc->rx.defrag.waitlist,
-				rx_reorder, defrag_waitlist_elem);
-			DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
-		}
-	}
+	for (i = 0; i < DP_RX_DEFRAG_WHEEL_SLOTS; i++)
+		TAILQ_INIT(&soc->rx.defrag.wheel[i]);
+
+	soc->rx.defrag.cur_tick = 0;
+	soc->rx.defrag.occupancy = 0;
+	qdf_timer_init(soc->osdev, &soc->rx.defrag.flush_timer,
+		       dp_rx_defrag_flush_timer, (void *)soc,
+		       QDF_TIMER_TYPE_SW);
+}
+
+/*
+ * dp_rx_defrag_wheel_deinit(): Tear down the SOC defrag timing wheel
+ * @soc: DP SOC
+ *
+ * Returns: None
+ */
+void dp_rx_defrag_wheel_deinit(struct dp_soc *soc)
+{
+	qdf_timer_stop(&soc->rx.defrag.flush_timer);
+	qdf_timer_free(&soc->rx.defrag.flush_timer);
+}
+
+/*
+ * dp_rx_defrag_wheel_suspend(): Stop the defrag flush timer on suspend
+ * @soc: DP SOC
+ *
+ * Returns: None
+ */
+void dp_rx_defrag_wheel_suspend(struct dp_soc *soc)
+{
+	qdf_timer_stop(&soc->rx.defrag.flush_timer);
+}
+
+/*
+ * dp_rx_defrag_wheel_resume(): Re-arm the defrag flush timer on resume
+ * @soc: DP SOC
+ *
+ * Returns: None
+ */
+void dp_rx_defrag_wheel_resume(struct dp_soc *soc)
+{
+	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+
+	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
+	dp_rx_defrag_wheel_arm(soc, now_ms);
 	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
 }
 
@@ -646,124 +794,107 @@ static void dp_rx_defrag_michdr(const struct ieee80211_frame *wh0,
 	hdr[13] = hdr[14] = hdr[15] = 0;	/* reserved */
 }
 
+/* Michael blocks processed per iteration of the contiguous data loop */
+#define DP_RX_DEFRAG_MIC_UNROLL 4
+
 /*
- * dp_rx_defrag_mic(): Calculate MIC header
+ * dp_rx_defrag_michael(): Calculate Michael MIC over a fragment chain
  * @key: Pointer to the key
+ * @hdr: Header processed ahead of the data
+ * @hdr_len: Length of @hdr, multiple of 4 bytes
  * @wbuf: fragment buffer
- * @off: Offset
+ * @off: Offset of the data in each fragment
  * @data_len: Data length
  * @mic: Array to hold MIC
  *
- * Calculate a pseudo MIC header
- *
  * Returns: QDF_STATUS
  */
-static QDF_STATUS dp_rx_defrag_mic(struct dp_soc *soc, const uint8_t *key,
-				   qdf_nbuf_t wbuf, uint16_t off,
-				   uint16_t data_len, uint8_t mic[])
+static QDF_STATUS dp_rx_defrag_michael(const uint8_t *key,
+				       const uint8_t *hdr, uint32_t hdr_len,
+				       qdf_nbuf_t wbuf, uint16_t off,
+				       uint16_t data_len, uint8_t mic[])
 {
-	uint8_t hdr[16] = { 0, };
-	uint32_t l, r;
+	uint8_t carry[sizeof(uint32_t)];
+	uint32_t ncarry = 0;
+	uint32_t l, r, i;
 	const uint8_t *data;
 	uint32_t space;
-	int rx_desc_len = soc->rx_pkt_tlv_size;
-
-	dp_rx_defrag_michdr((struct ieee80211_frame *)(qdf_nbuf_data(wbuf)
-		+ rx_desc_len), hdr);
 
 	l = dp_rx_get_le32(key);
 	r = dp_rx_get_le32(key + 4);
 
-	/* Michael MIC pseudo header: DA, SA, 3 x 0, Priority */
-	l ^= dp_rx_get_le32(hdr);
-	dp_rx_michael_block(l, r);
-	l ^= dp_rx_get_le32(&hdr[4]);
-	dp_rx_michael_block(l, r);
-	l ^= dp_rx_get_le32(&hdr[8]);
-	dp_rx_michael_block(l, r);
-	l ^= dp_rx_get_le32(&hdr[12]);
-	dp_rx_michael_block(l, r);
+	for (i = 0; i < hdr_len; i += sizeof(uint32_t)) {
+		l ^= dp_rx_get_le32(hdr + i);
+		dp_rx_michael_block(l, r);
+	}
 
-	/* first buffer has special handling */
+	/*
+	 * Walk the fragment chain in place. Blocks that lie within one
+	 * buffer are loaded directly, four at a time where possible; the
+	 * bytes of a block that straddles buffers (or of the short final
+	 * block) are gathered in @carry.
+	 */
 	data = (uint8_t *)qdf_nbuf_data(wbuf) + off;
 	space = qdf_nbuf_len(wbuf) - off;
 
 	for (;; ) {
 		if (space > data_len)
 			space = data_len;
+		data_len -= space;
+
+		if (ncarry) {
+			while (ncarry < sizeof(uint32_t) && space) {
+				carry[ncarry++] = *data++;
+				space--;
+			}
+			if (ncarry == sizeof(uint32_t)) {
+				l ^= dp_rx_get_le32(carry);
+				dp_rx_michael_block(l, r);
+				ncarry = 0;
+			}
+		}
+
+		while (space >= DP_RX_DEFRAG_MIC_UNROLL * sizeof(uint32_t)) {
+			l ^= dp_rx_get_le32(data);
+			dp_rx_michael_block(l, r);
+			l ^= dp_rx_get_le32(data + 4);
+			dp_rx_michael_block(l, r);
+			l ^= dp_rx_get_le32(data + 8);
+			dp_rx_michael_block(l, r);
+			l ^= dp_rx_get_le32(data + 12);
+			dp_rx_michael_block(l, r);
+			data += DP_RX_DEFRAG_MIC_UNROLL * sizeof(uint32_t);
+			space -= DP_RX_DEFRAG_MIC_UNROLL * sizeof(uint32_t);
+		}
 
-		/* collect 32-bit blocks from current buffer */
 		while (space >= sizeof(uint32_t)) {
 			l ^= dp_rx_get_le32(data);
 			dp_rx_michael_block(l, r);
 			data += sizeof(uint32_t);
 			space -= sizeof(uint32_t);
-			data_len -= sizeof(uint32_t);
 		}
-		if (data_len < sizeof(uint32_t))
+
+		while (space) {
+			carry[ncarry++] = *data++;
+			space--;
+		}
+
+		if (!data_len)
 			break;
 
 		wbuf = qdf_nbuf_next(wbuf);
-		if (!wbuf)
+		if (!wbuf || qdf_nbuf_len(wbuf) < off)
 			return QDF_STATUS_E_DEFRAG_ERROR;
 
-		if (space != 0) {
-			const uint8_t *data_next;
-			/*
-			 * Block straddles buffers, split references.
-			 */
-			data_next =
-				(uint8_t *)qdf_nbuf_data(wbuf) + off;
-			if ((qdf_nbuf_len(wbuf)) <
-				sizeof(uint32_t) - space) {
-				return QDF_STATUS_E_DEFRAG_ERROR;
-			}
-			switch (space) {
-			case 1:
-				l ^= dp_rx_get_le32_split(data[0],
-					data_next[0], data_next[1],
-					data_next[2]);
-				data = data_next + 3;
-				space = (qdf_nbuf_len(wbuf) - off) - 3;
-				break;
-			case 2:
-				l ^= dp_rx_get_le32_split(data[0], data[1],
-						    data_next[0], data_next[1]);
-				data = data_next + 2;
-				space = (qdf_nbuf_len(wbuf) - off) - 2;
-				break;
-			case 3:
-				l ^= dp_rx_get_le32_split(data[0], data[1],
-					data[2], data_next[0]);
-				data = data_next + 1;
-				space = (qdf_nbuf_len(wbuf) - off) - 1;
-				break;
-			}
-			dp_rx_michael_block(l, r);
-			data_len -= sizeof(uint32_t);
-		} else {
-			/*
-			 * Setup for next buffer.
-			 */
-			data = (uint8_t *)qdf_nbuf_data(wbuf) + off;
-			space = qdf_nbuf_len(wbuf) - off;
-		}
+		data = (uint8_t *)qdf_nbuf_data(wbuf) + off;
+		space = qdf_nbuf_len(wbuf) - off;
 	}
+
 	/* Last block and padding (0x5a, 4..7 x 0) */
-	switch (data_len) {
-	case 0:
-		l ^= dp_rx_get_le32_split(0x5a, 0, 0, 0);
-		break;
-	case 1:
-		l ^= dp_rx_get_le32_split(data[0], 0x5a, 0, 0);
-		break;
-	case 2:
-		l ^= dp_rx_get_le32_split(data[0], data[1], 0x5a, 0);
-		break;
-	case 3:
-		l ^= dp_rx_get_le32_split(data[0], data[1], data[2], 0x5a);
-		break;
-	}
+	carry[ncarry++] = 0x5a;
+	while (ncarry < sizeof(uint32_t))
+		carry[ncarry++] = 0;
+	l ^= dp_rx_get_le32(carry);
 	dp_rx_michael_block(l, r);
 	dp_rx_michael_block(l, r);
 	dp_rx_put_le32(mic, l);
@@ -772,6 +903,44 @@ static QDF_STATUS dp_rx_defrag_mic(struct dp_soc *soc, const uint8_t *key,
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_DP_RX_DEFRAG_TEST
+QDF_STATUS dp_rx_defrag_michael_test(const uint8_t *key, const uint8_t *hdr,
+				     uint32_t hdr_len, qdf_nbuf_t wbuf,
+				     uint16_t off, uint16_t data_len,
+				     uint8_t mic[])
+{
+	return dp_rx_defrag_michael(key, hdr, hdr_len, wbuf, off, data_len,
+				    mic);
+}
+#endif /* WLAN_DP_RX_DEFRAG_TEST */
+
+/*
+ * dp_rx_defrag_mic(): Calculate MIC header
+ * @key: Pointer to the key
+ * @wbuf: fragment buffer
+ * @off: Offset
+ * @data_len: Data length
+ * @mic: Array to hold MIC
+ *
+ * Calculate a pseudo MIC header
+ *
+ * Returns: QDF_STATUS
+ */
+static QDF_STATUS dp_rx_defrag_mic(struct dp_soc *soc, const uint8_t *key,
+				   qdf_nbuf_t wbuf, uint16_t off,
+				   uint16_t data_len, uint8_t mic[])
+{
+	uint8_t hdr[16] = { 0, };
+	int rx_desc_len = soc->rx_pkt_tlv_size;
+
+	dp_rx_defrag_michdr((struct ieee80211_frame *)(qdf_nbuf_data(wbuf)
+		+ rx_desc_len), hdr);
+
+	/* Michael MIC pseudo header: DA, SA, 3 x 0, Priority */
+	return dp_rx_defrag_michael(key, hdr, sizeof(hdr), wbuf, off,
+				    data_len, mic);
+}
+
 /*
  * dp_rx_defrag_tkip_demic(): Remove MIC header from the TKIP frame
  * @key: Pointer to the key
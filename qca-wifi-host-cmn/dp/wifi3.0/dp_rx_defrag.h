@@ -133,6 +133,10 @@ uint8_t dp_rx_get_pkt_dir(struct dp_soc *soc, uint8_t *rx_desc_info)
 }
 
 void dp_rx_defrag_waitlist_flush(struct dp_soc *soc);
+void dp_rx_defrag_wheel_init(struct dp_soc *soc);
+void dp_rx_defrag_wheel_deinit(struct dp_soc *soc);
+void dp_rx_defrag_wheel_suspend(struct dp_soc *soc);
+void dp_rx_defrag_wheel_resume(struct dp_soc *soc);
 void dp_rx_reorder_flush_frag(struct dp_peer *peer,
 			 unsigned int tid);
 void dp_rx_defrag_waitlist_remove(struct dp_peer *peer, unsigned tid);
@@ -141,4 +145,24 @@ void dp_rx_defrag_cleanup(struct dp_peer *peer, unsigned tid);
 QDF_STATUS dp_rx_defrag_add_last_frag(struct dp_soc *soc,
 				      struct dp_peer *peer, uint16_t tid,
 		uint16_t rxseq, qdf_nbuf_t nbuf);
+
+#ifdef WLAN_DP_RX_DEFRAG_TEST
+/**
+ * dp_rx_defrag_michael_test() - run the TKIP Michael MIC calculation of RX
+ * defrag on a given fragment chain
+ * @key: 8 byte Michael key
+ * @hdr: header processed ahead of the data, the pseudo header in RX defrag
+ * @hdr_len: length of @hdr, multiple of 4 bytes
+ * @wbuf: fragment chain, linked with qdf_nbuf_next()
+ * @off: offset of the data in each fragment
+ * @data_len: length of the data across the chain
+ * @mic: 8 byte array to hold the MIC
+ *
+ * Return: QDF_STATUS_E_DEFRAG_ERROR if the chain is shorter than @data_len
+ */
+QDF_STATUS dp_rx_defrag_michael_test(const uint8_t *key, const uint8_t *hdr,
+				     uint32_t hdr_len, qdf_nbuf_t wbuf,
+				     uint16_t off, uint16_t data_len,
+				     uint8_t mic[]);
+#endif /* WLAN_DP_RX_DEFRAG_TEST */
 #endif /* _DP_RX_DEFRAG_H */
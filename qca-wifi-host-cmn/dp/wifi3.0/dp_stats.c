@@ -6535,6 +6535,115 @@ int dp_fill_tx_interrupt_ctx_stats(struct dp_intr *intr_ctx,
 	return pos;
 }
 
+/**
+ * dp_print_srng_work_hist() - Print the work/quota histograms of the TX
+ *			       completion and REO destination rings
+ * @int_ctx_id: interrupt context id
+ * @intr_stats: interrupt stats of the context
+ *
+ * Return: None
+ */
+static void dp_print_srng_work_hist(int int_ctx_id,
+				    struct dp_intr_stats *intr_stats)
+{
+	uint32_t *hist;
+	int i;
+
+	for (i = 0; i < MAX_TCL_DATA_RINGS; i++) {
+		if (!intr_stats->num_tx_ring_masks[i])
+			continue;
+		hist = intr_stats->tx_comp_work_hist[i];
+		dp_info("%2u tx_comp[%u] work/quota <=25%%:%u <=50%%:%u <=75%%:%u <100%%:%u full:%u",
+			int_ctx_id, i, hist[DP_SRNG_WORK_25],
+			hist[DP_SRNG_WORK_50], hist[DP_SRNG_WORK_75],
+			hist[DP_SRNG_WORK_99], hist[DP_SRNG_WORK_FULL]);
+	}
+
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++) {
+		if (!intr_stats->num_rx_ring_masks[i])
+			continue;
+		hist = intr_stats->rx_work_hist[i];
+		dp_info("%2u reo[%u] work/quota <=25%%:%u <=50%%:%u <=75%%:%u <100%%:%u full:%u",
+			int_ctx_id, i, hist[DP_SRNG_WORK_25],
+			hist[DP_SRNG_WORK_50], hist[DP_SRNG_WORK_75],
+			hist[DP_SRNG_WORK_99], hist[DP_SRNG_WORK_FULL]);
+	}
+}
+
+#ifdef WLAN_DP_FEATURE_RING_PERF_STATS
+/**
+ * dp_print_srng_perf() - Print the processing cost of a DP ring
+ * @int_ctx_id: interrupt context id
+ * @ring_name: name of the ring class
+ * @ring: ring index
+ * @perf: perf stats of the ring
+ *
+ * Return: None
+ */
+static void dp_print_srng_perf(int int_ctx_id, const char *ring_name,
+			       int ring, struct dp_srng_perf_stats *perf)
+{
+	if (!perf->num_calls || !perf->num_entries)
+		return;
+
+	dp_info("%2u %s[%u] calls:%llu entries:%llu entries/call:%llu ns/entry:%llu max_ns:%llu",
+		int_ctx_id, ring_name, ring, perf->num_calls,
+		perf->num_entries,
+		qdf_do_div(perf->num_entries, perf->num_calls),
+		qdf_do_div(perf->time_ns, perf->num_entries),
+		perf->max_time_ns);
+}
+
+/**
+ * dp_print_srng_perf_stats() - Print the processing cost of the TX
+ *				completion and REO destination rings
+ * @int_ctx_id: interrupt context id
+ * @intr_stats: interrupt stats of the context
+ *
+ * Return: None
+ */
+static void dp_print_srng_perf_stats(int int_ctx_id,
+				     struct dp_intr_stats *intr_stats)
+{
+	int i;
+
+	for (i = 0; i < MAX_TCL_DATA_RINGS; i++)
+		dp_print_srng_perf(int_ctx_id, "tx_comp", i,
+				   &intr_stats->tx_comp_perf[i]);
+
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+		dp_print_srng_perf(int_ctx_id, "reo", i,
+				   &intr_stats->rx_perf[i]);
+}
+#else
+static inline void dp_print_srng_perf_stats(int int_ctx_id,
+					    struct dp_intr_stats *intr_stats)
+{
+}
+#endif /* WLAN_DP_FEATURE_RING_PERF_STATS */
+
+/**
+ * dp_print_intr_mod_stats() - Print the adaptive interrupt moderation state
+ *			       of an interrupt context
+ * @int_ctx_id: interrupt context id
+ * @int_ctx: interrupt context
+ *
+ * Return: None
+ */
+static void dp_print_intr_mod_stats(int int_ctx_id, struct dp_intr *int_ctx)
+{
+	struct dp_intr_mod *mod = &int_ctx->intr_mod;
+
+	if (!wlan_cfg_is_intr_mod_enabled(int_ctx->soc->wlan_cfg_ctx))
+		return;
+
+	dp_info("%2u intr_mod level:%u pkts/s:%u polls/s:%u changes:%u samples/level %u %u %u %u",
+		int_ctx_id, mod->level, mod->pkt_rate, mod->poll_rate,
+		mod->level_changes, mod->level_samples[0],
+		mod->level_samples[1], mod->level_samples[2],
+		mod->level_samples[3]);
+}
+
 #define DP_INT_CTX_STATS_STRING_LEN 512
 void dp_print_soc_interrupt_stats(struct dp_soc *soc)
 {
@@ -6607,6 +6716,9 @@ void dp_print_soc_interrupt_stats(struct dp_soc *soc)
 					     intr_stats->num_near_full_masks);
 
 		dp_info("%s", int_ctx_str);
+		dp_print_srng_work_hist(i, intr_stats);
+		dp_print_srng_perf_stats(i, intr_stats);
+		dp_print_intr_mod_stats(i, &soc->intr_ctx[i]);
 	}
 }
 
@@ -6650,6 +6762,10 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 		       soc->stats.rx.err.msdu_done_fail);
 	DP_PRINT_STATS("RX frags: %d", soc->stats.rx.rx_frags);
 	DP_PRINT_STATS("RX frag wait: %d", soc->stats.rx.rx_frag_wait);
+	DP_PRINT_STATS("RX frag wait max: %d", soc->stats.rx.rx_frag_wait_max);
+	DP_PRINT_STATS("RX frag expired: %d", soc->stats.rx.rx_frag_expired);
+	DP_PRINT_STATS("RX frag wait removed: %d",
+		       soc->stats.rx.rx_frag_wait_removed);
 	DP_PRINT_STATS("RX frag err: %d", soc->stats.rx.rx_frag_err);
 	DP_PRINT_STATS("RX frag OOR: %d", soc->stats.rx.rx_frag_oor);
 
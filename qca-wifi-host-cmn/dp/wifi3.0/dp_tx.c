@@ -1607,6 +1607,48 @@ static inline int dp_get_rtpm_tput_policy_requirement(struct dp_soc *soc)
 }
 #endif
 
+/**
+ * dp_tx_get_tid_from_cls() - Obtain TOS/TID from the TX classification record
+ * @nbuf: skb, classified by qdf_nbuf_tx_classify()
+ * @msdu_info: msdu descriptor, tid is updated for special frames
+ * @is_mcast: frame is multicast or broadcast
+ * @tos: filled with the TOS/traffic class to map through the DSCP-TID table
+ *
+ * Same decisions as the header parsing in dp_tx_get_tid(), taken from the
+ * record the OS shim left in the nbuf cb instead of the frame headers.
+ *
+ * Return: 1 if @tos is to be used for DSCP-TID mapping, 0 otherwise
+ */
+static inline uint8_t
+dp_tx_get_tid_from_cls(qdf_nbuf_t nbuf, struct dp_tx_msdu_info_s *msdu_info,
+		       uint8_t is_mcast, uint8_t *tos)
+{
+	uint8_t pkt_type = QDF_NBUF_CB_GET_PACKET_TYPE(nbuf);
+
+	if (qdf_nbuf_tx_cls_is_ipv4(nbuf)) {
+		if (pkt_type == QDF_NBUF_CB_PACKET_TYPE_DHCP) {
+			/* Only for unicast frames */
+			if (!is_mcast)
+				msdu_info->tid = DP_VO_TID;
+			return 0;
+		}
+		*tos = qdf_nbuf_tx_cls_get_tos(nbuf);
+		return 1;
+	}
+
+	if (qdf_nbuf_tx_cls_is_ipv6(nbuf)) {
+		*tos = qdf_nbuf_tx_cls_get_tos(nbuf);
+		return 1;
+	}
+
+	if (pkt_type == QDF_NBUF_CB_PACKET_TYPE_EAPOL)
+		msdu_info->tid = DP_VO_TID;
+	else if (pkt_type == QDF_NBUF_CB_PACKET_TYPE_ARP && !is_mcast)
+		msdu_info->tid = DP_VO_TID;
+
+	return 0;
+}
+
 /**
  * dp_tx_get_tid() - Obtain TID to be used for this frame
  * @vdev: DP vdev handle
@@ -1641,6 +1683,15 @@ static void dp_tx_get_tid(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 		return;
 	}
 
+	/* Headers were already walked by the OS shim, reuse its result */
+	if (qdf_nbuf_tx_cls_valid(nbuf)) {
+		is_mcast = QDF_NBUF_CB_GET_IS_BCAST(nbuf) ||
+			   QDF_NBUF_CB_GET_IS_MCAST(nbuf);
+		dscp_tid_override = dp_tx_get_tid_from_cls(nbuf, msdu_info,
+							   is_mcast, &tos);
+		goto map_tos;
+	}
+
 	is_mcast = DP_FRAME_IS_MULTICAST(hdr_ptr);
 	ether_type = eh->ether_type;
 
@@ -1712,6 +1763,7 @@ static void dp_tx_get_tid(struct dp_vdev *vdev, qdf_nbuf_t nbuf,
 		}
 	}
 
+map_tos:
 	/*
 	 * Assign all MCAST packets to BE
 	 */
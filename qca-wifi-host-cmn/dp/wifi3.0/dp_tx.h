@@ -934,4 +934,59 @@ void dp_tx_desc_check_corruption(struct dp_tx_desc_s *tx_desc)
 }
 #endif
 
+#ifdef QCA_TX_SOJOURN_AQM
+/**
+ * dp_tx_aqm_ac_to_level() - netdev sub-queue level carrying an access category
+ * @ac: WME access category
+ *
+ * Return: flow control threshold level of the sub-queue
+ */
+static inline enum dp_fl_ctrl_threshold dp_tx_aqm_ac_to_level(uint8_t ac)
+{
+	switch (ac) {
+	case WME_AC_VO:
+		return DP_TH_VO;
+	case WME_AC_VI:
+		return DP_TH_VI;
+	default:
+		return DP_TH_BE_BK;
+	}
+}
+
+/**
+ * dp_tx_aqm_desc_enqueue() - account a descriptor handed to the hw ring
+ * @soc: DP soc handle
+ * @tx_desc: tx descriptor
+ * @tid: tid the frame was classified to, or HTT_TX_EXT_TID_INVALID
+ *
+ * Only called once the descriptor got a TCL ring entry, so that the
+ * release of a descriptor which failed to enqueue is not sampled. The
+ * descriptor is stamped with a monotonic clock of its own, as the delay
+ * stats timestamp is wall clock and only set on demand.
+ *
+ * Return: none
+ */
+static inline void dp_tx_aqm_desc_enqueue(struct dp_soc *soc,
+					  struct dp_tx_desc_s *tx_desc,
+					  uint8_t tid)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[tx_desc->pool_id];
+
+	if (tid == HTT_TX_EXT_TID_INVALID)
+		tid = qdf_nbuf_get_priority(tx_desc->nbuf) & 0x7;
+
+	tx_desc->ac = TID_TO_WME_AC(tid);
+	tx_desc->aqm_enq_ms = (uint32_t)qdf_ktime_to_ms(qdf_ktime_get());
+	tx_desc->aqm_queued = 1;
+	qdf_atomic_inc(&pool->aqm[dp_tx_aqm_ac_to_level(tx_desc->ac)].
+		       outstanding);
+}
+#else
+static inline void dp_tx_aqm_desc_enqueue(struct dp_soc *soc,
+					  struct dp_tx_desc_s *tx_desc,
+					  uint8_t tid)
+{
+}
+#endif
+
 #endif
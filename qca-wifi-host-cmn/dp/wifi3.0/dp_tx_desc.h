@@ -191,6 +191,68 @@ void dp_tx_put_desc_flow_pool(struct dp_tx_desc_pool_s *pool,
 
 #ifdef QCA_AC_BASED_FLOW_CONTROL
 
+#ifdef QCA_TX_SOJOURN_AQM
+void dp_tx_aqm_sample(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		      struct dp_tx_desc_s *tx_desc);
+
+/**
+ * dp_tx_aqm_level_paused() - check if the AQM holds a sub-queue paused
+ * @pool: flow pool
+ * @level: sub-queue threshold level
+ *
+ * Caller needs to hold the flow pool lock.
+ *
+ * Return: true if the sub-queue must stay paused for the AQM
+ */
+static inline bool
+dp_tx_aqm_level_paused(struct dp_tx_desc_pool_s *pool,
+		       enum dp_fl_ctrl_threshold level)
+{
+	return pool->aqm[level].paused;
+}
+
+#ifdef WLAN_DP_TX_AQM_TEST
+/**
+ * dp_tx_aqm_init_test() - initialize the AQM state of a flow pool
+ * @pool: flow pool
+ * @target_ms: queueing delay target
+ * @interval_ms: observation interval
+ *
+ * Return: none
+ */
+void dp_tx_aqm_init_test(struct dp_tx_desc_pool_s *pool,
+			 uint32_t target_ms, uint32_t interval_ms);
+
+/**
+ * dp_tx_aqm_sample_test() - run the AQM of a sub-queue on a given sample
+ * @soc: dp soc, only its pause_cb is used
+ * @pool: flow pool
+ * @level: sub-queue threshold level
+ * @sojourn: sojourn of the released descriptor, in ms
+ * @now: current time in ms
+ * @drained: nothing queued on @level is left outstanding
+ *
+ * Return: none
+ */
+void dp_tx_aqm_sample_test(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+			   enum dp_fl_ctrl_threshold level, uint32_t sojourn,
+			   uint64_t now, bool drained);
+#endif
+#else
+static inline void
+dp_tx_aqm_sample(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		 struct dp_tx_desc_s *tx_desc)
+{
+}
+
+static inline bool
+dp_tx_aqm_level_paused(struct dp_tx_desc_pool_s *pool,
+		       enum dp_fl_ctrl_threshold level)
+{
+	return false;
+}
+#endif
+
 /**
  * dp_tx_flow_pool_member_clean() - Clean the members of TX flow pool
  *
@@ -397,8 +459,10 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 	qdf_time_t unpause_time = qdf_get_system_timestamp(), pause_dur;
 	enum netif_action_type act = WLAN_WAKE_ALL_NETIF_QUEUE;
 	enum netif_reason_type reason;
+	enum dp_fl_ctrl_threshold level = DP_TH_BE_BK;
 
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	dp_tx_aqm_sample(soc, pool, tx_desc);
 	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
 	tx_desc->nbuf = NULL;
 	tx_desc->flags = 0;
@@ -410,6 +474,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		if (pool->avail_desc > pool->start_th[DP_TH_HI]) {
 			act = WLAN_NETIF_PRIORITY_QUEUE_ON;
 			reason = WLAN_DATA_FLOW_CTRL_PRI;
+			level = DP_TH_HI;
 			pool->status = FLOW_POOL_VO_PAUSED;
 
 			/* Update maxinum pause duration for HI queue */
@@ -423,6 +488,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		if (pool->avail_desc > pool->start_th[DP_TH_VO]) {
 			act = WLAN_NETIF_VO_QUEUE_ON;
 			reason = WLAN_DATA_FLOW_CTRL_VO;
+			level = DP_TH_VO;
 			pool->status = FLOW_POOL_VI_PAUSED;
 
 			/* Update maxinum pause duration for VO queue */
@@ -436,6 +502,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		if (pool->avail_desc > pool->start_th[DP_TH_VI]) {
 			act = WLAN_NETIF_VI_QUEUE_ON;
 			reason = WLAN_DATA_FLOW_CTRL_VI;
+			level = DP_TH_VI;
 			pool->status = FLOW_POOL_BE_BK_PAUSED;
 
 			/* Update maxinum pause duration for VI queue */
@@ -449,6 +516,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		if (pool->avail_desc > pool->start_th[DP_TH_BE_BK]) {
 			act = WLAN_NETIF_BE_BK_QUEUE_ON;
 			reason = WLAN_DATA_FLOW_CTRL_BE_BK;
+			level = DP_TH_BE_BK;
 			pool->status = FLOW_POOL_ACTIVE_UNPAUSED;
 
 			/* Update maxinum pause duration for BE_BK queue */
@@ -479,7 +547,8 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		break;
 	};
 
-	if (act != WLAN_WAKE_ALL_NETIF_QUEUE)
+	if (act != WLAN_WAKE_ALL_NETIF_QUEUE &&
+	    !dp_tx_aqm_level_paused(pool, level))
 		soc->pause_cb(pool->flow_pool_id,
 			      act, reason);
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
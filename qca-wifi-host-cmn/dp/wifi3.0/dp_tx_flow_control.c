@@ -34,6 +34,447 @@
 #define FLOW_POOL_LOG_LEN 50
 
 #ifdef QCA_AC_BASED_FLOW_CONTROL
+#ifdef QCA_TX_SOJOURN_AQM
+static const enum netif_action_type dp_tx_aqm_off_act[FL_TH_MAX] = {
+	[DP_TH_BE_BK] = WLAN_NETIF_BE_BK_QUEUE_OFF,
+	[DP_TH_VI] = WLAN_NETIF_VI_QUEUE_OFF,
+	[DP_TH_VO] = WLAN_NETIF_VO_QUEUE_OFF,
+	[DP_TH_HI] = WLAN_NETIF_PRIORITY_QUEUE_OFF,
+};
+
+static const enum netif_action_type dp_tx_aqm_on_act[FL_TH_MAX] = {
+	[DP_TH_BE_BK] = WLAN_NETIF_BE_BK_QUEUE_ON,
+	[DP_TH_VI] = WLAN_NETIF_VI_QUEUE_ON,
+	[DP_TH_VO] = WLAN_NETIF_VO_QUEUE_ON,
+	[DP_TH_HI] = WLAN_NETIF_PRIORITY_QUEUE_ON,
+};
+
+static const enum netif_reason_type dp_tx_aqm_reason[FL_TH_MAX] = {
+	[DP_TH_BE_BK] = WLAN_DATA_FLOW_CTRL_BE_BK,
+	[DP_TH_VI] = WLAN_DATA_FLOW_CTRL_VI,
+	[DP_TH_VO] = WLAN_DATA_FLOW_CTRL_VO,
+	[DP_TH_HI] = WLAN_DATA_FLOW_CTRL_PRI,
+};
+
+/**
+ * dp_tx_flow_pool_level_paused() - check if the descriptor threshold
+ *				    logic holds a sub-queue paused
+ * @status: flow pool status
+ * @level: sub-queue threshold level
+ *
+ * Return: true if the sub-queue is paused for lack of descriptors
+ */
+static bool dp_tx_flow_pool_level_paused(enum flow_pool_status status,
+					 enum dp_fl_ctrl_threshold level)
+{
+	switch (status) {
+	case FLOW_POOL_ACTIVE_PAUSED:
+		return true;
+	case FLOW_POOL_VO_PAUSED:
+		return level <= DP_TH_VO;
+	case FLOW_POOL_VI_PAUSED:
+		return level <= DP_TH_VI;
+	case FLOW_POOL_BE_BK_PAUSED:
+		return level == DP_TH_BE_BK;
+	default:
+		return false;
+	}
+}
+
+/**
+ * dp_tx_aqm_isqrt() - integer square root
+ * @x: input value
+ *
+ * Return: floor(sqrt(x))
+ */
+static uint32_t dp_tx_aqm_isqrt(uint32_t x)
+{
+	uint32_t res = 0;
+	uint32_t bit = 1u << 30;
+
+	while (bit > x)
+		bit >>= 2;
+
+	while (bit) {
+		if (x >= res + bit) {
+			x -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return res;
+}
+
+/**
+ * dp_tx_aqm_next_interval() - length of the next observation interval
+ * @pool: flow pool
+ * @aqm: AQM state of the sub-queue
+ *
+ * Follows the CoDel control law: the more pauses a congestion episode
+ * needed, the sooner a persisting standing queue is acted upon again.
+ *
+ * Return: interval in ms
+ */
+static inline uint32_t
+dp_tx_aqm_next_interval(struct dp_tx_desc_pool_s *pool,
+			struct dp_tx_aqm_level *aqm)
+{
+	if (aqm->count <= 1)
+		return pool->aqm_interval_ms;
+
+	return pool->aqm_interval_ms / dp_tx_aqm_isqrt(aqm->count);
+}
+
+/**
+ * dp_tx_aqm_base_update() - track the service time floor of a sub-queue
+ * @pool: flow pool
+ * @aqm: AQM state of the sub-queue
+ * @sojourn: sojourn of the released descriptor, in ms
+ * @now: current time in ms
+ *
+ * The sojourn runs from the hw ring post to the completion, so it holds
+ * the air time of the frame on top of the time spent queued. The lowest
+ * sojourn of the last one to two floor windows stands for the former.
+ *
+ * Return: none
+ */
+static inline void dp_tx_aqm_base_update(struct dp_tx_desc_pool_s *pool,
+					 struct dp_tx_aqm_level *aqm,
+					 uint32_t sojourn, uint64_t now)
+{
+	if (now >= aqm->base_end) {
+		aqm->base_prev = aqm->base_cur;
+		aqm->base_cur = UINT32_MAX;
+		aqm->base_end = now + DP_TX_AQM_BASE_INTERVALS *
+				      pool->aqm_interval_ms;
+	}
+
+	if (sojourn < aqm->base_cur)
+		aqm->base_cur = sojourn;
+}
+
+/**
+ * dp_tx_aqm_target() - sojourn above which a sub-queue is congested
+ * @pool: flow pool
+ * @aqm: AQM state of the sub-queue
+ *
+ * Return: configured queueing delay target plus the service time floor,
+ *	   in ms
+ */
+static inline uint32_t dp_tx_aqm_target(struct dp_tx_desc_pool_s *pool,
+					struct dp_tx_aqm_level *aqm)
+{
+	uint32_t base = qdf_min(aqm->base_cur, aqm->base_prev);
+
+	if (base == UINT32_MAX)
+		base = 0;
+
+	return pool->aqm_target_ms + base;
+}
+
+/**
+ * dp_tx_aqm_set_paused() - pause or resume a sub-queue for the AQM
+ * @soc: dp soc
+ * @pool: flow pool
+ * @level: sub-queue threshold level
+ * @pause: true to pause, false to resume
+ * @now: current time in ms
+ *
+ * A paused sub-queue is watched for a full interval before it is resumed,
+ * a resumed one for an interval shrinking with the pause count before it
+ * is paused again. The netdev sub-queue is only toggled when the
+ * descriptor threshold logic does not hold it paused as well.
+ *
+ * Return: none
+ */
+static void dp_tx_aqm_set_paused(struct dp_soc *soc,
+				 struct dp_tx_desc_pool_s *pool,
+				 enum dp_fl_ctrl_threshold level,
+				 bool pause, uint64_t now)
+{
+	struct dp_tx_aqm_level *aqm = &pool->aqm[level];
+
+	aqm->paused = pause;
+	if (pause) {
+		if (now - aqm->last_pause > DP_TX_AQM_COUNT_RESET_INTERVALS *
+					    pool->aqm_interval_ms)
+			aqm->count = 1;
+		else
+			aqm->count++;
+		aqm->last_pause = now;
+		aqm->pause_cnt++;
+		aqm->interval_end = now + pool->aqm_interval_ms;
+	} else {
+		aqm->resume_cnt++;
+		aqm->interval_end = now + dp_tx_aqm_next_interval(pool, aqm);
+	}
+
+	aqm->min_sojourn = UINT32_MAX;
+
+	if (dp_tx_flow_pool_level_paused(pool->status, level))
+		return;
+
+	soc->pause_cb(pool->flow_pool_id,
+		      pause ? dp_tx_aqm_off_act[level] :
+			      dp_tx_aqm_on_act[level],
+		      dp_tx_aqm_reason[level]);
+}
+
+/**
+ * dp_tx_aqm_sample_level() - run the AQM of a sub-queue on a sojourn sample
+ * @soc: dp soc
+ * @pool: flow pool
+ * @level: sub-queue threshold level
+ * @sojourn: sojourn of the released descriptor, in ms
+ * @now: current time in ms
+ * @drained: nothing queued on @level is left outstanding
+ *
+ * A sub-queue is paused once the minimum sojourn seen over a whole
+ * interval stays above target, i.e. the hw queue holds a standing
+ * backlog. It is resumed once a whole interval passed with every sample
+ * below target, or once everything queued on it has drained. The backlog
+ * is thereby kept in the qdisc above the driver instead of in the
+ * descriptor rings.
+ *
+ * Caller needs to hold the flow pool lock.
+ *
+ * Return: none
+ */
+static void dp_tx_aqm_sample_level(struct dp_soc *soc,
+				   struct dp_tx_desc_pool_s *pool,
+				   enum dp_fl_ctrl_threshold level,
+				   uint32_t sojourn, uint64_t now, bool drained)
+{
+	struct dp_tx_aqm_level *aqm = &pool->aqm[level];
+	uint32_t target;
+
+	aqm->samples++;
+	aqm->sojourn_sum += sojourn;
+	if (sojourn > aqm->max_sojourn)
+		aqm->max_sojourn = sojourn;
+	if (sojourn < aqm->min_sojourn)
+		aqm->min_sojourn = sojourn;
+	dp_tx_aqm_base_update(pool, aqm, sojourn, now);
+
+	if (qdf_unlikely(pool->status == FLOW_POOL_INVALID ||
+			 pool->status == FLOW_POOL_INACTIVE))
+		return;
+
+	target = dp_tx_aqm_target(pool, aqm);
+
+	if (aqm->paused) {
+		if (drained) {
+			dp_tx_aqm_set_paused(soc, pool, level, false, now);
+			return;
+		}
+
+		/* Any sample above target restarts the resume interval */
+		if (sojourn >= target)
+			aqm->interval_end = now + pool->aqm_interval_ms;
+		else if (now >= aqm->interval_end)
+			dp_tx_aqm_set_paused(soc, pool, level, false, now);
+		return;
+	}
+
+	if (!aqm->interval_end) {
+		aqm->interval_end = now + pool->aqm_interval_ms;
+		return;
+	}
+
+	if (now < aqm->interval_end)
+		return;
+
+	if (aqm->min_sojourn >= target && !drained) {
+		dp_tx_aqm_set_paused(soc, pool, level, true, now);
+		return;
+	}
+
+	aqm->min_sojourn = UINT32_MAX;
+	aqm->interval_end = now + pool->aqm_interval_ms;
+}
+
+/**
+ * dp_tx_aqm_sample() - feed the sojourn time of a released descriptor
+ * @soc: dp soc
+ * @pool: flow pool the descriptor belongs to
+ * @tx_desc: tx descriptor being released, still carrying its enqueue time
+ *
+ * Caller needs to hold the flow pool lock.
+ *
+ * Return: none
+ */
+void dp_tx_aqm_sample(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		      struct dp_tx_desc_s *tx_desc)
+{
+	enum dp_fl_ctrl_threshold level = dp_tx_aqm_ac_to_level(tx_desc->ac);
+	uint64_t now;
+	uint32_t sojourn;
+	bool drained;
+
+	/* Never made it to the hw ring, e.g. released on enqueue failure */
+	if (!tx_desc->aqm_queued)
+		return;
+
+	tx_desc->aqm_queued = 0;
+	now = qdf_ktime_to_ms(qdf_ktime_get());
+	sojourn = (uint32_t)now - tx_desc->aqm_enq_ms;
+
+	drained = qdf_atomic_dec_and_test(&pool->aqm[level].outstanding);
+
+	dp_tx_aqm_sample_level(soc, pool, level, sojourn, now, drained);
+}
+
+/**
+ * dp_tx_aqm_reset() - drop the AQM congestion state of a flow pool
+ * @pool: flow pool
+ *
+ * Outstanding counts are kept as the descriptors are still in flight.
+ *
+ * Return: none
+ */
+static void dp_tx_aqm_reset(struct dp_tx_desc_pool_s *pool)
+{
+	struct dp_tx_aqm_level *aqm;
+	int i;
+
+	for (i = 0; i < FL_TH_MAX; i++) {
+		aqm = &pool->aqm[i];
+		aqm->paused = false;
+		aqm->count = 0;
+		aqm->min_sojourn = UINT32_MAX;
+		aqm->interval_end = 0;
+		aqm->base_cur = UINT32_MAX;
+		aqm->base_prev = UINT32_MAX;
+		aqm->base_end = 0;
+	}
+}
+
+/**
+ * dp_tx_aqm_resume_all() - resume the sub-queues held paused by the AQM
+ * @soc: dp soc
+ * @pool: flow pool
+ * @pool_status: flow pool status the sub-queues were left in
+ *
+ * Return: none
+ */
+static void dp_tx_aqm_resume_all(struct dp_soc *soc,
+				 struct dp_tx_desc_pool_s *pool,
+				 enum flow_pool_status pool_status)
+{
+	int i;
+
+	for (i = 0; i < FL_TH_MAX; i++) {
+		if (pool->aqm[i].paused &&
+		    !dp_tx_flow_pool_level_paused(pool_status, i))
+			soc->pause_cb(pool->flow_pool_id,
+				      dp_tx_aqm_on_act[i],
+				      dp_tx_aqm_reason[i]);
+	}
+
+	dp_tx_aqm_reset(pool);
+}
+
+/**
+ * __dp_tx_aqm_init() - initialize the AQM state of a new flow pool
+ * @pool: flow pool
+ * @target_ms: queueing delay target
+ * @interval_ms: observation interval
+ *
+ * Return: none
+ */
+static void __dp_tx_aqm_init(struct dp_tx_desc_pool_s *pool,
+			     uint32_t target_ms, uint32_t interval_ms)
+{
+	int i;
+
+	qdf_mem_zero(pool->aqm, sizeof(pool->aqm));
+	for (i = 0; i < FL_TH_MAX; i++)
+		qdf_atomic_init(&pool->aqm[i].outstanding);
+	dp_tx_aqm_reset(pool);
+
+	pool->aqm_target_ms = target_ms;
+	pool->aqm_interval_ms = interval_ms;
+}
+
+/**
+ * dp_tx_aqm_init() - initialize the AQM state of a new flow pool
+ * @soc: dp soc
+ * @pool: flow pool
+ *
+ * Return: none
+ */
+static void dp_tx_aqm_init(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool)
+{
+	__dp_tx_aqm_init(pool, wlan_cfg_get_tx_aqm_target(soc->wlan_cfg_ctx),
+			 wlan_cfg_get_tx_aqm_interval(soc->wlan_cfg_ctx));
+}
+
+#ifdef WLAN_DP_TX_AQM_TEST
+void dp_tx_aqm_init_test(struct dp_tx_desc_pool_s *pool,
+			 uint32_t target_ms, uint32_t interval_ms)
+{
+	__dp_tx_aqm_init(pool, target_ms, interval_ms);
+}
+
+void dp_tx_aqm_sample_test(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+			   enum dp_fl_ctrl_threshold level, uint32_t sojourn,
+			   uint64_t now, bool drained)
+{
+	dp_tx_aqm_sample_level(soc, pool, level, sojourn, now, drained);
+}
+#endif
+
+/**
+ * dp_tx_aqm_dump() - dump the AQM statistics of a flow pool
+ * @pool: flow pool
+ *
+ * Return: none
+ */
+static void dp_tx_aqm_dump(struct dp_tx_desc_pool_s *pool)
+{
+	struct dp_tx_aqm_level *aqm;
+	int i;
+
+	QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
+		  "AQM target %u ms :: interval %u ms",
+		  pool->aqm_target_ms, pool->aqm_interval_ms);
+	for (i = 0; i < FL_TH_MAX; i++) {
+		aqm = &pool->aqm[i];
+		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
+			  "Level %d :: AQM paused %d :: outstanding %d :: pause %u :: resume %u",
+			  i, aqm->paused, qdf_atomic_read(&aqm->outstanding),
+			  aqm->pause_cnt, aqm->resume_cnt);
+		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
+			  "Level %d :: AQM sojourn avg %llu ms :: max %u ms :: samples %u",
+			  i, aqm->samples ?
+			  qdf_do_div(aqm->sojourn_sum, aqm->samples) : 0,
+			  aqm->max_sojourn, aqm->samples);
+	}
+}
+#else
+static inline void dp_tx_aqm_reset(struct dp_tx_desc_pool_s *pool)
+{
+}
+
+static inline void dp_tx_aqm_resume_all(struct dp_soc *soc,
+					struct dp_tx_desc_pool_s *pool,
+					enum flow_pool_status pool_status)
+{
+}
+
+static inline void dp_tx_aqm_init(struct dp_soc *soc,
+				  struct dp_tx_desc_pool_s *pool)
+{
+}
+
+static inline void dp_tx_aqm_dump(struct dp_tx_desc_pool_s *pool)
+{
+}
+#endif
+
 /**
  * dp_tx_initialize_threshold() - Threshold of flow Pool initialization
  * @pool: flow_pool
@@ -92,6 +533,7 @@ dp_tx_flow_pool_reattach(struct dp_tx_desc_pool_s *pool)
 		  __func__, pool->pool_create_cnt);
 
 	pool->status = FLOW_POOL_ACTIVE_UNPAUSED_REATTACH;
+	dp_tx_aqm_reset(pool);
 	pool->pool_create_cnt++;
 }
 
@@ -117,6 +559,8 @@ dp_tx_flow_pool_dump_threshold(struct dp_tx_desc_pool_s *pool)
 			  "Level %d :: Latest pause timestamp %lu",
 			  i, pool->latest_pause_time[i]);
 	}
+
+	dp_tx_aqm_dump(pool);
 }
 
 /**
@@ -155,6 +599,8 @@ dp_tx_flow_ctrl_reset_subqueues(struct dp_soc *soc,
 	default:
 		break;
 	}
+
+	dp_tx_aqm_resume_all(soc, pool, pool_status);
 }
 
 #else
@@ -199,6 +645,10 @@ dp_tx_flow_ctrl_reset_subqueues(struct dp_soc *soc,
 {
 }
 
+static inline void dp_tx_aqm_init(struct dp_soc *soc,
+				  struct dp_tx_desc_pool_s *pool)
+{
+}
 #endif
 
 /**
@@ -365,6 +815,7 @@ struct dp_tx_desc_pool_s *dp_tx_create_flow_pool(struct dp_soc *soc,
 	pool->status = FLOW_POOL_ACTIVE_UNPAUSED;
 	dp_tx_initialize_threshold(pool, start_threshold, stop_threshold,
 				   flow_pool_size);
+	dp_tx_aqm_init(soc, pool);
 	pool->pool_create_cnt++;
 
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
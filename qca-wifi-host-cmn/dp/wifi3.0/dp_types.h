@@ -26,6 +26,8 @@
 #include <qdf_atomic.h>
 #include <qdf_util.h>
 #include <qdf_list.h>
+#include <qdf_hrtimer.h>
+#include <qdf_defer.h>
 #include <qdf_lro.h>
 #include <queue.h>
 #include <htt_common.h>
@@ -137,6 +139,13 @@
 
 #define DP_MAX_SRNGS 64
 
+/*
+ * Rx defrag timing wheel: waitlisted TIDs are hashed by expiry tick into
+ * DP_RX_DEFRAG_WHEEL_SLOTS slots (power of 2) of DP_RX_DEFRAG_WHEEL_TICK_MS
+ */
+#define DP_RX_DEFRAG_WHEEL_TICK_MS 10
+#define DP_RX_DEFRAG_WHEEL_SLOTS 32
+
 /* 2G PHYB */
 #define PHYB_2G_LMAC_ID 2
 #define PHYB_2G_TARGET_PDEV_ID 2
@@ -151,6 +160,19 @@
 #define FISA_FLOW_MAX_AGGR_COUNT        16 /* max flow aggregate count */
 #endif
 
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+/* Period of the FST aging pass */
+#define DP_FISA_AGING_INTERVAL_MS	1000
+/* Idle time after which a flow is evicted from the FST */
+#define DP_FISA_FLOW_IDLE_TIMEOUT_MS	5000
+/* Idle time used instead once the FST is 3/4th full */
+#define DP_FISA_FLOW_IDLE_TIMEOUT_PRESSURE_MS	1000
+/* Max flows evicted by one aging pass */
+#define DP_FISA_AGING_BATCH		16
+/* Number of aging passes kept in history */
+#define DP_FISA_AGING_HIST		10
+#endif
+
 #ifdef WLAN_FEATURE_RX_PREALLOC_BUFFER_POOL
 #define DP_RX_REFILL_BUFF_POOL_SIZE  2048
 #define DP_RX_REFILL_BUFF_POOL_BURST 64
@@ -542,6 +564,12 @@ struct dp_tx_ext_desc_pool_s {
  * 		   processing in completion event processing code.
  * 		   This field is filled in with the htt_pkt_type enum.
  * @buffer_src: buffer source TQM, REO, FW etc.
+ * @ac: WME access category the frame was queued on, used by the tx
+ *	sojourn AQM
+ * @aqm_queued: descriptor was handed to the hw ring and is accounted by
+ *		the tx sojourn AQM
+ * @aqm_enq_ms: monotonic time the descriptor was handed to the hw ring, in
+ *		ms, used by the tx sojourn AQM
  * @frm_type: Frame Type - ToDo check if this is redundant
  * @pkt_offset: Offset from which the actual packet data starts
  * @pool: handle to flow_pool this descriptor belongs to.
@@ -562,12 +590,16 @@ struct dp_tx_desc_s {
 	struct dp_pdev *pdev;
 	uint8_t tx_encap_type:2,
 		buffer_src:3,
-		reserved:3;
+		ac:2,
+		aqm_queued:1;
 	uint8_t frm_type;
 	uint8_t pkt_offset;
 	uint8_t  pool_id;
 	struct dp_tx_ext_desc_elem_s *msdu_ext_desc;
 	uint64_t timestamp;
+#ifdef QCA_TX_SOJOURN_AQM
+	uint32_t aqm_enq_ms;
+#endif
 	struct hal_tx_desc_comp_s comp;
 };
 
@@ -650,6 +682,47 @@ struct dp_tx_tso_num_seg_pool_s {
 	qdf_spinlock_t lock;
 };
 
+#ifdef QCA_TX_SOJOURN_AQM
+/* Pause episodes further apart than this many intervals restart the count */
+#define DP_TX_AQM_COUNT_RESET_INTERVALS 16
+/* Intervals over which each service time floor window is tracked */
+#define DP_TX_AQM_BASE_INTERVALS 16
+
+/**
+ * struct dp_tx_aqm_level - sojourn AQM state of one netdev sub-queue
+ * @outstanding: descriptors enqueued on this level and not yet freed
+ * @paused: sub-queue is currently held off by the AQM
+ * @count: pauses taken in the current congestion episode
+ * @min_sojourn: smallest sojourn seen in the current interval, in ms
+ * @interval_end: end of the current observation interval, in ms
+ * @last_pause: time of the latest AQM pause, in ms
+ * @base_cur: lowest sojourn of the current floor window, in ms
+ * @base_prev: lowest sojourn of the previous floor window, in ms
+ * @base_end: end of the current floor window, in ms
+ * @max_sojourn: largest sojourn seen, in ms
+ * @sojourn_sum: sum of all sampled sojourns, in ms
+ * @samples: number of sampled descriptors
+ * @pause_cnt: number of AQM pauses
+ * @resume_cnt: number of AQM resumes
+ */
+struct dp_tx_aqm_level {
+	qdf_atomic_t outstanding;
+	bool paused;
+	uint32_t count;
+	uint32_t min_sojourn;
+	uint64_t interval_end;
+	uint64_t last_pause;
+	uint32_t base_cur;
+	uint32_t base_prev;
+	uint64_t base_end;
+	uint32_t max_sojourn;
+	uint64_t sojourn_sum;
+	uint32_t samples;
+	uint32_t pause_cnt;
+	uint32_t resume_cnt;
+};
+#endif
+
 /**
  * struct dp_tx_desc_pool_s - Tx Descriptor pool information
  * @elem_size: Size of each descriptor in the pool
@@ -662,6 +735,9 @@ struct dp_tx_tso_num_seg_pool_s {
  * @flow_pool_array_lock: Lock when operating on flow_pool_array.
  * @flow_pool_array: List of allocated flow pools
  * @lock- Lock for descriptor allocation/free from/to the pool
+ * @aqm: per sub-queue sojourn AQM state, protected by @flow_pool_lock
+ * @aqm_target_ms: queueing delay the AQM lets a sub-queue build up
+ * @aqm_interval_ms: AQM observation interval
  */
 struct dp_tx_desc_pool_s {
 	uint16_t elem_size;
@@ -680,6 +756,11 @@ struct dp_tx_desc_pool_s {
 	uint16_t start_th[FL_TH_MAX];
 	qdf_time_t max_pause_time[FL_TH_MAX];
 	qdf_time_t latest_pause_time[FL_TH_MAX];
+#ifdef QCA_TX_SOJOURN_AQM
+	struct dp_tx_aqm_level aqm[FL_TH_MAX];
+	uint32_t aqm_target_ms;
+	uint32_t aqm_interval_ms;
+#endif
 #else
 	uint16_t stop_th;
 	uint16_t start_th;
@@ -820,6 +901,8 @@ struct dp_rx_tid {
 	uint64_t pn128[2];
 
 	uint32_t defrag_timeout_ms;
+	/* defrag wheel slot, valid while defrag_waitlist_elem is linked */
+	uint8_t defrag_wheel_slot;
 	uint16_t dialogtoken;
 	uint16_t statuscode;
 	/* user defined ADDBA response status code */
@@ -851,6 +934,40 @@ struct dp_rx_tid {
 	struct dp_peer *defrag_peer;
 };
 
+/**
+ * enum dp_srng_work_bucket - Buckets of the ring work/quota histogram
+ * @DP_SRNG_WORK_25: ring reaped up to 25% of the quota it was given
+ * @DP_SRNG_WORK_50: ring reaped 26% to 50% of the quota
+ * @DP_SRNG_WORK_75: ring reaped 51% to 75% of the quota
+ * @DP_SRNG_WORK_99: ring reaped 76% to 99% of the quota
+ * @DP_SRNG_WORK_FULL: ring exhausted the quota
+ * @DP_SRNG_WORK_MAX: max buckets
+ */
+enum dp_srng_work_bucket {
+	DP_SRNG_WORK_25,
+	DP_SRNG_WORK_50,
+	DP_SRNG_WORK_75,
+	DP_SRNG_WORK_99,
+	DP_SRNG_WORK_FULL,
+	DP_SRNG_WORK_MAX,
+};
+
+#ifdef WLAN_DP_FEATURE_RING_PERF_STATS
+/**
+ * struct dp_srng_perf_stats - Processing cost of a DP ring
+ * @num_calls: number of times the ring handler reaped entries
+ * @num_entries: total entries reaped
+ * @time_ns: total time spent in the ring handler
+ * @max_time_ns: longest single ring handler run
+ */
+struct dp_srng_perf_stats {
+	uint64_t num_calls;
+	uint64_t num_entries;
+	uint64_t time_ns;
+	uint64_t max_time_ns;
+};
+#endif
+
 /**
  * struct dp_intr_stats - DP Interrupt Stats for an interrupt context
  * @num_tx_ring_masks: interrupts with tx_ring_mask set
@@ -871,6 +988,10 @@ struct dp_rx_tid {
  *                       was received
  * @num_masks: total number of times the interrupt was received
  * @num_tx_mon_ring_masks: interrupts with num_tx_mon_ring_masks set
+ * @tx_comp_work_hist: work done/quota histogram of the TX completion rings
+ * @rx_work_hist: work done/quota histogram of the REO destination rings
+ * @tx_comp_perf: processing cost of the TX completion rings
+ * @rx_perf: processing cost of the REO destination rings
  *
  * Counter for individual masks are incremented only if there are any packets
  * on that ring.
@@ -891,6 +1012,55 @@ struct dp_intr_stats {
 	uint32_t num_near_full_masks;
 	uint32_t num_masks;
 	uint32_t num_tx_mon_ring_masks;
+	uint32_t tx_comp_work_hist[MAX_TCL_DATA_RINGS][DP_SRNG_WORK_MAX];
+	uint32_t rx_work_hist[MAX_REO_DEST_RINGS][DP_SRNG_WORK_MAX];
+#ifdef WLAN_DP_FEATURE_RING_PERF_STATS
+	struct dp_srng_perf_stats tx_comp_perf[MAX_TCL_DATA_RINGS];
+	struct dp_srng_perf_stats rx_perf[MAX_REO_DEST_RINGS];
+#endif
+};
+
+/* Number of adaptive interrupt moderation levels, 0 being the static one */
+#define DP_INTR_MOD_LEVELS 4
+
+/**
+ * struct dp_intr_mod - adaptive interrupt moderation of an interrupt context
+ * @level: current moderation level, as decided by the poll
+ * @applied_level: moderation level currently programmed on the rings
+ * @apply_work: work programming the thresholds of @level on the rings, as
+ *		the register writes may sleep and cannot be done from the poll
+ * @work_valid: @apply_work has been created
+ * @num_pkts: entries reaped from the TX completion and REO destination
+ *	      rings in the current sample window
+ * @num_polls: polls done in the current sample window
+ * @window_start: start of the current sample window, in system ticks
+ * @pkt_rate: packets per second of the last sample window
+ * @poll_rate: polls per second of the last sample window
+ * @base_valid: static thresholds below have been read from the rings
+ * @tx_base_timer_us: static interrupt timer threshold of the TX comp rings
+ * @tx_base_batch: static interrupt batch threshold of the TX comp rings
+ * @rx_base_timer_us: static interrupt timer threshold of the REO dst rings
+ * @rx_base_batch: static interrupt batch threshold of the REO dst rings
+ * @level_changes: number of times the thresholds were re-programmed
+ * @level_samples: number of sample windows which ended in each level
+ */
+struct dp_intr_mod {
+	uint8_t level;
+	uint8_t applied_level;
+	qdf_work_t apply_work;
+	bool work_valid;
+	uint32_t num_pkts;
+	uint32_t num_polls;
+	unsigned long window_start;
+	uint32_t pkt_rate;
+	uint32_t poll_rate;
+	bool base_valid;
+	uint32_t tx_base_timer_us;
+	uint32_t tx_base_batch;
+	uint32_t rx_base_timer_us;
+	uint32_t rx_base_batch;
+	uint32_t level_changes;
+	uint32_t level_samples[DP_INTR_MOD_LEVELS];
 };
 
 /* per interrupt context  */
@@ -919,6 +1089,13 @@ struct dp_intr {
 	qdf_lro_ctx_t lro_ctx;
 	uint8_t dp_intr_id;
 
+	/* Budget carried over by TX completion and REO dest ring classes */
+	int tx_comp_deficit;
+	int rx_deficit;
+
+	/* Adaptive interrupt moderation of the TX comp and REO dst rings */
+	struct dp_intr_mod intr_mod;
+
 	/* Interrupt Stats for individual masks */
 	struct dp_intr_stats intr_stats;
 };
@@ -1034,6 +1211,12 @@ struct dp_soc_stats {
 		uint32_t rx_frags;
 		/* No of incomplete fragments in waitlist */
 		uint32_t rx_frag_wait;
+		/* Peak no of TIDs in the defrag waitlist */
+		uint32_t rx_frag_wait_max;
+		/* Waitlisted TIDs flushed on defrag timeout */
+		uint32_t rx_frag_expired;
+		/* Waitlisted TIDs removed before the defrag timeout */
+		uint32_t rx_frag_wait_removed;
 		/* Fragments dropped due to errors */
 		uint32_t rx_frag_err;
 		/* Fragments received OOR causing sequence num mismatch */
@@ -1496,6 +1679,9 @@ struct dp_swlm_ops {
 				     struct dp_swlm_tcl_data *tcl_data);
 };
 
+/* Num buckets in the SWLM TCL coalescing added latency histogram */
+#define DP_SWLM_TCL_LATENCY_HIST_MAX 7
+
 /**
  * struct dp_swlm_stats - Stats for Software Latency manager.
  * @tcl.timer_flush_success: Num TCL HP writes success from timer context
@@ -1514,6 +1700,13 @@ struct dp_swlm_ops {
  *			   throughput did not meet session threshold
  * @tcl.coalesce_success: Num of TCL HP writes coalesced successfully.
  * @tcl.coalesce_fail: Num of TCL HP writes coalesces failed
+ * @tcl.coalesced_bytes: Num bytes sent with a coalesced TCL HP write
+ * @tcl.slo_violation: Num coalescing sessions which delayed the TCL HP
+ *		      write beyond the latency SLO
+ * @tcl.ring_backoff: Num times the coalescing budget was cut since the
+ *		     TCL ring occupancy was high
+ * @tcl.added_latency_hist: Histogram of the delay added to the TCL HP
+ *			   write by a coalescing session
  */
 struct dp_swlm_stats {
 	struct {
@@ -1527,6 +1720,10 @@ struct dp_swlm_stats {
 		uint32_t tput_criteria_fail;
 		uint32_t coalesce_success;
 		uint32_t coalesce_fail;
+		uint64_t coalesced_bytes;
+		uint32_t slo_violation;
+		uint32_t ring_backoff;
+		uint32_t added_latency_hist[DP_SWLM_TCL_LATENCY_HIST_MAX];
 	} tcl[MAX_TCL_DATA_RINGS];
 };
 
@@ -1535,7 +1732,9 @@ struct dp_swlm_stats {
  *			      in the Software latency manager.
  * @soc: DP soc reference
  * @ring_id: TCL ring id
- * @flush_timer: Timer for flushing the coalesced TCL HP writes
+ * @flush_timer: Backstop timer, armed at @time_flush_thresh when a
+ *		 coalescing session starts, to flush the TCL HP write
+ * @flush_bh: Bottom half doing the flush on behalf of @flush_timer
  * @sampling_session_tx_bytes: Num bytes transmitted in the sampling time
  * @bytes_flush_thresh: Bytes threshold to flush the TCL HP register write
  * @coalesce_end_time: End timestamp for current coalescing session
@@ -1545,11 +1744,17 @@ struct dp_swlm_stats {
  * @prev_rx_bytes: Previous RX bytes accounted
  * @expire_time: expiry time for sample
  * @tput_pass_cnt: threshold throughput pass counter
+ * @session_start_time: Timestamp of the first TCL HP write coalesced in the
+ *			current session, 0 if no write is pending
+ * @time_flush_thresh: Adaptive time threshold to flush the TCL HP write
+ * @bytes_budget: Adaptive multiplier, in units of 1/16, applied to the
+ *		  sampled tx bytes to deduce @bytes_flush_thresh
  */
 struct dp_swlm_tcl_params {
 	struct dp_soc *soc;
 	uint32_t ring_id;
-	qdf_timer_t flush_timer;
+	qdf_hrtimer_data_t flush_timer;
+	qdf_bh_t flush_bh;
 	uint32_t sampling_session_tx_bytes;
 	uint32_t bytes_flush_thresh;
 	uint64_t coalesce_end_time;
@@ -1559,6 +1764,9 @@ struct dp_swlm_tcl_params {
 	uint32_t prev_rx_bytes;
 	uint64_t expire_time;
 	uint32_t tput_pass_cnt;
+	uint64_t session_start_time;
+	uint32_t time_flush_thresh;
+	uint32_t bytes_budget;
 };
 
 /**
@@ -1575,6 +1783,8 @@ struct dp_swlm_tcl_params {
  *			      ending the coalescing.
  * @tx_pkt_thresh: Threshold for TX packet count, to begin TCL register
  *		       write coalescing
+ * @latency_slo: Max delay, in us, a coalescing session should add to the
+ *		 TCL HP register write
  * @tcl: TCL ring specific params
  */
 
@@ -1585,6 +1795,7 @@ struct dp_swlm_params {
 	uint32_t time_flush_thresh;
 	uint32_t tx_thresh_multiplier;
 	uint32_t tx_pkt_thresh;
+	uint32_t latency_slo;
 	struct dp_swlm_tcl_params tcl[MAX_TCL_DATA_RINGS];
 };
 
@@ -2004,7 +2215,13 @@ struct dp_soc {
 	/* rx defrag state – TBD: do we need this per radio? */
 	struct {
 		struct {
-			TAILQ_HEAD(, dp_rx_tid) waitlist;
+			/* waitlisted TIDs hashed by expiry tick */
+			TAILQ_HEAD(, dp_rx_tid) wheel[DP_RX_DEFRAG_WHEEL_SLOTS];
+			/* last wheel tick swept */
+			uint32_t cur_tick;
+			/* no of TIDs on the wheel */
+			uint32_t occupancy;
+			qdf_timer_t flush_timer;
 			uint32_t timeout_ms;
 			uint32_t next_flush_ms;
 			qdf_spinlock_t defrag_lock;
@@ -3555,6 +3772,16 @@ struct dp_fisa_stats {
 	/* flow index invalid from RX HW TLV */
 	uint32_t invalid_flow_index;
 	uint32_t reo_mismatch;
+	/* flush sweeps done over the per REO active flow lists */
+	uint32_t flush_sweeps;
+	/* flow entries visited by those flush sweeps */
+	uint64_t flush_entries_visited;
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+	/* TCP aggregates cut short by seq/ack/option mismatch */
+	uint32_t tcp_mismatch_flush;
+	/* TCP frames delivered without aggregation */
+	uint32_t tcp_not_eligible;
+#endif
 };
 
 enum fisa_aggr_ret {
@@ -3563,6 +3790,26 @@ enum fisa_aggr_ret {
 	FISA_FLUSH_FLOW
 };
 
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+/**
+ * struct dp_fisa_aging_record - FST aging stats of one aging interval
+ * @timestamp: time at which the aging pass ran
+ * @occupancy: populated flow entries found by the pass
+ * @idle: flow entries idle beyond the idle timeout
+ * @evicted: flow entries evicted by the pass
+ * @rx_msdus: msdus handed to FISA during the interval
+ * @aggr_msdus: msdus aggregated by FISA during the interval
+ */
+struct dp_fisa_aging_record {
+	uint64_t timestamp;
+	uint32_t occupancy;
+	uint32_t idle;
+	uint32_t evicted;
+	uint64_t rx_msdus;
+	uint64_t aggr_msdus;
+};
+#endif
+
 /**
  * struct fisa_pkt_hist - FISA Packet history structure
  * @tlv_hist: array of TLV history
@@ -3624,6 +3871,26 @@ struct dp_fisa_rx_sw_ft {
 	qdf_time_t last_accessed_ts;
 #ifdef WLAN_SUPPORT_RX_FISA_HIST
 	struct fisa_pkt_hist pkt_hist;
+#endif
+	/* Linkage in the active flow list of the REO ring napi_id */
+	TAILQ_ENTRY(dp_fisa_rx_sw_ft) active_list_elem;
+	/* Flag indicating whether flow is on the active flow list */
+	uint8_t is_active;
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+	/* Sequence number expected for the next in-order TCP segment */
+	uint32_t tcp_next_seq;
+	/* Payload length of the head TCP segment, used as gso_size */
+	uint16_t tcp_mss;
+	/* Number of TCP segments held in the aggregate */
+	uint16_t tcp_segs;
+	/* Flag indicating whether the aggregated TCP flow is over IPv6 */
+	uint8_t head_skb_is_ipv6;
+#endif
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+	/* HW FSE timestamp seen by the last aging pass */
+	uint32_t aging_hw_ts;
+	/* Time at which the aging pass saw the HW FSE timestamp move */
+	uint64_t aging_last_hit_ts;
 #endif
 };
 
@@ -3677,10 +3944,32 @@ struct dp_rx_fst {
 	uint32_t meta_counter;
 	uint32_t cmem_ba;
 	qdf_spinlock_t dp_rx_sw_ft_lock[MAX_REO_DEST_RINGS];
+	/* Per REO flows touched since their last flush */
+	TAILQ_HEAD(, dp_fisa_rx_sw_ft) active_flows[MAX_REO_DEST_RINGS];
+	/* Protects active_flows and the is_active flag of the flows on it */
+	qdf_spinlock_t active_flows_lock[MAX_REO_DEST_RINGS];
 	qdf_event_t cmem_resp_event;
 	bool flow_deletion_supported;
 	bool fst_in_cmem;
 	bool pm_suspended;
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+	/* FST aging, runs on fst_update_wq */
+	qdf_timer_t aging_timer;
+	qdf_work_t aging_work;
+	/* Aging timer is running, it is stopped while the FST is empty */
+	bool aging_armed;
+	/* Set at deinit, the aging timer is not re-armed anymore */
+	bool aging_stopped;
+	/* Per REO msdus handed to FISA and msdus aggregated */
+	uint64_t rx_msdus[MAX_REO_DEST_RINGS];
+	uint64_t aggr_msdus[MAX_REO_DEST_RINGS];
+	/* Totals of the above seen by the last aging pass */
+	uint64_t aging_rx_msdus;
+	uint64_t aging_aggr_msdus;
+	uint32_t aging_evict_count;
+	uint32_t aging_rec_idx;
+	struct dp_fisa_aging_record aging_rec[DP_FISA_AGING_HIST];
+#endif
 };
 
 #endif /* WLAN_SUPPORT_RX_FISA */
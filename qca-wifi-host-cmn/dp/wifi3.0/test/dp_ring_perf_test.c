@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "dp_types.h"
+#include "dp_internal.h"
+#include "dp_ring_perf_test.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+/* Number of ring handler runs accounted by the random test */
+#define DP_RING_PERF_UT_RUNS 4096
+
+/* Most entries reaped by one run, as with a full NAPI budget */
+#define DP_RING_PERF_UT_MAX_WORK 64
+
+/* Longest run, in ns, faked by moving the start time back */
+#define DP_RING_PERF_UT_MAX_LAG_NS 1000000
+
+#define ut_check(cond) __ut_check(!!(cond), #cond, __func__, __LINE__)
+
+static uint32_t
+__ut_check(bool pass, const char *expr, const char *func, uint32_t line)
+{
+	if (pass)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s:%u %s", func, line, expr);
+
+	return 1;
+}
+
+static uint32_t dp_ring_perf_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static uint64_t dp_ring_perf_ut_now(void)
+{
+	return qdf_ktime_to_ns(qdf_ktime_get());
+}
+
+/**
+ * dp_ring_perf_ut_idle() - Check runs which reaped nothing are not
+ *	accounted, however long they took
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_ring_perf_ut_idle(void)
+{
+	struct dp_srng_perf_stats perf = { 0 };
+	uint32_t errors = 0;
+
+	dp_srng_perf_update_test(&perf, dp_ring_perf_ut_now() -
+				 DP_RING_PERF_UT_MAX_LAG_NS, 0);
+	errors += ut_check(!perf.num_calls);
+	errors += ut_check(!perf.num_entries);
+	errors += ut_check(!perf.time_ns);
+	errors += ut_check(!perf.max_time_ns);
+
+	return errors;
+}
+
+/**
+ * dp_ring_perf_ut_random() - Check the counters against a reference over
+ *	random runs
+ *
+ * The time of each run is only known within the time the accounting call
+ * took, so the time counters are checked against a lower and an upper
+ * bound.
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_ring_perf_ut_random(void)
+{
+	struct dp_srng_perf_stats perf = { 0 };
+	uint64_t seed = 1;
+	uint64_t calls = 0, entries = 0;
+	uint64_t time_lo = 0, time_hi = 0;
+	uint64_t max_lo = 0, max_hi = 0;
+	uint64_t before, after;
+	uint32_t work, lag;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	for (i = 0; i < DP_RING_PERF_UT_RUNS; i++) {
+		work = dp_ring_perf_ut_rand(&seed,
+					    DP_RING_PERF_UT_MAX_WORK + 1);
+		lag = dp_ring_perf_ut_rand(&seed, DP_RING_PERF_UT_MAX_LAG_NS);
+
+		before = dp_ring_perf_ut_now();
+		dp_srng_perf_update_test(&perf, before - lag, work);
+		after = dp_ring_perf_ut_now();
+
+		if (!work)
+			continue;
+
+		calls++;
+		entries += work;
+		time_lo += lag;
+		time_hi += lag + (after - before);
+		max_lo = QDF_MAX(max_lo, lag);
+		max_hi = QDF_MAX(max_hi, lag + (after - before));
+	}
+
+	errors += ut_check(perf.num_calls == calls);
+	errors += ut_check(perf.num_entries == entries);
+	errors += ut_check(perf.time_ns >= time_lo);
+	errors += ut_check(perf.time_ns <= time_hi);
+	errors += ut_check(perf.max_time_ns >= max_lo);
+	errors += ut_check(perf.max_time_ns <= max_hi);
+
+	return errors;
+}
+
+uint32_t dp_ring_perf_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_ring_perf_ut_idle();
+	errors += dp_ring_perf_ut_random();
+	QDF_BUG(!errors);
+
+	return errors;
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "dp_types.h"
+#include "dp_rx_defrag.h"
+#include "dp_rx_defrag_test.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_str.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+#define DP_RX_DEFRAG_UT_MIC_LEN 8
+
+/* Largest offset of the data in a fragment, covers all load alignments */
+#define DP_RX_DEFRAG_UT_MAX_OFF 7
+
+/* Most fragments in a chain, as in the RX defrag reorder array */
+#define DP_RX_DEFRAG_UT_MAX_FRAGS 4
+
+/* Longest message of the random cross-check */
+#define DP_RX_DEFRAG_UT_MAX_LEN 300
+
+/* Number of random messages checked against the reference */
+#define DP_RX_DEFRAG_UT_RUNS 2000
+
+/* Length of the Michael MIC pseudo header: DA, SA, priority, 3 x 0 */
+#define DP_RX_DEFRAG_UT_HDR_LEN 16
+
+/**
+ * struct dp_rx_defrag_ut_kat - Michael known answer vector
+ * @key: Michael key
+ * @msg: message, with no pseudo header
+ * @mic: expected MIC
+ *
+ * Each key is the MIC of the previous vector, as published along with the
+ * Michael specification in IEEE 802.11i.
+ */
+struct dp_rx_defrag_ut_kat {
+	uint8_t key[DP_RX_DEFRAG_UT_MIC_LEN];
+	const char *msg;
+	uint8_t mic[DP_RX_DEFRAG_UT_MIC_LEN];
+};
+
+static const struct dp_rx_defrag_ut_kat dp_rx_defrag_ut_kats[] = {
+	{ { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, "",
+	  { 0x82, 0x92, 0x5c, 0x1c, 0xa1, 0xd1, 0x30, 0xb8 } },
+	{ { 0x82, 0x92, 0x5c, 0x1c, 0xa1, 0xd1, 0x30, 0xb8 }, "M",
+	  { 0x43, 0x47, 0x21, 0xca, 0x40, 0x63, 0x9b, 0x3f } },
+	{ { 0x43, 0x47, 0x21, 0xca, 0x40, 0x63, 0x9b, 0x3f }, "Mi",
+	  { 0xe8, 0xf9, 0xbe, 0xca, 0xe9, 0x7e, 0x5d, 0x29 } },
+	{ { 0xe8, 0xf9, 0xbe, 0xca, 0xe9, 0x7e, 0x5d, 0x29 }, "Mic",
+	  { 0x90, 0x03, 0x8f, 0xc6, 0xcf, 0x13, 0xc1, 0xdb } },
+	{ { 0x90, 0x03, 0x8f, 0xc6, 0xcf, 0x13, 0xc1, 0xdb }, "Mich",
+	  { 0xd5, 0x5e, 0x10, 0x05, 0x10, 0x12, 0x89, 0x86 } },
+	{ { 0xd5, 0x5e, 0x10, 0x05, 0x10, 0x12, 0x89, 0x86 }, "Michael",
+	  { 0x0a, 0x94, 0x2b, 0x12, 0x4e, 0xca, 0xa5, 0x46 } },
+};
+
+static uint8_t dp_rx_defrag_ut_msg[DP_RX_DEFRAG_UT_HDR_LEN +
+				   DP_RX_DEFRAG_UT_MAX_LEN];
+
+static uint32_t dp_rx_defrag_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static uint32_t dp_rx_defrag_ut_le32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t dp_rx_defrag_ut_rotl(uint32_t v, uint32_t n)
+{
+	return (v << n) | (v >> (32 - n));
+}
+
+static void dp_rx_defrag_ut_block(uint32_t *l, uint32_t *r)
+{
+	*r ^= dp_rx_defrag_ut_rotl(*l, 17);
+	*l += *r;
+	*r ^= ((*l & 0xff00ff00) >> 8) | ((*l & 0x00ff00ff) << 8);
+	*l += *r;
+	*r ^= dp_rx_defrag_ut_rotl(*l, 3);
+	*l += *r;
+	*r ^= dp_rx_defrag_ut_rotl(*l, 30);
+	*l += *r;
+}
+
+/**
+ * dp_rx_defrag_ut_ref_mic() - Reference Michael, a byte at a time over a
+ *	flat message as written in the specification
+ * @key: Michael key
+ * @msg: message
+ * @len: length of @msg
+ * @mic: array to hold the MIC
+ *
+ * Return: None
+ */
+static void dp_rx_defrag_ut_ref_mic(const uint8_t *key, const uint8_t *msg,
+				    uint32_t len, uint8_t *mic)
+{
+	uint32_t l = dp_rx_defrag_ut_le32(key);
+	uint32_t r = dp_rx_defrag_ut_le32(key + 4);
+	uint32_t m = 0;
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		m |= (uint32_t)msg[i] << (8 * (i % 4));
+		if (i % 4 == 3) {
+			l ^= m;
+			dp_rx_defrag_ut_block(&l, &r);
+			m = 0;
+		}
+	}
+
+	l ^= m | (0x5a << (8 * (len % 4)));
+	dp_rx_defrag_ut_block(&l, &r);
+	dp_rx_defrag_ut_block(&l, &r);
+
+	for (i = 0; i < 4; i++) {
+		mic[i] = l >> (8 * i);
+		mic[4 + i] = r >> (8 * i);
+	}
+}
+
+static void dp_rx_defrag_ut_free_chain(qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_t next;
+
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_free(nbuf);
+		nbuf = next;
+	}
+}
+
+/**
+ * dp_rx_defrag_ut_chain() - Build a fragment chain holding a message
+ * @msg: message
+ * @frag_len: length of the message in each fragment
+ * @num_frags: number of fragments
+ * @off: offset of the message in each fragment, filled with junk ahead
+ *
+ * Fragments are allocated 4 byte aligned, so @off sets the alignment of
+ * the loads.
+ *
+ * Return: head of the chain, NULL on allocation failure
+ */
+static qdf_nbuf_t dp_rx_defrag_ut_chain(const uint8_t *msg,
+					const uint32_t *frag_len,
+					uint32_t num_frags, uint16_t off)
+{
+	qdf_nbuf_t head = NULL, tail = NULL, nbuf;
+	uint32_t i;
+
+	for (i = 0; i < num_frags; i++) {
+		nbuf = qdf_nbuf_alloc(NULL, off + frag_len[i] + 1, 0, 4,
+				      false);
+		if (!nbuf) {
+			dp_rx_defrag_ut_free_chain(head);
+			return NULL;
+		}
+
+		qdf_nbuf_set_pktlen(nbuf, off + frag_len[i]);
+		qdf_mem_set(qdf_nbuf_data(nbuf), off, 0xa5);
+		qdf_mem_copy(qdf_nbuf_data(nbuf) + off, msg, frag_len[i]);
+		msg += frag_len[i];
+
+		if (tail)
+			qdf_nbuf_set_next(tail, nbuf);
+		else
+			head = nbuf;
+		tail = nbuf;
+	}
+
+	return head;
+}
+
+/**
+ * dp_rx_defrag_ut_check() - Compare the RX defrag MIC of a chain with
+ *	@exp_mic
+ * @key: Michael key
+ * @hdr: header processed ahead of the message
+ * @hdr_len: length of @hdr
+ * @msg: message
+ * @frag_len: length of the message in each fragment
+ * @num_frags: number of fragments
+ * @off: offset of the message in each fragment
+ * @exp_mic: expected MIC
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_rx_defrag_ut_check(const uint8_t *key, const uint8_t *hdr,
+				      uint32_t hdr_len, const uint8_t *msg,
+				      const uint32_t *frag_len,
+				      uint32_t num_frags, uint16_t off,
+				      const uint8_t *exp_mic)
+{
+	uint8_t mic[DP_RX_DEFRAG_UT_MIC_LEN];
+	uint32_t len = 0;
+	qdf_nbuf_t chain;
+	QDF_STATUS status;
+	uint32_t i;
+
+	for (i = 0; i < num_frags; i++)
+		len += frag_len[i];
+
+	chain = dp_rx_defrag_ut_chain(msg, frag_len, num_frags, off);
+	if (!chain) {
+		qdf_nofl_alert("FAIL: fragment chain allocation");
+		return 1;
+	}
+
+	status = dp_rx_defrag_michael_test(key, hdr, hdr_len, chain, off,
+					   len, mic);
+	dp_rx_defrag_ut_free_chain(chain);
+
+	if (QDF_IS_STATUS_ERROR(status) ||
+	    qdf_mem_cmp(mic, exp_mic, DP_RX_DEFRAG_UT_MIC_LEN)) {
+		qdf_nofl_alert("FAIL: Michael MIC, len %u frags %u off %u status %d",
+			       len, num_frags, off, status);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * dp_rx_defrag_ut_kat() - Check the known answer vectors
+ *
+ * Each vector is run at every load alignment, in one fragment and split in
+ * two fragments at every byte, which moves the short final block across
+ * the fragment boundary. The reference is checked against the vectors too.
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_rx_defrag_ut_kat(void)
+{
+	const struct dp_rx_defrag_ut_kat *kat;
+	uint8_t mic[DP_RX_DEFRAG_UT_MIC_LEN];
+	const uint8_t *msg;
+	uint32_t frag_len[2];
+	uint32_t errors = 0;
+	uint32_t i, len, split;
+	uint16_t off;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(dp_rx_defrag_ut_kats); i++) {
+		kat = &dp_rx_defrag_ut_kats[i];
+		msg = (const uint8_t *)kat->msg;
+		len = qdf_str_len(kat->msg);
+
+		dp_rx_defrag_ut_ref_mic(kat->key, msg, len, mic);
+		if (qdf_mem_cmp(mic, kat->mic, DP_RX_DEFRAG_UT_MIC_LEN)) {
+			qdf_nofl_alert("FAIL: reference Michael MIC of \"%s\"",
+				       kat->msg);
+			errors++;
+		}
+
+		for (off = 0; off <= DP_RX_DEFRAG_UT_MAX_OFF; off++) {
+			frag_len[0] = len;
+			errors += dp_rx_defrag_ut_check(kat->key, NULL, 0, msg,
+							frag_len, 1, off,
+							kat->mic);
+
+			for (split = 0; split <= len; split++) {
+				frag_len[0] = split;
+				frag_len[1] = len - split;
+				errors += dp_rx_defrag_ut_check(kat->key, NULL,
+								0, msg,
+								frag_len, 2,
+								off, kat->mic);
+			}
+		}
+	}
+
+	return errors;
+}
+
+/**
+ * dp_rx_defrag_ut_random() - Cross-check random chains with the reference
+ *
+ * Random keys, pseudo headers and messages are split in random fragment
+ * lengths, so that blocks straddle fragments at every position and the
+ * unrolled and the short final block paths are all taken.
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_rx_defrag_ut_random(void)
+{
+	uint8_t *hdr = dp_rx_defrag_ut_msg;
+	uint8_t *msg = dp_rx_defrag_ut_msg + DP_RX_DEFRAG_UT_HDR_LEN;
+	uint32_t frag_len[DP_RX_DEFRAG_UT_MAX_FRAGS];
+	uint8_t key[DP_RX_DEFRAG_UT_MIC_LEN];
+	uint8_t mic[DP_RX_DEFRAG_UT_MIC_LEN];
+	uint32_t num_frags, len, left;
+	uint64_t seed = 0x6d696368;
+	uint32_t errors = 0;
+	uint32_t run, i;
+	uint16_t off;
+
+	for (run = 0; run < DP_RX_DEFRAG_UT_RUNS; run++) {
+		for (i = 0; i < DP_RX_DEFRAG_UT_MIC_LEN; i++)
+			key[i] = dp_rx_defrag_ut_rand(&seed, 256);
+
+		len = dp_rx_defrag_ut_rand(&seed, DP_RX_DEFRAG_UT_MAX_LEN + 1);
+		for (i = 0; i < DP_RX_DEFRAG_UT_HDR_LEN + len; i++)
+			dp_rx_defrag_ut_msg[i] = dp_rx_defrag_ut_rand(&seed,
+								      256);
+
+		num_frags = 1 + dp_rx_defrag_ut_rand(&seed,
+						     DP_RX_DEFRAG_UT_MAX_FRAGS);
+		left = len;
+		for (i = 0; i < num_frags - 1; i++) {
+			frag_len[i] = dp_rx_defrag_ut_rand(&seed, left + 1);
+			left -= frag_len[i];
+		}
+		frag_len[i] = left;
+
+		off = dp_rx_defrag_ut_rand(&seed, DP_RX_DEFRAG_UT_MAX_OFF + 1);
+
+		dp_rx_defrag_ut_ref_mic(key, dp_rx_defrag_ut_msg,
+					DP_RX_DEFRAG_UT_HDR_LEN + len, mic);
+		errors += dp_rx_defrag_ut_check(key, hdr,
+						DP_RX_DEFRAG_UT_HDR_LEN, msg,
+						frag_len, num_frags, off, mic);
+	}
+
+	return errors;
+}
+
+/**
+ * dp_rx_defrag_ut_short_chain() - Check a chain shorter than the data
+ *	length is rejected
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_rx_defrag_ut_short_chain(void)
+{
+	const struct dp_rx_defrag_ut_kat *kat = &dp_rx_defrag_ut_kats[5];
+	uint8_t mic[DP_RX_DEFRAG_UT_MIC_LEN];
+	uint32_t frag_len[2] = { 3, 3 };
+	qdf_nbuf_t chain;
+	QDF_STATUS status;
+
+	chain = dp_rx_defrag_ut_chain((const uint8_t *)kat->msg, frag_len, 2,
+				      1);
+	if (!chain) {
+		qdf_nofl_alert("FAIL: fragment chain allocation");
+		return 1;
+	}
+
+	status = dp_rx_defrag_michael_test(kat->key, NULL, 0, chain, 1,
+					   qdf_str_len(kat->msg), mic);
+	dp_rx_defrag_ut_free_chain(chain);
+
+	if (status != QDF_STATUS_E_DEFRAG_ERROR) {
+		qdf_nofl_alert("FAIL: short chain -> status %d", status);
+		return 1;
+	}
+
+	return 0;
+}
+
+uint32_t dp_rx_defrag_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_rx_defrag_ut_kat();
+	errors += dp_rx_defrag_ut_random();
+	errors += dp_rx_defrag_ut_short_chain();
+	QDF_BUG(!errors);
+
+	return errors;
+}
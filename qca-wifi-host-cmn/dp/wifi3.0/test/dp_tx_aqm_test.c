@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "dp_types.h"
+#include "dp_tx_desc.h"
+#include "dp_tx_aqm_test.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+#define DP_TX_AQM_UT_TARGET 5
+#define DP_TX_AQM_UT_INTERVAL 100
+
+/* Milliseconds between two released descriptors */
+#define DP_TX_AQM_UT_STEP 1
+
+/* Service time floor of the sub-queue, i.e. the air time of a frame */
+#define DP_TX_AQM_UT_FLOOR 3
+
+/* Air time longer than the target, which alone must not pause */
+#define DP_TX_AQM_UT_LONG_FLOOR 20
+
+/* Largest jitter added on top of the floor of an uncongested sample */
+#define DP_TX_AQM_UT_JITTER 3
+
+/* Number of back to back congestion episodes of the control law test */
+#define DP_TX_AQM_UT_EPISODES 9
+
+#define ut_check(cond) __ut_check(!!(cond), #cond, __func__, __LINE__)
+
+/**
+ * struct dp_tx_aqm_ut_ctx - state shared with the pause callback
+ * @off_cnt: number of sub-queue pauses
+ * @on_cnt: number of sub-queue resumes
+ * @action: action of the latest callback
+ * @reason: reason of the latest callback
+ */
+struct dp_tx_aqm_ut_ctx {
+	uint32_t off_cnt;
+	uint32_t on_cnt;
+	enum netif_action_type action;
+	enum netif_reason_type reason;
+};
+
+static struct dp_tx_aqm_ut_ctx dp_tx_aqm_ut_ctx;
+
+static const enum netif_action_type dp_tx_aqm_ut_off_act[FL_TH_MAX] = {
+	[DP_TH_BE_BK] = WLAN_NETIF_BE_BK_QUEUE_OFF,
+	[DP_TH_VI] = WLAN_NETIF_VI_QUEUE_OFF,
+	[DP_TH_VO] = WLAN_NETIF_VO_QUEUE_OFF,
+	[DP_TH_HI] = WLAN_NETIF_PRIORITY_QUEUE_OFF,
+};
+
+static const enum netif_action_type dp_tx_aqm_ut_on_act[FL_TH_MAX] = {
+	[DP_TH_BE_BK] = WLAN_NETIF_BE_BK_QUEUE_ON,
+	[DP_TH_VI] = WLAN_NETIF_VI_QUEUE_ON,
+	[DP_TH_VO] = WLAN_NETIF_VO_QUEUE_ON,
+	[DP_TH_HI] = WLAN_NETIF_PRIORITY_QUEUE_ON,
+};
+
+static const enum netif_reason_type dp_tx_aqm_ut_reason[FL_TH_MAX] = {
+	[DP_TH_BE_BK] = WLAN_DATA_FLOW_CTRL_BE_BK,
+	[DP_TH_VI] = WLAN_DATA_FLOW_CTRL_VI,
+	[DP_TH_VO] = WLAN_DATA_FLOW_CTRL_VO,
+	[DP_TH_HI] = WLAN_DATA_FLOW_CTRL_PRI,
+};
+
+static uint32_t
+__ut_check(bool pass, const char *expr, const char *func, uint32_t line)
+{
+	if (pass)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s:%u %s", func, line, expr);
+
+	return 1;
+}
+
+static uint32_t dp_tx_aqm_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static void dp_tx_aqm_ut_pause_cb(uint8_t vdev_id,
+				  enum netif_action_type action,
+				  enum netif_reason_type reason)
+{
+	switch (action) {
+	case WLAN_NETIF_BE_BK_QUEUE_OFF:
+	case WLAN_NETIF_VI_QUEUE_OFF:
+	case WLAN_NETIF_VO_QUEUE_OFF:
+	case WLAN_NETIF_PRIORITY_QUEUE_OFF:
+		dp_tx_aqm_ut_ctx.off_cnt++;
+		break;
+	default:
+		dp_tx_aqm_ut_ctx.on_cnt++;
+		break;
+	}
+
+	dp_tx_aqm_ut_ctx.action = action;
+	dp_tx_aqm_ut_ctx.reason = reason;
+}
+
+/**
+ * dp_tx_aqm_ut_setup() - Allocate a soc and an active flow pool
+ * @soc: filled with a zeroed soc carrying the test pause callback
+ * @pool: filled with a flow pool with fresh AQM state
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS dp_tx_aqm_ut_setup(struct dp_soc **soc,
+				     struct dp_tx_desc_pool_s **pool)
+{
+	*soc = qdf_mem_malloc(sizeof(**soc));
+	if (!*soc)
+		return QDF_STATUS_E_NOMEM;
+
+	*pool = qdf_mem_malloc(sizeof(**pool));
+	if (!*pool) {
+		qdf_mem_free(*soc);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	(*soc)->pause_cb = dp_tx_aqm_ut_pause_cb;
+	(*pool)->status = FLOW_POOL_ACTIVE_UNPAUSED;
+	dp_tx_aqm_init_test(*pool, DP_TX_AQM_UT_TARGET, DP_TX_AQM_UT_INTERVAL);
+	qdf_mem_zero(&dp_tx_aqm_ut_ctx, sizeof(dp_tx_aqm_ut_ctx));
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void dp_tx_aqm_ut_teardown(struct dp_soc *soc,
+				  struct dp_tx_desc_pool_s *pool)
+{
+	qdf_mem_free(pool);
+	qdf_mem_free(soc);
+}
+
+/**
+ * dp_tx_aqm_ut_idle() - Feed uncongested samples, checking nothing pauses
+ * @soc: dp soc
+ * @pool: flow pool
+ * @level: sub-queue threshold level
+ * @floor: service time floor of the samples
+ * @now: current time, advanced past the fed samples
+ * @duration: time to feed samples for
+ * @seed: random seed of the jitter
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_tx_aqm_ut_idle(struct dp_soc *soc,
+				  struct dp_tx_desc_pool_s *pool,
+				  enum dp_fl_ctrl_threshold level,
+				  uint32_t floor, uint64_t *now,
+				  uint32_t duration, uint64_t *seed)
+{
+	uint64_t end = *now + duration;
+	uint32_t errors = 0;
+	uint32_t sojourn;
+
+	for (; *now < end; *now += DP_TX_AQM_UT_STEP) {
+		sojourn = floor + dp_tx_aqm_ut_rand(seed, DP_TX_AQM_UT_JITTER);
+		dp_tx_aqm_sample_test(soc, pool, level, sojourn, *now, false);
+		errors += ut_check(!dp_tx_aqm_level_paused(pool, level));
+	}
+
+	return errors;
+}
+
+/**
+ * dp_tx_aqm_ut_congest() - Feed samples of a standing queue until the
+ *	sub-queue gets paused
+ * @soc: dp soc
+ * @pool: flow pool
+ * @level: sub-queue threshold level
+ * @floor: service time floor of the samples
+ * @now: current time, advanced to the pause
+ * @seed: random seed of the jitter
+ *
+ * Return: time from the first congested sample to the pause, 0 if the
+ *	   sub-queue never got paused
+ */
+static uint32_t dp_tx_aqm_ut_congest(struct dp_soc *soc,
+				     struct dp_tx_desc_pool_s *pool,
+				     enum dp_fl_ctrl_threshold level,
+				     uint32_t floor, uint64_t *now,
+				     uint64_t *seed)
+{
+	uint64_t start = *now;
+	uint32_t sojourn;
+
+	for (; *now < start + 4 * DP_TX_AQM_UT_INTERVAL;
+	     *now += DP_TX_AQM_UT_STEP) {
+		sojourn = floor + DP_TX_AQM_UT_TARGET +
+			  dp_tx_aqm_ut_rand(seed, DP_TX_AQM_UT_JITTER);
+		dp_tx_aqm_sample_test(soc, pool, level, sojourn, *now, false);
+		if (dp_tx_aqm_level_paused(pool, level))
+			return *now - start + DP_TX_AQM_UT_STEP;
+	}
+
+	return 0;
+}
+
+/**
+ * dp_tx_aqm_ut_air_time() - Check a long air time alone never pauses
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_tx_aqm_ut_air_time(void)
+{
+	struct dp_tx_desc_pool_s *pool;
+	struct dp_soc *soc;
+	uint64_t seed = 1;
+	uint64_t now = 1000;
+	uint32_t errors = 0;
+
+	if (QDF_IS_STATUS_ERROR(dp_tx_aqm_ut_setup(&soc, &pool)))
+		return 1;
+
+	errors += dp_tx_aqm_ut_idle(soc, pool, DP_TH_BE_BK,
+				    DP_TX_AQM_UT_LONG_FLOOR, &now,
+				    40 * DP_TX_AQM_UT_INTERVAL, &seed);
+	errors += ut_check(!dp_tx_aqm_ut_ctx.off_cnt);
+
+	dp_tx_aqm_ut_teardown(soc, pool);
+
+	return errors;
+}
+
+/**
+ * dp_tx_aqm_ut_pause_resume() - Check a standing queue pauses its own
+ *	sub-queue, and resume needs a whole interval below target
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_tx_aqm_ut_pause_resume(void)
+{
+	struct dp_tx_desc_pool_s *pool;
+	struct dp_soc *soc;
+	enum dp_fl_ctrl_threshold level;
+	uint64_t seed = 2;
+	uint64_t now = 1000;
+	uint64_t last_high, end;
+	uint32_t errors = 0;
+	uint32_t target = DP_TX_AQM_UT_FLOOR + DP_TX_AQM_UT_TARGET;
+	uint32_t delay, sojourn;
+	bool high;
+
+	for (level = DP_TH_BE_BK; level <= DP_TH_VO; level++) {
+		if (QDF_IS_STATUS_ERROR(dp_tx_aqm_ut_setup(&soc, &pool)))
+			return errors + 1;
+
+		errors += dp_tx_aqm_ut_idle(soc, pool, level,
+					    DP_TX_AQM_UT_FLOOR, &now,
+					    10 * DP_TX_AQM_UT_INTERVAL, &seed);
+
+		/* Takes the rest of the current interval and a whole one */
+		delay = dp_tx_aqm_ut_congest(soc, pool, level,
+					     DP_TX_AQM_UT_FLOOR, &now, &seed);
+		errors += ut_check(delay >= DP_TX_AQM_UT_INTERVAL);
+		errors += ut_check(delay <= 2 * DP_TX_AQM_UT_INTERVAL +
+				   DP_TX_AQM_UT_STEP);
+		errors += ut_check(dp_tx_aqm_ut_ctx.off_cnt == 1);
+		errors += ut_check(dp_tx_aqm_ut_ctx.action ==
+				   dp_tx_aqm_ut_off_act[level]);
+		errors += ut_check(dp_tx_aqm_ut_ctx.reason ==
+				   dp_tx_aqm_ut_reason[level]);
+
+		/* A sample above target every 60 ms keeps it paused */
+		last_high = now;
+		end = now + 10 * DP_TX_AQM_UT_INTERVAL;
+		for (now += DP_TX_AQM_UT_STEP; now < end;
+		     now += DP_TX_AQM_UT_STEP) {
+			high = !((now - last_high) % 60);
+			sojourn = high ? target :
+				  DP_TX_AQM_UT_FLOOR +
+				  dp_tx_aqm_ut_rand(&seed, DP_TX_AQM_UT_JITTER);
+			if (high)
+				last_high = now;
+			dp_tx_aqm_sample_test(soc, pool, level, sojourn, now,
+					      false);
+			errors += ut_check(dp_tx_aqm_level_paused(pool,
+								  level));
+		}
+
+		/* Then resumes once a whole interval stayed below target */
+		for (; now < end + 2 * DP_TX_AQM_UT_INTERVAL;
+		     now += DP_TX_AQM_UT_STEP) {
+			sojourn = DP_TX_AQM_UT_FLOOR +
+				  dp_tx_aqm_ut_rand(&seed, DP_TX_AQM_UT_JITTER);
+			dp_tx_aqm_sample_test(soc, pool, level, sojourn, now,
+					      false);
+			if (!dp_tx_aqm_level_paused(pool, level))
+				break;
+		}
+		errors += ut_check(!dp_tx_aqm_level_paused(pool, level));
+		errors += ut_check(now - last_high >= DP_TX_AQM_UT_INTERVAL);
+		errors += ut_check(now - last_high <= DP_TX_AQM_UT_INTERVAL +
+				   DP_TX_AQM_UT_STEP);
+		errors += ut_check(dp_tx_aqm_ut_ctx.on_cnt == 1);
+		errors += ut_check(dp_tx_aqm_ut_ctx.action ==
+				   dp_tx_aqm_ut_on_act[level]);
+
+		/* Paused again, a drained sub-queue resumes right away */
+		now += DP_TX_AQM_UT_STEP;
+		errors += ut_check(dp_tx_aqm_ut_congest(soc, pool, level,
+							DP_TX_AQM_UT_FLOOR,
+							&now, &seed));
+		now += DP_TX_AQM_UT_STEP;
+		dp_tx_aqm_sample_test(soc, pool, level, target, now, true);
+		errors += ut_check(!dp_tx_aqm_level_paused(pool, level));
+		errors += ut_check(dp_tx_aqm_ut_ctx.on_cnt == 2);
+
+		dp_tx_aqm_ut_teardown(soc, pool);
+		now += DP_TX_AQM_UT_STEP;
+	}
+
+	return errors;
+}
+
+/**
+ * dp_tx_aqm_ut_control_law() - Check the interval after a resume shrinks
+ *	with the number of pauses of the congestion episode
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_tx_aqm_ut_control_law(void)
+{
+	static const uint32_t isqrt[DP_TX_AQM_UT_EPISODES + 1] = {
+		1, 1, 1, 1, 2, 2, 2, 2, 2, 3
+	};
+	struct dp_tx_desc_pool_s *pool;
+	struct dp_soc *soc;
+	uint64_t seed = 3;
+	uint64_t now = 1000;
+	uint32_t errors = 0;
+	uint32_t delay, expected;
+	uint32_t i;
+
+	if (QDF_IS_STATUS_ERROR(dp_tx_aqm_ut_setup(&soc, &pool)))
+		return 1;
+
+	errors += dp_tx_aqm_ut_idle(soc, pool, DP_TH_BE_BK,
+				    DP_TX_AQM_UT_FLOOR, &now,
+				    10 * DP_TX_AQM_UT_INTERVAL, &seed);
+	errors += ut_check(dp_tx_aqm_ut_congest(soc, pool, DP_TH_BE_BK,
+						DP_TX_AQM_UT_FLOOR, &now,
+						&seed));
+
+	for (i = 1; i <= DP_TX_AQM_UT_EPISODES; i++) {
+		/* Exactly one clean interval resumes it */
+		now += DP_TX_AQM_UT_INTERVAL;
+		dp_tx_aqm_sample_test(soc, pool, DP_TH_BE_BK,
+				      DP_TX_AQM_UT_FLOOR, now, false);
+		errors += ut_check(!dp_tx_aqm_level_paused(pool,
+							   DP_TH_BE_BK));
+
+		now += DP_TX_AQM_UT_STEP;
+		delay = dp_tx_aqm_ut_congest(soc, pool, DP_TH_BE_BK,
+					     DP_TX_AQM_UT_FLOOR, &now, &seed);
+		expected = DP_TX_AQM_UT_INTERVAL / isqrt[i];
+		errors += ut_check(delay >= expected);
+		errors += ut_check(delay <= expected + DP_TX_AQM_UT_STEP);
+	}
+	errors += ut_check(dp_tx_aqm_ut_ctx.off_cnt ==
+			   DP_TX_AQM_UT_EPISODES + 1);
+
+	dp_tx_aqm_ut_teardown(soc, pool);
+
+	return errors;
+}
+
+/**
+ * dp_tx_aqm_ut_pool_state() - Check the AQM leaves the netdev sub-queues
+ *	to the descriptor threshold logic when that holds them paused, and
+ *	stays out of inactive pools
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_tx_aqm_ut_pool_state(void)
+{
+	struct dp_tx_desc_pool_s *pool;
+	struct dp_soc *soc;
+	uint64_t seed = 4;
+	uint64_t now = 1000;
+	uint32_t errors = 0;
+
+	if (QDF_IS_STATUS_ERROR(dp_tx_aqm_ut_setup(&soc, &pool)))
+		return 1;
+
+	pool->status = FLOW_POOL_BE_BK_PAUSED;
+	errors += dp_tx_aqm_ut_idle(soc, pool, DP_TH_BE_BK,
+				    DP_TX_AQM_UT_FLOOR, &now,
+				    10 * DP_TX_AQM_UT_INTERVAL, &seed);
+	errors += ut_check(dp_tx_aqm_ut_congest(soc, pool, DP_TH_BE_BK,
+						DP_TX_AQM_UT_FLOOR, &now,
+						&seed));
+	now += DP_TX_AQM_UT_STEP;
+	dp_tx_aqm_sample_test(soc, pool, DP_TH_BE_BK, DP_TX_AQM_UT_FLOOR, now,
+			      true);
+	errors += ut_check(!dp_tx_aqm_level_paused(pool, DP_TH_BE_BK));
+	errors += ut_check(!dp_tx_aqm_ut_ctx.off_cnt);
+	errors += ut_check(!dp_tx_aqm_ut_ctx.on_cnt);
+
+	pool->status = FLOW_POOL_INACTIVE;
+	errors += ut_check(!dp_tx_aqm_ut_congest(soc, pool, DP_TH_VI,
+						 DP_TX_AQM_UT_FLOOR, &now,
+						 &seed));
+	errors += ut_check(!dp_tx_aqm_ut_ctx.off_cnt);
+
+	dp_tx_aqm_ut_teardown(soc, pool);
+
+	return errors;
+}
+
+uint32_t dp_tx_aqm_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_tx_aqm_ut_air_time();
+	errors += dp_tx_aqm_ut_pause_resume();
+	errors += dp_tx_aqm_ut_control_law();
+	errors += dp_tx_aqm_ut_pool_state();
+	QDF_BUG(!errors);
+
+	return errors;
+}
@@ -2491,6 +2491,36 @@ static inline void hal_srng_dst_hw_init(struct hal_soc *hal,
 	hal->ops->hal_srng_dst_hw_init(hal, srng);
 }
 
+/**
+ * hal_srng_dst_set_intr_thresholds() - Re-program the interrupt timer and
+ *					batch counter thresholds of an
+ *					initialized destination ring
+ * @hal_soc_hdl: Opaque HAL SOC handle
+ * @hal_ring_hdl: Destination ring pointer
+ * @timer_thres_us: interrupt timer threshold in us
+ * @batch_thres_entries: interrupt batch counter threshold in entries
+ *
+ * Return: QDF_STATUS_SUCCESS if the thresholds were updated,
+ *	   QDF_STATUS_E_NOSUPPORT if the target does not support it
+ */
+static inline QDF_STATUS
+hal_srng_dst_set_intr_thresholds(hal_soc_handle_t hal_soc_hdl,
+				 hal_ring_handle_t hal_ring_hdl,
+				 uint32_t timer_thres_us,
+				 uint32_t batch_thres_entries)
+{
+	struct hal_soc *hal_soc = (struct hal_soc *)hal_soc_hdl;
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+
+	if (!hal_soc->ops->hal_srng_dst_set_intr_thres)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	hal_soc->ops->hal_srng_dst_set_intr_thres(hal_soc, srng,
+						  timer_thres_us,
+						  batch_thres_entries);
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * hal_srng_src_hw_init - Private function to initialize SRNG
  * source ring HW
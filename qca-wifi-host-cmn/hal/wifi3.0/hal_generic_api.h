@@ -352,6 +352,54 @@ static inline void hal_srng_dst_near_full_int_setup(struct hal_srng *srng)
 }
 #endif
 
+/**
+ * hal_srng_dst_int_setup() - Program the interrupt timer and batch counter
+ *			      thresholds of a destination ring
+ * @srng: SRNG ring pointer
+ *
+ * Return: None
+ */
+static inline void hal_srng_dst_int_setup(struct hal_srng *srng)
+{
+	uint32_t reg_val = 0;
+
+	if (srng->intr_timer_thres_us) {
+		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
+			INTERRUPT_TIMER_THRESHOLD),
+			srng->intr_timer_thres_us >> 3);
+	}
+
+	if (srng->intr_batch_cntr_thres_entries) {
+		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
+			BATCH_COUNTER_THRESHOLD),
+			srng->intr_batch_cntr_thres_entries *
+			srng->entry_size);
+	}
+
+	SRNG_DST_REG_WRITE(srng, PRODUCER_INT_SETUP, reg_val);
+}
+
+/**
+ * hal_srng_dst_set_intr_thres_generic() - Update the interrupt thresholds
+ *					   of an initialized destination ring
+ * @hal: HAL SOC handle
+ * @srng: SRNG ring pointer
+ * @timer_thres_us: interrupt timer threshold in us
+ * @batch_thres_entries: interrupt batch counter threshold in entries
+ *
+ * Return: None
+ */
+static inline
+void hal_srng_dst_set_intr_thres_generic(struct hal_soc *hal,
+					 struct hal_srng *srng,
+					 uint32_t timer_thres_us,
+					 uint32_t batch_thres_entries)
+{
+	srng->intr_timer_thres_us = timer_thres_us;
+	srng->intr_batch_cntr_thres_entries = batch_thres_entries;
+	hal_srng_dst_int_setup(srng);
+}
+
 /**
  * hal_srng_dst_hw_init - Private function to initialize SRNG
  * destination ring HW
@@ -398,21 +446,7 @@ void hal_srng_dst_hw_init_generic(struct hal_soc *hal,
 	 * Default interrupt mode is 'pulse'. Need to setup SW_INTERRUPT_MODE
 	 * if level mode is required
 	 */
-	reg_val = 0;
-	if (srng->intr_timer_thres_us) {
-		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
-			INTERRUPT_TIMER_THRESHOLD),
-			srng->intr_timer_thres_us >> 3);
-	}
-
-	if (srng->intr_batch_cntr_thres_entries) {
-		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
-			BATCH_COUNTER_THRESHOLD),
-			srng->intr_batch_cntr_thres_entries *
-			srng->entry_size);
-	}
-
-	SRNG_DST_REG_WRITE(srng, PRODUCER_INT_SETUP, reg_val);
+	hal_srng_dst_int_setup(srng);
 
 	/**
 	 * Near-Full Interrupt setup:
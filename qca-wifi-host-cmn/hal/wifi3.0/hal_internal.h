@@ -398,6 +398,14 @@ typedef struct hal_ring_handle *hal_ring_handle_t;
  */
 #define HAL_SRNG_FLUSH_EVENT BIT(0)
 
+/*
+ * HAL_SRNG_REG_WRITE_PENDING: bit in hal_srng reg_write_state which is held
+ * from the first HP/TP update that needs a delayed write until the register
+ * has been written with the latest value. Updates which find the bit already
+ * set are coalesced into the pending write.
+ */
+#define HAL_SRNG_REG_WRITE_PENDING 0
+
 #if defined(FEATURE_HAL_DELAYED_REG_WRITE)
 
 /**
@@ -431,6 +439,7 @@ struct hal_reg_write_q_elem {
  * @coalesces: writes not enqueued since srng is already queued up
  * @direct: writes not enqueued and written to register directly
  * @dequeue_delay: dequeue operation be delayed
+ * @max_write_delay_us: max time from enqueue to register write completion
  */
 struct hal_reg_write_srng_stats {
 	uint32_t enqueues;
@@ -438,6 +447,7 @@ struct hal_reg_write_srng_stats {
 	uint32_t coalesces;
 	uint32_t direct;
 	uint32_t dequeue_delay;
+	uint32_t max_write_delay_us;
 };
 
 /**
@@ -467,6 +477,9 @@ enum hal_reg_sched_delay {
  * @max_q_depth: maximum queue for delayed register write queue
  * @sched_delay: = kernel work sched delay + bus wakeup delay, histogram
  * @dequeue_delay: dequeue operation be delayed
+ * @write_delay: enqueue to register write completion delay, histogram
+ * @max_write_delay_us: max enqueue to register write completion delay
+ * @work_runs: number of worker runs which wrote at least one register
  */
 struct hal_reg_write_soc_stats {
 	qdf_atomic_t enqueues;
@@ -478,6 +491,9 @@ struct hal_reg_write_soc_stats {
 	uint32_t max_q_depth;
 	uint32_t sched_delay[REG_WRITE_SCHED_DELAY_HIST_MAX];
 	uint32_t dequeue_delay;
+	uint32_t write_delay[REG_WRITE_SCHED_DELAY_HIST_MAX];
+	uint32_t max_write_delay_us;
+	uint32_t work_runs;
 };
 #endif
 
@@ -634,8 +650,17 @@ struct hal_srng {
 	uint32_t last_desc_cleared;
 #endif
 #if defined(FEATURE_HAL_DELAYED_REG_WRITE)
-	/* flag to indicate whether srng is already queued for delayed write */
-	uint8_t reg_write_in_progress;
+	/*
+	 * HAL_SRNG_REG_WRITE_PENDING is set while the srng is queued for
+	 * a delayed write, all further updates are coalesced into it
+	 */
+	unsigned long reg_write_state;
+	/*
+	 * HP/TP value last committed to HW through the register write path,
+	 * the delayed write publishes this rather than the SW HP/TP which can
+	 * be ahead of it (reap mode, SWLM deferred HP update)
+	 */
+	uint32_t reg_write_val;
 	/* last dequeue elem time stamp */
 	qdf_time_t last_dequeue_time;
 
@@ -731,6 +756,10 @@ struct hal_hw_txrx_ops {
 				     struct hal_srng *srng);
 	void (*hal_srng_src_hw_init)(struct hal_soc *hal,
 				     struct hal_srng *srng);
+	void (*hal_srng_dst_set_intr_thres)(struct hal_soc *hal,
+					    struct hal_srng *srng,
+					    uint32_t timer_thres_us,
+					    uint32_t batch_thres_entries);
 	void (*hal_get_hw_hptp)(struct hal_soc *hal,
 				hal_ring_handle_t hal_ring_hdl,
 				uint32_t *headp, uint32_t *tailp,
@@ -903,6 +932,8 @@ struct hal_hw_txrx_ops {
 				uint32_t table_offset, uint8_t *rx_flow);
 	uint32_t (*hal_rx_flow_get_cmem_fse_ts)(struct hal_soc *soc,
 						uint32_t fse_offset);
+	void (*hal_rx_flow_invalidate_cmem_fse)(struct hal_soc *soc,
+						uint32_t fse_offset);
 	void (*hal_rx_flow_get_cmem_fse)(struct hal_soc *soc,
 					 uint32_t fse_offset,
 					 uint32_t *fse, qdf_size_t len);
@@ -207,6 +207,24 @@ uint32_t hal_rx_flow_get_cmem_fse_timestamp(hal_soc_handle_t hal_soc_hdl,
 }
 qdf_export_symbol(hal_rx_flow_get_cmem_fse_timestamp);
 
+/**
+ * hal_rx_flow_invalidate_cmem_fse() - Clear valid bit of a CMEM FSE
+ * @hal_soc_hdl: HAL SOC handle
+ * @fse_offset: CMEM FSE offset
+ *
+ * Return: None
+ */
+void hal_rx_flow_invalidate_cmem_fse(hal_soc_handle_t hal_soc_hdl,
+				     uint32_t fse_offset)
+{
+	struct hal_soc *hal_soc = (struct hal_soc *)hal_soc_hdl;
+
+	if (hal_soc->ops->hal_rx_flow_invalidate_cmem_fse)
+		hal_soc->ops->hal_rx_flow_invalidate_cmem_fse(hal_soc,
+							      fse_offset);
+}
+qdf_export_symbol(hal_rx_flow_invalidate_cmem_fse);
+
 /**
  * hal_rx_flow_delete_entry() - Delete a flow from the Rx Flow Search Table
  * @fst: Pointer to the Rx Flow Search Table
@@ -101,6 +101,16 @@ hal_rx_flow_setup_cmem_fse(hal_soc_handle_t hal_soc_hdl, uint32_t cmem_ba,
 uint32_t hal_rx_flow_get_cmem_fse_timestamp(hal_soc_handle_t hal_soc_hdl,
 					    uint32_t fse_offset);
 
+/**
+ * hal_rx_flow_invalidate_cmem_fse() - Clear valid bit of a CMEM FSE
+ * @hal_soc_hdl: HAL SOC handle
+ * @fse_offset: CMEM FSE offset
+ *
+ * Return: None
+ */
+void hal_rx_flow_invalidate_cmem_fse(hal_soc_handle_t hal_soc_hdl,
+				     uint32_t fse_offset);
+
 /**
  * hal_rx_flow_delete_entry() - Delete a flow from the Rx Flow Search Table
  * @fst: Pointer to the Rx Flow Search Table
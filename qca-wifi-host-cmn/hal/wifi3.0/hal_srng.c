@@ -524,14 +524,16 @@ static inline
 char *hal_fill_reg_write_srng_stats(struct hal_srng *srng,
 				    char *buf, qdf_size_t size)
 {
-	qdf_scnprintf(buf, size, "enq %u deq %u coal %u direct %u",
+	qdf_scnprintf(buf, size,
+		      "enq %u deq %u coal %u direct %u max_write_delay %u us",
 		      srng->wstats.enqueues, srng->wstats.dequeues,
-		      srng->wstats.coalesces, srng->wstats.direct);
+		      srng->wstats.coalesces, srng->wstats.direct,
+		      srng->wstats.max_write_delay_us);
 	return buf;
 }
 
 /* bytes for local buffer */
-#define HAL_REG_WRITE_SRNG_STATS_LEN 100
+#define HAL_REG_WRITE_SRNG_STATS_LEN 128
 
 void hal_dump_reg_write_srng_stats(hal_soc_handle_t hal_soc_hdl)
 {
@@ -562,14 +564,27 @@ void hal_dump_reg_write_srng_stats(hal_soc_handle_t hal_soc_hdl)
 
 void hal_dump_reg_write_stats(hal_soc_handle_t hal_soc_hdl)
 {
-	uint32_t *hist;
+	uint32_t *hist, *write_hist;
+	uint32_t enqueues, coalesces, coal_pct = 0, batch = 0;
 	struct hal_soc *hal = (struct hal_soc *)hal_soc_hdl;
 
 	hist = hal->stats.wstats.sched_delay;
+	write_hist = hal->stats.wstats.write_delay;
+	enqueues = qdf_atomic_read(&hal->stats.wstats.enqueues);
+	coalesces = qdf_atomic_read(&hal->stats.wstats.coalesces);
+
+	/* share of HP/TP updates absorbed into an already pending write */
+	if (enqueues + coalesces)
+		coal_pct = (uint32_t)qdf_do_div((uint64_t)coalesces * 100,
+						enqueues + coalesces);
+	if (hal->stats.wstats.work_runs)
+		batch = hal->stats.wstats.dequeues /
+			hal->stats.wstats.work_runs;
+
 	hal_debug("wstats: enq %u deq %u coal %u direct %u q_depth %u max_q %u sched-delay hist %u %u %u %u",
-		  qdf_atomic_read(&hal->stats.wstats.enqueues),
+		  enqueues,
 		  hal->stats.wstats.dequeues,
-		  qdf_atomic_read(&hal->stats.wstats.coalesces),
+		  coalesces,
 		  qdf_atomic_read(&hal->stats.wstats.direct),
 		  qdf_atomic_read(&hal->stats.wstats.q_depth),
 		  hal->stats.wstats.max_q_depth,
@@ -577,6 +592,13 @@ void hal_dump_reg_write_stats(hal_soc_handle_t hal_soc_hdl)
 		  hist[REG_WRITE_SCHED_DELAY_SUB_1000us],
 		  hist[REG_WRITE_SCHED_DELAY_SUB_5000us],
 		  hist[REG_WRITE_SCHED_DELAY_GT_5000us]);
+	hal_debug("wstats: coal %u%% work_runs %u avg_batch %u max_write_delay %u us write-delay hist %u %u %u %u",
+		  coal_pct, hal->stats.wstats.work_runs, batch,
+		  hal->stats.wstats.max_write_delay_us,
+		  write_hist[REG_WRITE_SCHED_DELAY_SUB_100us],
+		  write_hist[REG_WRITE_SCHED_DELAY_SUB_1000us],
+		  write_hist[REG_WRITE_SCHED_DELAY_SUB_5000us],
+		  write_hist[REG_WRITE_SCHED_DELAY_GT_5000us]);
 }
 
 int hal_get_reg_write_pending_work(void *hal_soc)
@@ -599,11 +621,50 @@ int hal_get_reg_write_pending_work(void *hal_soc)
 #define HAL_REG_WRITE_QUEUE_LEN 32
 #endif
 
+/**
+ * hal_reg_write_fill_delay_hist() - fill reg write delay histogram
+ * @hist: histogram to be updated
+ * @delay_us: delay in us
+ *
+ * Return: None
+ */
+static inline void hal_reg_write_fill_delay_hist(uint32_t *hist,
+						 uint64_t delay_us)
+{
+	if (delay_us < 100)
+		hist[REG_WRITE_SCHED_DELAY_SUB_100us]++;
+	else if (delay_us < 1000)
+		hist[REG_WRITE_SCHED_DELAY_SUB_1000us]++;
+	else if (delay_us < 5000)
+		hist[REG_WRITE_SCHED_DELAY_SUB_5000us]++;
+	else
+		hist[REG_WRITE_SCHED_DELAY_GT_5000us]++;
+}
+
+/**
+ * hal_reg_write_srng_addr() - HP/TP register address of the srng
+ * @srng: hal_srng pointer
+ *
+ * Return: iomem address of HP for source rings, TP for dest rings
+ */
+static inline void __iomem *hal_reg_write_srng_addr(struct hal_srng *srng)
+{
+	if (srng->ring_dir == HAL_SRNG_SRC_RING)
+		return srng->u.src_ring.hp_addr;
+
+	return srng->u.dst_ring.tp_addr;
+}
+
 /**
  * hal_process_reg_write_q_elem() - process a regiter write queue element
  * @hal: hal_soc pointer
  * @q_elem: pointer to hal regiter write queue element
  *
+ * All HP/TP updates done while the srng is pending are coalesced into one
+ * register write of the last value committed by the ring access end. The
+ * SRNG lock is held across the write, so that the pending bit is released
+ * only once the register holds that value.
+ *
  * Return: The value which was written to the address
  */
 static uint32_t
@@ -615,22 +676,13 @@ hal_process_reg_write_q_elem(struct hal_soc *hal,
 
 	SRNG_LOCK(&srng->lock);
 
-	srng->reg_write_in_progress = false;
 	srng->wstats.dequeues++;
-
-	if (srng->ring_dir == HAL_SRNG_SRC_RING) {
-		q_elem->dequeue_val = srng->u.src_ring.hp;
-		hal_write_address_32_mb(hal,
-					srng->u.src_ring.hp_addr,
-					srng->u.src_ring.hp, false);
-		write_val = srng->u.src_ring.hp;
-	} else {
-		q_elem->dequeue_val = srng->u.dst_ring.tp;
-		hal_write_address_32_mb(hal,
-					srng->u.dst_ring.tp_addr,
-					srng->u.dst_ring.tp, false);
-		write_val = srng->u.dst_ring.tp;
-	}
+	q_elem->dequeue_val = srng->reg_write_val;
+	write_val = srng->reg_write_val;
+	hal_write_address_32_mb(hal, hal_reg_write_srng_addr(srng),
+				write_val, false);
+	qdf_atomic_clear_bit(HAL_SRNG_REG_WRITE_PENDING,
+			     &srng->reg_write_state);
 
 	q_elem->valid = 0;
 	srng->last_dequeue_time = q_elem->dequeue_time;
@@ -639,30 +691,6 @@ hal_process_reg_write_q_elem(struct hal_soc *hal,
 	return write_val;
 }
 
-/**
- * hal_reg_write_fill_sched_delay_hist() - fill reg write delay histogram in hal
- * @hal: hal_soc pointer
- * @delay: delay in us
- *
- * Return: None
- */
-static inline void hal_reg_write_fill_sched_delay_hist(struct hal_soc *hal,
-						       uint64_t delay_us)
-{
-	uint32_t *hist;
-
-	hist = hal->stats.wstats.sched_delay;
-
-	if (delay_us < 100)
-		hist[REG_WRITE_SCHED_DELAY_SUB_100us]++;
-	else if (delay_us < 1000)
-		hist[REG_WRITE_SCHED_DELAY_SUB_1000us]++;
-	else if (delay_us < 5000)
-		hist[REG_WRITE_SCHED_DELAY_SUB_5000us]++;
-	else
-		hist[REG_WRITE_SCHED_DELAY_GT_5000us]++;
-}
-
 #ifdef SHADOW_WRITE_DELAY
 
 #define SHADOW_WRITE_MIN_DELTA_US	5
@@ -721,6 +749,33 @@ static inline bool hal_reg_write_need_delay(struct hal_reg_write_q_elem *elem)
 }
 #endif
 
+/**
+ * hal_reg_write_update_write_delay() - account end to end write latency
+ * @hal: hal_soc pointer
+ * @q_elem: register write queue element which has just been written
+ *
+ * Latency is measured from the enqueue of the first (uncoalesced) update
+ * of the srng till the completion of the register write.
+ *
+ * Return: None
+ */
+static inline void
+hal_reg_write_update_write_delay(struct hal_soc *hal,
+				 struct hal_reg_write_q_elem *q_elem)
+{
+	struct hal_srng *srng = q_elem->srng;
+	uint64_t delay_us;
+
+	delay_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() -
+					      q_elem->enqueue_time);
+	hal_reg_write_fill_delay_hist(hal->stats.wstats.write_delay, delay_us);
+
+	if (delay_us > hal->stats.wstats.max_write_delay_us)
+		hal->stats.wstats.max_write_delay_us = delay_us;
+	if (delay_us > srng->wstats.max_write_delay_us)
+		srng->wstats.max_write_delay_us = delay_us;
+}
+
 /**
  * hal_reg_write_work() - Worker to process delayed writes
  * @arg: hal_soc pointer
@@ -765,7 +820,8 @@ static void hal_reg_write_work(void *arg)
 		addr = q_elem->addr;
 		delta_us = qdf_log_timestamp_to_usecs(q_elem->dequeue_time -
 						      q_elem->enqueue_time);
-		hal_reg_write_fill_sched_delay_hist(hal, delta_us);
+		hal_reg_write_fill_delay_hist(hal->stats.wstats.sched_delay,
+					      delta_us);
 
 		hal->stats.wstats.dequeues++;
 		qdf_atomic_dec(&hal->stats.wstats.q_depth);
@@ -775,6 +831,7 @@ static void hal_reg_write_work(void *arg)
 					  q_elem->srng->ring_id, q_elem->addr);
 
 		write_val = hal_process_reg_write_q_elem(hal, q_elem);
+		hal_reg_write_update_write_delay(hal, q_elem);
 		hal_verbose_debug("read_idx %u srng 0x%x, addr 0x%pK dequeue_val %u sched delay %llu us",
 				  hal->read_idx, ring_id, addr, write_val, delta_us);
 
@@ -790,6 +847,8 @@ static void hal_reg_write_work(void *arg)
 	}
 
 	hif_allow_link_low_power_states(hal->hif_handle);
+	if (num_processed)
+		hal->stats.wstats.work_runs++;
 	/*
 	 * Decrement active_work_cnt by the number of elements dequeued after
 	 * hif_allow_link_low_power_states.
@@ -832,7 +891,10 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 	struct hal_reg_write_q_elem *q_elem;
 	uint32_t write_idx;
 
-	if (srng->reg_write_in_progress) {
+	/* picked up by the pending write, if any, under the SRNG lock */
+	srng->reg_write_val = value;
+	if (qdf_atomic_test_and_set_bit(HAL_SRNG_REG_WRITE_PENDING,
+					&srng->reg_write_state)) {
 		hal_verbose_debug("Already in progress srng ring id 0x%x addr 0x%pK val %u",
 				  srng->ring_id, addr, value);
 		qdf_atomic_inc(&hal_soc->stats.wstats.coalesces);
@@ -848,6 +910,8 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 
 	if (q_elem->valid) {
 		hal_err("queue full");
+		qdf_atomic_clear_bit(HAL_SRNG_REG_WRITE_PENDING,
+				     &srng->reg_write_state);
 		QDF_BUG(0);
 		return;
 	}
@@ -882,7 +946,6 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 	 */
 	qdf_wmb();
 
-	srng->reg_write_in_progress  = true;
 	qdf_atomic_inc(&hal_soc->active_work_cnt);
 
 	hal_verbose_debug("write_idx %u srng ring id 0x%x addr 0x%pK val %u",
@@ -892,6 +955,41 @@ static void hal_reg_write_enqueue(struct hal_soc *hal_soc,
 		       &hal_soc->reg_write_work);
 }
 
+/**
+ * hal_reg_write_direct() - write HP/TP register right away
+ * @hal_soc: hal_soc pointer
+ * @srng: srng pointer
+ * @addr: iomem address of regiter
+ * @value: value to be written to iomem address
+ *
+ * Used when the bus is awake. If a delayed write is still pending for the
+ * srng, the update is coalesced into it instead and written by the worker.
+ *
+ * This function executes from within the SRNG LOCK
+ *
+ * Return: None
+ */
+static void hal_reg_write_direct(struct hal_soc *hal_soc,
+				 struct hal_srng *srng,
+				 void __iomem *addr,
+				 uint32_t value)
+{
+	srng->reg_write_val = value;
+	if (qdf_atomic_test_and_set_bit(HAL_SRNG_REG_WRITE_PENDING,
+					&srng->reg_write_state)) {
+		qdf_atomic_inc(&hal_soc->stats.wstats.coalesces);
+		srng->wstats.coalesces++;
+		return;
+	}
+
+	hal_write_address_32_mb(hal_soc, addr, value, false);
+	qdf_atomic_inc(&hal_soc->stats.wstats.direct);
+	srng->wstats.direct++;
+
+	qdf_atomic_clear_bit(HAL_SRNG_REG_WRITE_PENDING,
+			     &srng->reg_write_state);
+}
+
 /**
  * hal_delayed_reg_write_init() - Initialization function for delayed reg writes
  * @hal_soc: hal_soc pointer
@@ -968,9 +1066,7 @@ void hal_delayed_reg_write(struct hal_soc *hal_soc,
 		    (vote_access == HIF_EP_VOTE_INTERMEDIATE_ACCESS &&
 		     PLD_MHI_STATE_L0 ==
 		     pld_get_mhi_state(hal_soc->qdf_dev->dev))) {
-			hal_write_address_32_mb(hal_soc, addr, value, false);
-			qdf_atomic_inc(&hal_soc->stats.wstats.direct);
-			srng->wstats.direct++;
+			hal_reg_write_direct(hal_soc, srng, addr, value);
 		} else {
 			hal_reg_write_enqueue(hal_soc, srng, addr, value);
 		}
@@ -982,9 +1078,7 @@ void hal_delayed_reg_write(struct hal_soc *hal_soc,
 		    hal_is_reg_write_tput_level_high(hal_soc) ||
 		    PLD_MHI_STATE_L0 ==
 		    pld_get_mhi_state(hal_soc->qdf_dev->dev)) {
-			hal_write_address_32_mb(hal_soc, addr, value, false);
-			qdf_atomic_inc(&hal_soc->stats.wstats.direct);
-			srng->wstats.direct++;
+			hal_reg_write_direct(hal_soc, srng, addr, value);
 		} else {
 			hal_reg_write_enqueue(hal_soc, srng, addr, value);
 		}
@@ -1000,9 +1094,7 @@ void hal_delayed_reg_write(struct hal_soc *hal_soc,
 {
 	if (hal_is_reg_write_tput_level_high(hal_soc) ||
 	    pld_is_device_awake(hal_soc->qdf_dev->dev)) {
-		qdf_atomic_inc(&hal_soc->stats.wstats.direct);
-		srng->wstats.direct++;
-		hal_write_address_32_mb(hal_soc, addr, value, false);
+		hal_reg_write_direct(hal_soc, srng, addr, value);
 	} else {
 		hal_reg_write_enqueue(hal_soc, srng, addr, value);
 	}
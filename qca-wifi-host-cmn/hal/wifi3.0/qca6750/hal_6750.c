@@ -1748,6 +1748,20 @@ static uint32_t hal_rx_flow_get_cmem_fse_ts_6750(struct hal_soc *hal_soc,
 			     HAL_OFFSET(RX_FLOW_SEARCH_ENTRY_13, TIMESTAMP));
 }
 
+/**
+ * hal_rx_flow_invalidate_cmem_fse_6750() - Clear valid bit of a CMEM FSE
+ * @hal_soc: hal_soc reference
+ * @fse_offset: CMEM FSE offset
+ *
+ * Return: None
+ */
+static void hal_rx_flow_invalidate_cmem_fse_6750(struct hal_soc *hal_soc,
+						 uint32_t fse_offset)
+{
+	HAL_CMEM_WRITE(hal_soc, fse_offset + HAL_OFFSET(RX_FLOW_SEARCH_ENTRY_9,
+							VALID), 0);
+}
+
 /**
  * hal_rx_flow_get_cmem_fse_6750() - Get FSE from CMEM
  * @hal_soc: hal_soc reference
@@ -1851,6 +1865,8 @@ static void hal_hw_txrx_ops_attach_qca6750(struct hal_soc *hal_soc)
 {
 	/* init and setup */
 	hal_soc->ops->hal_srng_dst_hw_init = hal_srng_dst_hw_init_generic;
+	hal_soc->ops->hal_srng_dst_set_intr_thres =
+				hal_srng_dst_set_intr_thres_generic;
 	hal_soc->ops->hal_srng_src_hw_init = hal_srng_src_hw_init_generic;
 	hal_soc->ops->hal_get_hw_hptp = hal_get_hw_hptp_generic;
 	hal_soc->ops->hal_reo_setup = hal_reo_setup_generic_li;
@@ -2033,6 +2049,8 @@ static void hal_hw_txrx_ops_attach_qca6750(struct hal_soc *hal_soc)
 					hal_rx_flow_setup_cmem_fse_6750;
 	hal_soc->ops->hal_rx_flow_get_cmem_fse_ts =
 					hal_rx_flow_get_cmem_fse_ts_6750;
+	hal_soc->ops->hal_rx_flow_invalidate_cmem_fse =
+					hal_rx_flow_invalidate_cmem_fse_6750;
 	hal_soc->ops->hal_rx_flow_get_cmem_fse = hal_rx_flow_get_cmem_fse_6750;
 	hal_soc->ops->hal_rx_msdu_get_reo_destination_indication =
 		hal_rx_msdu_get_reo_destination_indication_6750;
@@ -243,6 +243,353 @@ os_if_spectral_destroy_netlink(struct wlan_objmgr_pdev *pdev)
 }
 #endif
 
+#ifdef WLAN_SPECTRAL_STREAMFS
+#define SPECTRAL_RING_RECS_PER_SUBBUF (16)
+#define SPECTRAL_RING_NUM_SUBBUFS     (64)
+
+/**
+ * os_if_spectral_ring_consumed_write() - Write handler of the ring consumed
+ * control file
+ * @priv: Pointer to pdev spectral object
+ * @buf: Number of sub-buffers consumed by the reader, as a string
+ * @len: Length of @buf
+ *
+ * Relay only counts the data returned by read() as consumed. A reader which
+ * maps the ring reports the sub-buffers it is done with here, so that they
+ * can be reused.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error status otherwise
+ */
+static QDF_STATUS
+os_if_spectral_ring_consumed_write(void *priv, const char *buf,
+				   qdf_size_t len)
+{
+	struct pdev_spectral *ps = priv;
+	uint32_t consumed;
+	QDF_STATUS status;
+
+	status = qdf_uint32_parse(buf, &consumed);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		osif_err("Invalid consumed sub-buffer count");
+		return status;
+	}
+
+	if (consumed > SPECTRAL_RING_NUM_SUBBUFS) {
+		osif_err("Consumed sub-buffer count %u exceeds ring size %u",
+			 consumed, SPECTRAL_RING_NUM_SUBBUFS);
+		return QDF_STATUS_E_RANGE;
+	}
+
+	/* The channel has a single global buffer, held by CPU 0 */
+	qdf_streamfs_subbufs_consumed(ps->ring.chan, 0, consumed);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * os_if_spectral_ring_enable_show() - Show handler of the ring enable
+ * control file
+ * @file: debugfs file handle
+ * @arg: Pointer to pdev spectral object
+ *
+ * Return: QDF_STATUS_SUCCESS
+ */
+static QDF_STATUS
+os_if_spectral_ring_enable_show(qdf_debugfs_file_t file, void *arg)
+{
+	struct pdev_spectral *ps = arg;
+
+	qdf_debugfs_printf(file, "%d\n", qdf_atomic_read(&ps->ring.enabled));
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * os_if_spectral_ring_enable_write() - Write handler of the ring enable
+ * control file
+ * @priv: Pointer to pdev spectral object
+ * @buf: 1 to send the SAMP messages through the ring, 0 to send them over
+ * netlink, as a string
+ * @len: Length of @buf
+ *
+ * A message already being built in the ring when the ring is disabled is
+ * still completed there, only new messages go to netlink.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error status otherwise
+ */
+static QDF_STATUS
+os_if_spectral_ring_enable_write(void *priv, const char *buf,
+				 qdf_size_t len)
+{
+	struct pdev_spectral *ps = priv;
+	uint32_t enable;
+	QDF_STATUS status;
+
+	status = qdf_uint32_parse(buf, &enable);
+	if (QDF_IS_STATUS_ERROR(status) || enable > 1) {
+		osif_err("Invalid ring enable value, expected 0 or 1");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_atomic_set(&ps->ring.enabled, enable);
+	osif_info("Spectral samples sent over %s",
+		  enable ? "streamfs ring" : "netlink");
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * os_if_spectral_ring_create() - Create the streamfs ring used to share
+ * Spectral samples with the applications
+ * @pdev: Pointer to pdev
+ *
+ * The ring is exposed as spectral<pdev_id>/samples0 under the streamfs root
+ * and can be mapped by the applications. Sub-buffers hold a whole number of
+ * fixed size records so that no record straddles two sub-buffers.
+ *
+ * The ring is not overwritten. Data returned by read() is consumed, a
+ * reader which maps the ring writes the number of sub-buffers it is done
+ * with to spectral<pdev_id>/consumed instead.
+ *
+ * Samples are sent over netlink until an application writes 1 to
+ * spectral<pdev_id>/enable, so that existing netlink readers keep working
+ * when the ring is built in.
+ *
+ * Return: void
+ */
+static void
+os_if_spectral_ring_create(struct wlan_objmgr_pdev *pdev)
+{
+	struct pdev_spectral *ps;
+	char dir_name[32];
+
+	ps = wlan_objmgr_pdev_get_comp_private_obj(pdev,
+						   WLAN_UMAC_COMP_SPECTRAL);
+	if (!ps) {
+		osif_err("PDEV SPECTRAL object is NULL!");
+		return;
+	}
+
+	qdf_mem_zero(&ps->ring, sizeof(ps->ring));
+
+	snprintf(dir_name, sizeof(dir_name), "spectral%u",
+		 wlan_objmgr_pdev_get_pdev_id(pdev));
+	ps->ring.dir = qdf_streamfs_create_dir(dir_name, NULL);
+	if (!ps->ring.dir) {
+		osif_err("Spectral ring directory create failed");
+		return;
+	}
+
+	ps->ring.chan = qdf_streamfs_open("samples", ps->ring.dir,
+					  SPECTRAL_RING_REC_SIZE *
+					  SPECTRAL_RING_RECS_PER_SUBBUF,
+					  SPECTRAL_RING_NUM_SUBBUFS, NULL);
+	if (!ps->ring.chan) {
+		osif_err("Spectral ring channel create failed");
+		qdf_streamfs_remove_dir_recursive(ps->ring.dir);
+		ps->ring.dir = NULL;
+		return;
+	}
+
+	ps->ring.consumed_fops.write = os_if_spectral_ring_consumed_write;
+	ps->ring.consumed_fops.priv = ps;
+	ps->ring.consumed_file = qdf_debugfs_create_file(
+					"consumed", QDF_FILE_USR_WRITE,
+					ps->ring.dir,
+					&ps->ring.consumed_fops);
+	if (!ps->ring.consumed_file)
+		osif_err("Spectral ring consumed file create failed, mmap readers cannot release sub-buffers");
+
+	ps->ring.enable_fops.show = os_if_spectral_ring_enable_show;
+	ps->ring.enable_fops.write = os_if_spectral_ring_enable_write;
+	ps->ring.enable_fops.priv = ps;
+	ps->ring.enable_file = qdf_debugfs_create_file(
+					"enable",
+					QDF_FILE_USR_READ | QDF_FILE_USR_WRITE,
+					ps->ring.dir,
+					&ps->ring.enable_fops);
+	if (!ps->ring.enable_file)
+		osif_err("Spectral ring enable file create failed, samples are sent over netlink only");
+}
+
+/**
+ * os_if_spectral_ring_destroy() - Destroy the Spectral streamfs ring
+ * @pdev: Pointer to pdev
+ *
+ * Return: void
+ */
+static void
+os_if_spectral_ring_destroy(struct wlan_objmgr_pdev *pdev)
+{
+	struct pdev_spectral *ps;
+
+	ps = wlan_objmgr_pdev_get_comp_private_obj(pdev,
+						   WLAN_UMAC_COMP_SPECTRAL);
+	if (!ps)
+		return;
+
+	if (ps->ring.enable_file) {
+		qdf_debugfs_remove_file(ps->ring.enable_file);
+		ps->ring.enable_file = NULL;
+	}
+	qdf_atomic_set(&ps->ring.enabled, 0);
+
+	/* Remove the control file before the channel it releases is closed */
+	if (ps->ring.consumed_file) {
+		qdf_debugfs_remove_file(ps->ring.consumed_file);
+		ps->ring.consumed_file = NULL;
+	}
+
+	if (ps->ring.chan) {
+		qdf_streamfs_close(ps->ring.chan);
+		ps->ring.chan = NULL;
+	}
+
+	if (ps->ring.dir) {
+		qdf_streamfs_remove_dir_recursive(ps->ring.dir);
+		ps->ring.dir = NULL;
+	}
+}
+
+/**
+ * os_if_spectral_ring_get_buf() - Get the buffer for a SAMP message from the
+ * Spectral streamfs ring
+ * @ps: Pointer to pdev spectral object
+ * @smsg_type: Spectral message type
+ * @buf_type: Spectral message buffer type
+ *
+ * Reserves a record in the ring for a new message, the caller then builds
+ * the SAMP message directly in the record. New messages are only put in the
+ * ring once it has been enabled through its control file. Interference
+ * notifications are always sent over netlink.
+ *
+ * Return: Pointer to the SAMP message in the ring, NULL if the message has
+ * to be built in a netlink buffer
+ */
+static void *
+os_if_spectral_ring_get_buf(struct pdev_spectral *ps,
+			    enum spectral_msg_type smsg_type,
+			    enum spectral_msg_buf_type buf_type)
+{
+	struct spectral_streamfs_ring *ring = &ps->ring;
+	struct spectral_ring_rec_hdr *rec;
+
+	if (!ring->chan ||
+	    smsg_type == SPECTRAL_MSG_INTERFERENCE_NOTIFICATION)
+		return NULL;
+
+	if (buf_type == SPECTRAL_MSG_BUF_SAVED) {
+		rec = ring->rec[smsg_type];
+		return rec ? rec + 1 : NULL;
+	}
+
+	if (buf_type != SPECTRAL_MSG_BUF_NEW ||
+	    !qdf_atomic_read(&ring->enabled))
+		return NULL;
+
+	QDF_ASSERT(!ring->rec[smsg_type]);
+	rec = qdf_streamfs_reserve(ring->chan, SPECTRAL_RING_REC_SIZE);
+	if (!rec) {
+		/* Ring is full, fall back to netlink */
+		ring->num_overruns++;
+		return NULL;
+	}
+
+	rec->magic = SPECTRAL_RING_REC_MAGIC;
+	rec->flags = 0;
+	rec->seq = 0;
+	rec->num_overruns = ring->num_overruns;
+	rec->msg_type = smsg_type;
+	rec->msg_len = MAX_SPECTRAL_PAYLOAD;
+	qdf_mem_zero(rec + 1, sizeof(struct spectral_samp_msg));
+
+	ring->rec[smsg_type] = rec;
+
+	return rec + 1;
+}
+
+/**
+ * os_if_spectral_ring_commit() - Publish the ring record holding the SAMP
+ * message of a message type
+ * @ps: Pointer to pdev spectral object
+ * @smsg_type: Spectral message type
+ *
+ * Return: true if the message was built in the ring, false otherwise
+ */
+static bool
+os_if_spectral_ring_commit(struct pdev_spectral *ps,
+			   enum spectral_msg_type smsg_type)
+{
+	struct spectral_ring_rec_hdr *rec = ps->ring.rec[smsg_type];
+
+	if (!rec)
+		return false;
+
+	rec->seq = ++ps->ring.seq;
+	/* Message contents have to be visible before the record is valid */
+	qdf_wmb();
+	rec->flags = SPECTRAL_RING_REC_FLAG_VALID;
+	ps->ring.rec[smsg_type] = NULL;
+
+	return true;
+}
+
+/**
+ * os_if_spectral_ring_drop() - Abandon the ring record holding the SAMP
+ * message of a message type
+ * @ps: Pointer to pdev spectral object
+ * @smsg_type: Spectral message type
+ *
+ * Return: true if the message was built in the ring, false otherwise
+ */
+static bool
+os_if_spectral_ring_drop(struct pdev_spectral *ps,
+			 enum spectral_msg_type smsg_type)
+{
+	struct spectral_ring_rec_hdr *rec = ps->ring.rec[smsg_type];
+
+	if (!rec)
+		return false;
+
+	rec->flags = SPECTRAL_RING_REC_FLAG_DROPPED;
+	ps->ring.rec[smsg_type] = NULL;
+
+	return true;
+}
+#else
+static inline void
+os_if_spectral_ring_create(struct wlan_objmgr_pdev *pdev)
+{
+}
+
+static inline void
+os_if_spectral_ring_destroy(struct wlan_objmgr_pdev *pdev)
+{
+}
+
+static inline void *
+os_if_spectral_ring_get_buf(struct pdev_spectral *ps,
+			    enum spectral_msg_type smsg_type,
+			    enum spectral_msg_buf_type buf_type)
+{
+	return NULL;
+}
+
+static inline bool
+os_if_spectral_ring_commit(struct pdev_spectral *ps,
+			   enum spectral_msg_type smsg_type)
+{
+	return false;
+}
+
+static inline bool
+os_if_spectral_ring_drop(struct pdev_spectral *ps,
+			 enum spectral_msg_type smsg_type)
+{
+	return false;
+}
+#endif /* WLAN_SPECTRAL_STREAMFS */
+
 void *
 os_if_spectral_prep_skb(struct wlan_objmgr_pdev *pdev,
 			enum spectral_msg_type smsg_type,
@@ -276,6 +623,10 @@ os_if_spectral_prep_skb(struct wlan_objmgr_pdev *pdev,
 		return NULL;
 	}
 
+	buf = os_if_spectral_ring_get_buf(ps, smsg_type, buf_type);
+	if (buf)
+		return buf;
+
 	if (buf_type == SPECTRAL_MSG_BUF_NEW) {
 		QDF_ASSERT(!ps->skb[smsg_type]);
 		ps->skb[smsg_type] =
@@ -385,6 +736,9 @@ os_if_spectral_nl_unicast_msg(struct wlan_objmgr_pdev *pdev,
 		return -EINVAL;
 	}
 
+	if (os_if_spectral_ring_commit(ps, smsg_type))
+		return 0;
+
 	if (!ps->skb[smsg_type]) {
 		osif_err("Socket buffer is null, msg_type= %u", smsg_type);
 		return -EINVAL;
@@ -442,6 +796,9 @@ os_if_spectral_nl_unicast_msg(struct wlan_objmgr_pdev *pdev,
 		return -EINVAL;
 	}
 
+	if (os_if_spectral_ring_commit(ps, smsg_type))
+		return 0;
+
 	if (!ps->skb[smsg_type]) {
 		osif_err("Socket buffer is null, msg_type= %u", smsg_type);
 		return -EINVAL;
@@ -504,6 +861,9 @@ os_if_spectral_nl_bcast_msg(struct wlan_objmgr_pdev *pdev,
 		return -EINVAL;
 	}
 
+	if (os_if_spectral_ring_commit(ps, smsg_type))
+		return 0;
+
 	if (!ps->skb[smsg_type]) {
 		osif_err("Socket buffer is null, msg_type= %u", smsg_type);
 		return -EINVAL;
@@ -559,6 +919,9 @@ os_if_spectral_free_skb(struct wlan_objmgr_pdev *pdev,
 		return;
 	}
 
+	if (os_if_spectral_ring_drop(ps, smsg_type))
+		return;
+
 	if (!ps->skb[smsg_type]) {
 		osif_info("Socket buffer is null, msg_type= %u", smsg_type);
 		return;
@@ -595,6 +958,7 @@ os_if_spectral_netlink_init(struct wlan_objmgr_pdev *pdev)
 	}
 
 	os_if_spectral_init_nl(pdev);
+	os_if_spectral_ring_create(pdev);
 
 	/* Register Netlink handlers */
 	nl_cb.get_sbuff = os_if_spectral_prep_skb;
@@ -634,6 +998,8 @@ void os_if_spectral_netlink_deinit(struct wlan_objmgr_pdev *pdev)
 	for (; msg_type < SPECTRAL_MSG_TYPE_MAX; msg_type++)
 		os_if_spectral_free_skb(pdev, msg_type);
 
+	os_if_spectral_ring_destroy(pdev);
+
 	if (sptrl_ctx->sptrlc_deregister_netlink_cb)
 		sptrl_ctx->sptrlc_deregister_netlink_cb(pdev);
 
@@ -2910,6 +2910,102 @@ qdf_nbuf_data_get_ipv6_proto(uint8_t *data)
 	return __qdf_nbuf_data_get_ipv6_proto(data);
 }
 
+/**
+ * qdf_nbuf_tx_classify() - classify a TX frame in a single header walk
+ * @buf: network buffer
+ *
+ * Resets the control block and records the bcast/mcast flags, the special
+ * packet type (QDF_NBUF_CB_GET_PACKET_TYPE) and, where the platform control
+ * block has room for it, the L3/L4 protocol and TOS of the frame.
+ *
+ * Return: none
+ */
+static inline void qdf_nbuf_tx_classify(qdf_nbuf_t buf)
+{
+	__qdf_nbuf_tx_classify(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_valid() - check if the TX classification record is valid
+ * @buf: network buffer
+ *
+ * Return: true if qdf_nbuf_tx_classify() recorded L3/L4 info for @buf
+ */
+static inline bool qdf_nbuf_tx_cls_valid(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_cls_valid(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_reset() - invalidate the TX classification record
+ * @buf: network buffer
+ *
+ * Must be called on buffers handed to the TX path with a control block
+ * that was not written by qdf_nbuf_tx_classify(), e.g. forwarded RX frames.
+ *
+ * Return: none
+ */
+static inline void qdf_nbuf_tx_cls_reset(qdf_nbuf_t buf)
+{
+	__qdf_nbuf_tx_cls_reset(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_is_ipv4() - untagged IPv4 frame as per classification
+ * @buf: network buffer
+ *
+ * Return: true if @buf is IPv4, valid only if qdf_nbuf_tx_cls_valid()
+ */
+static inline bool qdf_nbuf_tx_cls_is_ipv4(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_cls_is_ipv4(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_is_ipv6() - untagged IPv6 frame as per classification
+ * @buf: network buffer
+ *
+ * Return: true if @buf is IPv6, valid only if qdf_nbuf_tx_cls_valid()
+ */
+static inline bool qdf_nbuf_tx_cls_is_ipv6(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_cls_is_ipv6(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_is_tcp() - TCP frame as per classification
+ * @buf: network buffer
+ *
+ * Return: true if @buf is IPv4/IPv6 TCP, valid only if qdf_nbuf_tx_cls_valid()
+ */
+static inline bool qdf_nbuf_tx_cls_is_tcp(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_cls_is_tcp(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_is_udp() - UDP frame as per classification
+ * @buf: network buffer
+ *
+ * Return: true if @buf is IPv4/IPv6 UDP, valid only if qdf_nbuf_tx_cls_valid()
+ */
+static inline bool qdf_nbuf_tx_cls_is_udp(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_cls_is_udp(buf);
+}
+
+/**
+ * qdf_nbuf_tx_cls_get_tos() - TOS/traffic class as per classification
+ * @buf: network buffer
+ *
+ * Return: IPv4 TOS or IPv6 traffic class byte of @buf, valid only if
+ *	   qdf_nbuf_tx_cls_valid()
+ */
+static inline uint8_t qdf_nbuf_tx_cls_get_tos(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_cls_get_tos(buf);
+}
+
 /**
  * qdf_nbuf_is_ipv4_pkt() - check if packet is a ipv4 packet or not
  * @buf:  buffer
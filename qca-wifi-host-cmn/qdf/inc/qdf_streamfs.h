@@ -148,6 +148,19 @@ void qdf_streamfs_subbufs_consumed(qdf_streamfs_chan_t chan,
  */
 void qdf_streamfs_write(qdf_streamfs_chan_t chan, const void *data,
 			size_t length);
+
+/**
+ * qdf_streamfs_reserve() - Reserve space in the channel
+ * @chan: relay channel
+ * @length: number of bytes to reserve
+ *
+ * Reserves a slot in the current cpu's channel buffer so that the caller can
+ * fill the data in place instead of copying it with qdf_streamfs_write().
+ * Callers have to serialize the reservations on a channel.
+ *
+ * Return: Pointer to the reserved slot, NULL if the channel is full
+ */
+void *qdf_streamfs_reserve(qdf_streamfs_chan_t chan, size_t length);
 #else
 static inline qdf_dentry_t qdf_streamfs_create_dir(
 			const char *name, qdf_dentry_t parent)
@@ -203,5 +216,11 @@ qdf_streamfs_write(qdf_streamfs_chan_t chan, const void *data,
 		   size_t length)
 {
 }
+
+static inline void *
+qdf_streamfs_reserve(qdf_streamfs_chan_t chan, size_t length)
+{
+	return NULL;
+}
 #endif /* WLAN_STREAMFS */
 #endif /* _QDF_STREAMFS_H */
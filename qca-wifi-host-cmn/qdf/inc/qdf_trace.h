@@ -482,6 +482,8 @@ struct qdf_dp_trace_record_s {
  * @proto_event_bitmap: defines which protocol to be diag logged.
  *  refer QDF_NBUF_PKT_TRAC_TYPE_DNS to QDF_NBUF_PKT_TRAC_TYPE_ARP
  *  for bitmap.
+ * @proto_sample_rate: record only every nth protocol packet record of a
+ *  protocol type, 0 and 1 record all of them
  */
 struct s_qdf_dp_trace_data {
 	uint32_t head;
@@ -528,6 +530,7 @@ struct s_qdf_dp_trace_data {
 	u16 icmpv6_rs;
 	u16 icmpv6_ra;
 	uint32_t proto_event_bitmap;
+	uint16_t proto_sample_rate[QDF_PROTO_TYPE_MAX];
 };
 
 /**
@@ -1001,6 +1004,15 @@ void qdf_dp_trace_record_event(enum QDF_DP_TRACE_ID code, uint8_t vdev_id,
  */
 void qdf_dp_set_proto_event_bitmap(uint32_t value);
 
+/**
+ * qdf_dp_set_proto_sample_rate() - Set the DP trace sampling of a protocol
+ * @type: protocol type
+ * @rate: record one in @rate packet records of @type, 0 or 1 for all
+ *
+ * Return: none
+ */
+void qdf_dp_set_proto_sample_rate(enum qdf_proto_type type, uint16_t rate);
+
 /**
  * qdf_dp_log_proto_pkt_info() - Send diag log event
  * @sa: source MAC address
@@ -1128,6 +1140,11 @@ void qdf_dp_track_noack_check(qdf_nbuf_t nbuf, enum qdf_proto_subtype *subtype)
 {
 }
 
+static inline
+void qdf_dp_set_proto_sample_rate(enum qdf_proto_type type, uint16_t rate)
+{
+}
+
 static inline
 enum qdf_dp_tx_rx_status qdf_dp_get_status_from_htt(uint8_t status)
 {
@@ -28,6 +28,7 @@
 #include <linux/skbuff.h>
 #include <linux/netdevice.h>
 #include <linux/etherdevice.h>
+#include <linux/in.h>
 #include <linux/dma-mapping.h>
 #include <linux/version.h>
 #include <asm/cacheflush.h>
@@ -194,7 +195,13 @@ typedef union {
  * @tx.dev.priv_cb_m.mgmt_desc_id: mgmt descriptor for tx completion cb
  * @tx.dev.priv_cb_m.dma_option.bi_map: flag to do bi-direction dma map
  * @tx.dev.priv_cb_m.dma_option.reserved: reserved bits for future use
- * @tx.dev.priv_cb_m.reserved: reserved
+ * @tx.dev.priv_cb_m.cls.valid: TX classification record below is valid
+ * @tx.dev.priv_cb_m.cls.is_ipv4: untagged IPv4 frame
+ * @tx.dev.priv_cb_m.cls.is_ipv6: untagged IPv6 frame
+ * @tx.dev.priv_cb_m.cls.is_tcp: L4 protocol is TCP
+ * @tx.dev.priv_cb_m.cls.is_udp: L4 protocol is UDP
+ * @tx.dev.priv_cb_m.cls.rsvd: reserved
+ * @tx.dev.priv_cb_m.cls.tos: IPv4 TOS or IPv6 traffic class byte
  *
  * @tx.ftype: mcast2ucast, TSO, SG, MESH
  * @tx.vdev_id: vdev (for protocol trace)
@@ -331,7 +338,15 @@ struct qdf_nbuf_cb {
 					} dma_option;
 					uint8_t flag_notify_comp:1,
 						rsvd:7;
-					uint8_t reserved[2];
+					struct {
+						uint8_t valid:1,
+							is_ipv4:1,
+							is_ipv6:1,
+							is_tcp:1,
+							is_udp:1,
+							rsvd:3;
+						uint8_t tos;
+					} cls;
 				} priv_cb_m;
 			} dev;
 			uint8_t ftype;
@@ -847,6 +862,7 @@ QDF_STATUS __qdf_nbuf_frag_map(
 	qdf_device_t osdev, __qdf_nbuf_t nbuf,
 	int offset, qdf_dma_dir_t dir, int cur_frag);
 void qdf_nbuf_classify_pkt(struct sk_buff *skb);
+void __qdf_nbuf_tx_classify(struct sk_buff *skb);
 
 bool __qdf_nbuf_is_ipv4_wapi_pkt(struct sk_buff *skb);
 bool __qdf_nbuf_is_ipv4_tdls_pkt(struct sk_buff *skb);
@@ -48,6 +48,18 @@
 #define QDF_NBUF_CB_TX_EXTRA_FRAG_FLAGS_NOTIFY_COMP(skb) \
 	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m. \
 	flag_notify_comp)
+#define QDF_NBUF_CB_TX_CLS_VALID(skb) \
+	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m.cls.valid)
+#define QDF_NBUF_CB_TX_CLS_IS_IPV4(skb) \
+	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m.cls.is_ipv4)
+#define QDF_NBUF_CB_TX_CLS_IS_IPV6(skb) \
+	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m.cls.is_ipv6)
+#define QDF_NBUF_CB_TX_CLS_IS_TCP(skb) \
+	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m.cls.is_tcp)
+#define QDF_NBUF_CB_TX_CLS_IS_UDP(skb) \
+	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m.cls.is_udp)
+#define QDF_NBUF_CB_TX_CLS_TOS(skb) \
+	(((struct qdf_nbuf_cb *)((skb)->cb))->u.tx.dev.priv_cb_m.cls.tos)
 
 #define QDF_NBUF_CB_RX_PEER_ID(skb) \
 	(((struct qdf_nbuf_cb *)((skb)->cb))->u.rx.dev.priv_cb_m.dp. \
@@ -103,6 +115,48 @@
 #define __qdf_nbuf_ipa_priv_set(skb, priv) \
 	(QDF_NBUF_CB_TX_IPA_PRIV(skb) = (priv))
 
+#define __qdf_nbuf_tx_cls_valid(skb) \
+	QDF_NBUF_CB_TX_CLS_VALID(skb)
+
+#define __qdf_nbuf_tx_cls_reset(skb) \
+	(QDF_NBUF_CB_TX_CLS_VALID(skb) = 0)
+
+#define __qdf_nbuf_tx_cls_is_ipv4(skb) \
+	QDF_NBUF_CB_TX_CLS_IS_IPV4(skb)
+
+#define __qdf_nbuf_tx_cls_is_ipv6(skb) \
+	QDF_NBUF_CB_TX_CLS_IS_IPV6(skb)
+
+#define __qdf_nbuf_tx_cls_is_tcp(skb) \
+	QDF_NBUF_CB_TX_CLS_IS_TCP(skb)
+
+#define __qdf_nbuf_tx_cls_is_udp(skb) \
+	QDF_NBUF_CB_TX_CLS_IS_UDP(skb)
+
+#define __qdf_nbuf_tx_cls_get_tos(skb) \
+	QDF_NBUF_CB_TX_CLS_TOS(skb)
+
+/**
+ * __qdf_nbuf_tx_cls_set() - record the TX classification result in skb cb
+ * @skb: skb pointer whose cb is updated
+ * @l3_proto: ethertype in network order, valid for untagged frames only
+ * @l4_proto: IP protocol / IPv6 next header
+ * @tos: IPv4 TOS or IPv6 traffic class byte
+ *
+ * Return: none
+ */
+static inline void
+__qdf_nbuf_tx_cls_set(struct sk_buff *skb, uint16_t l3_proto,
+		      uint8_t l4_proto, uint8_t tos)
+{
+	QDF_NBUF_CB_TX_CLS_IS_IPV4(skb) = l3_proto == htons(ETH_P_IP);
+	QDF_NBUF_CB_TX_CLS_IS_IPV6(skb) = l3_proto == htons(ETH_P_IPV6);
+	QDF_NBUF_CB_TX_CLS_IS_TCP(skb) = l4_proto == IPPROTO_TCP;
+	QDF_NBUF_CB_TX_CLS_IS_UDP(skb) = l4_proto == IPPROTO_UDP;
+	QDF_NBUF_CB_TX_CLS_TOS(skb) = tos;
+	QDF_NBUF_CB_TX_CLS_VALID(skb) = 1;
+}
+
 /**
  * qdf_nbuf_cb_update_vdev_id() - update vdev id in skb cb
  * @skb: skb pointer whose cb is updated with vdev id information
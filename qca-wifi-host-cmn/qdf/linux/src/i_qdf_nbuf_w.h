@@ -145,6 +145,25 @@ static inline uint8_t *__qdf_nbuf_pull_head(struct sk_buff *skb, size_t size)
 	return skb_pull(skb, size);
 }
 
+/*
+ * The TX classification record lives in priv_cb_m, which overlaps the
+ * fctx pointer of priv_cb_w, so it is never recorded here and readers
+ * fall back to parsing the frame.
+ */
+#define __qdf_nbuf_tx_cls_valid(skb) 0
+#define __qdf_nbuf_tx_cls_reset(skb)
+#define __qdf_nbuf_tx_cls_is_ipv4(skb) 0
+#define __qdf_nbuf_tx_cls_is_ipv6(skb) 0
+#define __qdf_nbuf_tx_cls_is_tcp(skb) 0
+#define __qdf_nbuf_tx_cls_is_udp(skb) 0
+#define __qdf_nbuf_tx_cls_get_tos(skb) 0
+
+static inline void
+__qdf_nbuf_tx_cls_set(struct sk_buff *skb, uint16_t l3_proto,
+		      uint8_t l4_proto, uint8_t tos)
+{
+}
+
 static inline void qdf_nbuf_init_replenish_timer(void) {}
 static inline void qdf_nbuf_deinit_replenish_timer(void) {}
 
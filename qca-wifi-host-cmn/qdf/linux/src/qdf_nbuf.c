@@ -5115,6 +5115,132 @@ void qdf_nbuf_classify_pkt(struct sk_buff *skb)
 }
 qdf_export_symbol(qdf_nbuf_classify_pkt);
 
+/**
+ * __qdf_nbuf_tx_classify_ip() - classify the L3/L4 part of a TX frame
+ * @ip: pointer to the IPv4/IPv6 header
+ * @ether_type: ethertype of the frame, in network order
+ * @l4_proto: filled with the IP protocol / IPv6 next header
+ * @tos: filled with the IPv4 TOS / IPv6 traffic class byte
+ *
+ * Return: QDF_NBUF_CB_PACKET_TYPE_* of the frame, 0 if not special
+ */
+static uint8_t __qdf_nbuf_tx_classify_ip(uint8_t *ip, uint16_t ether_type,
+					 uint8_t *l4_proto, uint8_t *tos)
+{
+	struct iphdr *iph;
+	struct ipv6hdr *ip6h;
+	uint16_t *ports;
+
+	if (ether_type == QDF_SWAP_U16(QDF_NBUF_TRAC_IPV6_ETH_TYPE)) {
+		ip6h = (struct ipv6hdr *)ip;
+		*l4_proto = ip6h->nexthdr;
+		*tos = (ip6h->priority << 4) | (ip6h->flow_lbl[0] >> 4);
+
+		return *l4_proto == QDF_NBUF_TRAC_ICMPV6_TYPE ?
+			QDF_NBUF_CB_PACKET_TYPE_ICMPv6 : 0;
+	}
+
+	iph = (struct iphdr *)ip;
+	*l4_proto = iph->protocol;
+	*tos = iph->tos;
+
+	/*
+	 * As in qdf_nbuf_is_ipv4_dhcp_pkt(), the ports are matched whatever
+	 * the IP protocol is, and DHCP takes precedence over ICMP.
+	 */
+	ports = (uint16_t *)(ip + iph->ihl * QDF_NBUF_IPV4_HDR_SIZE_UNIT);
+	if ((ports[0] == QDF_SWAP_U16(QDF_NBUF_TRAC_DHCP_SRV_PORT) &&
+	     ports[1] == QDF_SWAP_U16(QDF_NBUF_TRAC_DHCP_CLI_PORT)) ||
+	    (ports[0] == QDF_SWAP_U16(QDF_NBUF_TRAC_DHCP_CLI_PORT) &&
+	     ports[1] == QDF_SWAP_U16(QDF_NBUF_TRAC_DHCP_SRV_PORT)))
+		return QDF_NBUF_CB_PACKET_TYPE_DHCP;
+
+	if (*l4_proto == QDF_NBUF_TRAC_ICMP_TYPE)
+		return QDF_NBUF_CB_PACKET_TYPE_ICMP;
+
+	return 0;
+}
+
+/**
+ * __qdf_nbuf_tx_classify() - classify a TX frame in a single header walk
+ * @skb: sk buff
+ *
+ * Resets skb->cb and records the broadcast/multicast flags and the special
+ * packet type (ARP, DHCP, EAPOL, WAPI, ICMP, ICMPv6) in it, with the same
+ * semantics as the individual qdf_nbuf_is_*_pkt() helpers. For untagged
+ * IPv4/IPv6 frames the L3/L4 protocol and TOS byte are recorded as well so
+ * that the DP layer can pick the TID without parsing the headers again.
+ *
+ * Return: none
+ */
+void __qdf_nbuf_tx_classify(struct sk_buff *skb)
+{
+	uint8_t *data = skb->data;
+	uint16_t ether_type, l3_proto;
+	uint8_t l4_proto = 0;
+	uint8_t tos = 0;
+	uint8_t ip_offset = QDF_NBUF_TRAC_IP_OFFSET;
+	uint8_t pkt_type = 0;
+
+	qdf_mem_zero(skb->cb, sizeof(skb->cb));
+
+	/* check destination mac address is broadcast/multicast */
+	if (is_broadcast_ether_addr(data))
+		QDF_NBUF_CB_GET_IS_BCAST(skb) = true;
+	else if (is_multicast_ether_addr(data))
+		QDF_NBUF_CB_GET_IS_MCAST(skb) = true;
+
+	l3_proto = *(uint16_t *)(data + QDF_NBUF_TRAC_ETH_TYPE_OFFSET);
+	ether_type = l3_proto;
+	if (unlikely(l3_proto == QDF_SWAP_U16(QDF_ETH_TYPE_8021Q))) {
+		ether_type = *(uint16_t *)(data +
+				QDF_NBUF_TRAC_VLAN_ETH_TYPE_OFFSET);
+		ip_offset = QDF_NBUF_TRAC_VLAN_IP_OFFSET;
+	} else if (unlikely(l3_proto == QDF_SWAP_U16(QDF_ETH_TYPE_8021AD))) {
+		ether_type = *(uint16_t *)(data +
+				QDF_NBUF_TRAC_DOUBLE_VLAN_ETH_TYPE_OFFSET);
+		ip_offset = QDF_NBUF_TRAC_DOUBLE_VLAN_IP_OFFSET;
+	}
+
+	switch (ether_type) {
+	case QDF_SWAP_U16(QDF_NBUF_TRAC_IPV4_ETH_TYPE):
+	case QDF_SWAP_U16(QDF_NBUF_TRAC_IPV6_ETH_TYPE):
+		pkt_type = __qdf_nbuf_tx_classify_ip(data + ip_offset,
+						     ether_type, &l4_proto,
+						     &tos);
+		/*
+		 * ICMP/ICMPv6 and the L3/L4 record are only reported for
+		 * untagged frames, matching qdf_nbuf_is_icmp_pkt() and the
+		 * TID classification in the DP layer.
+		 */
+		if (l3_proto != ether_type) {
+			if (pkt_type != QDF_NBUF_CB_PACKET_TYPE_DHCP)
+				pkt_type = 0;
+			l3_proto = 0;
+			l4_proto = 0;
+			tos = 0;
+		}
+		break;
+	case QDF_SWAP_U16(QDF_NBUF_TRAC_ARP_ETH_TYPE):
+		pkt_type = QDF_NBUF_CB_PACKET_TYPE_ARP;
+		break;
+	case QDF_SWAP_U16(QDF_NBUF_TRAC_EAPOL_ETH_TYPE):
+		pkt_type = QDF_NBUF_CB_PACKET_TYPE_EAPOL;
+		break;
+	case QDF_SWAP_U16(QDF_NBUF_TRAC_WAPI_ETH_TYPE):
+		/* WAPI is only recognised untagged */
+		if (l3_proto == ether_type)
+			pkt_type = QDF_NBUF_CB_PACKET_TYPE_WAPI;
+		break;
+	default:
+		break;
+	}
+
+	QDF_NBUF_CB_GET_PACKET_TYPE(skb) = pkt_type;
+	__qdf_nbuf_tx_cls_set(skb, l3_proto, l4_proto, tos);
+}
+qdf_export_symbol(__qdf_nbuf_tx_classify);
+
 void __qdf_nbuf_init(__qdf_nbuf_t nbuf)
 {
 	qdf_nbuf_users_set(&nbuf->users, 1);
@@ -98,6 +98,47 @@ static struct qdf_dp_trace_record_s
 #endif
 static spinlock_t l_dp_trace_lock;
 
+#ifdef QDF_DP_TRACE_PCPU
+/* Records in each per-CPU DP trace ring, must be a power of 2 */
+#ifndef QDF_DP_TRACE_PCPU_RECORDS
+#define QDF_DP_TRACE_PCPU_RECORDS 512
+#endif
+#define QDF_DP_TRACE_PCPU_MASK (QDF_DP_TRACE_PCPU_RECORDS - 1)
+
+/**
+ * struct qdf_dp_trace_pcpu - per-CPU DP trace ring
+ * @recs: QDF_DP_TRACE_PCPU_RECORDS records
+ * @count: free running number of records written by this CPU
+ * @clear_mark: value of @count when the trace buffer was last cleared
+ * @tx_count: TX packets seen by qdf_dp_trace_set_track() on this CPU
+ * @rx_count: RX packets seen by qdf_dp_trace_set_track() on this CPU
+ *
+ * @recs, @count and the packet counters are only written by the owning
+ * CPU, so recording needs no lock. g_qdf_dp_trace_tbl holds the merged
+ * view of all the rings built by qdf_dp_trace_snapshot() for the dumps.
+ */
+struct qdf_dp_trace_pcpu {
+	struct qdf_dp_trace_record_s *recs;
+	uint32_t count;
+	uint32_t clear_mark;
+	uint32_t tx_count;
+	uint32_t rx_count;
+};
+
+static DEFINE_PER_CPU(struct qdf_dp_trace_pcpu, qdf_dp_trace_pcpu);
+static struct qdf_dp_trace_record_s *g_qdf_dp_trace_pcpu_mem;
+#endif
+
+/**
+ * struct qdf_dp_proto_sample - per-CPU protocol record sampling counters
+ * @count: protocol packets seen, per protocol type
+ */
+struct qdf_dp_proto_sample {
+	uint32_t count[QDF_PROTO_TYPE_MAX];
+};
+
+static DEFINE_PER_CPU(struct qdf_dp_proto_sample, qdf_dp_proto_sample);
+
 /*
  * all the options to configure/control DP trace are
  * defined in this structure
@@ -694,6 +735,56 @@ static inline void free_g_qdf_dp_trace_tbl_buffer(void)
 { }
 #endif
 
+#ifdef QDF_DP_TRACE_PCPU
+static QDF_STATUS qdf_dp_trace_pcpu_alloc(void)
+{
+	struct qdf_dp_trace_pcpu *pcpu;
+	int cpu;
+	int i = 0;
+
+	g_qdf_dp_trace_pcpu_mem =
+		qdf_mem_valloc(num_possible_cpus() * QDF_DP_TRACE_PCPU_RECORDS *
+			       sizeof(*g_qdf_dp_trace_pcpu_mem));
+	if (!g_qdf_dp_trace_pcpu_mem)
+		return QDF_STATUS_E_NOMEM;
+
+	for_each_possible_cpu(cpu) {
+		pcpu = per_cpu_ptr(&qdf_dp_trace_pcpu, cpu);
+		qdf_mem_zero(pcpu, sizeof(*pcpu));
+		WRITE_ONCE(pcpu->recs, &g_qdf_dp_trace_pcpu_mem[i++ *
+					QDF_DP_TRACE_PCPU_RECORDS]);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void qdf_dp_trace_pcpu_free(void)
+{
+	int cpu;
+
+	if (!g_qdf_dp_trace_pcpu_mem)
+		return;
+
+	for_each_possible_cpu(cpu)
+		WRITE_ONCE(per_cpu_ptr(&qdf_dp_trace_pcpu, cpu)->recs, NULL);
+
+	/* Writers run with interrupts disabled, an RCU read side section */
+	synchronize_rcu();
+
+	qdf_mem_vfree(g_qdf_dp_trace_pcpu_mem);
+	g_qdf_dp_trace_pcpu_mem = NULL;
+}
+#else
+static inline QDF_STATUS qdf_dp_trace_pcpu_alloc(void)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void qdf_dp_trace_pcpu_free(void)
+{
+}
+#endif
+
 #define QDF_DP_TRACE_PREPEND_STR_SIZE 100
 /*
  * one dp trace record can't be greater than 300 bytes.
@@ -739,6 +830,12 @@ void qdf_dp_trace_init(bool live_mode_config, uint8_t thresh,
 				"Failed!!! DP Trace buffer allocation");
 		return;
 	}
+	if (qdf_dp_trace_pcpu_alloc() != QDF_STATUS_SUCCESS) {
+		QDF_TRACE_ERROR(QDF_MODULE_ID_QDF,
+				"Failed!!! DP Trace per-CPU buffer allocation");
+		free_g_qdf_dp_trace_tbl_buffer();
+		return;
+	}
 	qdf_dp_trace_spin_lock_init();
 	qdf_dp_trace_clear_buffer();
 	g_qdf_dp_trace_data.enable = true;
@@ -795,6 +892,7 @@ void qdf_dp_trace_deinit(void)
 	g_qdf_dp_trace_data.no_of_record = 0;
 	spin_unlock_bh(&l_dp_trace_lock);
 
+	qdf_dp_trace_pcpu_free();
 	free_g_qdf_dp_trace_tbl_buffer();
 }
 /**
@@ -864,6 +962,39 @@ static uint32_t qdf_dp_get_proto_event_bitmap(void)
 	return g_qdf_dp_trace_data.proto_event_bitmap;
 }
 
+void qdf_dp_set_proto_sample_rate(enum qdf_proto_type type, uint16_t rate)
+{
+	if (type >= QDF_PROTO_TYPE_MAX)
+		return;
+
+	g_qdf_dp_trace_data.proto_sample_rate[type] = rate;
+}
+
+qdf_export_symbol(qdf_dp_set_proto_sample_rate);
+
+/**
+ * qdf_dp_proto_sample_check() - check if a protocol record is sampled
+ * @type: protocol type
+ *
+ * The counters are per-CPU, so the sampling is one in rate records of
+ * the protocol on each CPU.
+ *
+ * Return: true if the record is to be added
+ */
+static bool qdf_dp_proto_sample_check(enum qdf_proto_type type)
+{
+	uint16_t rate;
+
+	if (type >= QDF_PROTO_TYPE_MAX)
+		return true;
+
+	rate = g_qdf_dp_trace_data.proto_sample_rate[type];
+	if (rate <= 1)
+		return true;
+
+	return !(this_cpu_inc_return(qdf_dp_proto_sample.count[type]) % rate);
+}
+
 /**
  * qdf_dp_set_no_of_record() - set dp trace no_of_record
  *
@@ -939,6 +1070,59 @@ uint32_t qdf_dp_get_proto_bitmap(void)
 		return 0;
 }
 
+#ifdef QDF_DP_TRACE_PCPU
+/**
+ * qdf_dp_trace_count_pkt() - count a packet for the DP trace sampling
+ * @dir: direction
+ * @count: filled with the packet number in @dir on this CPU
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_count_pkt(enum qdf_proto_dir dir, uint32_t *count)
+{
+	if (QDF_TX == dir)
+		*count = this_cpu_inc_return(qdf_dp_trace_pcpu.tx_count);
+	else if (QDF_RX == dir)
+		*count = this_cpu_inc_return(qdf_dp_trace_pcpu.rx_count);
+}
+
+/**
+ * qdf_dp_trace_sum_pkt_count() - sum up the per-CPU packet counters
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_sum_pkt_count(void)
+{
+	struct qdf_dp_trace_pcpu *pcpu;
+	uint32_t tx_count = 0;
+	uint32_t rx_count = 0;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		pcpu = per_cpu_ptr(&qdf_dp_trace_pcpu, cpu);
+		tx_count += READ_ONCE(pcpu->tx_count);
+		rx_count += READ_ONCE(pcpu->rx_count);
+	}
+
+	g_qdf_dp_trace_data.tx_count = tx_count;
+	g_qdf_dp_trace_data.rx_count = rx_count;
+}
+#else
+static void qdf_dp_trace_count_pkt(enum qdf_proto_dir dir, uint32_t *count)
+{
+	spin_lock_bh(&l_dp_trace_lock);
+	if (QDF_TX == dir)
+		*count = ++g_qdf_dp_trace_data.tx_count;
+	else if (QDF_RX == dir)
+		*count = ++g_qdf_dp_trace_data.rx_count;
+	spin_unlock_bh(&l_dp_trace_lock);
+}
+
+static inline void qdf_dp_trace_sum_pkt_count(void)
+{
+}
+#endif
+
 /**
  * qdf_dp_trace_set_track() - Marks whether the packet needs to be traced
  * @nbuf: defines the netbuf
@@ -953,11 +1137,7 @@ void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 	if (!g_qdf_dp_trace_data.enable)
 		return;
 
-	spin_lock_bh(&l_dp_trace_lock);
-	if (QDF_TX == dir)
-		count = ++g_qdf_dp_trace_data.tx_count;
-	else if (QDF_RX == dir)
-		count = ++g_qdf_dp_trace_data.rx_count;
+	qdf_dp_trace_count_pkt(dir, &count);
 
 	if ((g_qdf_dp_trace_data.no_of_record != 0) &&
 		(count % g_qdf_dp_trace_data.no_of_record == 0)) {
@@ -966,7 +1146,6 @@ void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 		else if (QDF_RX == dir)
 			QDF_NBUF_CB_RX_DP_TRACE(nbuf) = 1;
 	}
-	spin_unlock_bh(&l_dp_trace_lock);
 }
 qdf_export_symbol(qdf_dp_trace_set_track);
 
@@ -1313,7 +1492,7 @@ int qdf_dp_trace_fill_meta_str(char *prepend_str, int size,
  * @meta_data: pointer to metadata
  * @metadata_size: size of metadata
  *
- * Should be called from within a spin_lock for the qdf record.
+ * Should be called for a record claimed by qdf_dp_trace_rec_get().
  * Fills up rec->data with |metadata|data|
  *
  * Return: none
@@ -1354,6 +1533,95 @@ end:
 	rec->size = data_to_copy;
 }
 
+#ifdef QDF_DP_TRACE_PCPU
+/**
+ * qdf_dp_trace_rec_get() - get the next record of the local CPU ring
+ * @index: filled with the index of the record in the ring
+ * @flags: saved interrupt state, to be passed to qdf_dp_trace_rec_put()
+ *
+ * Only the local CPU writes its ring, and it does so with interrupts
+ * disabled, so no lock is needed.
+ *
+ * Return: record to fill, NULL if the rings are not allocated
+ */
+static struct qdf_dp_trace_record_s *
+qdf_dp_trace_rec_get(int *index, unsigned long *flags)
+{
+	struct qdf_dp_trace_pcpu *pcpu;
+	struct qdf_dp_trace_record_s *recs;
+
+	local_irq_save(*flags);
+	pcpu = this_cpu_ptr(&qdf_dp_trace_pcpu);
+	recs = READ_ONCE(pcpu->recs);
+	if (!recs) {
+		local_irq_restore(*flags);
+		return NULL;
+	}
+
+	*index = pcpu->count & QDF_DP_TRACE_PCPU_MASK;
+	/*
+	 * A reader copying the old record in this slot checks the count
+	 * afterwards, so the count must be visible before the slot changes.
+	 */
+	smp_wmb();
+
+	return &recs[*index];
+}
+
+/**
+ * qdf_dp_trace_rec_put() - publish the record from qdf_dp_trace_rec_get()
+ * @flags: interrupt state saved by qdf_dp_trace_rec_get()
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_rec_put(unsigned long flags)
+{
+	struct qdf_dp_trace_pcpu *pcpu = this_cpu_ptr(&qdf_dp_trace_pcpu);
+
+	smp_store_release(&pcpu->count, pcpu->count + 1);
+	local_irq_restore(flags);
+}
+#else
+static struct qdf_dp_trace_record_s *
+qdf_dp_trace_rec_get(int *index, unsigned long *flags)
+{
+	spin_lock_bh(&l_dp_trace_lock);
+
+	g_qdf_dp_trace_data.num++;
+
+	if (g_qdf_dp_trace_data.num > MAX_QDF_DP_TRACE_RECORDS)
+		g_qdf_dp_trace_data.num = MAX_QDF_DP_TRACE_RECORDS;
+
+	if (INVALID_QDF_DP_TRACE_ADDR == g_qdf_dp_trace_data.head) {
+		/* first record */
+		g_qdf_dp_trace_data.head = 0;
+		g_qdf_dp_trace_data.tail = 0;
+	} else {
+		/* queue is not empty */
+		g_qdf_dp_trace_data.tail++;
+
+		if (MAX_QDF_DP_TRACE_RECORDS == g_qdf_dp_trace_data.tail)
+			g_qdf_dp_trace_data.tail = 0;
+
+		if (g_qdf_dp_trace_data.head == g_qdf_dp_trace_data.tail) {
+			/* full */
+			if (MAX_QDF_DP_TRACE_RECORDS ==
+				++g_qdf_dp_trace_data.head)
+				g_qdf_dp_trace_data.head = 0;
+		}
+	}
+
+	*index = g_qdf_dp_trace_data.tail;
+
+	return &g_qdf_dp_trace_tbl[g_qdf_dp_trace_data.tail];
+}
+
+static void qdf_dp_trace_rec_put(unsigned long flags)
+{
+	spin_unlock_bh(&l_dp_trace_lock);
+}
+#endif
+
 /**
  * qdf_dp_add_record() - add dp trace record
  * @code: dptrace code
@@ -1375,6 +1643,7 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 {
 	struct qdf_dp_trace_record_s *rec = NULL;
 	int index;
+	unsigned long flags;
 	bool print_this_record = false;
 	u8 info = 0;
 
@@ -1385,7 +1654,9 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 		return;
 	}
 
-	spin_lock_bh(&l_dp_trace_lock);
+	rec = qdf_dp_trace_rec_get(&index, &flags);
+	if (!rec)
+		return;
 
 	if (print || g_qdf_dp_trace_data.force_live_mode) {
 		print_this_record = true;
@@ -1401,32 +1672,6 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 		}
 	}
 
-	g_qdf_dp_trace_data.num++;
-
-	if (g_qdf_dp_trace_data.num > MAX_QDF_DP_TRACE_RECORDS)
-		g_qdf_dp_trace_data.num = MAX_QDF_DP_TRACE_RECORDS;
-
-	if (INVALID_QDF_DP_TRACE_ADDR == g_qdf_dp_trace_data.head) {
-		/* first record */
-		g_qdf_dp_trace_data.head = 0;
-		g_qdf_dp_trace_data.tail = 0;
-	} else {
-		/* queue is not empty */
-		g_qdf_dp_trace_data.tail++;
-
-		if (MAX_QDF_DP_TRACE_RECORDS == g_qdf_dp_trace_data.tail)
-			g_qdf_dp_trace_data.tail = 0;
-
-		if (g_qdf_dp_trace_data.head == g_qdf_dp_trace_data.tail) {
-			/* full */
-			if (MAX_QDF_DP_TRACE_RECORDS ==
-				++g_qdf_dp_trace_data.head)
-				g_qdf_dp_trace_data.head = 0;
-		}
-	}
-
-	rec = &g_qdf_dp_trace_tbl[g_qdf_dp_trace_data.tail];
-	index = g_qdf_dp_trace_data.tail;
 	rec->code = code;
 	rec->pdev_id = pdev_id;
 	rec->size = 0;
@@ -1435,18 +1680,11 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 	rec->time = qdf_get_log_timestamp();
 	rec->pid = (in_interrupt() ? 0 : current->pid);
 
-	if (rec->code >= QDF_DP_TRACE_MAX) {
-		QDF_TRACE_ERROR(QDF_MODULE_ID_QDF,
-				"invalid record code %u, max code %u",
-				rec->code, QDF_DP_TRACE_MAX);
-		return;
-	}
-
-	spin_unlock_bh(&l_dp_trace_lock);
+	qdf_dp_trace_rec_put(flags);
 
 	info |= QDF_DP_TRACE_RECORD_INFO_LIVE;
 	if (print_this_record)
-		qdf_dp_trace_cb_table[rec->code] (rec, index,
+		qdf_dp_trace_cb_table[code] (rec, index,
 					QDF_TRACE_DEFAULT_PDEV_ID, info);
 }
 
@@ -2326,6 +2564,9 @@ void qdf_dp_trace_proto_pkt(enum QDF_DP_TRACE_ID code, uint8_t vdev_id,
 	if (qdf_dp_enable_check(NULL, code, dir) == false)
 		return;
 
+	if (!qdf_dp_proto_sample_check(type))
+		return;
+
 	if (buf_size > QDF_DP_TRACE_RECORD_SIZE)
 		QDF_BUG(0);
 
@@ -2678,6 +2919,150 @@ void qdf_dp_trace_enable_live_mode(void)
 }
 qdf_export_symbol(qdf_dp_trace_enable_live_mode);
 
+#ifdef QDF_DP_TRACE_PCPU
+/**
+ * struct qdf_dp_trace_pcpu_cursor - read position in a per-CPU ring
+ * @start: oldest record number still to be read
+ * @end: one past the next record number to be read
+ * @valid: @rec holds a record
+ * @rec: copy of the record
+ */
+struct qdf_dp_trace_pcpu_cursor {
+	uint32_t start;
+	uint32_t end;
+	bool valid;
+	struct qdf_dp_trace_record_s rec;
+};
+
+/**
+ * qdf_dp_trace_pcpu_fetch() - copy the next older record of a ring
+ * @pcpu: per-CPU ring
+ * @cur: read position in @pcpu
+ *
+ * The writer is not stopped. The copy is only valid if the slot was not
+ * claimed again for a newer record while it was read, and once that has
+ * happened every older record is gone too.
+ *
+ * Return: true if @cur->rec holds a record
+ */
+static bool qdf_dp_trace_pcpu_fetch(struct qdf_dp_trace_pcpu *pcpu,
+				    struct qdf_dp_trace_pcpu_cursor *cur)
+{
+	uint32_t seq;
+
+	cur->valid = false;
+	if (cur->end == cur->start)
+		return false;
+
+	seq = --cur->end;
+	cur->rec = pcpu->recs[seq & QDF_DP_TRACE_PCPU_MASK];
+	smp_rmb();
+	if (READ_ONCE(pcpu->count) - seq >= QDF_DP_TRACE_PCPU_RECORDS) {
+		cur->start = cur->end;
+		return false;
+	}
+
+	cur->valid = true;
+
+	return true;
+}
+
+/**
+ * qdf_dp_trace_snapshot() - merge the per-CPU rings into g_qdf_dp_trace_tbl
+ *
+ * The newest MAX_QDF_DP_TRACE_RECORDS records of all CPUs are merged by
+ * time stamp into g_qdf_dp_trace_tbl, oldest first, and head, tail and num
+ * are set up for the dump code that walks the table.
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_snapshot(void)
+{
+	struct qdf_dp_trace_pcpu_cursor *cur;
+	struct qdf_dp_trace_pcpu *pcpu;
+	uint32_t avail;
+	uint32_t pos;
+	int newest;
+	int cpu;
+
+	cur = qdf_mem_malloc(nr_cpu_ids * sizeof(*cur));
+	if (!cur)
+		return;
+
+	spin_lock_bh(&l_dp_trace_lock);
+	for_each_possible_cpu(cpu) {
+		pcpu = per_cpu_ptr(&qdf_dp_trace_pcpu, cpu);
+		if (!pcpu->recs)
+			continue;
+
+		cur[cpu].end = smp_load_acquire(&pcpu->count);
+		avail = cur[cpu].end - pcpu->clear_mark;
+		if (avail > QDF_DP_TRACE_PCPU_RECORDS)
+			avail = QDF_DP_TRACE_PCPU_RECORDS;
+		cur[cpu].start = cur[cpu].end - avail;
+		qdf_dp_trace_pcpu_fetch(pcpu, &cur[cpu]);
+	}
+
+	pos = MAX_QDF_DP_TRACE_RECORDS;
+	while (pos) {
+		newest = -1;
+		for_each_possible_cpu(cpu) {
+			if (cur[cpu].valid &&
+			    (newest < 0 ||
+			     cur[cpu].rec.time > cur[newest].rec.time))
+				newest = cpu;
+		}
+
+		if (newest < 0)
+			break;
+
+		g_qdf_dp_trace_tbl[--pos] = cur[newest].rec;
+		qdf_dp_trace_pcpu_fetch(per_cpu_ptr(&qdf_dp_trace_pcpu, newest),
+					&cur[newest]);
+	}
+
+	g_qdf_dp_trace_data.num = MAX_QDF_DP_TRACE_RECORDS - pos;
+	if (!g_qdf_dp_trace_data.num) {
+		g_qdf_dp_trace_data.head = INVALID_QDF_DP_TRACE_ADDR;
+		g_qdf_dp_trace_data.tail = INVALID_QDF_DP_TRACE_ADDR;
+	} else {
+		if (pos)
+			memmove(&g_qdf_dp_trace_tbl[0], &g_qdf_dp_trace_tbl[pos],
+				g_qdf_dp_trace_data.num *
+				sizeof(*g_qdf_dp_trace_tbl));
+		g_qdf_dp_trace_data.head = 0;
+		g_qdf_dp_trace_data.tail = g_qdf_dp_trace_data.num - 1;
+	}
+	spin_unlock_bh(&l_dp_trace_lock);
+
+	qdf_mem_free(cur);
+}
+
+/**
+ * qdf_dp_trace_pcpu_clear() - drop the records recorded so far
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_pcpu_clear(void)
+{
+	struct qdf_dp_trace_pcpu *pcpu;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		pcpu = per_cpu_ptr(&qdf_dp_trace_pcpu, cpu);
+		pcpu->clear_mark = READ_ONCE(pcpu->count);
+	}
+}
+#else
+static inline void qdf_dp_trace_snapshot(void)
+{
+}
+
+static inline void qdf_dp_trace_pcpu_clear(void)
+{
+}
+#endif
+
 /**
  * qdf_dp_trace_clear_buffer() - clear dp trace buffer
  *
@@ -2685,6 +3070,7 @@ qdf_export_symbol(qdf_dp_trace_enable_live_mode);
  */
 void qdf_dp_trace_clear_buffer(void)
 {
+	qdf_dp_trace_pcpu_clear();
 	g_qdf_dp_trace_data.head = INVALID_QDF_DP_TRACE_ADDR;
 	g_qdf_dp_trace_data.tail = INVALID_QDF_DP_TRACE_ADDR;
 	g_qdf_dp_trace_data.num = 0;
@@ -2699,6 +3085,7 @@ qdf_export_symbol(qdf_dp_trace_clear_buffer);
 
 void qdf_dp_trace_dump_stats(void)
 {
+		qdf_dp_trace_sum_pkt_count();
 		DPTRACE_PRINT("STATS |DPT: tx %u rx %u icmp(%u %u) arp(%u %u) icmpv6(%u %u %u %u %u %u) dhcp(%u %u %u %u %u %u) eapol(%u %u %u %u %u)",
 			      g_qdf_dp_trace_data.tx_count,
 			      g_qdf_dp_trace_data.rx_count,
@@ -2902,7 +3289,7 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 {
 	uint32_t i = 0;
 	uint32_t tail;
-	uint32_t count = g_qdf_dp_trace_data.num;
+	uint32_t count;
 
 	if (!g_qdf_dp_trace_data.enable) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
@@ -2910,6 +3297,11 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 		return QDF_STATUS_E_EMPTY;
 	}
 
+	if (state != QDF_DPT_DEBUGFS_STATE_SHOW_IN_PROGRESS)
+		qdf_dp_trace_snapshot();
+
+	count = g_qdf_dp_trace_data.num;
+
 	if (!count) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
 		  "%s: no packets", __func__);
@@ -3149,6 +3541,8 @@ void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 		return;
 	}
 
+	qdf_dp_trace_snapshot();
+
 	DPTRACE_PRINT(
 		"DPT: config - bitmap 0x%x verb %u #rec %u live_config %u thresh %u time_limit %u",
 		g_qdf_dp_trace_data.proto_bitmap,
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_nbuf_test.h"
+#include "qdf_net_types.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define QDF_NBUF_UT_FRAME_LEN 128
+
+/* Random fills of each frame layout, covering TOS and the other bytes */
+#define QDF_NBUF_UT_RUNS 16
+
+#define QDF_NBUF_UT_ETH_TYPE_OTHER 0x88cc
+#define QDF_NBUF_UT_ETH_LEN 0x0040
+#define QDF_NBUF_UT_IP_PROTO_OTHER 47
+#define QDF_NBUF_UT_IPV6_HOPOPTS 0
+#define QDF_NBUF_UT_DNS_PORT 53
+
+/**
+ * enum qdf_nbuf_ut_l2 - L2 header of a test frame
+ * @QDF_NBUF_UT_UNTAGGED: Ethernet II
+ * @QDF_NBUF_UT_VLAN: 802.1Q tagged
+ * @QDF_NBUF_UT_QINQ: 802.1AD and 802.1Q tagged
+ * @QDF_NBUF_UT_L2_MAX: number of L2 headers
+ */
+enum qdf_nbuf_ut_l2 {
+	QDF_NBUF_UT_UNTAGGED,
+	QDF_NBUF_UT_VLAN,
+	QDF_NBUF_UT_QINQ,
+	QDF_NBUF_UT_L2_MAX,
+};
+
+/**
+ * struct qdf_nbuf_ut_frame - Layout of a test frame
+ * @da: destination address
+ * @l2: L2 header
+ * @ether_type: ethertype, after the VLAN tags
+ * @ihl: IPv4 header length in 4 byte units
+ * @l4_proto: IPv4 protocol or IPv6 next header
+ * @sport: L4 source port
+ * @dport: L4 destination port
+ */
+struct qdf_nbuf_ut_frame {
+	const uint8_t *da;
+	enum qdf_nbuf_ut_l2 l2;
+	uint16_t ether_type;
+	uint8_t ihl;
+	uint8_t l4_proto;
+	uint16_t sport;
+	uint16_t dport;
+};
+
+static const uint8_t qdf_nbuf_ut_da[][QDF_MAC_ADDR_SIZE] = {
+	{ 0x00, 0x03, 0x7f, 0x12, 0x34, 0x56 },
+	{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+	{ 0x01, 0x00, 0x5e, 0x00, 0x00, 0xfb },
+	{ 0x33, 0x33, 0x00, 0x00, 0x00, 0x01 },
+};
+
+static const uint16_t qdf_nbuf_ut_ether_types[] = {
+	QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	QDF_NBUF_TRAC_IPV6_ETH_TYPE,
+	QDF_NBUF_TRAC_ARP_ETH_TYPE,
+	QDF_NBUF_TRAC_EAPOL_ETH_TYPE,
+	QDF_NBUF_TRAC_WAPI_ETH_TYPE,
+	QDF_NBUF_UT_ETH_TYPE_OTHER,
+	QDF_NBUF_UT_ETH_LEN,
+};
+
+static const uint8_t qdf_nbuf_ut_ipv4_protos[] = {
+	QDF_NBUF_TRAC_TCP_TYPE,
+	QDF_NBUF_TRAC_UDP_TYPE,
+	QDF_NBUF_TRAC_ICMP_TYPE,
+	QDF_NBUF_UT_IP_PROTO_OTHER,
+};
+
+static const uint8_t qdf_nbuf_ut_ipv6_protos[] = {
+	QDF_NBUF_TRAC_TCP_TYPE,
+	QDF_NBUF_TRAC_UDP_TYPE,
+	QDF_NBUF_TRAC_ICMPV6_TYPE,
+	QDF_NBUF_UT_IPV6_HOPOPTS,
+};
+
+static const uint16_t qdf_nbuf_ut_ports[][2] = {
+	{ QDF_NBUF_TRAC_DHCP_SRV_PORT, QDF_NBUF_TRAC_DHCP_CLI_PORT },
+	{ QDF_NBUF_TRAC_DHCP_CLI_PORT, QDF_NBUF_TRAC_DHCP_SRV_PORT },
+	{ QDF_NBUF_TRAC_DHCP_SRV_PORT, QDF_NBUF_TRAC_DHCP_SRV_PORT },
+	{ QDF_NBUF_UT_DNS_PORT, QDF_NBUF_TRAC_DHCP_CLI_PORT },
+};
+
+static uint32_t qdf_nbuf_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static void qdf_nbuf_ut_put_be16(uint8_t *p, uint16_t v)
+{
+	p[0] = v >> 8;
+	p[1] = v & 0xff;
+}
+
+/**
+ * qdf_nbuf_ut_build() - Build a test frame over random bytes
+ * @data: frame buffer of QDF_NBUF_UT_FRAME_LEN bytes
+ * @frame: layout of the frame
+ * @seed: random seed
+ *
+ * Return: None
+ */
+static void qdf_nbuf_ut_build(uint8_t *data, struct qdf_nbuf_ut_frame *frame,
+			      uint64_t *seed)
+{
+	uint32_t off = QDF_NBUF_TRAC_ETH_TYPE_OFFSET;
+	uint32_t i;
+
+	for (i = 0; i < QDF_NBUF_UT_FRAME_LEN; i++)
+		data[i] = qdf_nbuf_ut_rand(seed, 256);
+
+	qdf_mem_copy(data, frame->da, QDF_MAC_ADDR_SIZE);
+
+	if (frame->l2 == QDF_NBUF_UT_QINQ) {
+		qdf_nbuf_ut_put_be16(data + off, QDF_ETH_TYPE_8021AD);
+		off += 4;
+	}
+	if (frame->l2 != QDF_NBUF_UT_UNTAGGED) {
+		qdf_nbuf_ut_put_be16(data + off, QDF_ETH_TYPE_8021Q);
+		off += 4;
+	}
+	qdf_nbuf_ut_put_be16(data + off, frame->ether_type);
+	off += 2;
+
+	if (frame->ether_type == QDF_NBUF_TRAC_IPV4_ETH_TYPE) {
+		data[off] = 0x40 | frame->ihl;
+		data[off + 9] = frame->l4_proto;
+		off += frame->ihl * QDF_NBUF_IPV4_HDR_SIZE_UNIT;
+		qdf_nbuf_ut_put_be16(data + off, frame->sport);
+		qdf_nbuf_ut_put_be16(data + off + 2, frame->dport);
+	} else if (frame->ether_type == QDF_NBUF_TRAC_IPV6_ETH_TYPE) {
+		data[off] = 0x60 | (data[off] & 0x0f);
+		data[off + 6] = frame->l4_proto;
+	}
+}
+
+/**
+ * qdf_nbuf_ut_ref_pkt_type() - Packet type as classified by HDD before
+ *	qdf_nbuf_tx_classify(), with one helper per type
+ * @nbuf: network buffer
+ *
+ * Return: QDF_NBUF_CB_PACKET_TYPE_* of the frame, 0 if not special
+ */
+static uint8_t qdf_nbuf_ut_ref_pkt_type(qdf_nbuf_t nbuf)
+{
+	if (qdf_nbuf_is_ipv4_arp_pkt(nbuf))
+		return QDF_NBUF_CB_PACKET_TYPE_ARP;
+	else if (qdf_nbuf_is_ipv4_dhcp_pkt(nbuf))
+		return QDF_NBUF_CB_PACKET_TYPE_DHCP;
+	else if (qdf_nbuf_is_ipv4_eapol_pkt(nbuf))
+		return QDF_NBUF_CB_PACKET_TYPE_EAPOL;
+	else if (qdf_nbuf_is_ipv4_wapi_pkt(nbuf))
+		return QDF_NBUF_CB_PACKET_TYPE_WAPI;
+	else if (qdf_nbuf_is_icmp_pkt(nbuf))
+		return QDF_NBUF_CB_PACKET_TYPE_ICMP;
+	else if (qdf_nbuf_is_icmpv6_pkt(nbuf))
+		return QDF_NBUF_CB_PACKET_TYPE_ICMPv6;
+
+	return 0;
+}
+
+/**
+ * qdf_nbuf_ut_ref_tos() - TOS byte as read by the DSCP-TID mapping of the
+ *	DP layer when it parses the frame
+ * @nbuf: network buffer
+ *
+ * Return: IPv4 TOS or IPv6 traffic class of an untagged frame, 0 otherwise
+ */
+static uint8_t qdf_nbuf_ut_ref_tos(qdf_nbuf_t nbuf)
+{
+	uint8_t *ip = qdf_nbuf_data(nbuf) + QDF_NBUF_TRAC_IP_OFFSET;
+
+	if (qdf_nbuf_is_ipv4_pkt(nbuf))
+		return ip[1];
+
+	if (qdf_nbuf_is_ipv6_pkt(nbuf))
+		return ((ip[0] & 0x0f) << 4) | (ip[1] >> 4);
+
+	return 0;
+}
+
+/**
+ * qdf_nbuf_ut_tx_classify_frame() - Classify a frame and check the result
+ * @nbuf: network buffer holding the frame
+ *
+ * The control block is filled with junk first, as classification has to
+ * reset it.
+ *
+ * Return: number of errors
+ */
+static uint32_t qdf_nbuf_ut_tx_classify_frame(qdf_nbuf_t nbuf)
+{
+	uint8_t *data = qdf_nbuf_data(nbuf);
+	bool bcast = qdf_is_macaddr_broadcast((struct qdf_mac_addr *)data);
+	bool mcast = !bcast && (data[0] & 1);
+	uint8_t pkt_type = qdf_nbuf_ut_ref_pkt_type(nbuf);
+	bool is_ipv4 = qdf_nbuf_is_ipv4_pkt(nbuf);
+	bool is_ipv6 = qdf_nbuf_is_ipv6_pkt(nbuf);
+	bool is_tcp = qdf_nbuf_is_ipv4_tcp_pkt(nbuf) ||
+		      qdf_nbuf_is_ipv6_tcp_pkt(nbuf);
+	bool is_udp = qdf_nbuf_is_ipv4_udp_pkt(nbuf) ||
+		      qdf_nbuf_is_ipv6_udp_pkt(nbuf);
+	uint8_t tos = qdf_nbuf_ut_ref_tos(nbuf);
+
+	qdf_mem_set(nbuf->cb, sizeof(nbuf->cb), 0xff);
+	qdf_nbuf_tx_classify(nbuf);
+
+	if (QDF_NBUF_CB_GET_PACKET_TYPE(nbuf) != pkt_type ||
+	    QDF_NBUF_CB_GET_IS_BCAST(nbuf) != bcast ||
+	    QDF_NBUF_CB_GET_IS_MCAST(nbuf) != mcast) {
+		qdf_nofl_alert("FAIL: qdf_nbuf_tx_classify(%*phN) -> type %u bcast %u mcast %u; expected type %u bcast %u mcast %u",
+			       48, data, QDF_NBUF_CB_GET_PACKET_TYPE(nbuf),
+			       QDF_NBUF_CB_GET_IS_BCAST(nbuf),
+			       QDF_NBUF_CB_GET_IS_MCAST(nbuf), pkt_type, bcast,
+			       mcast);
+		return 1;
+	}
+
+	/* Platforms without room in the control block keep no record */
+	if (!qdf_nbuf_tx_cls_valid(nbuf))
+		return 0;
+
+	if (qdf_nbuf_tx_cls_is_ipv4(nbuf) != is_ipv4 ||
+	    qdf_nbuf_tx_cls_is_ipv6(nbuf) != is_ipv6 ||
+	    qdf_nbuf_tx_cls_is_tcp(nbuf) != is_tcp ||
+	    qdf_nbuf_tx_cls_is_udp(nbuf) != is_udp ||
+	    qdf_nbuf_tx_cls_get_tos(nbuf) != tos) {
+		qdf_nofl_alert("FAIL: qdf_nbuf_tx_classify(%*phN) -> ipv4 %u ipv6 %u tcp %u udp %u tos 0x%02x; expected ipv4 %u ipv6 %u tcp %u udp %u tos 0x%02x",
+			       48, data, qdf_nbuf_tx_cls_is_ipv4(nbuf),
+			       qdf_nbuf_tx_cls_is_ipv6(nbuf),
+			       qdf_nbuf_tx_cls_is_tcp(nbuf),
+			       qdf_nbuf_tx_cls_is_udp(nbuf),
+			       qdf_nbuf_tx_cls_get_tos(nbuf), is_ipv4, is_ipv6,
+			       is_tcp, is_udp, tos);
+		return 1;
+	}
+
+	qdf_nbuf_tx_cls_reset(nbuf);
+	if (qdf_nbuf_tx_cls_valid(nbuf)) {
+		qdf_nofl_alert("FAIL: qdf_nbuf_tx_cls_reset() left the record valid");
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * qdf_nbuf_ut_tx_classify_l4() - Check the IPv4/IPv6 L4 variants of a frame
+ * @nbuf: network buffer
+ * @frame: layout of the frame, L4 fields are set here
+ * @seed: random seed
+ *
+ * Return: number of errors
+ */
+static uint32_t qdf_nbuf_ut_tx_classify_l4(qdf_nbuf_t nbuf,
+					   struct qdf_nbuf_ut_frame *frame,
+					   uint64_t *seed)
+{
+	uint8_t *data = qdf_nbuf_data(nbuf);
+	uint32_t errors = 0;
+	uint32_t proto, ports, run;
+
+	if (frame->ether_type == QDF_NBUF_TRAC_IPV6_ETH_TYPE) {
+		for (proto = 0; proto < QDF_ARRAY_SIZE(qdf_nbuf_ut_ipv6_protos);
+		     proto++) {
+			frame->l4_proto = qdf_nbuf_ut_ipv6_protos[proto];
+			for (run = 0; run < QDF_NBUF_UT_RUNS; run++) {
+				qdf_nbuf_ut_build(data, frame, seed);
+				errors += qdf_nbuf_ut_tx_classify_frame(nbuf);
+			}
+		}
+
+		return errors;
+	}
+
+	for (proto = 0; proto < QDF_ARRAY_SIZE(qdf_nbuf_ut_ipv4_protos);
+	     proto++) {
+		frame->l4_proto = qdf_nbuf_ut_ipv4_protos[proto];
+		for (ports = 0; ports < QDF_ARRAY_SIZE(qdf_nbuf_ut_ports);
+		     ports++) {
+			frame->sport = qdf_nbuf_ut_ports[ports][0];
+			frame->dport = qdf_nbuf_ut_ports[ports][1];
+			for (frame->ihl = 5; frame->ihl <= 6; frame->ihl++) {
+				for (run = 0; run < QDF_NBUF_UT_RUNS; run++) {
+					qdf_nbuf_ut_build(data, frame, seed);
+					errors +=
+					qdf_nbuf_ut_tx_classify_frame(nbuf);
+				}
+			}
+		}
+	}
+
+	return errors;
+}
+
+/**
+ * qdf_nbuf_ut_tx_classify() - Cross-check qdf_nbuf_tx_classify() with the
+ *	per type helpers
+ *
+ * Every destination kind, VLAN tagging, ethertype, IP protocol and DHCP
+ * port combination is classified over random bytes, so that TOS, IPv6
+ * traffic class and the other header bytes take random values.
+ *
+ * Return: number of errors
+ */
+static uint32_t qdf_nbuf_ut_tx_classify(void)
+{
+	struct qdf_nbuf_ut_frame frame = { 0 };
+	uint64_t seed = 0x636c7373;
+	uint32_t errors = 0;
+	uint32_t da, type, run;
+	qdf_nbuf_t nbuf;
+
+	nbuf = qdf_nbuf_alloc(NULL, QDF_NBUF_UT_FRAME_LEN, 0, 4, false);
+	if (!nbuf) {
+		qdf_nofl_alert("FAIL: nbuf allocation");
+		return 1;
+	}
+	qdf_nbuf_set_pktlen(nbuf, QDF_NBUF_UT_FRAME_LEN);
+
+	for (da = 0; da < QDF_ARRAY_SIZE(qdf_nbuf_ut_da); da++) {
+		frame.da = qdf_nbuf_ut_da[da];
+		for (frame.l2 = 0; frame.l2 < QDF_NBUF_UT_L2_MAX; frame.l2++) {
+			for (type = 0;
+			     type < QDF_ARRAY_SIZE(qdf_nbuf_ut_ether_types);
+			     type++) {
+				frame.ether_type =
+					qdf_nbuf_ut_ether_types[type];
+				if (frame.ether_type ==
+				    QDF_NBUF_TRAC_IPV4_ETH_TYPE ||
+				    frame.ether_type ==
+				    QDF_NBUF_TRAC_IPV6_ETH_TYPE) {
+					errors += qdf_nbuf_ut_tx_classify_l4(
+							nbuf, &frame, &seed);
+					continue;
+				}
+
+				for (run = 0; run < QDF_NBUF_UT_RUNS; run++) {
+					qdf_nbuf_ut_build(qdf_nbuf_data(nbuf),
+							  &frame, &seed);
+					errors +=
+					qdf_nbuf_ut_tx_classify_frame(nbuf);
+				}
+			}
+		}
+	}
+
+	qdf_nbuf_free(nbuf);
+
+	return errors;
+}
+
+uint32_t qdf_nbuf_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += qdf_nbuf_ut_tx_classify();
+	QDF_BUG(!errors);
+
+	return errors;
+}
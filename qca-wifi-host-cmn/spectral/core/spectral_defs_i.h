@@ -28,6 +28,9 @@
 #include <qdf_list.h>
 #include <qdf_timer.h>
 #include <qdf_util.h>
+#include <qdf_streamfs.h>
+#include <qdf_debugfs.h>
+#include <qdf_atomic.h>
 #include <wlan_spectral_public_structs.h>
 #include <wlan_spectral_utils_api.h>
 #include <spectral_ioctl.h>
@@ -76,6 +79,39 @@
 #define spectral_debug_rl_nofl(format, args...) \
 	QDF_TRACE_DEBUG_RL_NO_FL(QDF_MODULE_ID_SPECTRAL, format, ## args)
 
+#ifdef WLAN_SPECTRAL_STREAMFS
+/**
+ * struct spectral_streamfs_ring - Ring used to share the Spectral samples
+ * with the applications through streamfs
+ * @dir: streamfs directory holding the ring
+ * @chan: streamfs channel backing the ring
+ * @consumed_file: Control file through which mmap readers return the
+ * sub-buffers they are done with
+ * @consumed_fops: File operations of @consumed_file
+ * @enable_file: Control file through which an application switches the
+ * SAMP messages from netlink to the ring
+ * @enable_fops: File operations of @enable_file
+ * @enabled: Non-zero if new SAMP messages are built in the ring, netlink is
+ * used otherwise
+ * @rec: Ring record in which the SAMP message of each message type is being
+ * built, NULL if the message is being built in a netlink buffer
+ * @seq: Sequence number of the last valid record
+ * @num_overruns: Number of samples which did not fit in the ring
+ */
+struct spectral_streamfs_ring {
+	qdf_dentry_t dir;
+	qdf_streamfs_chan_t chan;
+	qdf_dentry_t consumed_file;
+	struct qdf_debugfs_fops consumed_fops;
+	qdf_dentry_t enable_file;
+	struct qdf_debugfs_fops enable_fops;
+	qdf_atomic_t enabled;
+	struct spectral_ring_rec_hdr *rec[SPECTRAL_MSG_TYPE_MAX];
+	uint64_t seq;
+	uint32_t num_overruns;
+};
+#endif /* WLAN_SPECTRAL_STREAMFS */
+
 /**
  * struct pdev_spectral - Radio specific spectral object
  * @psptrl_pdev:          Back-pointer to struct wlan_objmgr_pdev
@@ -84,6 +120,7 @@
  * @psptrl_target_handle: reference to spectral lmac object
  * @skb:                  Socket buffer for sending samples to applications
  * @spectral_pid :        Spectral port ID
+ * @ring:                 streamfs ring for sending samples to applications
  */
 struct pdev_spectral {
 	struct wlan_objmgr_pdev *psptrl_pdev;
@@ -91,6 +128,9 @@ struct pdev_spectral {
 	void *psptrl_target_handle;
 	struct sk_buff *skb[SPECTRAL_MSG_TYPE_MAX];
 	uint32_t spectral_pid;
+#ifdef WLAN_SPECTRAL_STREAMFS
+	struct spectral_streamfs_ring ring;
+#endif
 };
 
 struct spectral_wmi_ops;
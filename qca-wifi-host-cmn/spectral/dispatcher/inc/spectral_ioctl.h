@@ -410,6 +410,44 @@ struct spectral_caps {
 #define MAX_NUM_DETECTORS             (2)
 #define MAX_SPECTRAL_PAYLOAD          (3028)
 
+/* Spectral sample records in the streamfs ring */
+#define SPECTRAL_RING_REC_MAGIC           (0x53505247)
+#define SPECTRAL_RING_REC_FLAG_VALID      (0x1)
+#define SPECTRAL_RING_REC_FLAG_DROPPED    (0x2)
+#define SPECTRAL_RING_REC_SIZE            \
+	(sizeof(struct spectral_ring_rec_hdr) + MAX_SPECTRAL_PAYLOAD)
+
+/**
+ * struct spectral_ring_rec_hdr - Header of a Spectral sample record in the
+ * streamfs ring. Every record is SPECTRAL_RING_REC_SIZE bytes long and the
+ * SAMP message follows the header.
+ * @magic: SPECTRAL_RING_REC_MAGIC
+ * @flags: SPECTRAL_RING_REC_FLAG_VALID once the SAMP message is complete,
+ * SPECTRAL_RING_REC_FLAG_DROPPED if the record was abandoned. Readers should
+ * skip the record while neither flag is set.
+ * @seq: Sequence number of the record, incremented for every valid record.
+ * A gap in the sequence numbers seen by a reader means it missed records.
+ * @num_overruns: Number of samples which did not fit in the ring so far.
+ * Those samples were sent over netlink instead.
+ * @msg_type: Spectral message type, enum spectral_msg_type
+ * @msg_len: Size of the area following the header which holds the SAMP
+ * message
+ *
+ * The ring is not overwritten, a sub-buffer is reused only once the reader
+ * consumed it. read() on samples0 consumes the data it returns. A reader
+ * which maps samples0 has to write the number of sub-buffers it is done
+ * with to the consumed file next to it, else the ring fills up and the
+ * samples are sent over netlink.
+ */
+struct spectral_ring_rec_hdr {
+	uint32_t magic;
+	uint32_t flags;
+	uint64_t seq;
+	uint32_t num_overruns;
+	uint16_t msg_type;
+	uint16_t msg_len;
+} __packed;
+
 /**
  * enum dcs_int_type - Interference type indicated by DCS
  * @SPECTRAL_DCS_INT_NONE:  No interference
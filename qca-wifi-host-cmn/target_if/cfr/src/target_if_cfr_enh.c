@@ -80,16 +80,75 @@ static struct look_up_table *get_lut_entry(struct pdev_cfr *pcfr,
 	return pcfr->lut[offset];
 }
 
+/**
+ * cfr_lut_age_list_remove() - Remove an LUT entry from the age list
+ * @pcfr: PDEV CFR object
+ * @lut: pointer to LUT
+ *
+ * Return: none
+ */
+static void cfr_lut_age_list_remove(struct pdev_cfr *pcfr,
+				    struct look_up_table *lut)
+{
+	if (qdf_list_node_in_any_list(&lut->age_node))
+		qdf_list_remove_node(&pcfr->lut_age_list, &lut->age_node);
+}
+
+/**
+ * cfr_lut_age_list_add() - Queue an LUT entry on the age list if it holds
+ * a DBR event without its TXRX event
+ * @pcfr: PDEV CFR object
+ * @lut: pointer to LUT
+ *
+ * Must be called in the same lut_lock section that recorded the DBR event in
+ * @lut, so that the age list stays ordered by dbr_tstamp.
+ *
+ * Return: none
+ */
+static void cfr_lut_age_list_add(struct pdev_cfr *pcfr,
+				 struct look_up_table *lut)
+{
+	if (lut->dbr_recv && !lut->tx_recv)
+		qdf_list_insert_back(&pcfr->lut_age_list, &lut->age_node);
+}
+
+/**
+ * cfr_update_capture_type_stats() - Account a capture relayed to userspace in
+ * the per capture type throughput counters
+ * @pcfr: PDEV CFR object
+ * @lut: pointer to LUT holding the correlated capture
+ *
+ * Return: none
+ */
+static void cfr_update_capture_type_stats(struct pdev_cfr *pcfr,
+					  struct look_up_table *lut)
+{
+	struct cfr_capture_type_stats *stats;
+	uint8_t capture_type = lut->header.u.meta_enh.capture_type;
+	uint64_t tstamp = qdf_ktime_to_ms(qdf_ktime_get());
+
+	if (capture_type >= CFR_CAPTURE_TYPE_STATS_OTHER)
+		capture_type = CFR_CAPTURE_TYPE_STATS_OTHER;
+
+	stats = &pcfr->capture_type_stats[capture_type];
+	if (!stats->release_cnt)
+		stats->first_tstamp = tstamp;
+	stats->last_tstamp = tstamp;
+	stats->release_cnt++;
+	stats->release_bytes += lut->data_len;
+}
+
 /**
  * release_lut_entry_enh() - Clear all params in an LUT entry
- * @pdev: objmgr PDEV
+ * @pcfr: PDEV CFR object
  * @lut: pointer to LUT
  *
  * Return: status
  */
-static int release_lut_entry_enh(struct wlan_objmgr_pdev *pdev,
+static int release_lut_entry_enh(struct pdev_cfr *pcfr,
 				 struct look_up_table *lut)
 {
+	cfr_lut_age_list_remove(pcfr, lut);
 	lut->dbr_recv = false;
 	lut->tx_recv = false;
 	lut->data = NULL;
@@ -157,13 +216,15 @@ void target_if_cfr_dump_lut_enh(struct wlan_objmgr_pdev *pdev)
  * in cases where for RXTLV drops in host monitor status ring is huge.
  * @pdev: objmgr pdev
  *
+ * Only DBR events older than the last successful correlation are flushed, so
+ * the walk over the age ordered list stops at the first newer entry.
+ *
  * return: none
  */
 static void cfr_free_pending_dbr_events(struct wlan_objmgr_pdev *pdev)
 {
 	struct pdev_cfr *pcfr;
-	struct look_up_table *lut = NULL;
-	int i = 0;
+	struct look_up_table *lut = NULL, *next = NULL;
 	QDF_STATUS retval = 0;
 
 	retval = wlan_objmgr_pdev_try_get_ref(pdev, WLAN_CFR_ID);
@@ -180,19 +241,18 @@ static void cfr_free_pending_dbr_events(struct wlan_objmgr_pdev *pdev)
 		return;
 	}
 
-	for (i = 0; i < pcfr->lut_num; i++) {
-		lut = get_lut_entry(pcfr, i);
-		if (!lut)
+	qdf_list_for_each_del(&pcfr->lut_age_list, lut, next, age_node) {
+		if (lut->dbr_tstamp >= pcfr->last_success_tstamp)
+			break;
+
+		if (lut->tx_recv)
 			continue;
 
-		if (lut->dbr_recv && !lut->tx_recv &&
-		    (lut->dbr_tstamp < pcfr->last_success_tstamp)) {
-			target_if_dbr_buf_release(pdev, DBR_MODULE_CFR,
-						  lut->dbr_address,
-						  i, 0);
-			pcfr->flush_dbr_cnt++;
-			release_lut_entry_enh(pdev, lut);
-		}
+		target_if_dbr_buf_release(pdev, DBR_MODULE_CFR,
+					  lut->dbr_address,
+					  lut->cookie, 0);
+		pcfr->flush_dbr_cnt++;
+		release_lut_entry_enh(pcfr, lut);
 	}
 	wlan_objmgr_pdev_release_ref(pdev, WLAN_CFR_ID);
 }
@@ -818,6 +878,7 @@ static int correlate_and_relay_enh(struct wlan_objmgr_pdev *pdev,
 			if (check_dma_length(lut, target_type) ==
 					QDF_STATUS_SUCCESS) {
 				pcfr->release_cnt++;
+				cfr_update_capture_type_stats(pcfr, lut);
 				cfr_debug("<CORRELATE><%u>:Stream and release "
 					  "CFR data for "
 					  "ppdu_id:0x%04x\n", cookie,
@@ -1120,7 +1181,7 @@ void target_if_cfr_rx_tlv_process(struct wlan_objmgr_pdev *pdev, void *nbuf)
 							   lut->data_len,
 							   &end_magic, 4);
 		dump_metadata(header, cookie);
-		release_lut_entry_enh(pdev, lut);
+		release_lut_entry_enh(pcfr, lut);
 		target_if_dbr_buf_release(pdev, DBR_MODULE_CFR, buf_addr,
 					  cookie, srng_id);
 	}
@@ -1263,6 +1324,9 @@ static bool enh_cfr_dbr_event_handler(struct wlan_objmgr_pdev *pdev,
 		return true;
 	}
 
+	/* Requeued in dbr_tstamp order below if it is left uncorrelated */
+	cfr_lut_age_list_remove(pcfr, lut);
+
 	lut->data = data;
 	lut->data_len = length;
 	lut->dbr_ppdu_id = dma_hdr.phy_ppdu_id;
@@ -1314,9 +1378,10 @@ static bool enh_cfr_dbr_event_handler(struct wlan_objmgr_pdev *pdev,
 							   lut->data_len,
 							   &end_magic, 4);
 		dump_metadata(header, cookie);
-		release_lut_entry_enh(pdev, lut);
+		release_lut_entry_enh(pcfr, lut);
 		status = true;
 	} else if (status == STATUS_HOLD) {
+		cfr_lut_age_list_add(pcfr, lut);
 		status = false;
 	} else {
 		status = true;
@@ -1783,7 +1848,7 @@ target_if_peer_capture_event(ol_scn_t sc, uint8_t *data, uint32_t datalen)
 							   lut->data_len,
 							   &end_magic, 4);
 		dump_metadata(header, cookie);
-		release_lut_entry_enh(pdev, lut);
+		release_lut_entry_enh(pcfr, lut);
 		target_if_dbr_buf_release(pdev, DBR_MODULE_CFR, buf_addr,
 					  cookie, 0);
 	} else {
@@ -1937,11 +2002,10 @@ target_if_unregister_tx_completion_enh_event_handler(struct wlan_objmgr_psoc
  */
 static os_timer_func(lut_ageout_timer_task)
 {
-	int i = 0;
 	struct pdev_cfr *pcfr = NULL;
 	struct wlan_objmgr_pdev *pdev = NULL;
-	struct look_up_table *lut = NULL;
-	uint64_t diff, cur_tstamp;
+	struct look_up_table *lut = NULL, *next = NULL;
+	uint64_t cur_tstamp;
 	uint8_t srng_id = 0;
 
 	OS_GET_TIMER_ARG(pcfr, struct pdev_cfr*);
@@ -1968,21 +2032,19 @@ static os_timer_func(lut_ageout_timer_task)
 
 	qdf_spin_lock_bh(&pcfr->lut_lock);
 
-	for (i = 0; i < pcfr->lut_num; i++) {
-		lut = get_lut_entry(pcfr, i);
-		if (!lut)
+	/* Entries are in DBR event order, stop at the first one not aged out */
+	qdf_list_for_each_del(&pcfr->lut_age_list, lut, next, age_node) {
+		if (lut->dbr_tstamp + LUT_AGE_THRESHOLD >= cur_tstamp)
+			break;
+
+		if (lut->tx_recv)
 			continue;
 
-		if (lut->dbr_recv && !lut->tx_recv) {
-			diff = cur_tstamp - lut->dbr_tstamp;
-			if (diff > LUT_AGE_THRESHOLD) {
-				target_if_dbr_buf_release(pdev, DBR_MODULE_CFR,
-							  lut->dbr_address,
-							  i, srng_id);
-				pcfr->flush_timeout_dbr_cnt++;
-				release_lut_entry_enh(pdev, lut);
-			}
-		}
+		target_if_dbr_buf_release(pdev, DBR_MODULE_CFR,
+					  lut->dbr_address,
+					  lut->cookie, srng_id);
+		pcfr->flush_timeout_dbr_cnt++;
+		release_lut_entry_enh(pcfr, lut);
 	}
 
 	qdf_spin_unlock_bh(&pcfr->lut_lock);
@@ -2226,6 +2288,7 @@ QDF_STATUS cfr_enh_init_pdev(struct wlan_objmgr_psoc *psoc,
 	}
 
 	qdf_spinlock_create(&pcfr->lut_lock);
+	qdf_list_create(&pcfr->lut_age_list, pcfr->lut_num);
 
 	return status;
 }
@@ -2242,6 +2305,7 @@ QDF_STATUS cfr_enh_deinit_pdev(struct wlan_objmgr_psoc *psoc,
 {
 	QDF_STATUS status;
 	struct pdev_cfr *pcfr;
+	qdf_list_node_t *node;
 
 	pcfr = wlan_objmgr_pdev_get_comp_private_obj(pdev,
 						     WLAN_UMAC_COMP_CFR);
@@ -2269,6 +2333,8 @@ QDF_STATUS cfr_enh_deinit_pdev(struct wlan_objmgr_psoc *psoc,
 	pcfr->tx_peer_status_cfr_fail = 0;
 	pcfr->tx_evt_status_cfr_fail = 0;
 	pcfr->tx_dbr_cookie_lookup_fail = 0;
+	qdf_mem_zero(pcfr->capture_type_stats,
+		     sizeof(pcfr->capture_type_stats));
 	qdf_mem_zero(&pcfr->rcc_param, sizeof(struct cfr_rcc_param));
 	qdf_mem_zero(&pcfr->global, (sizeof(struct ta_ra_cfr_cfg) *
 				     MAX_TA_RA_ENTRIES));
@@ -2288,6 +2354,12 @@ QDF_STATUS cfr_enh_deinit_pdev(struct wlan_objmgr_psoc *psoc,
 	if (status != QDF_STATUS_SUCCESS)
 		cfr_err("Failed to unregister phase delta handler");
 
+	qdf_spin_lock_bh(&pcfr->lut_lock);
+	while (!qdf_list_empty(&pcfr->lut_age_list))
+		qdf_list_remove_front(&pcfr->lut_age_list, &node);
+	qdf_spin_unlock_bh(&pcfr->lut_lock);
+	qdf_list_destroy(&pcfr->lut_age_list);
+
 	qdf_spinlock_destroy(&pcfr->lut_lock);
 
 	return status;
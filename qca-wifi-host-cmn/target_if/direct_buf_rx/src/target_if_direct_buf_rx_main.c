@@ -1298,6 +1298,131 @@ static inline void target_if_dbr_qdf_show_ring_debug(
 }
 #endif /* DIRECT_BUF_RX_DEBUG */
 
+/**
+ * target_if_dbr_paddr_hash_idx() - Bucket of a buffer physical address
+ * @mod_param: Pointer to direct buf rx module param struct
+ * @paddr: Physical address of the buffer
+ *
+ * Buffer addresses share their low alignment bits, so a multiplicative
+ * hash is used and the top bits of the product select the bucket.
+ *
+ * Return: bucket index
+ */
+static inline uint32_t
+target_if_dbr_paddr_hash_idx(struct direct_buf_rx_module_param *mod_param,
+			     qdf_dma_addr_t paddr)
+{
+	return (uint32_t)(((uint64_t)paddr * 0x9E3779B97F4A7C15ULL) >>
+			  (64 - mod_param->paddr_hash_bits));
+}
+
+/**
+ * target_if_dbr_paddr_hash_init() - Allocate the paddr to cookie index
+ * @mod_param: Pointer to direct buf rx module param struct
+ * @num_entries: Number of buffers in the ring
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS
+target_if_dbr_paddr_hash_init(struct direct_buf_rx_module_param *mod_param,
+			      uint32_t num_entries)
+{
+	uint32_t idx, num_buckets;
+	uint8_t bits = 1;
+
+	while (bits < 31 && (1U << bits) < num_entries)
+		bits++;
+	num_buckets = 1U << bits;
+
+	mod_param->paddr_hash = qdf_mem_malloc(num_buckets *
+					       sizeof(*mod_param->paddr_hash));
+	if (!mod_param->paddr_hash)
+		return QDF_STATUS_E_NOMEM;
+
+	mod_param->paddr_hash_next =
+		qdf_mem_malloc(num_entries *
+			       sizeof(*mod_param->paddr_hash_next));
+	if (!mod_param->paddr_hash_next) {
+		qdf_mem_free(mod_param->paddr_hash);
+		mod_param->paddr_hash = NULL;
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	for (idx = 0; idx < num_buckets; idx++)
+		mod_param->paddr_hash[idx] = DBR_PADDR_HASH_INVALID;
+	for (idx = 0; idx < num_entries; idx++)
+		mod_param->paddr_hash_next[idx] = DBR_PADDR_HASH_INVALID;
+
+	mod_param->paddr_hash_bits = bits;
+	qdf_spinlock_create(&mod_param->paddr_hash_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * target_if_dbr_paddr_hash_deinit() - Free the paddr to cookie index
+ * @mod_param: Pointer to direct buf rx module param struct
+ *
+ * Return: None
+ */
+static void
+target_if_dbr_paddr_hash_deinit(struct direct_buf_rx_module_param *mod_param)
+{
+	if (!mod_param->paddr_hash)
+		return;
+
+	qdf_spinlock_destroy(&mod_param->paddr_hash_lock);
+	qdf_mem_free(mod_param->paddr_hash_next);
+	qdf_mem_free(mod_param->paddr_hash);
+	mod_param->paddr_hash_next = NULL;
+	mod_param->paddr_hash = NULL;
+}
+
+/**
+ * target_if_dbr_set_buf_paddr() - Update the physical address of a buffer
+ * @mod_param: Pointer to direct buf rx module param struct
+ * @cookie: Cookie of the buffer
+ * @paddr: New physical address of the buffer
+ *
+ * Moves the cookie from the bucket of its previous address to the bucket of
+ * @paddr. A cookie is present in the index if and only if its pool paddr is
+ * non-zero.
+ *
+ * Return: None
+ */
+static void
+target_if_dbr_set_buf_paddr(struct direct_buf_rx_module_param *mod_param,
+			    uint32_t cookie, qdf_dma_addr_t paddr)
+{
+	struct direct_buf_rx_buf_info *dbr_buf_pool = mod_param->dbr_buf_pool;
+	uint32_t *link;
+	uint32_t bucket;
+
+	qdf_spin_lock_bh(&mod_param->paddr_hash_lock);
+
+	if (dbr_buf_pool[cookie].paddr) {
+		bucket = target_if_dbr_paddr_hash_idx(
+				mod_param, dbr_buf_pool[cookie].paddr);
+		link = &mod_param->paddr_hash[bucket];
+		while (*link != DBR_PADDR_HASH_INVALID && *link != cookie)
+			link = &mod_param->paddr_hash_next[*link];
+		if (*link == cookie)
+			*link = mod_param->paddr_hash_next[cookie];
+		mod_param->paddr_hash_next[cookie] = DBR_PADDR_HASH_INVALID;
+	}
+
+	dbr_buf_pool[cookie].paddr = paddr;
+
+	if (paddr) {
+		bucket = target_if_dbr_paddr_hash_idx(mod_param, paddr);
+		mod_param->paddr_hash_next[cookie] =
+					mod_param->paddr_hash[bucket];
+		mod_param->paddr_hash[bucket] = cookie;
+	}
+
+	qdf_spin_unlock_bh(&mod_param->paddr_hash_lock);
+}
+
 static QDF_STATUS target_if_dbr_replenish_ring(struct wlan_objmgr_pdev *pdev,
 			struct direct_buf_rx_module_param *mod_param,
 			void *aligned_vaddr, uint32_t cookie)
@@ -1358,7 +1483,7 @@ static QDF_STATUS target_if_dbr_replenish_ring(struct wlan_objmgr_pdev *pdev,
 	}
 
 	QDF_ASSERT(!((uint64_t)paddr % dbr_ring_cap->min_buf_align));
-	dbr_buf_pool[cookie].paddr = paddr;
+	target_if_dbr_set_buf_paddr(mod_param, cookie, paddr);
 
 	hal_le_srng_access_start_in_cpu_order(hal_soc, srng);
 	ring_entry = hal_srng_src_get_next(hal_soc, srng);
@@ -1490,6 +1615,13 @@ static QDF_STATUS target_if_dbr_init_ring(struct wlan_objmgr_pdev *pdev,
 	if (!mod_param->dbr_buf_pool)
 		return QDF_STATUS_E_NOMEM;
 
+	if (QDF_IS_STATUS_ERROR(target_if_dbr_paddr_hash_init(mod_param,
+							      num_entries))) {
+		qdf_mem_free(mod_param->dbr_buf_pool);
+		mod_param->dbr_buf_pool = NULL;
+		return QDF_STATUS_E_NOMEM;
+	}
+
 	ring_alloc_size = (num_entries * entry_size) + DBR_RING_BASE_ALIGN - 1;
 	dbr_ring_cfg->ring_alloc_size = ring_alloc_size;
 	direct_buf_rx_debug("dbr_psoc_obj %pK", dbr_psoc_obj);
@@ -1500,6 +1632,7 @@ static QDF_STATUS target_if_dbr_init_ring(struct wlan_objmgr_pdev *pdev,
 	dbr_ring_cfg->base_paddr_unaligned = paddr;
 	if (!dbr_ring_cfg->base_vaddr_unaligned) {
 		direct_buf_rx_err("dir buf rx vaddr alloc failed");
+		target_if_dbr_paddr_hash_deinit(mod_param);
 		qdf_mem_free(mod_param->dbr_buf_pool);
 		return QDF_STATUS_E_NOMEM;
 	}
@@ -1521,6 +1654,7 @@ static QDF_STATUS target_if_dbr_init_ring(struct wlan_objmgr_pdev *pdev,
 
 	if (!srng) {
 		direct_buf_rx_err("srng setup failed");
+		target_if_dbr_paddr_hash_deinit(mod_param);
 		qdf_mem_free(mod_param->dbr_buf_pool);
 		qdf_mem_free_consistent(dbr_psoc_obj->osdev,
 					dbr_psoc_obj->osdev->dev,
@@ -1858,13 +1992,22 @@ QDF_STATUS target_if_dbr_cookie_lookup(struct wlan_objmgr_pdev *pdev,
 	dbr_ring_cfg = mod_param->dbr_ring_cfg;
 	dbr_buf_pool = mod_param->dbr_buf_pool;
 
-	for (idx = 0; idx < dbr_ring_cfg->num_ptr - 1; idx++) {
-		if (dbr_buf_pool[idx].paddr &&
+	if (!paddr || !mod_param->paddr_hash)
+		return QDF_STATUS_E_FAILURE;
+
+	qdf_spin_lock_bh(&mod_param->paddr_hash_lock);
+	idx = mod_param->paddr_hash[target_if_dbr_paddr_hash_idx(mod_param,
+								 paddr)];
+	while (idx != DBR_PADDR_HASH_INVALID) {
+		if (idx < dbr_ring_cfg->num_ptr - 1 &&
 		    dbr_buf_pool[idx].paddr == paddr) {
+			qdf_spin_unlock_bh(&mod_param->paddr_hash_lock);
 			*cookie = idx;
 			return QDF_STATUS_SUCCESS;
 		}
+		idx = mod_param->paddr_hash_next[idx];
 	}
+	qdf_spin_unlock_bh(&mod_param->paddr_hash_lock);
 
 	return QDF_STATUS_E_FAILURE;
 }
@@ -2310,6 +2453,7 @@ static QDF_STATUS target_if_dbr_deinit_srng(
 	dbr_buf_pool = mod_param->dbr_buf_pool;
 	direct_buf_rx_debug("dbr buf pool %pK", dbr_buf_pool);
 	target_if_dbr_deinit_ring(pdev, mod_param);
+	target_if_dbr_paddr_hash_deinit(mod_param);
 	if (mod_param->dbr_buf_pool)
 		qdf_mem_free(dbr_buf_pool);
 	mod_param->dbr_buf_pool = NULL;
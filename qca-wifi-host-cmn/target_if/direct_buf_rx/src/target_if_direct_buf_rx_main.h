@@ -29,6 +29,7 @@ struct wlan_lmac_if_tx_ops;
 struct direct_buf_rx_data;
 
 #define DBR_RING_BASE_ALIGN 8
+#define DBR_PADDR_HASH_INVALID 0xFFFFFFFF
 
 #ifdef DBR_MULTI_SRNG_ENABLE
 #define DBR_SRNG_NUM 2
@@ -175,6 +176,11 @@ struct direct_buf_rx_module_debug {
  * @dbr_ring_cap: Pointer to direct buf rx ring capabilities struct
  * @dbr_ring_cfg: Pointer to direct buf rx ring config struct
  * @dbr_buf_pool: Pointer to direct buf rx buffer pool struct
+ * @paddr_hash: Buckets of the physical address to cookie index, each holding
+ * the first cookie of its chain or DBR_PADDR_HASH_INVALID
+ * @paddr_hash_next: Next cookie in the chain, indexed by cookie
+ * @paddr_hash_bits: log2 of the number of buckets in @paddr_hash
+ * @paddr_hash_lock: Lock protecting @paddr_hash and the buffer pool paddrs
  * @dbr_rsp_handler: Pointer to direct buf rx response handler for the module
  */
 struct direct_buf_rx_module_param {
@@ -185,6 +191,10 @@ struct direct_buf_rx_module_param {
 	struct direct_buf_rx_ring_cap *dbr_ring_cap;
 	struct direct_buf_rx_ring_cfg *dbr_ring_cfg;
 	struct direct_buf_rx_buf_info *dbr_buf_pool;
+	uint32_t *paddr_hash;
+	uint32_t *paddr_hash_next;
+	uint8_t paddr_hash_bits;
+	qdf_spinlock_t paddr_hash_lock;
 	bool (*dbr_rsp_handler)(struct wlan_objmgr_pdev *pdev,
 				struct direct_buf_rx_data *dbr_data);
 };
@@ -2968,6 +2968,8 @@ spectral_is_session_info_expected_from_target(struct wlan_objmgr_pdev *pdev,
  *   - Read DWORDs one by one
  *   - Extract individual FFT bins out of it
  *   - Copy the FFT bin to destination buffer
+ * FFT bin widths of 1, 2 and 4 bytes are unpacked by loops specialized for
+ * the width and the power format, other widths fall back to a per bin loop.
  *
  * Return: QDF_STATUS_SUCCESS in case of success, else QDF_STATUS_E_FAILURE
  */
@@ -2978,5 +2980,25 @@ target_if_spectral_copy_fft_bins(struct target_if_spectral *spectral,
 				 uint32_t fft_bin_count,
 				 uint32_t *bytes_copied,
 				 uint16_t pwr_format);
+
+#ifdef WLAN_SPECTRAL_TEST
+/**
+ * target_if_spectral_copy_fft_bins_generic_test() - Copy FFT bins with the
+ * per bin reference loop of target_if_spectral_copy_fft_bins()
+ * @dword_ptr: Pointer to the DWORDs holding the FFT bins
+ * @fft_bin_buf: Pointer to destination FFT buffer
+ * @num_dwords: Number of DWORDs to unpack
+ * @hw_fft_bin_width: Width of an FFT bin in the source buffer (in bytes)
+ * @pwr_format: Spectral FFT bin format (linear/dBm mode)
+ *
+ * Return: void
+ */
+void
+target_if_spectral_copy_fft_bins_generic_test(const uint32_t *dword_ptr,
+					      uint8_t *fft_bin_buf,
+					      uint32_t num_dwords,
+					      uint8_t hw_fft_bin_width,
+					      uint16_t pwr_format);
+#endif /* WLAN_SPECTRAL_TEST */
 #endif /* WLAN_CONV_SPECTRAL_ENABLE */
 #endif /* _TARGET_IF_SPECTRAL_H_ */
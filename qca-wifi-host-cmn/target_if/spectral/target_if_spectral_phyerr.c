@@ -2175,6 +2175,160 @@ target_if_spectral_dump_phyerr_data_gen2(uint8_t *data, uint32_t datalen,
 	return 0;
 }
 
+/**
+ * target_if_spectral_copy_fft_bins_generic() - Copy FFT bins one at a time
+ * @dword_ptr: Pointer to the DWORDs holding the FFT bins
+ * @fft_bin_buf: Pointer to destination FFT buffer
+ * @num_dwords: Number of DWORDs to unpack
+ * @hw_fft_bin_width: Width of an FFT bin in the source buffer (in bytes)
+ * @pwr_format: Spectral FFT bin format (linear/dBm mode)
+ *
+ * Reference implementation which handles any bin width and power format.
+ * Only the lower 16 bits of a bin are extracted, as the bin value is 16 bits
+ * wide; this also keeps the mask of 32-bit bins well defined.
+ *
+ * Return: void
+ */
+static void
+target_if_spectral_copy_fft_bins_generic(const uint32_t *dword_ptr,
+					 uint8_t *fft_bin_buf,
+					 uint32_t num_dwords,
+					 uint8_t hw_fft_bin_width,
+					 uint16_t pwr_format)
+{
+	uint16_t idx, dword_idx, fft_bin_idx;
+	uint8_t num_bins_per_dword, hw_fft_bin_width_bits, fft_bin_val_bits;
+	uint16_t fft_bin_val;
+	uint32_t dword;
+
+	num_bins_per_dword = SPECTRAL_DWORD_SIZE / hw_fft_bin_width;
+	hw_fft_bin_width_bits = hw_fft_bin_width * QDF_CHAR_BIT;
+	fft_bin_val_bits = qdf_min(hw_fft_bin_width_bits,
+				   (uint8_t)(sizeof(fft_bin_val) * QDF_CHAR_BIT));
+
+	fft_bin_idx = 0;
+	for (dword_idx = 0; dword_idx < num_dwords; dword_idx++) {
+		dword = *dword_ptr++; /* Read a DWORD */
+		for (idx = 0; idx < num_bins_per_dword; idx++) {
+			fft_bin_val = (uint16_t)QDF_GET_BITS(
+					dword,
+					idx * hw_fft_bin_width_bits,
+					fft_bin_val_bits);
+
+			fft_bin_buf[fft_bin_idx++] =
+				clamp_fft_bin_value(fft_bin_val, pwr_format);
+		}
+	}
+}
+
+/**
+ * target_if_spectral_copy_8bit_fft_bins() - Copy FFT bins reported in 8 bits
+ * @dword_ptr: Pointer to the DWORDs holding the FFT bins
+ * @fft_bin_buf: Pointer to destination FFT buffer
+ * @num_dwords: Number of DWORDs to unpack
+ * @pwr_format: Spectral FFT bin format (linear/dBm mode)
+ *
+ * Four bins are packed in every DWORD. In linear mode the bins need no
+ * clamping, so on little-endian hosts the DWORDs are copied as is. In dBm
+ * mode the bins with the MSB set exceed S8_MAX and saturate to S8_MAX; this
+ * is done for all four bins of a DWORD at once.
+ *
+ * Return: void
+ */
+static void
+target_if_spectral_copy_8bit_fft_bins(const uint32_t *dword_ptr,
+				      uint8_t *fft_bin_buf,
+				      uint32_t num_dwords,
+				      uint16_t pwr_format)
+{
+	uint32_t dword_idx;
+	uint32_t dword;
+	uint32_t msb;
+	uint32_t sat;
+
+#ifndef BIG_ENDIAN_HOST
+	if (pwr_format == SPECTRAL_PWR_FORMAT_LINEAR) {
+		qdf_mem_copy(fft_bin_buf, dword_ptr,
+			     num_dwords * SPECTRAL_DWORD_SIZE);
+		return;
+	}
+#endif /* BIG_ENDIAN_HOST */
+
+	for (dword_idx = 0; dword_idx < num_dwords; dword_idx++) {
+		dword = *dword_ptr++;
+
+		if (pwr_format == SPECTRAL_PWR_FORMAT_DBM) {
+			msb = dword & 0x80808080;
+			/* 0x7f in every byte which has the MSB set */
+			sat = msb - (msb >> 7);
+			dword = (dword & ~(msb | sat)) | sat;
+		}
+
+		*fft_bin_buf++ = dword & 0xff;
+		*fft_bin_buf++ = (dword >> 8) & 0xff;
+		*fft_bin_buf++ = (dword >> 16) & 0xff;
+		*fft_bin_buf++ = (dword >> 24) & 0xff;
+	}
+}
+
+/**
+ * target_if_spectral_copy_16bit_fft_bins() - Copy FFT bins reported in 16 or
+ * 32 bits
+ * @dword_ptr: Pointer to the DWORDs holding the FFT bins
+ * @fft_bin_buf: Pointer to destination FFT buffer
+ * @num_dwords: Number of DWORDs to unpack
+ * @num_bins_per_dword: Number of FFT bins in a DWORD (1 or 2)
+ * @pwr_format: Spectral FFT bin format (linear/dBm mode)
+ *
+ * Only the lower 16 bits of a bin carry the value. The power format is
+ * resolved once for the whole buffer instead of once per bin.
+ *
+ * Return: void
+ */
+static void
+target_if_spectral_copy_16bit_fft_bins(const uint32_t *dword_ptr,
+				       uint8_t *fft_bin_buf,
+				       uint32_t num_dwords,
+				       uint8_t num_bins_per_dword,
+				       uint16_t pwr_format)
+{
+	uint32_t dword_idx;
+	uint32_t dword;
+	uint16_t lo, hi;
+	int16_t slo, shi;
+
+	if (pwr_format == SPECTRAL_PWR_FORMAT_LINEAR) {
+		for (dword_idx = 0; dword_idx < num_dwords; dword_idx++) {
+			dword = *dword_ptr++;
+			lo = dword & 0xffff;
+			*fft_bin_buf++ = qdf_min(lo, (uint16_t)
+						 MAX_FFTBIN_VALUE_LINEAR_MODE);
+			if (num_bins_per_dword == 1)
+				continue;
+
+			hi = dword >> 16;
+			*fft_bin_buf++ = qdf_min(hi, (uint16_t)
+						 MAX_FFTBIN_VALUE_LINEAR_MODE);
+		}
+		return;
+	}
+
+	for (dword_idx = 0; dword_idx < num_dwords; dword_idx++) {
+		dword = *dword_ptr++;
+		slo = (int16_t)(dword & 0xffff);
+		slo = qdf_max(qdf_min(slo, (int16_t)MAX_FFTBIN_VALUE_DBM_MODE),
+			      (int16_t)MIN_FFTBIN_VALUE_DBM_MODE);
+		*fft_bin_buf++ = (uint8_t)slo;
+		if (num_bins_per_dword == 1)
+			continue;
+
+		shi = (int16_t)(dword >> 16);
+		shi = qdf_max(qdf_min(shi, (int16_t)MAX_FFTBIN_VALUE_DBM_MODE),
+			      (int16_t)MIN_FFTBIN_VALUE_DBM_MODE);
+		*fft_bin_buf++ = (uint8_t)shi;
+	}
+}
+
 QDF_STATUS
 target_if_spectral_copy_fft_bins(struct target_if_spectral *spectral,
 				 const void *src_fft_buf,
@@ -2183,14 +2337,12 @@ target_if_spectral_copy_fft_bins(struct target_if_spectral *spectral,
 				 uint32_t *bytes_copied,
 				 uint16_t pwr_format)
 {
-	uint16_t idx, dword_idx, fft_bin_idx;
-	uint8_t num_bins_per_dword, hw_fft_bin_width_bits;
+	uint8_t num_bins_per_dword;
 	uint32_t num_dwords;
-	uint16_t fft_bin_val;
 	struct spectral_report_params *rparams;
 	const uint32_t *dword_ptr;
-	uint32_t dword;
 	uint8_t *fft_bin_buf;
+	bool is_known_format;
 
 	*bytes_copied = 0;
 
@@ -2212,29 +2364,45 @@ target_if_spectral_copy_fft_bins(struct target_if_spectral *spectral,
 	rparams = &spectral->rparams;
 	num_bins_per_dword = SPECTRAL_DWORD_SIZE / rparams->hw_fft_bin_width;
 	num_dwords = fft_bin_count / num_bins_per_dword;
-	hw_fft_bin_width_bits = rparams->hw_fft_bin_width * QDF_CHAR_BIT;
 
-	fft_bin_idx = 0;
 	dword_ptr = src_fft_buf;
 	fft_bin_buf = dest_fft_buf;
-	for (dword_idx = 0; dword_idx < num_dwords; dword_idx++) {
-		dword = *dword_ptr++; /* Read a DWORD */
-		for (idx = 0; idx < num_bins_per_dword; idx++) {
-			fft_bin_val = (uint16_t)QDF_GET_BITS(
-					dword,
-					idx * hw_fft_bin_width_bits,
-					hw_fft_bin_width_bits);
-
-			fft_bin_buf[fft_bin_idx++] =
-				clamp_fft_bin_value(fft_bin_val, pwr_format);
-		}
-	}
+	is_known_format = pwr_format == SPECTRAL_PWR_FORMAT_LINEAR ||
+			  pwr_format == SPECTRAL_PWR_FORMAT_DBM;
+
+	if (is_known_format && rparams->hw_fft_bin_width == 1)
+		target_if_spectral_copy_8bit_fft_bins(dword_ptr, fft_bin_buf,
+						      num_dwords, pwr_format);
+	else if (is_known_format && (rparams->hw_fft_bin_width == 2 ||
+				     rparams->hw_fft_bin_width == 4))
+		target_if_spectral_copy_16bit_fft_bins(dword_ptr, fft_bin_buf,
+						       num_dwords,
+						       num_bins_per_dword,
+						       pwr_format);
+	else
+		target_if_spectral_copy_fft_bins_generic(
+				dword_ptr, fft_bin_buf, num_dwords,
+				rparams->hw_fft_bin_width, pwr_format);
 
 	*bytes_copied = num_dwords *  SPECTRAL_DWORD_SIZE;
 
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_SPECTRAL_TEST
+void
+target_if_spectral_copy_fft_bins_generic_test(const uint32_t *dword_ptr,
+					      uint8_t *fft_bin_buf,
+					      uint32_t num_dwords,
+					      uint8_t hw_fft_bin_width,
+					      uint16_t pwr_format)
+{
+	target_if_spectral_copy_fft_bins_generic(dword_ptr, fft_bin_buf,
+						 num_dwords, hw_fft_bin_width,
+						 pwr_format);
+}
+#endif /* WLAN_SPECTRAL_TEST */
+
 #ifdef DIRECT_BUF_RX_ENABLE
 /**
  * target_if_get_spectral_mode() - Get Spectral scan mode corresponding to a
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <qdf_mem.h>
+#include <qdf_time.h>
+#include <qdf_trace.h>
+#include <qdf_types.h>
+#include <qdf_util.h>
+#include <target_if_spectral.h>
+#include "target_if_spectral_test.h"
+
+/* Most DWORDs unpacked in one copy, more than a 320 MHz report holds */
+#define SPECTRAL_UT_MAX_DWORDS 512
+
+/* Spare bytes at the end of the destination, to catch an overrun */
+#define SPECTRAL_UT_GUARD_LEN 8
+
+/* Largest offset of the destination, covers all store alignments */
+#define SPECTRAL_UT_MAX_OFF 3
+
+#define SPECTRAL_UT_BUF_LEN (SPECTRAL_UT_MAX_DWORDS * SPECTRAL_DWORD_SIZE + \
+			     SPECTRAL_UT_MAX_OFF + SPECTRAL_UT_GUARD_LEN)
+
+#define SPECTRAL_UT_CANARY 0xa5
+
+/* Number of random reports checked against the reference */
+#define SPECTRAL_UT_RUNS 2000
+
+/* Reports copied per bin width and power format by the benchmark */
+#define SPECTRAL_UT_BENCH_REPORTS 5000
+
+static const uint8_t spectral_ut_widths[] = { 1, 2, 4 };
+
+static const uint16_t spectral_ut_formats[] = {
+	SPECTRAL_PWR_FORMAT_LINEAR,
+	SPECTRAL_PWR_FORMAT_DBM,
+};
+
+static uint32_t spectral_ut_src[SPECTRAL_UT_MAX_DWORDS];
+static uint8_t spectral_ut_dest[SPECTRAL_UT_BUF_LEN];
+static uint8_t spectral_ut_ref[SPECTRAL_UT_BUF_LEN];
+
+static uint32_t spectral_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static uint32_t spectral_ut_rand32(uint64_t *seed)
+{
+	return (spectral_ut_rand(seed, 1 << 16) << 16) |
+		spectral_ut_rand(seed, 1 << 16);
+}
+
+/**
+ * spectral_ut_check() - Compare target_if_spectral_copy_fft_bins() with the
+ *	per bin reference loop on the bins in spectral_ut_src
+ * @spectral: Spectral LMAC object, only the FFT bin width is used
+ * @fft_bin_count: Number of FFT bins to copy
+ * @pwr_format: Spectral FFT bin format (linear/dBm mode)
+ * @off: offset of the FFT bins in the destination buffer
+ *
+ * Both destination buffers are filled with a canary first and compared
+ * whole, so a byte written by only one of the copies is caught as well.
+ *
+ * Return: number of errors
+ */
+static uint32_t spectral_ut_check(struct target_if_spectral *spectral,
+				  uint32_t fft_bin_count, uint16_t pwr_format,
+				  uint32_t off)
+{
+	uint8_t width = spectral->rparams.hw_fft_bin_width;
+	uint32_t num_bins_per_dword = SPECTRAL_DWORD_SIZE / width;
+	uint32_t num_dwords = fft_bin_count / num_bins_per_dword;
+	uint32_t num_bins = num_dwords * num_bins_per_dword;
+	uint32_t bytes_copied;
+	QDF_STATUS status;
+	uint32_t i;
+
+	qdf_mem_set(spectral_ut_dest, sizeof(spectral_ut_dest),
+		    SPECTRAL_UT_CANARY);
+	qdf_mem_set(spectral_ut_ref, sizeof(spectral_ut_ref),
+		    SPECTRAL_UT_CANARY);
+
+	status = target_if_spectral_copy_fft_bins(spectral, spectral_ut_src,
+						  spectral_ut_dest + off,
+						  fft_bin_count, &bytes_copied,
+						  pwr_format);
+	target_if_spectral_copy_fft_bins_generic_test(spectral_ut_src,
+						      spectral_ut_ref + off,
+						      num_dwords, width,
+						      pwr_format);
+
+	if (QDF_IS_STATUS_ERROR(status) ||
+	    bytes_copied != num_dwords * SPECTRAL_DWORD_SIZE) {
+		qdf_nofl_alert("FAIL: width %u format %u bins %u -> status %d bytes copied %u",
+			       width, pwr_format, fft_bin_count, status,
+			       bytes_copied);
+		return 1;
+	}
+
+	for (i = off + num_bins; i < sizeof(spectral_ut_dest); i++) {
+		if (spectral_ut_dest[i] != SPECTRAL_UT_CANARY) {
+			qdf_nofl_alert("FAIL: width %u format %u bins %u off %u -> overrun at byte %u",
+				       width, pwr_format, fft_bin_count, off,
+				       i - off);
+			return 1;
+		}
+	}
+
+	for (i = 0; i < sizeof(spectral_ut_dest); i++) {
+		if (spectral_ut_dest[i] != spectral_ut_ref[i]) {
+			qdf_nofl_alert("FAIL: width %u format %u bins %u off %u -> byte %u is 0x%02x, expected 0x%02x",
+				       width, pwr_format, fft_bin_count, off,
+				       i, spectral_ut_dest[i],
+				       spectral_ut_ref[i]);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * spectral_ut_fill() - Fill spectral_ut_src with consecutive bin values
+ * @width: FFT bin width in bytes
+ * @val: value of the first bin
+ * @seed: random seed for the bits above the lower 16 bits of 32-bit bins
+ *
+ * Return: value of the bin following the last one filled
+ */
+static uint32_t spectral_ut_fill(uint8_t width, uint32_t val, uint64_t *seed)
+{
+	uint32_t num_bins_per_dword = SPECTRAL_DWORD_SIZE / width;
+	uint32_t bin_bits = width * QDF_CHAR_BIT;
+	uint32_t bin_mask = width == 1 ? 0xff : 0xffff;
+	uint32_t dword_idx, idx, dword;
+
+	for (dword_idx = 0; dword_idx < SPECTRAL_UT_MAX_DWORDS; dword_idx++) {
+		dword = 0;
+		for (idx = 0; idx < num_bins_per_dword; idx++)
+			dword |= (val++ & bin_mask) << (idx * bin_bits);
+		if (width == 4)
+			dword |= spectral_ut_rand32(seed) & ~bin_mask;
+		spectral_ut_src[dword_idx] = dword;
+	}
+
+	return val;
+}
+
+/**
+ * spectral_ut_sweep() - Cross-check every value an FFT bin can carry
+ * @spectral: Spectral LMAC object
+ * @seed: random seed
+ *
+ * The bins take every 8-bit value for 8-bit bins and every 16-bit value for
+ * wider bins, in both power formats, so each clamp boundary is hit.
+ *
+ * Return: number of errors
+ */
+static uint32_t spectral_ut_sweep(struct target_if_spectral *spectral,
+				  uint64_t *seed)
+{
+	uint32_t num_bins_per_dword, num_vals, val;
+	uint32_t errors = 0;
+	uint8_t width;
+	uint32_t w, f;
+
+	for (w = 0; w < QDF_ARRAY_SIZE(spectral_ut_widths); w++) {
+		width = spectral_ut_widths[w];
+		spectral->rparams.hw_fft_bin_width = width;
+		num_bins_per_dword = SPECTRAL_DWORD_SIZE / width;
+		num_vals = width == 1 ? 1 << 8 : 1 << 16;
+
+		for (f = 0; f < QDF_ARRAY_SIZE(spectral_ut_formats); f++) {
+			for (val = 0; val < num_vals;) {
+				val = spectral_ut_fill(width, val, seed);
+				errors += spectral_ut_check(
+					spectral,
+					SPECTRAL_UT_MAX_DWORDS *
+					num_bins_per_dword,
+					spectral_ut_formats[f], 0);
+			}
+		}
+	}
+
+	return errors;
+}
+
+/**
+ * spectral_ut_random() - Cross-check random reports with the reference
+ * @spectral: Spectral LMAC object
+ * @seed: random seed
+ *
+ * Random bins, bin widths, power formats and destination alignments. The
+ * bin count is not always a multiple of the bins in a DWORD, in which case
+ * only the whole DWORDs are copied.
+ *
+ * Return: number of errors
+ */
+static uint32_t spectral_ut_random(struct target_if_spectral *spectral,
+				   uint64_t *seed)
+{
+	uint32_t num_bins_per_dword, fft_bin_count;
+	uint32_t errors = 0;
+	uint16_t pwr_format;
+	uint32_t run, i;
+	uint32_t off;
+
+	for (run = 0; run < SPECTRAL_UT_RUNS; run++) {
+		spectral->rparams.hw_fft_bin_width = spectral_ut_widths[
+			spectral_ut_rand(seed,
+					 QDF_ARRAY_SIZE(spectral_ut_widths))];
+		pwr_format = spectral_ut_formats[
+			spectral_ut_rand(seed,
+					 QDF_ARRAY_SIZE(spectral_ut_formats))];
+		num_bins_per_dword = SPECTRAL_DWORD_SIZE /
+				     spectral->rparams.hw_fft_bin_width;
+		fft_bin_count = spectral_ut_rand(seed,
+						 SPECTRAL_UT_MAX_DWORDS *
+						 num_bins_per_dword + 1);
+		off = spectral_ut_rand(seed, SPECTRAL_UT_MAX_OFF + 1);
+
+		for (i = 0; i < SPECTRAL_UT_MAX_DWORDS; i++)
+			spectral_ut_src[i] = spectral_ut_rand32(seed);
+
+		errors += spectral_ut_check(spectral, fft_bin_count,
+					    pwr_format, off);
+	}
+
+	return errors;
+}
+
+/**
+ * spectral_ut_reports_per_sec() - Report rate of a benchmark
+ * @reports: Number of reports copied
+ * @elapsed_ns: Time taken
+ *
+ * Return: reports per second
+ */
+static uint64_t spectral_ut_reports_per_sec(uint32_t reports,
+					    uint64_t elapsed_ns)
+{
+	uint32_t elapsed_us = qdf_do_div(elapsed_ns, 1000);
+
+	return qdf_do_div((uint64_t)reports * 1000000, QDF_MAX(elapsed_us, 1));
+}
+
+/**
+ * spectral_ut_bench() - Benchmark the FFT bin copy against the per bin loop
+ * @spectral: Spectral LMAC object
+ * @seed: random seed
+ *
+ * Copies a report of SPECTRAL_UT_MAX_DWORDS DWORDs of random bins, once
+ * with target_if_spectral_copy_fft_bins() and once with the per bin
+ * reference loop, for every bin width and power format. The rate of each
+ * is reported in reports per second.
+ *
+ * Return: number of errors
+ */
+static uint32_t spectral_ut_bench(struct target_if_spectral *spectral,
+				  uint64_t *seed)
+{
+	uint32_t fft_bin_count, bytes_copied;
+	uint64_t start_ns, elapsed_ns, ref_elapsed_ns;
+	uint16_t pwr_format;
+	QDF_STATUS status;
+	uint8_t width;
+	uint32_t w, f, i;
+
+	for (i = 0; i < SPECTRAL_UT_MAX_DWORDS; i++)
+		spectral_ut_src[i] = spectral_ut_rand32(seed);
+
+	for (w = 0; w < QDF_ARRAY_SIZE(spectral_ut_widths); w++) {
+		width = spectral_ut_widths[w];
+		spectral->rparams.hw_fft_bin_width = width;
+		fft_bin_count = SPECTRAL_UT_MAX_DWORDS *
+				(SPECTRAL_DWORD_SIZE / width);
+
+		for (f = 0; f < QDF_ARRAY_SIZE(spectral_ut_formats); f++) {
+			pwr_format = spectral_ut_formats[f];
+
+			start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+			for (i = 0; i < SPECTRAL_UT_BENCH_REPORTS; i++) {
+				status = target_if_spectral_copy_fft_bins(
+						spectral, spectral_ut_src,
+						spectral_ut_dest,
+						fft_bin_count, &bytes_copied,
+						pwr_format);
+				if (QDF_IS_STATUS_ERROR(status)) {
+					qdf_nofl_alert("FAIL: width %u format %u -> status %d",
+						       width, pwr_format,
+						       status);
+					return 1;
+				}
+			}
+			elapsed_ns = qdf_ktime_to_ns(qdf_ktime_get()) -
+				     start_ns;
+
+			start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+			for (i = 0; i < SPECTRAL_UT_BENCH_REPORTS; i++)
+				target_if_spectral_copy_fft_bins_generic_test(
+					spectral_ut_src, spectral_ut_ref,
+					SPECTRAL_UT_MAX_DWORDS, width,
+					pwr_format);
+			ref_elapsed_ns = qdf_ktime_to_ns(qdf_ktime_get()) -
+					 start_ns;
+
+			qdf_nofl_info("spectral fft bin copy: width %u format %u, %u bins, %llu reports/s, per bin loop %llu reports/s",
+				      width, pwr_format, fft_bin_count,
+				      spectral_ut_reports_per_sec(
+					SPECTRAL_UT_BENCH_REPORTS,
+					elapsed_ns),
+				      spectral_ut_reports_per_sec(
+					SPECTRAL_UT_BENCH_REPORTS,
+					ref_elapsed_ns));
+		}
+	}
+
+	return 0;
+}
+
+uint32_t target_if_spectral_unit_test(void)
+{
+	struct target_if_spectral *spectral;
+	uint64_t seed = 0x66667462;
+	uint32_t errors = 0;
+
+	spectral = qdf_mem_malloc(sizeof(*spectral));
+	if (!spectral)
+		return 1;
+
+	errors += spectral_ut_sweep(spectral, &seed);
+	errors += spectral_ut_random(spectral, &seed);
+	if (!errors)
+		errors += spectral_ut_bench(spectral, &seed);
+	qdf_mem_free(spectral);
+	QDF_BUG(!errors);
+
+	return errors;
+}
@@ -230,9 +230,14 @@ wlan_cfr_pdev_obj_create_handler(struct wlan_objmgr_pdev *pdev, void *arg)
 		qdf_mem_free(pa);
 		return QDF_STATUS_E_NOMEM;
 	}
-	for (idx = 0; idx < pa->lut_num; idx++)
+	for (idx = 0; idx < pa->lut_num; idx++) {
 		pa->lut[idx] = (struct look_up_table *)qdf_mem_malloc(
 			sizeof(struct look_up_table));
+		if (!pa->lut[idx])
+			continue;
+		pa->lut[idx]->cookie = idx;
+		qdf_init_list_head(&pa->lut[idx]->age_node);
+	}
 
 	cfr_wakelock_init(pa);
 	wlan_objmgr_pdev_component_obj_attach(pdev, WLAN_UMAC_COMP_CFR,
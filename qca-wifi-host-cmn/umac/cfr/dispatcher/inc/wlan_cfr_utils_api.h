@@ -23,6 +23,7 @@
 
 #include <wlan_objmgr_cmn.h>
 #include <qdf_streamfs.h>
+#include <qdf_list.h>
 #ifdef WLAN_ENH_CFR_ENABLE
 #include <qdf_timer.h>
 #endif
@@ -359,6 +360,9 @@ struct whal_cfir_dma_hdr {
  * dbr_tstamp: Timestamp when DBR completion event was received
  * header_length: Length of header DMAed by ucode in words
  * payload_length: Length of CFR payload
+ * cookie: Index of this entry in the lookup table
+ * age_node: Node in the age ordered list of entries holding a DBR event
+ * without its TXRX event
  */
 struct look_up_table {
 	bool dbr_recv;
@@ -376,6 +380,27 @@ struct look_up_table {
 	uint64_t dbr_tstamp;
 	uint32_t header_length;
 	uint32_t payload_length;
+	uint32_t cookie;
+	qdf_list_node_t age_node;
+};
+
+/* Stats slot for CFR_TYPE_METHOD_AUTO and unknown capture types */
+#define CFR_CAPTURE_TYPE_STATS_OTHER CFR_TYPE_METHOD_LAST_VALID
+#define CFR_CAPTURE_TYPE_STATS_MAX (CFR_TYPE_METHOD_LAST_VALID + 1)
+
+/**
+ * struct cfr_capture_type_stats - Throughput of correlated CFR captures of
+ * one capture type
+ * release_cnt: No. of correlated captures relayed to userspace
+ * release_bytes: No. of CFR data bytes relayed to userspace
+ * first_tstamp: Time in ms of the first relayed capture
+ * last_tstamp: Time in ms of the latest relayed capture
+ */
+struct cfr_capture_type_stats {
+	uint64_t release_cnt;
+	uint64_t release_bytes;
+	uint64_t first_tstamp;
+	uint64_t last_tstamp;
 };
 
 struct unassoc_pool_entry {
@@ -552,6 +577,8 @@ struct nl_event_cb {
  * global: Structure to store accumulated CFR config
  * rx_tlv_evt_cnt: Number of CFR WDI events from datapath
  * lut_age_timer: Timer to flush pending TXRX/DBR events in lookup table
+ * lut_age_list: Lookup table entries holding a DBR event without its TXRX
+ * event, oldest DBR event first
  * lut_timer_init: flag to determine if lut_age_timer is initialized or not
  * is_cfr_rcc_capable: Flag to determine if RCC is enabled or not.
  * flush_dbr_cnt: No. of un-correlated DBR completions flushed when a newer PPDU
@@ -567,6 +594,7 @@ struct nl_event_cb {
  * is_mo_marking_support: flag to determine if MO marking is supported or not
  * is_aoa_for_rcc_support: flag to determine if AoA is available for RCC or not
  * capture_count and capture_duration modes with a nob provided to configure.
+ * capture_type_stats: Throughput of relayed captures per capture type
  * unassoc_pool: Pool of un-associated clients used when capture method is
  * CFR_CAPTURE_METHOD_PROBE_RESPONSE
  * nl_cb: call back to register for nl event for cfr data
@@ -614,6 +642,7 @@ struct pdev_cfr {
 	struct ta_ra_cfr_cfg global[MAX_TA_RA_ENTRIES];
 	uint64_t rx_tlv_evt_cnt;
 	qdf_timer_t lut_age_timer;
+	qdf_list_t lut_age_list;
 	uint8_t lut_timer_init;
 	uint8_t is_cfr_rcc_capable;
 	uint64_t flush_dbr_cnt;
@@ -625,6 +654,8 @@ struct pdev_cfr {
 	uint8_t is_cap_interval_mode_sel_support;
 	uint8_t is_mo_marking_support;
 	uint8_t is_aoa_for_rcc_support;
+	struct cfr_capture_type_stats
+		capture_type_stats[CFR_CAPTURE_TYPE_STATS_MAX];
 #endif
 	struct unassoc_pool_entry unassoc_pool[MAX_CFR_ENABLED_CLIENTS];
 	struct nl_event_cb nl_cb;
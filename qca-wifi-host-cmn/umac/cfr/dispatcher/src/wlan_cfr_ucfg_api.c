@@ -23,6 +23,7 @@
 #include <wlan_objmgr_peer_obj.h>
 #include <wlan_objmgr_pdev_obj.h>
 #include <qdf_module.h>
+#include <qdf_util.h>
 #ifdef WLAN_ENH_CFR_ENABLE
 #include "cdp_txrx_ctrl.h"
 #endif
@@ -1028,6 +1029,72 @@ char *mac_freeze_reason_to_str(enum mac_freeze_capture_reason type)
 	}
 }
 
+static const char *cfr_capture_type_to_str(uint8_t type)
+{
+	switch (type) {
+	case CFR_TYPE_METHOD_NULL_FRAME:
+		return "NULL_FRAME";
+	case CFR_TYPE_METHOD_NULL_FRAME_WITH_PHASE:
+		return "NULL_FRAME_WITH_PHASE";
+	case CFR_TYPE_METHOD_PROBE_RESP:
+		return "PROBE_RESP";
+	case CFR_TYPE_METHOD_TM:
+		return "TM";
+	case CFR_TYPE_METHOD_FTM:
+		return "FTM";
+	case CFR_TYPE_METHOD_ACK_RESP_TO_TM_FTM:
+		return "ACK_RESP_TO_TM_FTM";
+	case CFR_TYPE_METHOD_TA_RA_TYPE_FILTER:
+		return "TA_RA_TYPE_FILTER";
+	case CFR_TYPE_METHOD_NDPA_NDP:
+		return "NDPA_NDP";
+	case CFR_TYPE_METHOD_ALL_PACKET:
+		return "ALL_PACKET";
+	default:
+		return "OTHER";
+	}
+}
+
+/**
+ * cfr_dump_capture_type_stats() - Print throughput of relayed captures per
+ * capture type
+ * @pcfr: pointer to pdev cfr object
+ *
+ * Rates are averaged between the first and the latest relayed capture of
+ * each type.
+ *
+ * Return: None
+ */
+static void cfr_dump_capture_type_stats(struct pdev_cfr *pcfr)
+{
+	struct cfr_capture_type_stats *stats;
+	uint64_t duration_ms, captures_ps, bytes_ps;
+	uint8_t type;
+
+	cfr_err("Throughput per capture type:\n");
+	for (type = 0; type < CFR_CAPTURE_TYPE_STATS_MAX; type++) {
+		stats = &pcfr->capture_type_stats[type];
+		if (!stats->release_cnt)
+			continue;
+
+		captures_ps = 0;
+		bytes_ps = 0;
+		duration_ms = stats->last_tstamp - stats->first_tstamp;
+		if (duration_ms && duration_ms <= UINT_MAX) {
+			captures_ps = qdf_do_div(stats->release_cnt * 1000,
+						 (uint32_t)duration_ms);
+			bytes_ps = qdf_do_div(stats->release_bytes * 1000,
+					      (uint32_t)duration_ms);
+		}
+
+		cfr_err("%s: release_cnt = %llu release_bytes = %llu "
+			"duration = %llu ms captures/s = %llu bytes/s = %llu\n",
+			cfr_capture_type_to_str(type), stats->release_cnt,
+			stats->release_bytes, duration_ms, captures_ps,
+			bytes_ps);
+	}
+}
+
 QDF_STATUS ucfg_cfr_rcc_dump_dbg_counters(struct wlan_objmgr_vdev *vdev)
 {
 	struct pdev_cfr *pcfr = NULL;
@@ -1074,6 +1141,7 @@ QDF_STATUS ucfg_cfr_rcc_dump_dbg_counters(struct wlan_objmgr_vdev *vdev)
 		pcfr->clear_txrx_event);
 	cfr_err("cfr_dma_aborts = %llu\n",
 		pcfr->cfr_dma_aborts);
+	cfr_dump_capture_type_stats(pcfr);
 
 	cfr_rcc_stats = qdf_mem_malloc(sizeof(struct cdp_cfr_rcc_stats));
 	if (!cfr_rcc_stats) {
@@ -1144,6 +1212,8 @@ QDF_STATUS ucfg_cfr_rcc_clr_dbg_counters(struct wlan_objmgr_vdev *vdev)
 	pcfr->tx_peer_status_cfr_fail = 0;
 	pcfr->tx_evt_status_cfr_fail = 0;
 	pcfr->tx_dbr_cookie_lookup_fail = 0;
+	qdf_mem_zero(pcfr->capture_type_stats,
+		     sizeof(pcfr->capture_type_stats));
 	wlan_objmgr_pdev_release_ref(pdev, WLAN_CFR_ID);
 
 	return status;
@@ -160,6 +160,12 @@ mgmt_rx_reo_handle_stale_frame(struct mgmt_rx_reo_list *reo_list,
 {
 	return QDF_STATUS_SUCCESS;
 }
+
+static inline void
+mgmt_rx_reo_sim_record_delivery(struct mgmt_rx_reo_context *reo_context,
+				const struct mgmt_rx_reo_list_entry *entry)
+{
+}
 #else
 /**
  * mgmt_rx_reo_sim_get_num_mlo_links() - Get number of MLO HW links from the reo
@@ -450,6 +456,34 @@ mgmt_rx_reo_handle_stale_frame(struct mgmt_rx_reo_list *reo_list,
 
 	return status;
 }
+/**
+ * mgmt_rx_reo_sim_record_delivery() - Update the simulation performance
+ * statistics when a frame is delivered to the upper layers
+ * @reo_context: Pointer to reo context
+ * @entry: Reorder list entry of the frame being delivered
+ *
+ * This API is called with the frame release lock held, so the statistics
+ * need no additional protection.
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_sim_record_delivery(struct mgmt_rx_reo_context *reo_context,
+				const struct mgmt_rx_reo_list_entry *entry)
+{
+	struct mgmt_rx_reo_sim_perf_stats *perf_stats;
+	uint64_t latency_us;
+
+	perf_stats = &reo_context->sim_context.perf_stats;
+
+	latency_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() -
+						entry->ingress_timestamp);
+
+	perf_stats->num_frames_delivered++;
+	perf_stats->latency_sum_us += latency_us;
+	perf_stats->latency_max_us = qdf_max(perf_stats->latency_max_us,
+					     latency_us);
+}
 #endif /* WLAN_MGMT_RX_REO_SIM_SUPPORT */
 
 /**
@@ -823,6 +857,269 @@ update_pending_frames:
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * mgmt_rx_reo_tree_get_priority() - Generate the heap priority for a new
+ * entry in the reorder treap
+ * @reo_list: Pointer to reorder list
+ *
+ * Return: Pseudo random priority value
+ */
+static inline uint32_t
+mgmt_rx_reo_tree_get_priority(struct mgmt_rx_reo_list *reo_list)
+{
+	uint32_t seed = reo_list->tree_seed;
+
+	/* xorshift32 */
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	reo_list->tree_seed = seed;
+
+	return seed;
+}
+
+/**
+ * mgmt_rx_reo_wait_count_update_compose() - Append a wait count update to
+ * an update which is already pending
+ * @update: Pointer to the pending update
+ * @next: Pointer to the update to be applied after @update
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_wait_count_update_compose(
+		struct mgmt_rx_reo_wait_count_update *update,
+		const struct mgmt_rx_reo_wait_count_update *next)
+{
+	uint8_t link_id;
+
+	if (!update->pending) {
+		*update = *next;
+		return;
+	}
+
+	for (link_id = 0; link_id < MGMT_RX_REO_MAX_LINKS; link_id++) {
+		unsigned int cap = update->cap[link_id];
+
+		if (cap != MGMT_RX_REO_WAIT_COUNT_NO_CAP)
+			cap = cap > next->dec[link_id] ?
+			      cap - next->dec[link_id] : 0;
+
+		update->cap[link_id] = qdf_min(cap, next->cap[link_id]);
+		update->dec[link_id] += next->dec[link_id];
+	}
+}
+
+/**
+ * mgmt_rx_reo_tree_apply_update() - Apply a wait count update to the root of
+ * a sub tree of the reorder treap
+ * @entry: Root of the sub tree
+ * @update: Pointer to the wait count update
+ *
+ * Updates the wait count of @entry right away and records @update as pending
+ * for the children of @entry. The children are updated only when they are
+ * visited next time.
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_tree_apply_update(
+		struct mgmt_rx_reo_list_entry *entry,
+		const struct mgmt_rx_reo_wait_count_update *update)
+{
+	struct mgmt_rx_reo_wait_count *wait_count = &entry->wait_count;
+	uint8_t link_id;
+
+	for (link_id = 0; link_id < MGMT_RX_REO_MAX_LINKS; link_id++) {
+		unsigned int old_count = wait_count->per_link_count[link_id];
+		unsigned int new_count;
+
+		if (!old_count)
+			continue;
+
+		new_count = old_count > update->dec[link_id] ?
+			    old_count - update->dec[link_id] : 0;
+		new_count = qdf_min(new_count, update->cap[link_id]);
+
+		wait_count->per_link_count[link_id] = new_count;
+		wait_count->total_count -= old_count - new_count;
+	}
+
+	if (wait_count->total_count == 0)
+		entry->status &=
+			~MGMT_RX_REO_STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
+
+	if (entry->tree_left || entry->tree_right)
+		mgmt_rx_reo_wait_count_update_compose(&entry->pending_update,
+						      update);
+}
+
+/**
+ * mgmt_rx_reo_tree_push_down() - Push the pending wait count update of an
+ * entry down to its children
+ * @entry: Entry in the reorder treap
+ *
+ * This has to be done before the children of @entry are accessed or
+ * modified.
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_tree_push_down(struct mgmt_rx_reo_list_entry *entry)
+{
+	if (!entry->pending_update.pending)
+		return;
+
+	if (entry->tree_left)
+		mgmt_rx_reo_tree_apply_update(entry->tree_left,
+					      &entry->pending_update);
+
+	if (entry->tree_right)
+		mgmt_rx_reo_tree_apply_update(entry->tree_right,
+					      &entry->pending_update);
+
+	entry->pending_update.pending = false;
+}
+
+/**
+ * mgmt_rx_reo_tree_push_down_all() - Push the pending wait count updates of
+ * all the entries in a sub tree of the reorder treap
+ * @entry: Root of the sub tree
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_tree_push_down_all(struct mgmt_rx_reo_list_entry *entry)
+{
+	if (!entry)
+		return;
+
+	mgmt_rx_reo_tree_push_down(entry);
+	mgmt_rx_reo_tree_push_down_all(entry->tree_left);
+	mgmt_rx_reo_tree_push_down_all(entry->tree_right);
+}
+
+/**
+ * mgmt_rx_reo_tree_split() - Split the reorder treap based on global time
+ * stamp
+ * @entry: Root of the treap
+ * @global_ts: Global time stamp used for splitting
+ * @lower: Pointer to the root of the treap with entries whose global time
+ * stamp <= @global_ts
+ * @higher: Pointer to the root of the treap with entries whose global time
+ * stamp > @global_ts
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_tree_split(struct mgmt_rx_reo_list_entry *entry,
+		       uint32_t global_ts,
+		       struct mgmt_rx_reo_list_entry **lower,
+		       struct mgmt_rx_reo_list_entry **higher)
+{
+	if (!entry) {
+		*lower = NULL;
+		*higher = NULL;
+		return;
+	}
+
+	mgmt_rx_reo_tree_push_down(entry);
+
+	if (mgmt_rx_reo_compare_global_timestamps_gte(
+	    global_ts, mgmt_rx_reo_get_global_ts(entry->rx_params))) {
+		mgmt_rx_reo_tree_split(entry->tree_right, global_ts,
+				       &entry->tree_right, higher);
+		*lower = entry;
+	} else {
+		mgmt_rx_reo_tree_split(entry->tree_left, global_ts,
+				       lower, &entry->tree_left);
+		*higher = entry;
+	}
+}
+
+/**
+ * mgmt_rx_reo_tree_merge() - Merge two reorder treaps
+ * @lower: Root of the treap with the older entries
+ * @higher: Root of the treap with the newer entries. Global time stamp of
+ * every entry in @higher should be > that of every entry in @lower.
+ *
+ * Return: Root of the merged treap
+ */
+static struct mgmt_rx_reo_list_entry *
+mgmt_rx_reo_tree_merge(struct mgmt_rx_reo_list_entry *lower,
+		       struct mgmt_rx_reo_list_entry *higher)
+{
+	if (!lower)
+		return higher;
+
+	if (!higher)
+		return lower;
+
+	if (lower->tree_priority > higher->tree_priority) {
+		mgmt_rx_reo_tree_push_down(lower);
+		lower->tree_right = mgmt_rx_reo_tree_merge(lower->tree_right,
+							   higher);
+		return lower;
+	}
+
+	mgmt_rx_reo_tree_push_down(higher);
+	higher->tree_left = mgmt_rx_reo_tree_merge(lower, higher->tree_left);
+
+	return higher;
+}
+
+/**
+ * mgmt_rx_reo_tree_get_first() - Get the entry with the least global time
+ * stamp in a reorder treap
+ * @entry: Root of the treap
+ *
+ * Pending wait count updates are pushed down along the path, so the wait
+ * count of the returned entry is up to date.
+ *
+ * Return: Entry with the least global time stamp, NULL if treap is empty
+ */
+static struct mgmt_rx_reo_list_entry *
+mgmt_rx_reo_tree_get_first(struct mgmt_rx_reo_list_entry *entry)
+{
+	if (!entry)
+		return NULL;
+
+	mgmt_rx_reo_tree_push_down(entry);
+	while (entry->tree_left) {
+		entry = entry->tree_left;
+		mgmt_rx_reo_tree_push_down(entry);
+	}
+
+	return entry;
+}
+
+/**
+ * mgmt_rx_reo_tree_remove_first() - Remove the entry with the least global
+ * time stamp from the reorder treap
+ * @reo_list: Pointer to reorder list
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_tree_remove_first(struct mgmt_rx_reo_list *reo_list)
+{
+	struct mgmt_rx_reo_list_entry **link = &reo_list->tree_root;
+	struct mgmt_rx_reo_list_entry *entry;
+
+	if (!*link)
+		return;
+
+	mgmt_rx_reo_tree_push_down(*link);
+	while ((*link)->tree_left) {
+		link = &(*link)->tree_left;
+		mgmt_rx_reo_tree_push_down(*link);
+	}
+
+	entry = *link;
+	*link = entry->tree_right;
+	entry->tree_right = NULL;
+}
+
 /*
  * struct mgmt_rx_reo_list_entry_debug_info - This structure holds the necessary
  * information about a reo list entry for debug purposes.
@@ -886,6 +1183,9 @@ mgmt_rx_reo_list_display(struct mgmt_rx_reo_list *reo_list,
 		return QDF_STATUS_E_NOMEM;
 	}
 
+	/* Materialize the wait counts before reading them */
+	mgmt_rx_reo_tree_push_down_all(reo_list->tree_root);
+
 	index = 0;
 	qdf_list_for_each(&reo_list->list, cur_entry, node) {
 		debug_info[index].link_id =
@@ -1151,6 +1451,8 @@ mgmt_rx_reo_list_entry_send_up(const struct mgmt_rx_reo_list *reo_list,
 			goto exit;
 	}
 
+	mgmt_rx_reo_sim_record_delivery(reo_context, entry);
+
 	status = wlan_mgmt_txrx_process_rx_frame(pdev, entry->nbuf,
 						 entry->rx_params);
 	/* Above call frees nbuf and rx_params, make it null explicitly */
@@ -1249,6 +1551,10 @@ mgmt_rx_reo_list_release_entries(struct mgmt_rx_reo_context *reo_context)
 			goto exit_unlock_list_lock;
 		}
 
+		/* Bring the wait count of the first entry up to date */
+		qdf_assert_always(mgmt_rx_reo_tree_get_first(
+				  reo_list->tree_root) == first_entry);
+
 		if (!mgmt_rx_reo_list_is_ready_to_send_up_entry(reo_list,
 								first_entry)) {
 			status = QDF_STATUS_SUCCESS;
@@ -1266,6 +1572,8 @@ mgmt_rx_reo_list_release_entries(struct mgmt_rx_reo_context *reo_context)
 			goto exit_unlock_list_lock;
 		}
 
+		mgmt_rx_reo_tree_remove_first(reo_list);
+
 		/**
 		 * Last released frame global time stamp is invalid means that
 		 * current frame is the first frame to be released to the
@@ -1436,6 +1744,9 @@ mgmt_rx_reo_prepare_list_entry(
 	list_entry->rx_params = frame_desc->rx_params;
 	list_entry->wait_count = frame_desc->wait_count;
 	list_entry->status = 0;
+	list_entry->tree_left = NULL;
+	list_entry->tree_right = NULL;
+	list_entry->pending_update.pending = false;
 	if (list_entry->wait_count.total_count)
 		list_entry->status |=
 			MGMT_RX_REO_STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
@@ -1525,6 +1836,12 @@ mgmt_rx_reo_update_wait_count(
  *      all the frames in the reorder list with global time stamp > current
  *      frame's global time stamp.
  *
+ * The list entries are also indexed by a treap keyed on global time stamp.
+ * Updates a) and c) are recorded lazily at the roots of the two halves of
+ * the split treap, so the cost per frame is logarithmic in the list size
+ * instead of linear. Pending updates are pushed down whenever an entry is
+ * visited and its wait count is needed.
+ *
  * Return: QDF_STATUS
  */
 static QDF_STATUS
@@ -1533,12 +1850,16 @@ mgmt_rx_reo_update_list(struct mgmt_rx_reo_list *reo_list,
 			struct mgmt_rx_reo_frame_descriptor *frame_desc,
 			bool *is_queued)
 {
-	struct mgmt_rx_reo_list_entry *cur_entry;
 	struct mgmt_rx_reo_list_entry *least_greater_entry;
+	struct mgmt_rx_reo_list_entry *lower;
+	struct mgmt_rx_reo_list_entry *higher;
+	struct mgmt_rx_reo_wait_count_update update;
 	bool least_greater_entry_found = false;
 	QDF_STATUS status;
 	uint32_t new_frame_global_ts;
 	struct mgmt_rx_reo_list_entry *new_entry = NULL;
+	uint8_t frame_link_id;
+	uint8_t link_id;
 
 	if (!is_queued)
 		return QDF_STATUS_E_NULL_VALUE;
@@ -1554,7 +1875,10 @@ mgmt_rx_reo_update_list(struct mgmt_rx_reo_list *reo_list,
 		return QDF_STATUS_E_NULL_VALUE;
 	}
 
+	qdf_assert_always(num_mlo_links <= MGMT_RX_REO_MAX_LINKS);
+
 	new_frame_global_ts = mgmt_rx_reo_get_global_ts(frame_desc->rx_params);
+	frame_link_id = mgmt_rx_reo_get_link_id(frame_desc->rx_params);
 
 	/* Prepare the list entry before acquiring lock */
 	if (frame_desc->type == MGMT_RX_REO_FRAME_DESC_HOST_CONSUMED_FRAME) {
@@ -1567,31 +1891,25 @@ mgmt_rx_reo_update_list(struct mgmt_rx_reo_list *reo_list,
 
 	qdf_spin_lock_bh(&reo_list->list_lock);
 
-	qdf_list_for_each(&reo_list->list, cur_entry, node) {
-		uint32_t cur_entry_global_ts;
-
-		cur_entry_global_ts = mgmt_rx_reo_get_global_ts(
-					cur_entry->rx_params);
+	mgmt_rx_reo_tree_split(reo_list->tree_root, new_frame_global_ts,
+			       &lower, &higher);
+	reo_list->tree_root = NULL;
 
-		if (!mgmt_rx_reo_compare_global_timestamps_gte(
-		    new_frame_global_ts, cur_entry_global_ts)) {
-			least_greater_entry = cur_entry;
-			least_greater_entry_found = true;
-			break;
+	if (lower) {
+		for (link_id = 0; link_id < MGMT_RX_REO_MAX_LINKS; link_id++) {
+			update.dec[link_id] = 0;
+			update.cap[link_id] = link_id < num_mlo_links ?
+				frame_desc->wait_count.per_link_count[link_id] :
+				MGMT_RX_REO_WAIT_COUNT_NO_CAP;
 		}
+		update.pending = true;
 
-		status = mgmt_rx_reo_update_wait_count(
-					num_mlo_links,
-					&cur_entry->wait_count,
-					&frame_desc->wait_count);
-		if (QDF_IS_STATUS_ERROR(status))
-			goto error;
-
-		if (cur_entry->wait_count.total_count == 0)
-			cur_entry->status &=
-			      ~MGMT_RX_REO_STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
+		mgmt_rx_reo_tree_apply_update(lower, &update);
 	}
 
+	least_greater_entry = mgmt_rx_reo_tree_get_first(higher);
+	least_greater_entry_found = !!least_greater_entry;
+
 	frame_desc->is_stale = false;
 	if (mgmt_rx_reo_is_stale_frame(&reo_list->ts_last_released_frame,
 				       new_frame_global_ts)) {
@@ -1622,33 +1940,43 @@ mgmt_rx_reo_update_list(struct mgmt_rx_reo_list *reo_list,
 		new_entry->insertion_ts = qdf_get_log_timestamp();
 		new_entry->ingress_timestamp = frame_desc->ingress_timestamp;
 
-		status = qdf_list_insert_before(&reo_list->list,
+		if (least_greater_entry_found)
+			status = qdf_list_insert_before(
+						&reo_list->list,
 						&new_entry->node,
 						&least_greater_entry->node);
+		else
+			status = qdf_list_insert_back(&reo_list->list,
+						      &new_entry->node);
 		if (QDF_IS_STATUS_ERROR(status))
 			goto error;
 
+		new_entry->tree_priority =
+				mgmt_rx_reo_tree_get_priority(reo_list);
+		lower = mgmt_rx_reo_tree_merge(lower, new_entry);
+
 		*is_queued = true;
 	}
 
-	cur_entry = least_greater_entry;
-	qdf_list_for_each_from(&reo_list->list, cur_entry, node) {
-		uint8_t frame_link_id;
-
-		frame_link_id = mgmt_rx_reo_get_link_id(frame_desc->rx_params);
-		if (cur_entry->wait_count.per_link_count[frame_link_id]) {
-			cur_entry->wait_count.per_link_count[frame_link_id]--;
-			cur_entry->wait_count.total_count--;
-			if (cur_entry->wait_count.total_count == 0)
-				cur_entry->status &=
-					~MGMT_RX_REO_STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
+	if (higher) {
+		for (link_id = 0; link_id < MGMT_RX_REO_MAX_LINKS; link_id++) {
+			update.dec[link_id] = 0;
+			update.cap[link_id] = MGMT_RX_REO_WAIT_COUNT_NO_CAP;
 		}
+		update.dec[frame_link_id] = 1;
+		update.pending = true;
+
+		mgmt_rx_reo_tree_apply_update(higher, &update);
 	}
 
+	reo_list->tree_root = mgmt_rx_reo_tree_merge(lower, higher);
+
 	status = QDF_STATUS_SUCCESS;
 	goto exit;
 
 error:
+	reo_list->tree_root = mgmt_rx_reo_tree_merge(lower, higher);
+
 	/* Cleanup the entry if it is not queued */
 	if (!*is_queued) {
 		struct wlan_objmgr_pdev *pdev;
@@ -1716,6 +2044,9 @@ mgmt_rx_reo_list_init(struct mgmt_rx_reo_list *reo_list)
 
 	reo_list->ts_last_delivered_frame.valid = false;
 
+	reo_list->tree_root = NULL;
+	reo_list->tree_seed = (uint32_t)qdf_get_log_timestamp() | 1;
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -3249,6 +3580,10 @@ mgmt_rx_reo_sim_start(void)
 
 	sim_context->mac_hw_sim.mac_hw_thread = mac_hw_thread;
 
+	qdf_mem_zero(&sim_context->perf_stats,
+		     sizeof(sim_context->perf_stats));
+	sim_context->perf_stats.start_ts = qdf_get_log_timestamp();
+
 	qdf_wake_up_process(sim_context->mac_hw_sim.mac_hw_thread);
 
 	return QDF_STATUS_SUCCESS;
@@ -3273,6 +3608,42 @@ error_destroy_fw_and_host_work_queues_till_last_link:
 	return status;
 }
 
+/**
+ * mgmt_rx_reo_sim_print_perf_stats() - Print the throughput and latency of
+ * the reorder algorithm measured during the simulation
+ * @sim_context: Pointer to reo simulation context
+ * @num_mlo_links: Number of MLO links simulated
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_sim_print_perf_stats(struct mgmt_rx_reo_sim_context *sim_context,
+				 int8_t num_mlo_links)
+{
+	struct mgmt_rx_reo_sim_perf_stats *perf_stats;
+	uint32_t duration_ms;
+	uint64_t frames_per_sec = 0;
+	uint64_t latency_avg_us = 0;
+
+	perf_stats = &sim_context->perf_stats;
+
+	duration_ms = qdf_do_div(qdf_log_timestamp_to_usecs(
+				 qdf_get_log_timestamp() - perf_stats->start_ts),
+				 USEC_PER_MSEC);
+	if (duration_ms)
+		frames_per_sec = qdf_do_div(perf_stats->num_frames_delivered *
+					    MSEC_PER_SEC, duration_ms);
+	if (perf_stats->num_frames_delivered)
+		latency_avg_us = qdf_do_div(perf_stats->latency_sum_us,
+					    perf_stats->num_frames_delivered);
+
+	mgmt_rx_reo_err("reo sim perf: links = %d, frames = %llu, duration = %u ms, frames/sec = %llu",
+			num_mlo_links, perf_stats->num_frames_delivered,
+			duration_ms, frames_per_sec);
+	mgmt_rx_reo_err("reo sim perf: reorder latency avg = %llu us, max = %llu us",
+			latency_avg_us, perf_stats->latency_max_us);
+}
+
 QDF_STATUS
 mgmt_rx_reo_sim_stop(void)
 {
@@ -3343,6 +3714,8 @@ mgmt_rx_reo_sim_stop(void)
 		mgmt_rx_reo_err("reo sim passed");
 	}
 
+	mgmt_rx_reo_sim_print_perf_stats(sim_context, num_mlo_links);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -3491,6 +3864,9 @@ mgmt_rx_reo_flush_reorder_list(struct mgmt_rx_reo_list *reo_list)
 
 	qdf_spin_lock_bh(&reo_list->list_lock);
 
+	/* All the entries are freed below, drop the treap index as well */
+	reo_list->tree_root = NULL;
+
 	qdf_list_for_each_del(&reo_list->list, cur_entry, temp, node) {
 		uint8_t link_id;
 		struct wlan_objmgr_pdev *pdev = NULL;
@@ -49,6 +49,7 @@
 #define MGMT_RX_REO_MAX_LINKS (16)
 #define MGMT_RX_REO_INVALID_NUM_LINKS (-1)
 #define MGMT_RX_REO_INVALID_LINK_ID   (-1)
+#define MGMT_RX_REO_WAIT_COUNT_NO_CAP (UINT_MAX)
 
 /* Reason to release an entry from the reorder list */
 #define MGMT_RX_REO_LIST_ENTRY_RELEASE_REASON_ZERO_WAIT_COUNT           (BIT(0))
@@ -161,6 +162,10 @@ struct mgmt_rx_reo_global_ts_info {
  * @ageout_timer: Periodic timer to age-out the list entries
  * @ts_last_released_frame: Stores the global time stamp for the last frame
  * removed from the reorder list
+ * @tree_root: Root of the treap which indexes the list entries by their
+ * global time stamp. Used to locate the insertion point and to apply the
+ * wait count updates lazily.
+ * @tree_seed: Seed of the generator for the treap priorities
  */
 struct mgmt_rx_reo_list {
 	qdf_list_t list;
@@ -169,6 +174,8 @@ struct mgmt_rx_reo_list {
 	uint32_t list_entry_timeout_us;
 	qdf_timer_t ageout_timer;
 	struct mgmt_rx_reo_global_ts_info ts_last_released_frame;
+	struct mgmt_rx_reo_list_entry *tree_root;
+	uint32_t tree_seed;
 };
 
 /*
@@ -183,6 +190,20 @@ struct mgmt_rx_reo_wait_count {
 	unsigned long long int total_count;
 };
 
+/*
+ * struct mgmt_rx_reo_wait_count_update - Wait count update which is yet to
+ * be applied to a sub tree of the reorder treap. The update maps the wait
+ * count x of a link to min(max(x - @dec, 0), @cap).
+ * @dec: Per link value to be subtracted from the wait count
+ * @cap: Per link upper bound for the wait count
+ * @pending: Indicates whether the update holds a valid value
+ */
+struct mgmt_rx_reo_wait_count_update {
+	unsigned int dec[MGMT_RX_REO_MAX_LINKS];
+	unsigned int cap[MGMT_RX_REO_MAX_LINKS];
+	bool pending;
+};
+
 /**
  * struct mgmt_rx_reo_list_entry - Entry in the Management reorder list
  * @node: List node
@@ -194,6 +215,10 @@ struct mgmt_rx_reo_wait_count {
  * @ingress_timestamp: Host time stamp when this frame has arrived reorder
  * module
  * @status: Status for this entry
+ * @tree_left: Left child of this entry in the reorder treap
+ * @tree_right: Right child of this entry in the reorder treap
+ * @tree_priority: Heap priority of this entry in the reorder treap
+ * @pending_update: Wait count update to be pushed down to the children
  */
 struct mgmt_rx_reo_list_entry {
 	qdf_list_node_t node;
@@ -203,6 +228,10 @@ struct mgmt_rx_reo_list_entry {
 	uint64_t insertion_ts;
 	uint64_t ingress_timestamp;
 	uint32_t status;
+	struct mgmt_rx_reo_list_entry *tree_left;
+	struct mgmt_rx_reo_list_entry *tree_right;
+	uint32_t tree_priority;
+	struct mgmt_rx_reo_wait_count_update pending_update;
 };
 
 #ifdef WLAN_MGMT_RX_REO_SIM_SUPPORT
@@ -345,6 +374,23 @@ struct mgmt_rx_reo_mac_hw_simulator {
 	qdf_thread_t *mac_hw_thread;
 };
 
+/**
+ * struct mgmt_rx_reo_sim_perf_stats - Throughput and latency statistics of
+ * the reorder algorithm collected during the simulation
+ * @start_ts: Host time stamp(us) when the simulation started
+ * @num_frames_delivered: Number of frames delivered to the upper layers
+ * @latency_sum_us: Sum of the time(us) spent in the reorder module by the
+ * delivered frames
+ * @latency_max_us: Maximum time(us) spent in the reorder module by a
+ * delivered frame
+ */
+struct mgmt_rx_reo_sim_perf_stats {
+	uint64_t start_ts;
+	uint64_t num_frames_delivered;
+	uint64_t latency_sum_us;
+	uint64_t latency_max_us;
+};
+
 /**
  * struct mgmt_rx_reo_sim_context - Management rx-reorder simulation context
  * @host_mgmt_frame_handler: Per link work queue to simulate the host layer
@@ -354,6 +400,7 @@ struct mgmt_rx_reo_mac_hw_simulator {
  * @mac_hw_sim:  MAC HW simulation object
  * @snapshot: snapshots required for reo algorithm
  * @link_id_to_pdev_map: link_id to pdev object map
+ * @perf_stats: Throughput and latency statistics
  */
 struct mgmt_rx_reo_sim_context {
 	struct workqueue_struct *host_mgmt_frame_handler[MGMT_RX_REO_MAX_LINKS];
@@ -364,6 +411,7 @@ struct mgmt_rx_reo_sim_context {
 	struct mgmt_rx_reo_snapshot snapshot[MGMT_RX_REO_MAX_LINKS]
 					    [MGMT_RX_REO_SHARED_SNAPSHOT_MAX];
 	struct mgmt_rx_reo_sim_link_id_to_pdev_map link_id_to_pdev_map;
+	struct mgmt_rx_reo_sim_perf_stats perf_stats;
 };
 #endif /* WLAN_MGMT_RX_REO_SIM_SUPPORT */
 
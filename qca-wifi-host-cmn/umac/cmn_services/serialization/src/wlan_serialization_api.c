@@ -560,9 +560,9 @@ wlan_serialization_get_scan_cmd_using_scan_id(
 	cmd.cmd_id = scan_id;
 	cmd.vdev = vdev;
 
-	node = wlan_serialization_find_cmd(
-			queue, WLAN_SER_MATCH_CMD_ID_VDEV,
-			&cmd, 0, NULL, vdev,  WLAN_SER_PDEV_NODE);
+	node = wlan_serialization_find_pdev_cmd(
+			pdev_q, queue, WLAN_SER_MATCH_CMD_ID_VDEV,
+			&cmd, 0, vdev);
 
 	if (node) {
 		cmd_list = qdf_container_of(
@@ -624,9 +624,9 @@ void *wlan_serialization_get_active_cmd(
 
 	queue = &pdev_q->active_list;
 
-	node = wlan_serialization_find_cmd(
-			queue, WLAN_SER_MATCH_CMD_TYPE_VDEV,
-			NULL, cmd_type, NULL, vdev,  WLAN_SER_PDEV_NODE);
+	node = wlan_serialization_find_pdev_cmd(
+			pdev_q, queue, WLAN_SER_MATCH_CMD_TYPE_VDEV,
+			NULL, cmd_type, vdev);
 
 	if (node) {
 		cmd_list = qdf_container_of(
@@ -797,9 +797,9 @@ wlan_ser_validate_umac_cmd(struct wlan_objmgr_vdev *vdev,
 	wlan_serialization_acquire_lock(&pdev_q->pdev_queue_lock);
 
 	queue = &pdev_q->active_list;
-	node = wlan_serialization_find_cmd(
-			queue, WLAN_SER_MATCH_CMD_TYPE_VDEV,
-			NULL, cmd_type, NULL, vdev,  WLAN_SER_PDEV_NODE);
+	node = wlan_serialization_find_pdev_cmd(
+			pdev_q, queue, WLAN_SER_MATCH_CMD_TYPE_VDEV,
+			NULL, cmd_type, vdev);
 	if (node) {
 		cmd_list = qdf_container_of(
 				node,
@@ -23,6 +23,7 @@
 #include <wlan_objmgr_vdev_obj.h>
 #include <wlan_objmgr_pdev_obj.h>
 #include <wlan_utility.h>
+#include <qdf_time.h>
 #include "wlan_serialization_utils_i.h"
 #include "wlan_serialization_main_i.h"
 #include "wlan_serialization_queue_i.h"
@@ -160,6 +161,86 @@ static void wlan_ser_print_all_history(
 	}
 }
 
+static const char *ser_latency_bucket_string[SER_LATENCY_BUCKET_MAX] = {
+	"<=10ms",
+	"<=50ms",
+	"<=100ms",
+	"<=500ms",
+	"<=1s",
+	"<=5s",
+	">5s",
+};
+
+static void wlan_ser_print_latency_stats(
+		struct wlan_serialization_pdev_queue *pdev_queue)
+{
+	struct ser_latency_hist *hist;
+	uint8_t cmd_type;
+	uint8_t bucket;
+
+	ser_err_no_fl(WLAN_SER_LINE WLAN_SER_LINE);
+	ser_err_no_fl("Queue Latency Histogram (wait/total)");
+	ser_err_no_fl(WLAN_SER_LINE WLAN_SER_LINE);
+
+	for (cmd_type = 0; cmd_type < WLAN_SER_CMD_MAX; cmd_type++) {
+		hist = &pdev_queue->latency[cmd_type];
+		if (!hist->num_activated)
+			continue;
+
+		ser_err_no_fl("CMD_TYPE %d activated %u max wait %u ms max total %u ms",
+			      cmd_type, hist->num_activated,
+			      hist->max_wait_ms, hist->max_total_ms);
+		for (bucket = 0; bucket < SER_LATENCY_BUCKET_MAX; bucket++)
+			ser_err_no_fl("%8s|%8u|%8u|",
+				      ser_latency_bucket_string[bucket],
+				      hist->wait[bucket], hist->total[bucket]);
+	}
+}
+
+static enum ser_latency_bucket wlan_ser_latency_bucket(uint32_t delta_ms)
+{
+	if (delta_ms <= 10)
+		return SER_LATENCY_10MS;
+	if (delta_ms <= 50)
+		return SER_LATENCY_50MS;
+	if (delta_ms <= 100)
+		return SER_LATENCY_100MS;
+	if (delta_ms <= 500)
+		return SER_LATENCY_500MS;
+	if (delta_ms <= 1000)
+		return SER_LATENCY_1S;
+	if (delta_ms <= 5000)
+		return SER_LATENCY_5S;
+
+	return SER_LATENCY_OVER_5S;
+}
+
+void wlan_ser_update_latency_stats(
+		struct wlan_serialization_pdev_queue *pdev_queue,
+		struct wlan_serialization_command_list *cmd_list,
+		bool activated)
+{
+	struct ser_latency_hist *hist;
+	uint32_t delta_ms;
+
+	if (cmd_list->cmd.cmd_type >= WLAN_SER_CMD_MAX)
+		return;
+
+	hist = &pdev_queue->latency[cmd_list->cmd.cmd_type];
+	delta_ms = qdf_get_system_timestamp() - cmd_list->enqueue_ts;
+
+	if (activated) {
+		hist->num_activated++;
+		hist->wait[wlan_ser_latency_bucket(delta_ms)]++;
+		if (delta_ms > hist->max_wait_ms)
+			hist->max_wait_ms = delta_ms;
+	} else {
+		hist->total[wlan_ser_latency_bucket(delta_ms)]++;
+		if (delta_ms > hist->max_total_ms)
+			hist->max_total_ms = delta_ms;
+	}
+}
+
 QDF_STATUS wlan_ser_print_history(
 		struct wlan_objmgr_vdev *vdev, uint8_t val,
 		uint32_t sub_val)
@@ -218,6 +299,7 @@ QDF_STATUS wlan_ser_print_history(
 	}
 
 	wlan_ser_print_all_history(pdev_q, for_vdev_queue, vdev_id);
+	wlan_ser_print_latency_stats(pdev_q);
 error:
 	return QDF_STATUS_SUCCESS;
 }
@@ -66,6 +66,44 @@ struct ser_history {
 	struct ser_data data[SER_MAX_HISTORY_CMDS];
 	uint16_t index;
 };
+
+/**
+ * enum ser_latency_bucket - Buckets of the serialization latency histogram
+ * @SER_LATENCY_10MS: 0 to 10 ms
+ * @SER_LATENCY_50MS: 11 to 50 ms
+ * @SER_LATENCY_100MS: 51 to 100 ms
+ * @SER_LATENCY_500MS: 101 to 500 ms
+ * @SER_LATENCY_1S: 501 to 1000 ms
+ * @SER_LATENCY_5S: 1001 to 5000 ms
+ * @SER_LATENCY_OVER_5S: more than 5000 ms
+ * @SER_LATENCY_BUCKET_MAX: Max buckets
+ */
+enum ser_latency_bucket {
+	SER_LATENCY_10MS,
+	SER_LATENCY_50MS,
+	SER_LATENCY_100MS,
+	SER_LATENCY_500MS,
+	SER_LATENCY_1S,
+	SER_LATENCY_5S,
+	SER_LATENCY_OVER_5S,
+	SER_LATENCY_BUCKET_MAX,
+};
+
+/**
+ * struct ser_latency_hist - Queue latency histogram of a command type
+ * @wait: Time from enqueue till the command is moved to the active queue
+ * @total: Time from enqueue till the command is removed from active queue
+ * @max_wait_ms: Maximum wait time seen
+ * @max_total_ms: Maximum total time seen
+ * @num_activated: Number of commands moved to the active queue
+ */
+struct ser_latency_hist {
+	uint32_t wait[SER_LATENCY_BUCKET_MAX];
+	uint32_t total[SER_LATENCY_BUCKET_MAX];
+	uint32_t max_wait_ms;
+	uint32_t max_total_ms;
+	uint32_t num_activated;
+};
 #endif /* WLAN_SER_DEBUG */
 #endif
 
@@ -27,6 +27,7 @@
 #include <wlan_objmgr_psoc_obj.h>
 #include <qdf_list.h>
 #include <qdf_status.h>
+#include <qdf_time.h>
 #include <wlan_utility.h>
 #include "wlan_serialization_api.h"
 #include "wlan_serialization_main_i.h"
@@ -41,8 +42,8 @@ bool wlan_serialization_is_cmd_present_queue(
 {
 	qdf_list_t *queue;
 	bool status = false;
-	enum wlan_serialization_node node_type;
 	struct wlan_ser_pdev_obj *ser_pdev_obj;
+	struct wlan_serialization_pdev_queue *pdev_queue;
 	struct wlan_ser_vdev_obj *ser_vdev_obj;
 	enum wlan_serialization_cmd_type cmd_type;
 
@@ -69,18 +70,21 @@ bool wlan_serialization_is_cmd_present_queue(
 	}
 
 	if (cmd_type < WLAN_SER_CMD_NONSCAN) {
+		pdev_queue = wlan_serialization_get_pdev_queue_obj(
+				ser_pdev_obj, cmd_type);
 		queue = wlan_serialization_get_list_from_pdev_queue(
 				ser_pdev_obj, cmd_type, is_active_queue);
-		node_type = WLAN_SER_PDEV_NODE;
+		if (wlan_serialization_find_pdev_cmd(
+				pdev_queue, queue, WLAN_SER_MATCH_CMD_ID_VDEV,
+				cmd, 0, cmd->vdev))
+			status = true;
 	} else {
 		queue = wlan_serialization_get_list_from_vdev_queue(
 				ser_vdev_obj, cmd_type, is_active_queue);
-		node_type = WLAN_SER_VDEV_NODE;
+		status = wlan_serialization_is_cmd_present_in_given_queue(
+				queue, cmd, WLAN_SER_VDEV_NODE);
 	}
 
-	status = wlan_serialization_is_cmd_present_in_given_queue(queue, cmd,
-								  node_type);
-
 error:
 	return status;
 }
@@ -237,6 +241,7 @@ wlan_serialization_enqueue_cmd(struct wlan_serialization_command *cmd,
 
 	qdf_mem_copy(&cmd_list->cmd, cmd,
 		     sizeof(struct wlan_serialization_command));
+	cmd_list->enqueue_ts = qdf_get_system_timestamp();
 
 	if (cmd->cmd_type < WLAN_SER_CMD_NONSCAN) {
 		status = wlan_ser_add_scan_cmd(ser_pdev_obj,
@@ -262,6 +262,7 @@ static QDF_STATUS wlan_serialization_pdev_create_handler(
 				max_active_cmds);
 		qdf_list_create(&pdev_queue->pending_list,
 				max_pending_cmds);
+		qdf_ht_init(pdev_queue->cmd_ht);
 
 		status = wlan_serialization_create_cmd_pool(pdev_queue,
 							    cmd_pool_size);
@@ -293,6 +294,7 @@ error_free:
 		pdev_queue = &ser_pdev_obj->pdev_q[free_index];
 
 		wlan_serialization_destroy_cmd_pool(pdev_queue);
+		qdf_ht_deinit(pdev_queue->cmd_ht);
 		qdf_list_destroy(&pdev_queue->pending_list);
 		qdf_list_destroy(&pdev_queue->active_list);
 		wlan_serialization_destroy_lock(&pdev_queue->pdev_queue_lock);
@@ -655,6 +655,8 @@ wlan_ser_cancel_non_scan_cmd(
 		pdev_status =
 			wlan_serialization_remove_node(pdev_queue,
 						       &cmd_list->pdev_node);
+		if (pdev_status == QDF_STATUS_SUCCESS)
+			wlan_ser_pdev_index_remove(pdev_q, cmd_list);
 
 		ser_vdev_obj = wlan_serialization_get_vdev_obj(
 					cmd_list->cmd.vdev);
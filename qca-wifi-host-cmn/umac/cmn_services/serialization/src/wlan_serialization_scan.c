@@ -283,6 +283,8 @@ wlan_ser_cancel_scan_cmd(
 			break;
 		}
 
+		wlan_ser_pdev_index_remove(pdev_q, cmd_list);
+
 		qdf_mem_zero(&cmd_list->cmd,
 			     sizeof(struct wlan_serialization_command));
 		cmd_list->cmd_in_use = 0;
@@ -37,6 +37,11 @@ void wlan_ser_update_cmd_history(
 		enum ser_queue_reason ser_reason,
 		bool add_remove,
 		bool active_queue){ }
+
+void wlan_ser_update_latency_stats(
+		struct wlan_serialization_pdev_queue *pdev_queue,
+		struct wlan_serialization_command_list *cmd_list,
+		bool activated){ }
 #endif
 
 struct wlan_objmgr_pdev*
@@ -303,6 +308,11 @@ static void wlan_serialization_release_pdev_list_cmds(
 	while (!wlan_serialization_list_empty(&pdev_queue->active_list)) {
 		wlan_serialization_remove_front(
 				&pdev_queue->active_list, &node);
+		wlan_ser_pdev_index_remove(
+			pdev_queue,
+			qdf_container_of(node,
+					 struct wlan_serialization_command_list,
+					 pdev_node));
 		wlan_serialization_insert_back(
 				&pdev_queue->cmd_pool_list, node);
 	}
@@ -310,6 +320,11 @@ static void wlan_serialization_release_pdev_list_cmds(
 	while (!wlan_serialization_list_empty(&pdev_queue->pending_list)) {
 		wlan_serialization_remove_front(
 				&pdev_queue->pending_list, &node);
+		wlan_ser_pdev_index_remove(
+			pdev_queue,
+			qdf_container_of(node,
+					 struct wlan_serialization_command_list,
+					 pdev_node));
 		wlan_serialization_insert_back(
 				&pdev_queue->cmd_pool_list, node);
 	}
@@ -331,6 +346,7 @@ void wlan_serialization_destroy_pdev_list(
 {
 
 	wlan_serialization_release_pdev_list_cmds(pdev_queue);
+	qdf_ht_deinit(pdev_queue->cmd_ht);
 	qdf_list_destroy(&pdev_queue->pending_list);
 	qdf_list_destroy(&pdev_queue->active_list);
 
@@ -472,6 +488,7 @@ wlan_serialization_remove_cmd_from_queue(
 		enum wlan_serialization_node node_type)
 {
 	struct wlan_serialization_command_list *cmd_list;
+	struct wlan_serialization_pdev_queue *pdev_queue = NULL;
 	qdf_list_node_t *node = NULL;
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
 
@@ -483,8 +500,17 @@ wlan_serialization_remove_cmd_from_queue(
 		goto error;
 	}
 
-	node = wlan_serialization_find_cmd(queue, WLAN_SER_MATCH_CMD_ID_VDEV,
-					   cmd, 0, NULL, cmd->vdev, node_type);
+	if (node_type == WLAN_SER_PDEV_NODE) {
+		pdev_queue = wlan_serialization_get_pdev_queue_obj(
+				ser_pdev_obj, cmd->cmd_type);
+		node = wlan_serialization_find_pdev_cmd(
+				pdev_queue, queue, WLAN_SER_MATCH_CMD_ID_VDEV,
+				cmd, 0, cmd->vdev);
+	} else {
+		node = wlan_serialization_find_cmd(
+				queue, WLAN_SER_MATCH_CMD_ID_VDEV,
+				cmd, 0, NULL, cmd->vdev, node_type);
+	}
 
 	if (!node) {
 		ser_info("fail to find node %d for removal", node_type);
@@ -515,6 +541,8 @@ wlan_serialization_remove_cmd_from_queue(
 	if (QDF_STATUS_SUCCESS != status)
 		ser_err("Fail to add to free pool type %d",
 			cmd->cmd_type);
+	else if (pdev_queue)
+		wlan_ser_pdev_index_remove(pdev_queue, cmd_list);
 
 	*pcmd_list = cmd_list;
 
@@ -560,6 +588,12 @@ wlan_serialization_add_cmd_to_queue(
 	if (QDF_IS_STATUS_ERROR(qdf_status))
 		goto error;
 
+	if (node_type == WLAN_SER_PDEV_NODE)
+		wlan_ser_pdev_index_add(
+			wlan_serialization_get_pdev_queue_obj(
+				ser_pdev_obj, cmd_list->cmd.cmd_type),
+			cmd_list, queue);
+
 	if (is_cmd_for_active_queue)
 		status = WLAN_SER_CMD_ACTIVE;
 	else
@@ -871,6 +905,110 @@ error:
 	return cmd_node;
 }
 
+/**
+ * wlan_ser_pdev_vdev_cmds() - Get the per vdev command count of a pdev list
+ * @pdev_queue: pdev queue object
+ * @queue: pdev active or pending list
+ *
+ * Return: Array of command counts indexed by vdev id
+ */
+static inline uint16_t *
+wlan_ser_pdev_vdev_cmds(struct wlan_serialization_pdev_queue *pdev_queue,
+			qdf_list_t *queue)
+{
+	if (queue == &pdev_queue->active_list)
+		return pdev_queue->active_vdev_cmds;
+
+	return pdev_queue->pending_vdev_cmds;
+}
+
+void wlan_ser_pdev_index_add(struct wlan_serialization_pdev_queue *pdev_queue,
+			     struct wlan_serialization_command_list *cmd_list,
+			     qdf_list_t *queue)
+{
+	uint8_t vdev_id = wlan_vdev_get_id(cmd_list->cmd.vdev);
+
+	cmd_list->ht_key = wlan_ser_cmd_key(cmd_list->cmd.cmd_type,
+					    cmd_list->cmd.cmd_id);
+	cmd_list->pdev_list = queue;
+	qdf_ht_add(pdev_queue->cmd_ht, &cmd_list->ht_node, cmd_list->ht_key);
+
+	if (vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS)
+		wlan_ser_pdev_vdev_cmds(pdev_queue, queue)[vdev_id]++;
+
+	if (queue == &pdev_queue->active_list)
+		wlan_ser_update_latency_stats(pdev_queue, cmd_list, true);
+}
+
+void
+wlan_ser_pdev_index_remove(struct wlan_serialization_pdev_queue *pdev_queue,
+			   struct wlan_serialization_command_list *cmd_list)
+{
+	uint8_t vdev_id;
+	uint16_t *vdev_cmds;
+
+	if (!cmd_list->pdev_list)
+		return;
+
+	vdev_id = wlan_vdev_get_id(cmd_list->cmd.vdev);
+	vdev_cmds = wlan_ser_pdev_vdev_cmds(pdev_queue, cmd_list->pdev_list);
+	if (vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS && vdev_cmds[vdev_id])
+		vdev_cmds[vdev_id]--;
+
+	if (cmd_list->pdev_list == &pdev_queue->active_list)
+		wlan_ser_update_latency_stats(pdev_queue, cmd_list, false);
+
+	qdf_ht_remove(&cmd_list->ht_node);
+	cmd_list->pdev_list = NULL;
+}
+
+qdf_list_node_t *
+wlan_serialization_find_pdev_cmd(
+		struct wlan_serialization_pdev_queue *pdev_queue,
+		qdf_list_t *queue,
+		enum wlan_serialization_match_type match_type,
+		struct wlan_serialization_command *cmd,
+		enum wlan_serialization_cmd_type cmd_type,
+		struct wlan_objmgr_vdev *vdev)
+{
+	struct wlan_serialization_command_list *cmd_list;
+	uint64_t key;
+	uint8_t vdev_id;
+
+	switch (match_type) {
+	case WLAN_SER_MATCH_CMD_ID_VDEV:
+		if (!cmd)
+			return NULL;
+
+		/*
+		 * (cmd_type, cmd_id, vdev) is unique within a queue as the
+		 * duplicates are rejected at enqueue, so the first hit in the
+		 * index is the node the list walk would have returned.
+		 */
+		key = wlan_ser_cmd_key(cmd->cmd_type, cmd->cmd_id);
+		qdf_ht_for_each_match(pdev_queue->cmd_ht, cmd_list, ht_node,
+				      key, ht_key) {
+			if (cmd_list->pdev_list == queue &&
+			    cmd_list->cmd.vdev == vdev)
+				return &cmd_list->pdev_node;
+		}
+
+		return NULL;
+	case WLAN_SER_MATCH_VDEV:
+	case WLAN_SER_MATCH_CMD_TYPE_VDEV:
+		vdev_id = wlan_vdev_get_id(vdev);
+		if (vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS &&
+		    !wlan_ser_pdev_vdev_cmds(pdev_queue, queue)[vdev_id])
+			return NULL;
+		break;
+	default:
+		break;
+	}
+
+	return wlan_serialization_find_cmd(queue, match_type, cmd, cmd_type,
+					   NULL, vdev, WLAN_SER_PDEV_NODE);
+}
+
 QDF_STATUS
 wlan_serialization_acquire_lock(qdf_spinlock_t *lock)
 {
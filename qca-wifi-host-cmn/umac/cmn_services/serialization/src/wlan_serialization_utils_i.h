@@ -25,6 +25,7 @@
 
 #include <qdf_status.h>
 #include <qdf_list.h>
+#include <qdf_hashtable.h>
 #include <qdf_mc_timer.h>
 #include <wlan_objmgr_cmn.h>
 #include <wlan_objmgr_global_obj.h>
@@ -47,6 +48,21 @@
 #define CMD_ACTIVE_MARKED_FOR_CANCEL  3
 #define CMD_ACTIVE_MARKED_FOR_REMOVAL 4
 #define CMD_MARKED_FOR_MOVEMENT       5
+
+/*
+ * Number of hash bits of the per pdev queue (cmd_type, cmd_id) index.
+ * The pdev queues hold at most a few tens of commands, so 32 buckets
+ * keep the chains short.
+ */
+#define WLAN_SER_CMD_HT_BITS          5
+
+/**
+ * wlan_ser_cmd_key() - Key of a command in the pdev queue command index
+ * @cmd_type: Command type
+ * @cmd_id: Command id
+ */
+#define wlan_ser_cmd_key(cmd_type, cmd_id) \
+	(((uint64_t)(cmd_type) << 32) | (uint32_t)(cmd_id))
 /**
  * struct wlan_serialization_timer - Timer used for serialization
  * @cmd:      Cmd to which the timer is linked
@@ -82,12 +98,20 @@ enum wlan_serialization_node {
  * @vdev_node: VDEV node identifier in the list
  * @cmd: Command to be serialized
  * @cmd_in_use: flag to check if the node/entry is logically active
+ * @ht_node: Node in the (cmd_type, cmd_id) index of the pdev queue
+ * @ht_key: Key with which the command is present in the index
+ * @pdev_list: pdev active/pending list the command is in, NULL otherwise
+ * @enqueue_ts: Time (ms) at which the command was queued to serialization
  */
 struct wlan_serialization_command_list {
 	qdf_list_node_t pdev_node;
 	qdf_list_node_t vdev_node;
 	struct wlan_serialization_command cmd;
 	unsigned long cmd_in_use;
+	qdf_ht_entry ht_node;
+	uint64_t ht_key;
+	qdf_list_t *pdev_list;
+	unsigned long enqueue_ts;
 };
 
 /**
@@ -99,6 +123,11 @@ struct wlan_serialization_command_list {
  * @blocking_cmd_active: Indicate if a blocking cmd is in active execution
  * @blocking_cmd_waiting: Indicate if a blocking cmd is in pending queue
  * @pdev_queue_lock: pdev lock to protect concurrent operations on the queues
+ * @cmd_ht: Index of the active and pending commands by (cmd_type, cmd_id)
+ * @active_vdev_cmds: Number of commands of each vdev in the active list
+ * @pending_vdev_cmds: Number of commands of each vdev in the pending list
+ * @history: Queue history of the commands
+ * @latency: Queue latency histogram of each command type
  */
 struct wlan_serialization_pdev_queue {
 	qdf_list_t active_list;
@@ -108,8 +137,12 @@ struct wlan_serialization_pdev_queue {
 	bool blocking_cmd_active;
 	uint16_t blocking_cmd_waiting;
 	qdf_spinlock_t pdev_queue_lock;
+	qdf_ht_declare(cmd_ht, WLAN_SER_CMD_HT_BITS);
+	uint16_t active_vdev_cmds[WLAN_UMAC_PSOC_MAX_VDEVS];
+	uint16_t pending_vdev_cmds[WLAN_UMAC_PSOC_MAX_VDEVS];
 #ifdef WLAN_SER_DEBUG
 	struct ser_history history;
+	struct ser_latency_hist latency[WLAN_SER_CMD_MAX];
 #endif
 };
 
@@ -578,6 +611,60 @@ wlan_serialization_find_cmd(qdf_list_t *queue, uint32_t match_type,
 			    struct wlan_objmgr_vdev *vdev,
 			    enum wlan_serialization_node node_type);
 
+/**
+ * wlan_serialization_find_pdev_cmd() - Find the cmd matching the given
+ * criterias in a pdev queue
+ * @pdev_queue: pdev queue which owns @queue
+ * @queue: pdev active or pending list to be searched
+ * @match_type: Match criteria
+ * @cmd: Serialization command information
+ * @cmd_type: Command type to be matched
+ * @vdev: vdev object that needs to be matched
+ *
+ * Same as wlan_serialization_find_cmd() for WLAN_SER_PDEV_NODE, but uses the
+ * (cmd_type, cmd_id) index and the per vdev command counts of the pdev queue
+ * to avoid walking the list where possible.
+ *
+ * Return: Pointer to the pdev node member in the list
+ */
+qdf_list_node_t *
+wlan_serialization_find_pdev_cmd(
+		struct wlan_serialization_pdev_queue *pdev_queue,
+		qdf_list_t *queue,
+		enum wlan_serialization_match_type match_type,
+		struct wlan_serialization_command *cmd,
+		enum wlan_serialization_cmd_type cmd_type,
+		struct wlan_objmgr_vdev *vdev);
+
+/**
+ * wlan_ser_pdev_index_add() - Add a command to the pdev queue indexes
+ * @pdev_queue: pdev queue object
+ * @cmd_list: Command which is inserted into @queue
+ * @queue: pdev active or pending list
+ *
+ * Must be called with the pdev queue lock held, whenever the pdev node of
+ * @cmd_list is inserted into the active or pending list.
+ *
+ * Return: None
+ */
+void wlan_ser_pdev_index_add(struct wlan_serialization_pdev_queue *pdev_queue,
+			     struct wlan_serialization_command_list *cmd_list,
+			     qdf_list_t *queue);
+
+/**
+ * wlan_ser_pdev_index_remove() - Remove a command from the pdev queue indexes
+ * @pdev_queue: pdev queue object
+ * @cmd_list: Command which is removed from the active or pending list
+ *
+ * Must be called with the pdev queue lock held, whenever the pdev node of
+ * @cmd_list is removed from the active or pending list.
+ *
+ * Return: None
+ */
+void
+wlan_ser_pdev_index_remove(struct wlan_serialization_pdev_queue *pdev_queue,
+			   struct wlan_serialization_command_list *cmd_list);
+
 /**
  * wlan_serialization_remove_front() - Remove the front node of the list
  * @list: List from which the node is to be removed
@@ -709,4 +796,21 @@ void wlan_ser_update_cmd_history(
 		bool add_remove,
 		bool active_queue);
 
+/**
+ * wlan_ser_update_latency_stats() - Update queue latency histogram
+ * @pdev_queue: serialization pdev queue
+ * @cmd_list: cmd moved into or out of the active queue
+ * @activated: true if the cmd is added to the active queue, false if it
+ *	       is removed from it
+ *
+ * When @activated is set, the time the command waited since enqueue is
+ * accounted, otherwise the total time spent in serialization.
+ *
+ * Return: None
+ */
+void wlan_ser_update_latency_stats(
+		struct wlan_serialization_pdev_queue *pdev_queue,
+		struct wlan_serialization_command_list *cmd_list,
+		bool activated);
+
 #endif
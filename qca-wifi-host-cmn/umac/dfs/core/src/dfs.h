@@ -616,6 +616,12 @@ struct dfs_delayelem {
  *                             delta peak value.
  * @dl_psidx_diff_match_count: Number of pulse in the delay line that had valid
  *                             psidx diff value.
+ * @dl_sorted_pri:     PRIs (de_time) of the delay line elements in ascending
+ *                     order. Maintained per added pulse and used to score
+ *                     the PRIs without scanning the whole delay line.
+ * @dl_sorted_numelems: Number of entries in @dl_sorted_pri.
+ * @dl_sorted_valid:   Whether @dl_sorted_pri reflects the delay line. It is
+ *                     rebuilt on the next search if not.
  */
 struct dfs_delayline {
 	struct dfs_delayelem dl_elems[DFS_MAX_DL_SIZE];
@@ -631,6 +637,9 @@ struct dfs_delayline {
 	int8_t   dl_max_sidx;
 	uint8_t  dl_delta_peak_match_count;
 	uint8_t  dl_psidx_diff_match_count;
+	uint32_t dl_sorted_pri[DFS_MAX_DL_SIZE];
+	uint32_t dl_sorted_numelems;
+	bool     dl_sorted_valid;
 } qdf_packed;
 
 /**
@@ -1856,6 +1865,33 @@ void dfs_add_pulse(struct wlan_dfs *dfs,
 		uint32_t deltaT,
 		uint64_t this_ts);
 
+#ifdef WLAN_DFS_BINDETECTS_TEST
+/**
+ * dfs_calculate_score_test() - Score a PRI against the delay line of a filter
+ * @rf: Pointer to dfs_filter structure.
+ * @refpri: reference PRI.
+ * @primargin: PRI margin.
+ *
+ * Rebuilds the sorted PRIs of the delay line first if they are stale, as
+ * the PRI score search does.
+ *
+ * Return: Number of delay line PRIs matching @refpri.
+ */
+int dfs_calculate_score_test(struct dfs_filter *rf, uint32_t refpri,
+			     uint32_t primargin);
+
+/**
+ * typedef dfs_ref_score_fn() - Reference PRI scoring for dfs_bin_check_test()
+ * @rf: Pointer to dfs_filter structure.
+ * @refpri: reference PRI.
+ * @primargin: PRI margin.
+ *
+ * Return: Number of delay line PRIs matching @refpri.
+ */
+typedef int (*dfs_ref_score_fn)(struct dfs_filter *rf, uint32_t refpri,
+				uint32_t primargin);
+#endif /* WLAN_DFS_BINDETECTS_TEST */
+
 /**
  * dfs_bin_check() - BIN check
  * @dfs: Pointer to wlan_dfs structure.
@@ -1870,6 +1906,27 @@ int dfs_bin_check(struct wlan_dfs *dfs,
 		uint32_t dur,
 		int ext_chan_flag);
 
+#ifdef WLAN_DFS_BINDETECTS_TEST
+/**
+ * dfs_bin_check_test() - BIN check with a given PRI scoring
+ * @dfs: Pointer to wlan_dfs structure.
+ * @rf: Pointer to dfs_filter structure.
+ * @deltaT: deltaT value.
+ * @dur: Pulse duration.
+ * @ext_chan_flag: Extension channel flag.
+ * @ref_score: PRI scoring to use instead of the sorted PRI search, NULL
+ *	for none
+ *
+ * Lets the delay line scan the PRIs were scored with before be replayed
+ * against the sorted PRI search. Not reentrant.
+ *
+ * Return: 1 if the filter matched, else 0
+ */
+int dfs_bin_check_test(struct wlan_dfs *dfs, struct dfs_filter *rf,
+		       uint32_t deltaT, uint32_t dur, int ext_chan_flag,
+		       dfs_ref_score_fn ref_score);
+#endif /* WLAN_DFS_BINDETECTS_TEST */
+
 /**
  * dfs_bin_pri_check() - BIN PRI check
  * @dfs: Pointer to wlan_dfs structure.
@@ -26,6 +26,9 @@
 #include "../dfs.h"
 #include "../dfs_process_radar_found_ind.h"
 
+/* Multiples of refpri scored when rf_ignore_pri_window is 2 */
+#define DFS_MAX_PRI_MULTIPLES 3
+
 /**
  * dfs_find_first_index_within_window() - Find first index within window
  * @pl: Pointer to dfs_pulseline structure.
@@ -275,6 +278,129 @@ static int  dfs_bin_fixedpattern_check(
 	}
 }
 
+/**
+ * dfs_dl_sorted_lower_bound() - Find the first sorted PRI >= given PRI
+ * @dl: Pointer to dfs delayline.
+ * @pri: PRI value.
+ *
+ * Return: Index of the first entry in dl_sorted_pri which is >= @pri.
+ */
+static inline uint32_t dfs_dl_sorted_lower_bound(
+		struct dfs_delayline *dl,
+		uint32_t pri)
+{
+	uint32_t lo = 0, hi = dl->dl_sorted_numelems, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (dl->dl_sorted_pri[mid] < pri)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/**
+ * dfs_dl_sorted_insert() - Insert a PRI into the sorted PRIs
+ * @dl: Pointer to dfs delayline.
+ * @pri: PRI value.
+ */
+static inline void dfs_dl_sorted_insert(
+		struct dfs_delayline *dl,
+		uint32_t pri)
+{
+	uint32_t pos;
+
+	if (dl->dl_sorted_numelems >= DFS_MAX_DL_SIZE) {
+		dl->dl_sorted_valid = false;
+		return;
+	}
+
+	pos = dfs_dl_sorted_lower_bound(dl, pri);
+	qdf_mem_move(&dl->dl_sorted_pri[pos + 1], &dl->dl_sorted_pri[pos],
+		     (dl->dl_sorted_numelems - pos) * sizeof(uint32_t));
+	dl->dl_sorted_pri[pos] = pri;
+	dl->dl_sorted_numelems++;
+}
+
+/**
+ * dfs_dl_sorted_remove() - Remove a PRI from the sorted PRIs
+ * @dl: Pointer to dfs delayline.
+ * @pri: PRI value.
+ */
+static inline void dfs_dl_sorted_remove(
+		struct dfs_delayline *dl,
+		uint32_t pri)
+{
+	uint32_t pos;
+
+	pos = dfs_dl_sorted_lower_bound(dl, pri);
+	if (pos >= dl->dl_sorted_numelems || dl->dl_sorted_pri[pos] != pri) {
+		dl->dl_sorted_valid = false;
+		return;
+	}
+
+	qdf_mem_move(&dl->dl_sorted_pri[pos], &dl->dl_sorted_pri[pos + 1],
+		     (dl->dl_sorted_numelems - pos - 1) * sizeof(uint32_t));
+	dl->dl_sorted_numelems--;
+}
+
+/**
+ * dfs_dl_sorted_sync() - Rebuild the sorted PRIs if they are out of sync
+ * with the delay line.
+ * @dl: Pointer to dfs delayline.
+ */
+static void dfs_dl_sorted_sync(struct dfs_delayline *dl)
+{
+	uint32_t n;
+
+	if (dl->dl_sorted_valid &&
+	    dl->dl_sorted_numelems == dl->dl_numelems)
+		return;
+
+	dl->dl_sorted_numelems = 0;
+	dl->dl_sorted_valid = true;
+	for (n = 0; n < dl->dl_numelems; n++)
+		dfs_dl_sorted_insert(dl, dl->dl_elems[(dl->dl_firstelem + n) &
+				     DFS_MAX_DL_MASK].de_time);
+}
+
+/**
+ * dfs_dl_find_pri_window() - Find the sorted PRI range matching a PRI
+ * @dl: Pointer to dfs delayline.
+ * @centre: PRI to match.
+ * @primargin: PRI margin.
+ * @first: Index of the first matching sorted PRI.
+ * @last: Index after the last matching sorted PRI.
+ *
+ * A PRI matches when DFS_DIFF(PRI, @centre) < @primargin.
+ */
+static inline void dfs_dl_find_pri_window(
+		struct dfs_delayline *dl,
+		uint32_t centre,
+		uint32_t primargin,
+		uint32_t *first,
+		uint32_t *last)
+{
+	uint32_t lo, hi;
+
+	if (!primargin) {
+		*first = 0;
+		*last = 0;
+		return;
+	}
+
+	lo = (centre >= primargin - 1) ? centre - (primargin - 1) : 0;
+	hi = (centre <= UINT_MAX - (primargin - 1)) ?
+		centre + (primargin - 1) : UINT_MAX;
+
+	*first = dfs_dl_sorted_lower_bound(dl, lo);
+	*last = (hi == UINT_MAX) ? dl->dl_sorted_numelems :
+		dfs_dl_sorted_lower_bound(dl, hi + 1);
+}
+
 void dfs_add_pulse(
 		struct wlan_dfs *dfs,
 		struct dfs_filter *rf,
@@ -283,15 +409,31 @@ void dfs_add_pulse(
 		uint64_t this_ts)
 {
 	uint32_t index, n, window;
+	uint32_t trim_first, trim_num;
 	struct dfs_delayline *dl;
+	bool sorted_sync;
 
 	dl = &rf->rf_dl;
+	/*
+	 * Keep the sorted PRIs in step only if they match the delay line and
+	 * the delay line ends right before the slot of the new pulse.
+	 */
+	sorted_sync = dl->dl_sorted_valid &&
+		      dl->dl_sorted_numelems == dl->dl_numelems &&
+		      ((dl->dl_firstelem + dl->dl_numelems) &
+		       DFS_MAX_DL_MASK) ==
+		      ((dl->dl_lastelem + 1) & DFS_MAX_DL_MASK);
+
 	/* Circular buffer of size 2^n */
 	index = (dl->dl_lastelem + 1) & DFS_MAX_DL_MASK;
-	if ((dl->dl_numelems) == DFS_MAX_DL_SIZE)
+	if ((dl->dl_numelems) == DFS_MAX_DL_SIZE) {
+		if (sorted_sync)
+			dfs_dl_sorted_remove(
+				dl, dl->dl_elems[dl->dl_firstelem].de_time);
 		dl->dl_firstelem = (dl->dl_firstelem + 1) & DFS_MAX_DL_MASK;
-	else
+	} else {
 		dl->dl_numelems++;
+	}
 	dl->dl_lastelem = index;
 	dl->dl_elems[index].de_time = deltaT;
 	dl->dl_elems[index].de_ts = this_ts;
@@ -303,12 +445,17 @@ void dfs_add_pulse(
 	dl->dl_elems[index].de_delta_peak = re->re_delta_peak;
 	dl->dl_elems[index].de_psidx_diff = re->re_psidx_diff;
 	dl->dl_elems[index].de_seq_num = dfs->dfs_seq_num;
+	if (sorted_sync)
+		dfs_dl_sorted_insert(dl, deltaT);
 
 	dfs_debug(dfs, WLAN_DEBUG_DFS2,
 		"adding: filter id %d, dur=%d, rssi=%d, ts=%llu",
 		 rf->rf_pulseid, re->re_dur,
 		re->re_rssi, (unsigned long long int)this_ts);
 
+	trim_first = dl->dl_firstelem;
+	trim_num = dl->dl_numelems;
+
 	for (n = 0; n < dl->dl_numelems-1; n++) {
 		index = (index-1) & DFS_MAX_DL_MASK;
 		/*
@@ -323,6 +470,15 @@ void dfs_add_pulse(
 		}
 	}
 
+	if (sorted_sync) {
+		/* Drop the PRIs of the elements which fell out of the window */
+		for (n = 0; n < trim_num - dl->dl_numelems; n++)
+			dfs_dl_sorted_remove(dl, dl->dl_elems[(trim_first + n) &
+					     DFS_MAX_DL_MASK].de_time);
+	} else {
+		dl->dl_sorted_valid = false;
+	}
+
 	dfs_debug(dfs, WLAN_DEBUG_DFS2, "dl firstElem = %d  lastElem = %d",
 			dl->dl_firstelem, dl->dl_lastelem);
 }
@@ -373,29 +529,103 @@ static inline void dfs_calculate_score(
 	uint32_t primargin,
 	uint32_t score_index)
 {
-	int pri_match = 0;
-	int dindex;
-	uint32_t searchpri, deltapri, deltapri_2, deltapri_3;
-	uint32_t i;
+	uint32_t first[DFS_MAX_PRI_MULTIPLES], last[DFS_MAX_PRI_MULTIPLES];
+	uint32_t cur_first, cur_last, tmp;
+	uint32_t i, j, num_multiples;
 
-	for (i = 0; i < dl->dl_numelems; i++) {
-		dindex = (dl->dl_firstelem + i) & DFS_MAX_DL_MASK;
-		searchpri = dl->dl_elems[dindex].de_time;
-		deltapri = DFS_DIFF(searchpri, refpri);
-		deltapri_2 = DFS_DIFF(searchpri, 2*refpri);
-		deltapri_3 = DFS_DIFF(searchpri, 3*refpri);
-		if (rf->rf_ignore_pri_window == 2)
-			pri_match = ((deltapri < primargin) ||
-					(deltapri_2 < primargin) ||
-					(deltapri_3 < primargin));
-		else
-			pri_match = (deltapri < primargin);
+	/*
+	 * Count the delay line PRIs within primargin of refpri (and of its
+	 * 2x and 3x multiples if so configured) using the sorted PRIs. The
+	 * windows are merged where they overlap so that a PRI is counted only
+	 * once.
+	 */
+	num_multiples = (rf->rf_ignore_pri_window == 2) ?
+		DFS_MAX_PRI_MULTIPLES : 1;
+
+	for (i = 0; i < num_multiples; i++)
+		dfs_dl_find_pri_window(dl, (i + 1) * refpri, primargin,
+				       &first[i], &last[i]);
+
+	/* The multiples wrap around like the 32 bit PRIs, so sort them */
+	for (i = 1; i < num_multiples; i++) {
+		for (j = i; j > 0 && first[j] < first[j - 1]; j--) {
+			tmp = first[j];
+			first[j] = first[j - 1];
+			first[j - 1] = tmp;
+			tmp = last[j];
+			last[j] = last[j - 1];
+			last[j - 1] = tmp;
+		}
+	}
+
+	cur_first = first[0];
+	cur_last = last[0];
+	for (i = 1; i < num_multiples; i++) {
+		if (first[i] <= cur_last) {
+			cur_last = DFS_MAX(cur_last, last[i]);
+			continue;
+		}
 
-		if (pri_match)
-			score[score_index]++;
+		score[score_index] += cur_last - cur_first;
+		cur_first = first[i];
+		cur_last = last[i];
 	}
+
+	score[score_index] += cur_last - cur_first;
 }
 
+#ifdef WLAN_DFS_BINDETECTS_TEST
+/* Reference PRI scoring the bin check is replayed with, if set */
+static dfs_ref_score_fn dfs_bin_ref_score;
+
+/**
+ * dfs_score_pri() - Score a PRI, with the reference scoring if one is set
+ * @dl: Pointer to dfs delayline.
+ * @rf: Pointer to dfs_filter structure.
+ * @score: score array.
+ * @refpri: reference PRI.
+ * @primargin: PRI margin.
+ * @score_index: Score index.
+ */
+static inline void dfs_score_pri(
+	struct dfs_delayline *dl,
+	struct dfs_filter *rf,
+	int *score,
+	uint32_t refpri,
+	uint32_t primargin,
+	uint32_t score_index)
+{
+	if (dfs_bin_ref_score) {
+		score[score_index] += dfs_bin_ref_score(rf, refpri, primargin);
+		return;
+	}
+
+	dfs_calculate_score(dl, rf, score, refpri, primargin, score_index);
+}
+
+int dfs_calculate_score_test(struct dfs_filter *rf, uint32_t refpri,
+			     uint32_t primargin)
+{
+	int score = 0;
+
+	dfs_dl_sorted_sync(&rf->rf_dl);
+	dfs_calculate_score(&rf->rf_dl, rf, &score, refpri, primargin, 0);
+
+	return score;
+}
+#else
+static inline void dfs_score_pri(
+	struct dfs_delayline *dl,
+	struct dfs_filter *rf,
+	int *score,
+	uint32_t refpri,
+	uint32_t primargin,
+	uint32_t score_index)
+{
+	dfs_calculate_score(dl, rf, score, refpri, primargin, score_index);
+}
+#endif /* WLAN_DFS_BINDETECTS_TEST */
+
 /**
  * dfs_find_priscores() - Find PRI score
  * @dl: Pointer to dfs delayline.
@@ -415,6 +645,8 @@ static void dfs_find_priscores(
 
 	qdf_mem_zero(score, sizeof(int)*DFS_MAX_DL_SIZE);
 
+	dfs_dl_sorted_sync(dl);
+
 	for (n = 0; n < dl->dl_numelems; n++) {
 		delayindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
 		refpri = dl->dl_elems[delayindex].de_time;
@@ -422,8 +654,7 @@ static void dfs_find_priscores(
 			continue;
 		if (refpri < rf->rf_maxpri) {
 			/* Use only valid PRI range for high score. */
-			dfs_calculate_score(dl, rf, score, refpri, primargin,
-				n);
+			dfs_score_pri(dl, rf, score, refpri, primargin, n);
 		} else {
 			score[n] = 0;
 		}
@@ -746,6 +977,21 @@ int dfs_bin_check(
 	return found;
 }
 
+#ifdef WLAN_DFS_BINDETECTS_TEST
+int dfs_bin_check_test(struct wlan_dfs *dfs, struct dfs_filter *rf,
+		       uint32_t deltaT, uint32_t dur, int ext_chan_flag,
+		       dfs_ref_score_fn ref_score)
+{
+	int found;
+
+	dfs_bin_ref_score = ref_score;
+	found = dfs_bin_check(dfs, rf, deltaT, dur, ext_chan_flag);
+	dfs_bin_ref_score = NULL;
+
+	return found;
+}
+#endif /* WLAN_DFS_BINDETECTS_TEST */
+
 /**
  * dfs_update_min_and_max_sidx() - Calculate min and max sidx.
  * @dl: Pointer to dfs_delayline structure.
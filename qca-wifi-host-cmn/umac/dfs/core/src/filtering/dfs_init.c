@@ -98,6 +98,7 @@ void dfs_reset_delayline(struct dfs_delayline *dl)
 {
 	qdf_mem_zero(&(dl->dl_elems[0]), sizeof(dl->dl_elems));
 	dl->dl_lastelem = (0xFFFFFFFF) & DFS_MAX_DL_MASK;
+	dl->dl_sorted_valid = false;
 }
 
 void dfs_reset_filter_delaylines(struct dfs_filtertype *dft)
@@ -0,0 +1,668 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "../../dfs.h"
+#include "dfs_bindetects_test.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+/* Number of random filters, each fed its own pulse train */
+#define DFS_UT_RUNS 200
+
+/* Pulses added to the delay line of a filter */
+#define DFS_UT_PULSES 400
+
+/* PRIs scored after a pulse is added */
+#define DFS_UT_SCORES 8
+
+/* One in this many pulses resets the delay line first */
+#define DFS_UT_RESET_ODDS 64
+
+/* One in this many pulses is followed by the scoring */
+#define DFS_UT_SCORE_ODDS 4
+
+/* Pulses in the replayed pulse log */
+#define DFS_UT_REPLAY_PULSES 20000
+
+/* Pulses replayed through either scoring before they are compared */
+#define DFS_UT_REPLAY_CHUNK 64
+
+/* Pulses are let through up to this multiple of the max PRI of a filter */
+#define DFS_UT_PRI_MULTIPLIER 2
+
+/* Max PRI jitter of a radar pulse, in usecs */
+#define DFS_UT_PRI_JITTER 2
+
+/* One in this many radar pulses is missed */
+#define DFS_UT_MISS_ODDS 8
+
+/* Gap between radar bursts, from once to twice this, in usecs */
+#define DFS_UT_BURST_GAP 20000
+
+/* Gap between noise pulses, from once to 16 times this, in usecs */
+#define DFS_UT_NOISE_GAP 1000
+
+/* Max duration of a noise pulse */
+#define DFS_UT_NOISE_MAXDUR 30
+
+/**
+ * struct dfs_ut_radar - Radar type replayed against its filter
+ * @numpulses: Num pulses in the filter, and min pulses in a burst
+ * @minpri: Min PRI of the filter
+ * @maxpri: Max PRI of the filter
+ * @threshold: Match filter output threshold
+ * @mindur: Min pulse duration
+ * @maxdur: Max pulse duration
+ * @ignore_pri_window: rf_ignore_pri_window of the filter
+ * @fixed_pri: Whether the PRI is fixed
+ */
+struct dfs_ut_radar {
+	uint32_t numpulses;
+	uint32_t minpri;
+	uint32_t maxpri;
+	uint32_t threshold;
+	uint32_t mindur;
+	uint32_t maxdur;
+	uint32_t ignore_pri_window;
+	uint32_t fixed_pri;
+};
+
+/*
+ * Filters as dfs_init_radar_filters() sets them up for FCC type 1, 2, 3,
+ * new type 1 and ETSI 200-400 Hz of the offload radar tables.
+ */
+static const struct dfs_ut_radar dfs_ut_radars[] = {
+	{18, 1425, 1433,  5, 0,  1, 1, 1},
+	{23,  146,  234, 11, 0,  7, 0, 0},
+	{18,  196,  504,  8, 6, 13, 0, 0},
+	{57,  514,  942, 20, 0,  1, 0, 0},
+	{10, 2496, 5004,  5, 0,  8, 2, 0},
+};
+
+/**
+ * struct dfs_ut_pulse - Entry of a pulse log
+ * @ts: 64 bit time stamp of the pulse, in usecs
+ * @dur: Pulse duration
+ */
+struct dfs_ut_pulse {
+	uint64_t ts;
+	uint32_t dur;
+};
+
+static uint32_t dfs_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static uint32_t dfs_ut_rand32(uint64_t *seed)
+{
+	return (dfs_ut_rand(seed, 1 << 16) << 16) | dfs_ut_rand(seed, 1 << 16);
+}
+
+/**
+ * dfs_ut_ref_score() - Reference PRI score, a scan of the whole delay line
+ *	as dfs_calculate_score() did before the PRIs were kept sorted
+ * @rf: Pointer to dfs_filter structure.
+ * @refpri: reference PRI.
+ * @primargin: PRI margin.
+ *
+ * Return: Number of delay line PRIs matching @refpri.
+ */
+static int dfs_ut_ref_score(struct dfs_filter *rf, uint32_t refpri,
+			    uint32_t primargin)
+{
+	struct dfs_delayline *dl = &rf->rf_dl;
+	uint32_t searchpri, deltapri, deltapri_2, deltapri_3;
+	int pri_match = 0;
+	int score = 0;
+	int dindex;
+	uint32_t i;
+
+	for (i = 0; i < dl->dl_numelems; i++) {
+		dindex = (dl->dl_firstelem + i) & DFS_MAX_DL_MASK;
+		searchpri = dl->dl_elems[dindex].de_time;
+		deltapri = DFS_DIFF(searchpri, refpri);
+		deltapri_2 = DFS_DIFF(searchpri, 2 * refpri);
+		deltapri_3 = DFS_DIFF(searchpri, 3 * refpri);
+		if (rf->rf_ignore_pri_window == 2)
+			pri_match = ((deltapri < primargin) ||
+				     (deltapri_2 < primargin) ||
+				     (deltapri_3 < primargin));
+		else
+			pri_match = (deltapri < primargin);
+
+		if (pri_match)
+			score++;
+	}
+
+	return score;
+}
+
+/**
+ * dfs_ut_pri() - Pick a random PRI
+ * @seed: random seed
+ * @base: base PRI of the pulse train
+ *
+ * Most PRIs are close to the base PRI or one of its multiples, so that the
+ * scores are high and the 2x/3x windows overlap. The rest are spread over
+ * the 32 bit range, including values next to 0 and UINT_MAX and values
+ * whose multiples wrap around.
+ *
+ * Return: PRI
+ */
+static uint32_t dfs_ut_pri(uint64_t *seed, uint32_t base)
+{
+	uint32_t jitter = dfs_ut_rand(seed, 33);
+
+	switch (dfs_ut_rand(seed, 8)) {
+	case 0:
+	case 1:
+	case 2:
+		return base + jitter - 16;
+	case 3:
+		return (2 + dfs_ut_rand(seed, 2)) * base + jitter - 16;
+	case 4:
+		return jitter;
+	case 5:
+		return UINT_MAX - jitter;
+	case 6:
+		return UINT_MAX / (1 + dfs_ut_rand(seed, 3)) + jitter - 16;
+	default:
+		return dfs_ut_rand32(seed);
+	}
+}
+
+/**
+ * dfs_ut_primargin() - Pick a random PRI margin
+ * @seed: random seed
+ *
+ * Return: PRI margin, from 0 to UINT_MAX
+ */
+static uint32_t dfs_ut_primargin(uint64_t *seed)
+{
+	switch (dfs_ut_rand(seed, 8)) {
+	case 0:
+		return 0;
+	case 1:
+		return UINT_MAX - dfs_ut_rand(seed, 2);
+	case 2:
+		return dfs_ut_rand32(seed);
+	default:
+		return 1 + dfs_ut_rand(seed, 24);
+	}
+}
+
+/**
+ * dfs_ut_dl_contiguous() - Check the delay line ends right before the slot
+ *	of the next pulse
+ * @dl: Pointer to dfs delayline.
+ *
+ * This does not hold after the delay line is emptied on a fixed pattern
+ * match, until pulses fall out of the window again.
+ *
+ * Return: true if the delay line is contiguous
+ */
+static bool dfs_ut_dl_contiguous(struct dfs_delayline *dl)
+{
+	return ((dl->dl_firstelem + dl->dl_numelems) & DFS_MAX_DL_MASK) ==
+	       ((dl->dl_lastelem + 1) & DFS_MAX_DL_MASK);
+}
+
+/**
+ * dfs_ut_check_sorted() - Compare the incrementally kept sorted PRIs of a
+ *	delay line with a rebuild from scratch
+ * @rf: Pointer to dfs_filter structure.
+ * @scratch: Filter to rebuild the sorted PRIs in.
+ * @incremental: Whether dfs_add_pulse() must have kept the sorted PRIs up
+ *	to date
+ *
+ * Return: number of errors
+ */
+static uint32_t dfs_ut_check_sorted(struct dfs_filter *rf,
+				    struct dfs_filter *scratch,
+				    bool incremental)
+{
+	struct dfs_delayline *dl = &rf->rf_dl;
+	struct dfs_delayline *ref = &scratch->rf_dl;
+
+	if (!dl->dl_sorted_valid ||
+	    dl->dl_sorted_numelems != dl->dl_numelems) {
+		if (!incremental)
+			return 0;
+
+		qdf_nofl_alert("FAIL: sorted PRIs stale after add, valid %d sorted %u elems %u",
+			       dl->dl_sorted_valid, dl->dl_sorted_numelems,
+			       dl->dl_numelems);
+		return 1;
+	}
+
+	qdf_mem_copy(ref, dl, sizeof(*ref));
+	ref->dl_sorted_valid = false;
+	dfs_calculate_score_test(scratch, 0, 0);
+
+	if (ref->dl_sorted_numelems != dl->dl_sorted_numelems ||
+	    qdf_mem_cmp(ref->dl_sorted_pri, dl->dl_sorted_pri,
+			dl->dl_sorted_numelems * sizeof(uint32_t))) {
+		qdf_nofl_alert("FAIL: sorted PRIs differ from a rebuild, elems %u first %u",
+			       dl->dl_numelems, dl->dl_firstelem);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * dfs_ut_check_scores() - Cross-check random PRI scores with the reference
+ * @rf: Pointer to dfs_filter structure.
+ * @seed: random seed
+ * @base: base PRI of the pulse train
+ *
+ * Half of the reference PRIs are taken from the delay line, as in
+ * dfs_find_priscores(), the other half are random.
+ *
+ * Return: number of errors
+ */
+static uint32_t dfs_ut_check_scores(struct dfs_filter *rf, uint64_t *seed,
+				    uint32_t base)
+{
+	struct dfs_delayline *dl = &rf->rf_dl;
+	uint32_t refpri, primargin, index;
+	int score, exp_score;
+	uint32_t i;
+
+	for (i = 0; i < DFS_UT_SCORES; i++) {
+		if (dl->dl_numelems && dfs_ut_rand(seed, 2)) {
+			index = (dl->dl_firstelem +
+				 dfs_ut_rand(seed, dl->dl_numelems)) &
+				DFS_MAX_DL_MASK;
+			refpri = dl->dl_elems[index].de_time;
+		} else {
+			refpri = dfs_ut_pri(seed, base);
+		}
+		primargin = dfs_ut_primargin(seed);
+
+		score = dfs_calculate_score_test(rf, refpri, primargin);
+		exp_score = dfs_ut_ref_score(rf, refpri, primargin);
+		if (score != exp_score) {
+			qdf_nofl_alert("FAIL: refpri %u primargin %u window %u elems %u -> score %d, expected %d",
+				       refpri, primargin,
+				       rf->rf_ignore_pri_window,
+				       dl->dl_numelems, score, exp_score);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * dfs_ut_run() - Feed a random pulse train to a filter
+ * @dfs: Pointer to wlan_dfs structure.
+ * @rf: Pointer to dfs_filter structure.
+ * @scratch: Filter to rebuild the sorted PRIs in.
+ * @seed: random seed
+ *
+ * The filter length and the timestamp steps are picked so that pulses fall
+ * out of the window as well as out of a full delay line. Now and then the
+ * delay line is reset or emptied as on a fixed pattern match, after which
+ * the sorted PRIs must be rebuilt by the next search. Otherwise, while the
+ * delay line is contiguous, they must be kept up to date by dfs_add_pulse()
+ * alone. Whenever they are marked valid they must match a rebuild.
+ *
+ * Return: number of errors
+ */
+static uint32_t dfs_ut_run(struct wlan_dfs *dfs, struct dfs_filter *rf,
+			   struct dfs_filter *scratch, uint64_t *seed)
+{
+	struct dfs_event re = { 0 };
+	uint32_t base, max_step;
+	uint64_t this_ts = 0;
+	uint32_t errors = 0;
+	bool in_sync = false;
+	bool incremental;
+	uint32_t n;
+
+	qdf_mem_zero(rf, sizeof(*rf));
+	dfs_reset_delayline(&rf->rf_dl);
+	rf->rf_ignore_pri_window = dfs_ut_rand(seed, 3);
+	rf->rf_filterlen = 1 + dfs_ut_rand(seed, 100000);
+	max_step = rf->rf_filterlen / (1 + dfs_ut_rand(seed, 128));
+	base = 1 + dfs_ut_rand(seed, 5000);
+
+	for (n = 0; n < DFS_UT_PULSES; n++) {
+		switch (dfs_ut_rand(seed, DFS_UT_RESET_ODDS)) {
+		case 0:
+			dfs_reset_delayline(&rf->rf_dl);
+			in_sync = false;
+			break;
+		case 1:
+			rf->rf_dl.dl_numelems = 0;
+			in_sync = false;
+			break;
+		default:
+			break;
+		}
+
+		incremental = in_sync && dfs_ut_dl_contiguous(&rf->rf_dl);
+		this_ts += dfs_ut_rand(seed, max_step + 1);
+		dfs_add_pulse(dfs, rf, &re, dfs_ut_pri(seed, base), this_ts);
+		errors += dfs_ut_check_sorted(rf, scratch, incremental);
+		in_sync = incremental;
+
+		if (!dfs_ut_rand(seed, DFS_UT_SCORE_ODDS)) {
+			errors += dfs_ut_check_scores(rf, seed, base);
+			in_sync = true;
+		}
+
+		if (errors)
+			break;
+	}
+
+	return errors;
+}
+
+/**
+ * dfs_ut_gen_log() - Generate a pulse log
+ * @log: Pulse log to fill
+ * @num: Number of pulses in @log
+ * @seed: random seed
+ *
+ * Bursts of the radar types in dfs_ut_radars, with PRI jitter and missed
+ * pulses, are interleaved with noise pulses of random duration.
+ */
+static void dfs_ut_gen_log(struct dfs_ut_pulse *log, uint32_t num,
+			   uint64_t *seed)
+{
+	const struct dfs_ut_radar *radar = dfs_ut_radars;
+	uint64_t burst_ts = 0, noise_ts = 0;
+	uint32_t burst_left = 0, pri = 0;
+	uint32_t i = 0;
+
+	while (i < num) {
+		if (!burst_left) {
+			radar = &dfs_ut_radars[dfs_ut_rand(
+					seed, QDF_ARRAY_SIZE(dfs_ut_radars))];
+			if (radar->fixed_pri)
+				pri = (radar->minpri + radar->maxpri) / 2;
+			else
+				pri = radar->minpri + DFS_UT_PRI_JITTER +
+				      dfs_ut_rand(seed, radar->maxpri -
+						  radar->minpri -
+						  2 * DFS_UT_PRI_JITTER + 1);
+			burst_left = radar->numpulses +
+				     dfs_ut_rand(seed, radar->numpulses);
+			burst_ts += DFS_UT_BURST_GAP +
+				    dfs_ut_rand(seed, DFS_UT_BURST_GAP);
+		}
+
+		if (noise_ts < burst_ts) {
+			log[i].ts = noise_ts;
+			log[i++].dur = dfs_ut_rand(seed,
+						   DFS_UT_NOISE_MAXDUR + 1);
+			noise_ts += DFS_UT_NOISE_GAP +
+				    dfs_ut_rand(seed, 15 * DFS_UT_NOISE_GAP);
+			continue;
+		}
+
+		if (dfs_ut_rand(seed, DFS_UT_MISS_ODDS)) {
+			log[i].ts = burst_ts;
+			log[i++].dur = radar->mindur +
+				       dfs_ut_rand(seed, radar->maxdur -
+						   radar->mindur + 1);
+		}
+		burst_ts += pri + dfs_ut_rand(seed, 2 * DFS_UT_PRI_JITTER + 1) -
+			    DFS_UT_PRI_JITTER;
+		burst_left--;
+	}
+}
+
+/**
+ * dfs_ut_init_filters() - Set up a filter for each of dfs_ut_radars
+ * @filters: Filters, one per entry of dfs_ut_radars
+ */
+static void dfs_ut_init_filters(struct dfs_filter *filters)
+{
+	const struct dfs_ut_radar *radar;
+	struct dfs_filter *rf;
+	uint32_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(dfs_ut_radars); i++) {
+		radar = &dfs_ut_radars[i];
+		rf = &filters[i];
+		qdf_mem_zero(rf, sizeof(*rf));
+		dfs_reset_delayline(&rf->rf_dl);
+		rf->rf_numpulses = radar->numpulses;
+		rf->rf_minpri = radar->minpri;
+		rf->rf_maxpri = radar->maxpri;
+		rf->rf_threshold = radar->threshold;
+		rf->rf_filterlen = radar->maxpri * radar->numpulses;
+		rf->rf_fixed_pri_radar_pulse = radar->fixed_pri;
+		rf->rf_mindur = radar->mindur;
+		rf->rf_maxdur = radar->maxdur;
+		rf->rf_ignore_pri_window = radar->ignore_pri_window;
+		rf->rf_pulseid = i;
+	}
+}
+
+/**
+ * dfs_ut_replay_pulse() - Replay a pulse through the filters
+ * @dfs: Pointer to wlan_dfs structure.
+ * @filters: Filters, one per entry of dfs_ut_radars
+ * @pulse: Pulse to replay
+ * @ref_score: PRI scoring to bin check with, NULL for the sorted PRIs
+ *
+ * Each filter is run as __dfs_process_radarevent() runs it: the pulse is
+ * rejected on duration and PRI, else added to the delay line and bin
+ * checked. The delay line is reset on a match as on radar found.
+ *
+ * Return: bitmap of the filters which matched
+ */
+static uint32_t dfs_ut_replay_pulse(struct wlan_dfs *dfs,
+				    struct dfs_filter *filters,
+				    const struct dfs_ut_pulse *pulse,
+				    dfs_ref_score_fn ref_score)
+{
+	struct dfs_event re = { 0 };
+	struct dfs_filter *rf;
+	uint32_t found = 0;
+	uint64_t deltaT;
+	uint32_t i;
+
+	re.re_dur = pulse->dur;
+	for (i = 0; i < QDF_ARRAY_SIZE(dfs_ut_radars); i++) {
+		rf = &filters[i];
+		if (re.re_dur < rf->rf_mindur || re.re_dur > rf->rf_maxdur)
+			continue;
+
+		/* As dfs_reject_on_pri() */
+		deltaT = pulse->ts - rf->rf_dl.dl_last_ts;
+		if (deltaT < rf->rf_minpri && deltaT)
+			continue;
+
+		if (deltaT < rf->rf_minpri ||
+		    (!rf->rf_ignore_pri_window &&
+		     deltaT > dfs->dfs_pri_multiplier * rf->rf_maxpri)) {
+			rf->rf_dl.dl_last_ts = pulse->ts;
+			continue;
+		}
+
+		dfs_add_pulse(dfs, rf, &re, deltaT, pulse->ts);
+		if (dfs_bin_check_test(dfs, rf, deltaT, re.re_dur, 0,
+				       ref_score))
+			found |= BIT(i);
+		rf->rf_dl.dl_last_ts = pulse->ts;
+
+		if (found & BIT(i))
+			dfs_reset_delayline(&rf->rf_dl);
+	}
+
+	return found;
+}
+
+/**
+ * dfs_ut_pulses_per_sec() - Pulse rate of a replay
+ * @pulses: Number of pulses replayed
+ * @elapsed_ns: Time taken
+ *
+ * Return: pulses per second
+ */
+static uint64_t dfs_ut_pulses_per_sec(uint32_t pulses, uint64_t elapsed_ns)
+{
+	uint32_t elapsed_us = qdf_do_div(elapsed_ns, 1000);
+
+	return qdf_do_div((uint64_t)pulses * 1000000, QDF_MAX(elapsed_us, 1));
+}
+
+/**
+ * dfs_ut_replay() - Replay a pulse log with the sorted PRI scoring and with
+ *	the delay line scan
+ * @dfs: Pointer to wlan_dfs structure.
+ * @seed: random seed
+ *
+ * Both replays must match the same filters on the same pulses and leave
+ * the same delay lines behind, as dfs_bin_pri_check() leaves the search
+ * PRI and the sequence numbers the false detection checks run on there.
+ * The pulse rate of each is reported.
+ *
+ * Return: number of errors
+ */
+static uint32_t dfs_ut_replay(struct wlan_dfs *dfs, uint64_t *seed)
+{
+	uint32_t found[DFS_UT_REPLAY_CHUNK], ref_found[DFS_UT_REPLAY_CHUNK];
+	uint64_t elapsed_ns = 0, ref_elapsed_ns = 0, start_ns;
+	uint32_t detections = 0, errors = 0;
+	struct dfs_filter *filters, *ref;
+	struct dfs_ut_pulse *log;
+	uint32_t n, i, chunk;
+
+	log = qdf_mem_malloc(DFS_UT_REPLAY_PULSES * sizeof(*log));
+	filters = qdf_mem_malloc(QDF_ARRAY_SIZE(dfs_ut_radars) *
+				 sizeof(*filters));
+	ref = qdf_mem_malloc(QDF_ARRAY_SIZE(dfs_ut_radars) * sizeof(*ref));
+	if (!log || !filters || !ref) {
+		errors++;
+		goto free;
+	}
+
+	dfs_ut_gen_log(log, DFS_UT_REPLAY_PULSES, seed);
+	dfs_ut_init_filters(filters);
+	dfs_ut_init_filters(ref);
+
+	for (n = 0; n < DFS_UT_REPLAY_PULSES; n += chunk) {
+		chunk = QDF_MIN(DFS_UT_REPLAY_CHUNK, DFS_UT_REPLAY_PULSES - n);
+
+		start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+		for (i = 0; i < chunk; i++)
+			found[i] = dfs_ut_replay_pulse(dfs, filters,
+						       &log[n + i], NULL);
+		elapsed_ns += qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+		start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+		for (i = 0; i < chunk; i++)
+			ref_found[i] = dfs_ut_replay_pulse(dfs, ref,
+							   &log[n + i],
+							   dfs_ut_ref_score);
+		ref_elapsed_ns += qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+		for (i = 0; i < chunk; i++) {
+			if (found[i] != ref_found[i]) {
+				qdf_nofl_alert("FAIL: pulse %u ts %llu dur %u matched filters 0x%x, expected 0x%x",
+					       n + i, log[n + i].ts,
+					       log[n + i].dur, found[i],
+					       ref_found[i]);
+				errors++;
+				goto free;
+			}
+			if (found[i])
+				detections++;
+		}
+
+		for (i = 0; i < QDF_ARRAY_SIZE(dfs_ut_radars); i++) {
+			if (qdf_mem_cmp(&filters[i].rf_dl, &ref[i].rf_dl,
+					offsetof(struct dfs_delayline,
+						 dl_sorted_pri))) {
+				qdf_nofl_alert("FAIL: filter %u delay line differs after pulse %u",
+					       i, n + chunk - 1);
+				errors++;
+				goto free;
+			}
+		}
+	}
+
+	if (!detections) {
+		qdf_nofl_alert("FAIL: no filter matched in %u pulses",
+			       DFS_UT_REPLAY_PULSES);
+		errors++;
+		goto free;
+	}
+
+	qdf_nofl_info("dfs bin check replay: %u pulses, %u detections, sorted PRIs %llu pulses/s, delay line scan %llu pulses/s",
+		      DFS_UT_REPLAY_PULSES, detections,
+		      dfs_ut_pulses_per_sec(DFS_UT_REPLAY_PULSES, elapsed_ns),
+		      dfs_ut_pulses_per_sec(DFS_UT_REPLAY_PULSES,
+					    ref_elapsed_ns));
+
+free:
+	qdf_mem_free(ref);
+	qdf_mem_free(filters);
+	qdf_mem_free(log);
+
+	return errors;
+}
+
+uint32_t dfs_bindetects_unit_test(void)
+{
+	struct dfs_filter *rf, *scratch;
+	uint64_t seed = 0x70726973;
+	struct dfs_channel *chan;
+	struct wlan_dfs *dfs;
+	uint32_t errors = 0;
+	uint32_t run;
+
+	dfs = qdf_mem_malloc(sizeof(*dfs));
+	rf = qdf_mem_malloc(sizeof(*rf));
+	scratch = qdf_mem_malloc(sizeof(*scratch));
+	chan = qdf_mem_malloc(sizeof(*chan));
+	if (!dfs || !rf || !scratch || !chan) {
+		errors++;
+		goto free;
+	}
+
+	for (run = 0; run < DFS_UT_RUNS; run++)
+		errors += dfs_ut_run(dfs, rf, scratch, &seed);
+
+	/* A non HT40 channel, for the PRI margin and filter threshold */
+	dfs->dfs_curchan = chan;
+	dfs->dfs_pri_multiplier = DFS_UT_PRI_MULTIPLIER;
+	if (!errors)
+		errors += dfs_ut_replay(dfs, &seed);
+
+free:
+	qdf_mem_free(chan);
+	qdf_mem_free(scratch);
+	qdf_mem_free(rf);
+	qdf_mem_free(dfs);
+	QDF_BUG(!errors);
+
+	return errors;
+}
@@ -39,6 +39,9 @@
 #include <qdf_event.h>
 #include <qdf_module.h>
 #include <qdf_str.h>
+#ifdef WLAN_LOGGING_PCPU_RING
+#include <linux/rtc.h>
+#endif
 #ifdef WLAN_FEATURE_CONNECTIVITY_LOGGING
 #include <wlan_connectivity_logging.h>
 #endif
@@ -382,37 +385,29 @@ log_to_console(QDF_TRACE_LEVEL level, const char *timestamp, const char *msg)
 }
 #endif
 
-int wlan_log_to_user(QDF_TRACE_LEVEL log_level, char *to_be_sent, int length)
+/**
+ * wlan_log_copy_to_node() - Append a log line to the current log_msg node
+ * @tbuf: context and time stamp prefix
+ * @tlen: length of @tbuf
+ * @msg: log message
+ * @length: length of @msg
+ *
+ * Need to call this with spin_lock acquired.
+ *
+ * Return: true if a filled node was queued and the logger thread needs a
+ *	   wake up
+ */
+static bool wlan_log_copy_to_node(const char *tbuf, int tlen,
+				  const char *msg, int length)
 {
 	char *ptr;
-	char tbuf[60];
-	int tlen;
 	int total_log_len;
 	unsigned int *pfilled_length;
 	bool wake_up_thread = false;
-	unsigned long flags;
-	uint64_t ts;
-
-	/* Add the current time stamp */
-	ts = qdf_get_log_timestamp();
-	tlen = wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
-
-	/* if logging isn't up yet, just dump to dmesg */
-	if (!gwlan_logging.is_active) {
-		log_to_console(log_level, tbuf, to_be_sent);
-		return 0;
-	}
 
 	/* 1+1 indicate '\n'+'\0' */
 	total_log_len = length + tlen + 1 + 1;
 
-	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
-	/* wlan logging svc resources are not yet initialized */
-	if (!gwlan_logging.pcur_node) {
-		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
-		return -EIO;
-	}
-
 	pfilled_length = &gwlan_logging.pcur_node->filled_length;
 
 	/* Check if we can accommodate more log into current node/buffer */
@@ -442,11 +437,492 @@ int wlan_log_to_user(QDF_TRACE_LEVEL log_level, char *to_be_sent, int length)
 	}
 
 	memcpy(&ptr[*pfilled_length], tbuf, tlen);
-	memcpy(&ptr[*pfilled_length + tlen], to_be_sent, length);
+	memcpy(&ptr[*pfilled_length + tlen], msg, length);
 	*pfilled_length += tlen + length;
 	ptr[*pfilled_length] = '\n';
 	*pfilled_length += 1;
 
+	return wake_up_thread;
+}
+
+#ifdef WLAN_LOGGING_PCPU_RING
+/* Size in bytes of each per-CPU log ring, must be a power of 2 */
+#ifndef WLAN_LOG_RING_SIZE
+#define WLAN_LOG_RING_SIZE (32 * 1024)
+#endif
+#define WLAN_LOG_RING_MASK (WLAN_LOG_RING_SIZE - 1)
+#define WLAN_LOG_REC_ALIGN 8
+/* Record length marking the unused end of the ring before a wrap */
+#define WLAN_LOG_REC_WRAP 0xffff
+/* Longest message text kept in a ring record */
+#define WLAN_LOG_REC_MAX_TEXT (MAX_LOGMSG_LENGTH / 2)
+/* Ring fill level in bytes at which the producer wakes the logger thread */
+#define WLAN_LOG_RING_WAKE_THRESH MAX_LOGMSG_LENGTH
+/* Records merged per spin_lock hold and batches per logger thread pass */
+#define WLAN_LOG_DRAIN_BATCH 64
+#define WLAN_LOG_DRAIN_MAX_BATCHES 64
+
+/**
+ * struct wlan_log_rec - binary log record in a per-CPU log ring
+ * @len: length of the message text following the header, or
+ *	 WLAN_LOG_REC_WRAP for the padding up to the end of the ring
+ * @level: trace level of the message
+ * @comm: logging context name, first 6 characters
+ * @ts: qdf_get_log_timestamp() value, also the merge key across CPUs
+ * @real_ns: wall clock time used for the time of the day string
+ */
+struct wlan_log_rec {
+	uint16_t len;
+	uint8_t level;
+	char comm[7];
+	uint64_t ts;
+	uint64_t real_ns;
+};
+
+/**
+ * struct wlan_log_ring - per-CPU single producer, single consumer log ring
+ * @buf: ring storage of WLAN_LOG_RING_SIZE bytes
+ * @head: free running producer offset, only written by the owning CPU
+ * @tail: free running consumer offset, written under gwlan_logging.spin_lock
+ * @drop_count: records dropped because the ring was full
+ * @drop_reported: part of @drop_count already reported in the log stream
+ * @trunc_count: messages cut to WLAN_LOG_REC_MAX_TEXT
+ * @trunc_reported: part of @trunc_count already reported in the log stream
+ * @max_fill: high watermark of the ring fill level in bytes
+ */
+struct wlan_log_ring {
+	char *buf;
+	unsigned long head;
+	unsigned long tail;
+	uint32_t drop_count;
+	uint32_t drop_reported;
+	uint32_t trunc_count;
+	uint32_t trunc_reported;
+	uint32_t max_fill;
+};
+
+static DEFINE_PER_CPU(struct wlan_log_ring, wlan_log_rings);
+static char *gwlan_log_ring_mem;
+
+/**
+ * wlan_log_ring_enqueue() - Store a log line in the local CPU log ring
+ * @log_level: trace level of the message
+ * @ts: log time stamp
+ * @msg: log message
+ * @length: length of @msg
+ *
+ * The ring is only written by its own CPU with interrupts disabled, so no
+ * shared lock is taken. The record is published to the logger thread by
+ * the release store of the ring head. A full ring drops the record, and
+ * messages longer than WLAN_LOG_REC_MAX_TEXT are truncated.
+ *
+ * Return: false if the rings are not available and the caller has to use
+ *	   the shared log buffer, true otherwise
+ */
+static bool wlan_log_ring_enqueue(QDF_TRACE_LEVEL log_level, uint64_t ts,
+				  const char *msg, int length)
+{
+	struct wlan_log_ring *ring;
+	struct wlan_log_rec *rec;
+	unsigned long flags;
+	unsigned long head, used;
+	unsigned int off, pad, rec_len;
+	char *buf;
+	bool kick, trunc = false;
+
+	if (length > WLAN_LOG_REC_MAX_TEXT) {
+		length = WLAN_LOG_REC_MAX_TEXT;
+		trunc = true;
+	}
+	rec_len = ALIGN(sizeof(*rec) + length, WLAN_LOG_REC_ALIGN);
+
+	local_irq_save(flags);
+	ring = this_cpu_ptr(&wlan_log_rings);
+	buf = READ_ONCE(ring->buf);
+	if (!buf) {
+		local_irq_restore(flags);
+		return false;
+	}
+
+	head = ring->head;
+	off = head & WLAN_LOG_RING_MASK;
+	pad = WLAN_LOG_RING_SIZE - off;
+	if (pad >= rec_len)
+		pad = 0;
+
+	used = head - smp_load_acquire(&ring->tail);
+	if (used + pad + rec_len > WLAN_LOG_RING_SIZE) {
+		ring->drop_count++;
+		local_irq_restore(flags);
+		return true;
+	}
+
+	if (pad) {
+		rec = (struct wlan_log_rec *)&buf[off];
+		rec->len = WLAN_LOG_REC_WRAP;
+		off = 0;
+	}
+
+	rec = (struct wlan_log_rec *)&buf[off];
+	rec->len = length;
+	strlcpy(rec->comm, current_process_name(), sizeof(rec->comm));
+	rec->ts = ts;
+	rec->real_ns = ktime_get_real_ns();
+	rec->level = log_level;
+	memcpy(rec + 1, msg, length);
+	if (trunc)
+		ring->trunc_count++;
+
+	smp_store_release(&ring->head, head + pad + rec_len);
+
+	kick = used < WLAN_LOG_RING_WAKE_THRESH;
+	used += pad + rec_len;
+	kick = kick && used >= WLAN_LOG_RING_WAKE_THRESH;
+	if (used > ring->max_fill)
+		ring->max_fill = used;
+	local_irq_restore(flags);
+
+	if (kick) {
+		set_bit(HOST_LOG_DRIVER_MSG, &gwlan_logging.eventFlag);
+		wake_up_interruptible(&gwlan_logging.wait_queue);
+	}
+
+	return true;
+}
+
+/**
+ * wlan_log_ring_peek() - Get the oldest record of a log ring
+ * @ring: per-CPU log ring
+ *
+ * Need to call this with spin_lock acquired.
+ *
+ * Return: oldest record, or NULL if the ring is empty
+ */
+static struct wlan_log_rec *wlan_log_ring_peek(struct wlan_log_ring *ring)
+{
+	unsigned long head = smp_load_acquire(&ring->head);
+	struct wlan_log_rec *rec;
+
+	while (ring->tail != head) {
+		rec = (struct wlan_log_rec *)
+		      &ring->buf[ring->tail & WLAN_LOG_RING_MASK];
+		if (rec->len != WLAN_LOG_REC_WRAP)
+			return rec;
+
+		/* Skip the padding to the start of the ring */
+		smp_store_release(&ring->tail,
+				  (ring->tail | WLAN_LOG_RING_MASK) + 1);
+	}
+
+	return NULL;
+}
+
+/**
+ * wlan_log_rec_time_stamp() - Format the prefix of a ring record
+ * @tbuf: Pointer to time stamp buffer
+ * @tbuf_sz: Time buffer size
+ * @rec: ring record
+ *
+ * Same format as wlan_add_user_log_time_stamp(), built from the values
+ * captured when the record was written.
+ *
+ * Return: number of characters written in target buffer
+ */
+static int wlan_log_rec_time_stamp(char *tbuf, size_t tbuf_sz,
+				   struct wlan_log_rec *rec)
+{
+	struct rtc_time tm;
+	uint64_t secs = rec->real_ns;
+	uint32_t nsecs;
+
+	nsecs = do_div(secs, NSEC_PER_SEC);
+	/* Convert rtc to local time */
+	rtc_time64_to_tm((u32)(secs - (sys_tz.tz_minuteswest * 60)), &tm);
+
+	return scnprintf(tbuf, tbuf_sz,
+			 "[%.6s][0x%llx][%02d:%02d:%02d.%06u]",
+			 rec->comm, (unsigned long long)rec->ts,
+			 tm.tm_hour, tm.tm_min, tm.tm_sec, nsecs / 1000);
+}
+
+/**
+ * wlan_log_rings_merge() - Move ring records into the log_msg nodes
+ * @budget: maximum number of records to move
+ * @wake_up_thread: set if a filled node was queued for the app
+ *
+ * Records of all CPUs are merged in log time stamp order, and the time
+ * stamp string is only formatted here, out of the logging hot path.
+ * Need to call this with spin_lock acquired.
+ *
+ * Return: number of records moved
+ */
+static int wlan_log_rings_merge(int budget, bool *wake_up_thread)
+{
+	struct wlan_log_ring *ring, *oldest_ring;
+	struct wlan_log_rec *rec, *oldest;
+	char tbuf[60];
+	int tlen;
+	int cpu;
+	int count;
+
+	for (count = 0; count < budget && gwlan_logging.pcur_node; count++) {
+		oldest = NULL;
+		oldest_ring = NULL;
+		for_each_possible_cpu(cpu) {
+			ring = per_cpu_ptr(&wlan_log_rings, cpu);
+			if (!ring->buf)
+				continue;
+
+			rec = wlan_log_ring_peek(ring);
+			if (rec && (!oldest || rec->ts < oldest->ts)) {
+				oldest = rec;
+				oldest_ring = ring;
+			}
+		}
+
+		if (!oldest)
+			break;
+
+		tlen = wlan_log_rec_time_stamp(tbuf, sizeof(tbuf), oldest);
+		if (wlan_log_copy_to_node(tbuf, tlen, (char *)(oldest + 1),
+					  oldest->len))
+			*wake_up_thread = true;
+
+		smp_store_release(&oldest_ring->tail,
+				  oldest_ring->tail +
+				  ALIGN(sizeof(*oldest) + oldest->len,
+					WLAN_LOG_REC_ALIGN));
+	}
+
+	return count;
+}
+
+/**
+ * wlan_log_rings_report_drops() - Add ring drops and truncations to the
+ *				   log stream
+ * @wake_up_thread: set if a filled node was queued for the app
+ *
+ * Need to call this with spin_lock acquired.
+ *
+ * Return: None
+ */
+static void wlan_log_rings_report_drops(bool *wake_up_thread)
+{
+	struct wlan_log_ring *ring;
+	uint32_t drop_count, trunc_count;
+	char msg[100];
+	int len;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		drop_count = READ_ONCE(ring->drop_count);
+		trunc_count = READ_ONCE(ring->trunc_count);
+		if (!ring->buf || !gwlan_logging.pcur_node ||
+		    (drop_count == ring->drop_reported &&
+		     trunc_count == ring->trunc_reported))
+			continue;
+
+		len = scnprintf(msg, sizeof(msg),
+				"[wlan_log] cpu%d: %u records dropped, %u truncated, %u log buffers overwritten",
+				cpu, drop_count - ring->drop_reported,
+				trunc_count - ring->trunc_reported,
+				gwlan_logging.drop_count);
+		if (wlan_log_copy_to_node("", 0, msg, len))
+			*wake_up_thread = true;
+		ring->drop_reported = drop_count;
+		ring->trunc_reported = trunc_count;
+	}
+}
+
+/**
+ * wlan_logging_drain_rings() - Drain the per-CPU log rings
+ *
+ * Records are moved in batches so that spin_lock is not held for the whole
+ * ring contents. If the rings still hold records after the last batch, the
+ * logger thread is scheduled again.
+ *
+ * Return: true if a filled node was queued for the app
+ */
+static bool wlan_logging_drain_rings(void)
+{
+	unsigned long flags;
+	bool wake_up_thread = false;
+	int batches = 0;
+	int count;
+
+	do {
+		spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+		count = wlan_log_rings_merge(WLAN_LOG_DRAIN_BATCH,
+					     &wake_up_thread);
+		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+	} while (count == WLAN_LOG_DRAIN_BATCH &&
+		 ++batches < WLAN_LOG_DRAIN_MAX_BATCHES);
+
+	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+	wlan_log_rings_report_drops(&wake_up_thread);
+	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+
+	if (count == WLAN_LOG_DRAIN_BATCH)
+		set_bit(HOST_LOG_DRIVER_MSG, &gwlan_logging.eventFlag);
+
+	return wake_up_thread;
+}
+
+/**
+ * wlan_log_rings_empty() - Check if all per-CPU log rings are drained
+ *
+ * Return: true if no ring holds a record
+ */
+static bool wlan_log_rings_empty(void)
+{
+	struct wlan_log_ring *ring;
+	unsigned long flags;
+	bool empty = true;
+	int cpu;
+
+	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		if (ring->buf && wlan_log_ring_peek(ring)) {
+			empty = false;
+			break;
+		}
+	}
+	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+
+	return empty;
+}
+
+/**
+ * wlan_log_rings_init() - Allocate the per-CPU log rings
+ *
+ * On failure logging falls back to the shared log buffer.
+ *
+ * Return: None
+ */
+static void wlan_log_rings_init(void)
+{
+	struct wlan_log_ring *ring;
+	int cpu;
+	int i = 0;
+
+	gwlan_log_ring_mem = qdf_mem_valloc(num_possible_cpus() *
+					    WLAN_LOG_RING_SIZE);
+	if (!gwlan_log_ring_mem) {
+		qdf_err("Could not allocate per-CPU log rings");
+		return;
+	}
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		qdf_mem_zero(ring, sizeof(*ring));
+		WRITE_ONCE(ring->buf,
+			   &gwlan_log_ring_mem[i++ * WLAN_LOG_RING_SIZE]);
+	}
+}
+
+/**
+ * wlan_log_rings_deinit() - Free the per-CPU log rings
+ *
+ * Return: None
+ */
+static void wlan_log_rings_deinit(void)
+{
+	struct wlan_log_ring *ring;
+	int cpu;
+
+	if (!gwlan_log_ring_mem)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		if (ring->drop_count || ring->trunc_count)
+			qdf_info("cpu%d log ring: dropped %u truncated %u max fill %u",
+				 cpu, ring->drop_count, ring->trunc_count,
+				 ring->max_fill);
+		WRITE_ONCE(ring->buf, NULL);
+	}
+
+	/*
+	 * Producers access the ring with interrupts disabled, which is an
+	 * RCU read side critical section, so none of them can still be
+	 * writing to the ring memory after this.
+	 */
+	synchronize_rcu();
+
+	qdf_mem_vfree(gwlan_log_ring_mem);
+	gwlan_log_ring_mem = NULL;
+}
+#else
+static inline bool
+wlan_log_ring_enqueue(QDF_TRACE_LEVEL log_level, uint64_t ts,
+		      const char *msg, int length)
+{
+	return false;
+}
+
+static inline int wlan_log_rings_merge(int budget, bool *wake_up_thread)
+{
+	return 0;
+}
+
+static inline bool wlan_logging_drain_rings(void)
+{
+	return false;
+}
+
+static inline bool wlan_log_rings_empty(void)
+{
+	return true;
+}
+
+static inline void wlan_log_rings_init(void)
+{
+}
+
+static inline void wlan_log_rings_deinit(void)
+{
+}
+#endif /* WLAN_LOGGING_PCPU_RING */
+
+int wlan_log_to_user(QDF_TRACE_LEVEL log_level, char *to_be_sent, int length)
+{
+	char tbuf[60];
+	int tlen;
+	bool wake_up_thread = false;
+	unsigned long flags;
+	uint64_t ts;
+
+	/* Add the current time stamp */
+	ts = qdf_get_log_timestamp();
+
+	/* if logging isn't up yet, just dump to dmesg */
+	if (!gwlan_logging.is_active) {
+		wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
+		log_to_console(log_level, tbuf, to_be_sent);
+		return 0;
+	}
+
+	if (wlan_log_ring_enqueue(log_level, ts, to_be_sent, length)) {
+		if (gwlan_logging.console_log_levels & BIT(log_level)) {
+			wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
+			log_to_console(log_level, tbuf, to_be_sent);
+		}
+		return 0;
+	}
+
+	tlen = wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
+
+	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+	/* wlan logging svc resources are not yet initialized */
+	if (!gwlan_logging.pcur_node) {
+		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+		return -EIO;
+	}
+
+	wake_up_thread = wlan_log_copy_to_node(tbuf, tlen, to_be_sent, length);
+
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
 
 	/* Wakeup logger thread */
@@ -829,6 +1305,37 @@ wlan_logging_send_connectivity_event(void)
  *
  * This thread logs log message to App registered for the logs.
  */
+#ifdef WLAN_LOGGING_PCPU_RING
+/**
+ * wlan_logging_flush_rings() - Send out the records left in the per-CPU
+ *				log rings when the logger thread stops
+ *
+ * Filled nodes are sent between the passes, so that the merge gets free
+ * nodes again. The number of passes is bounded in case the nodes cannot be
+ * sent.
+ *
+ * Return: None
+ */
+static void wlan_logging_flush_rings(void)
+{
+	unsigned long flags;
+	int passes = 0;
+
+	while (!wlan_log_rings_empty() &&
+	       passes++ < WLAN_LOG_DRAIN_MAX_BATCHES) {
+		wlan_logging_drain_rings();
+		spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+		wlan_queue_logmsg_for_app();
+		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+		send_filled_buffers_to_user();
+	}
+}
+#else
+static inline void wlan_logging_flush_rings(void)
+{
+}
+#endif /* WLAN_LOGGING_PCPU_RING */
+
 static int wlan_logging_thread(void *Arg)
 {
 	int ret_wait_status = 0;
@@ -866,6 +1373,7 @@ static int wlan_logging_thread(void *Arg)
 
 		if (test_and_clear_bit(HOST_LOG_DRIVER_MSG,
 					&gwlan_logging.eventFlag)) {
+			wlan_logging_drain_rings();
 			ret = send_filled_buffers_to_user();
 			if (-ENOMEM == ret)
 				msleep(200);
@@ -902,6 +1410,7 @@ static int wlan_logging_thread(void *Arg)
 			} else {
 				gwlan_logging.is_flush_complete = true;
 				/* Flush all current host logs*/
+				wlan_logging_drain_rings();
 				spin_lock_irqsave(&gwlan_logging.spin_lock,
 					flags);
 				wlan_queue_logmsg_for_app();
@@ -924,6 +1433,7 @@ static int wlan_logging_thread(void *Arg)
 			  &gwlan_logging.eventFlag);
 	}
 
+	wlan_logging_flush_rings();
 	complete_and_exit(&gwlan_logging.shutdown_comp, 0);
 
 	return 0;
@@ -1033,8 +1543,11 @@ static int wlan_logging_panic_handler(struct notifier_block *this,
 	char *log;
 	struct log_msg *plog_msg;
 	unsigned long flags;
+	bool wake_up_thread = false;
 
 	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+	/* Pull in the records still held in the per-CPU log rings */
+	wlan_log_rings_merge(INT_MAX, &wake_up_thread);
 	/* Iterate over nodes queued for app */
 	while (!list_empty(&gwlan_logging.filled_list)) {
 		plog_msg = (struct log_msg *)
@@ -1151,6 +1664,7 @@ int wlan_logging_sock_init_svc(void)
 	list_del_init(gwlan_logging.free_list.next);
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, irq_flag);
 
+	wlan_log_rings_init();
 	flush_timer_init();
 
 	/* Initialize the pktStats data structure here */
@@ -1229,6 +1743,7 @@ err2:
 	gpkt_stats_buffers = NULL;
 err1:
 	flush_timer_deinit();
+	wlan_log_rings_deinit();
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	gwlan_logging.pcur_node = NULL;
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, irq_flag);
@@ -1275,6 +1790,7 @@ int wlan_logging_sock_deinit_svc(void)
 
 	/* Delete the Flush timer then mark pcur_node NULL */
 	flush_timer_deinit();
+	wlan_log_rings_deinit();
 
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	gwlan_logging.pcur_node = NULL;
@@ -1344,6 +1860,7 @@ void wlan_flush_host_logs_for_fatal(void)
 
 	if (gwlan_logging.flush_timer_period == 0)
 		qdf_info("Flush all host logs Setting HOST_LOG_POST_MAS");
+	wlan_logging_drain_rings();
 	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
 	wlan_queue_logmsg_for_app();
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
@@ -993,6 +993,67 @@
 		0, 50, 15, \
 		CFG_VALUE_OR_DEFAULT, "Stop queue Threshold")
 
+#define WLAN_CFG_TX_AQM_TARGET 5
+#define WLAN_CFG_TX_AQM_TARGET_MIN 1
+#define WLAN_CFG_TX_AQM_TARGET_MAX 100
+
+/*
+ * <ini>
+ * TxAqmTargetMs - Queueing delay target of the tx sojourn AQM
+ * @Min: 1
+ * @Max: 100
+ * @Default: 5
+ *
+ * This ini is used to set, in milliseconds, the queueing delay a flow
+ * controlled tx sub-queue may build up in the hw rings before it is paused.
+ * It is counted on top of the service time of the sub-queue, which is
+ * tracked as the lowest sojourn seen recently.
+ *
+ * Related: TxAqmIntervalMs
+ *
+ * Supported Feature: STA,P2P and SAP
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_TX_AQM_TARGET \
+		CFG_INI_UINT("TxAqmTargetMs", \
+		WLAN_CFG_TX_AQM_TARGET_MIN, \
+		WLAN_CFG_TX_AQM_TARGET_MAX, \
+		WLAN_CFG_TX_AQM_TARGET, \
+		CFG_VALUE_OR_DEFAULT, "Tx AQM target in ms")
+
+#define WLAN_CFG_TX_AQM_INTERVAL 100
+#define WLAN_CFG_TX_AQM_INTERVAL_MIN 10
+#define WLAN_CFG_TX_AQM_INTERVAL_MAX 1000
+
+/*
+ * <ini>
+ * TxAqmIntervalMs - Observation interval of the tx sojourn AQM
+ * @Min: 10
+ * @Max: 1000
+ * @Default: 100
+ *
+ * This ini is used to set, in milliseconds, how long the queueing delay of
+ * a tx sub-queue has to stay above TxAqmTargetMs before it is paused, and
+ * below it before it is resumed.
+ *
+ * Related: TxAqmTargetMs
+ *
+ * Supported Feature: STA,P2P and SAP
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_TX_AQM_INTERVAL \
+		CFG_INI_UINT("TxAqmIntervalMs", \
+		WLAN_CFG_TX_AQM_INTERVAL_MIN, \
+		WLAN_CFG_TX_AQM_INTERVAL_MAX, \
+		WLAN_CFG_TX_AQM_INTERVAL, \
+		CFG_VALUE_OR_DEFAULT, "Tx AQM interval in ms")
+
 #define CFG_DP_IPA_UC_TX_BUF_SIZE \
 		CFG_INI_UINT("IpaUcTxBufSize", \
 		0, 4096, WLAN_CFG_IPA_UC_TX_BUF_SIZE, \
@@ -1183,6 +1244,34 @@
 #define CFG_DP_SWLM_ENABLE \
 	CFG_INI_BOOL("gEnableSWLM", false, \
 		     "Enable/Disable DP SWLM")
+
+#define WLAN_CFG_SWLM_LATENCY_SLO 1000
+#define WLAN_CFG_SWLM_LATENCY_SLO_MIN 100
+#define WLAN_CFG_SWLM_LATENCY_SLO_MAX 10000
+
+/*
+ * <ini>
+ * gSWLMLatencySLO - Latency budget for DP Software latency manager
+ * @Min: 100
+ * @Max: 10000
+ * @Default: 1000
+ *
+ * This ini is used to bound, in microseconds, the delay that coalescing
+ * may add to a TCL head pointer write. The coalescing time and bytes
+ * thresholds are adapted at runtime to stay within this budget.
+ *
+ * Supported Feature: STA,P2P and SAP IPA disabled terminating
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_SWLM_LATENCY_SLO \
+	CFG_INI_UINT("gSWLMLatencySLO", \
+		     WLAN_CFG_SWLM_LATENCY_SLO_MIN, \
+		     WLAN_CFG_SWLM_LATENCY_SLO_MAX, \
+		     WLAN_CFG_SWLM_LATENCY_SLO, \
+		     CFG_VALUE_OR_DEFAULT, "DP SWLM latency SLO in us")
 /*
  * <ini>
  * wow_check_rx_pending_enable - control to check RX frames pending in Wow
@@ -1205,6 +1294,149 @@
 		CFG_INI_BOOL("delay_mon_replenish", \
 		true, "Delay Monitor Replenish")
 
+#define WLAN_CFG_SRNG_SERVICE_POLICY_MIN 0
+#define WLAN_CFG_SRNG_SERVICE_POLICY_MAX 2
+#define WLAN_CFG_SRNG_SERVICE_POLICY 0
+
+#define WLAN_CFG_SRNG_SERVICE_WEIGHT_MIN 1
+#define WLAN_CFG_SRNG_SERVICE_WEIGHT_MAX 16
+#define WLAN_CFG_SRNG_SERVICE_TX_WEIGHT 1
+#define WLAN_CFG_SRNG_SERVICE_RX_WEIGHT 1
+
+/*
+ * <ini>
+ * dp_srng_service_policy - Budget split between TX completion and REO
+ * destination rings in one DP interrupt context poll
+ * @Min: 0
+ * @Max: 2
+ * @Default: 0
+ *
+ * 0 - TX completion rings are serviced first with the full budget and the
+ *     REO destination rings get what is left
+ * 1 - Weighted round robin, the budget is split as per
+ *     dp_srng_service_tx_weight and dp_srng_service_rx_weight
+ * 2 - Deficit based, each ring class earns budget as per its weight and
+ *     ring backlog, unused budget of a backlogged class is carried over
+ *
+ * In modes 1 and 2, budget left unused by one class is given to the other.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_SRNG_SERVICE_POLICY \
+		CFG_INI_UINT("dp_srng_service_policy", \
+		WLAN_CFG_SRNG_SERVICE_POLICY_MIN, \
+		WLAN_CFG_SRNG_SERVICE_POLICY_MAX, \
+		WLAN_CFG_SRNG_SERVICE_POLICY, \
+		CFG_VALUE_OR_DEFAULT, "DP SRNG servicing policy")
+
+/*
+ * <ini>
+ * dp_srng_service_tx_weight - Weight of the TX completion rings
+ * @Min: 1
+ * @Max: 16
+ * @Default: 1
+ *
+ * Used only when dp_srng_service_policy is 1 or 2.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_SRNG_SERVICE_TX_WEIGHT \
+		CFG_INI_UINT("dp_srng_service_tx_weight", \
+		WLAN_CFG_SRNG_SERVICE_WEIGHT_MIN, \
+		WLAN_CFG_SRNG_SERVICE_WEIGHT_MAX, \
+		WLAN_CFG_SRNG_SERVICE_TX_WEIGHT, \
+		CFG_VALUE_OR_DEFAULT, "DP TX completion ring service weight")
+
+/*
+ * <ini>
+ * dp_srng_service_rx_weight - Weight of the REO destination rings
+ * @Min: 1
+ * @Max: 16
+ * @Default: 1
+ *
+ * Used only when dp_srng_service_policy is 1 or 2.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_SRNG_SERVICE_RX_WEIGHT \
+		CFG_INI_UINT("dp_srng_service_rx_weight", \
+		WLAN_CFG_SRNG_SERVICE_WEIGHT_MIN, \
+		WLAN_CFG_SRNG_SERVICE_WEIGHT_MAX, \
+		WLAN_CFG_SRNG_SERVICE_RX_WEIGHT, \
+		CFG_VALUE_OR_DEFAULT, "DP REO destination ring service weight")
+
+#define WLAN_CFG_INTR_MOD_TIMER_MAX_MIN 8
+#define WLAN_CFG_INTR_MOD_TIMER_MAX_MAX 1000
+#define WLAN_CFG_INTR_MOD_TIMER_MAX 256
+
+#define WLAN_CFG_INTR_MOD_BATCH_MAX_MIN 1
+#define WLAN_CFG_INTR_MOD_BATCH_MAX_MAX 256
+#define WLAN_CFG_INTR_MOD_BATCH_MAX 32
+
+/*
+ * <ini>
+ * dp_intr_mod_enable - Adaptive interrupt moderation of the REO destination
+ * and TX completion rings
+ * @Default: false
+ *
+ * When enabled, the packet rate of each DP interrupt context is sampled and
+ * the interrupt timer/batch thresholds of its REO destination and TX
+ * completion rings are raised for bulk traffic, up to dp_intr_mod_timer_max
+ * and dp_intr_mod_batch_max, and brought back to the static configuration
+ * when the rate drops.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_ENABLE \
+		CFG_INI_BOOL("dp_intr_mod_enable", false, \
+		"DP adaptive interrupt moderation")
+
+/*
+ * <ini>
+ * dp_intr_mod_timer_max - Highest interrupt timer threshold in us used by
+ * the adaptive interrupt moderation
+ * @Min: 8
+ * @Max: 1000
+ * @Default: 256
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_TIMER_MAX \
+		CFG_INI_UINT("dp_intr_mod_timer_max", \
+		WLAN_CFG_INTR_MOD_TIMER_MAX_MIN, \
+		WLAN_CFG_INTR_MOD_TIMER_MAX_MAX, \
+		WLAN_CFG_INTR_MOD_TIMER_MAX, \
+		CFG_VALUE_OR_DEFAULT, "DP interrupt moderation max timer")
+
+/*
+ * <ini>
+ * dp_intr_mod_batch_max - Highest interrupt batch counter threshold in ring
+ * entries used by the adaptive interrupt moderation
+ * @Min: 1
+ * @Max: 256
+ * @Default: 32
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_INTR_MOD_BATCH_MAX \
+		CFG_INI_UINT("dp_intr_mod_batch_max", \
+		WLAN_CFG_INTR_MOD_BATCH_MAX_MIN, \
+		WLAN_CFG_INTR_MOD_BATCH_MAX_MAX, \
+		WLAN_CFG_INTR_MOD_BATCH_MAX, \
+		CFG_VALUE_OR_DEFAULT, "DP interrupt moderation max batch")
+
 #ifdef QCA_VDEV_STATS_HW_OFFLOAD_SUPPORT
 #define WLAN_CFG_INT_VDEV_STATS_HW_OFFLOAD_TIMER_MIN 500
 #define WLAN_CFG_INT_VDEV_STATS_HW_OFFLOAD_TIMER_MAX 2000
@@ -1529,6 +1761,8 @@
 		CFG(CFG_DP_PER_PKT_LOGGING) \
 		CFG(CFG_DP_TX_FLOW_START_QUEUE_OFFSET) \
 		CFG(CFG_DP_TX_FLOW_STOP_QUEUE_TH) \
+		CFG(CFG_DP_TX_AQM_TARGET) \
+		CFG(CFG_DP_TX_AQM_INTERVAL) \
 		CFG(CFG_DP_IPA_UC_TX_BUF_SIZE) \
 		CFG(CFG_DP_IPA_UC_TX_PARTITION_BASE) \
 		CFG(CFG_DP_IPA_UC_RX_IND_RING_COUNT) \
@@ -1553,6 +1787,7 @@
 		CFG(CFG_DP_LEGACY_MODE_CSUM_DISABLE) \
 		CFG(CFG_DP_POLL_MODE_ENABLE) \
 		CFG(CFG_DP_SWLM_ENABLE) \
+		CFG(CFG_DP_SWLM_LATENCY_SLO) \
 		CFG(CFG_DP_TX_PER_PKT_VDEV_ID_CHECK) \
 		CFG(CFG_DP_RX_FST_IN_CMEM) \
 		CFG(CFG_DP_RX_RADIO_0_DEFAULT_REO) \
@@ -1561,6 +1796,12 @@
 		CFG(CFG_DP_WOW_CHECK_RX_PENDING) \
 		CFG(CFG_DP_HW_CC_ENABLE) \
 		CFG(CFG_DP_DELAY_MON_REPLENISH) \
+		CFG(CFG_DP_SRNG_SERVICE_POLICY) \
+		CFG(CFG_DP_SRNG_SERVICE_TX_WEIGHT) \
+		CFG(CFG_DP_SRNG_SERVICE_RX_WEIGHT) \
+		CFG(CFG_DP_INTR_MOD_ENABLE) \
+		CFG(CFG_DP_INTR_MOD_TIMER_MAX) \
+		CFG(CFG_DP_INTR_MOD_BATCH_MAX) \
 		CFG(CFG_DP_TX_MONITOR_BUF_RING) \
 		CFG(CFG_DP_TX_MONITOR_DST_RING) \
 		CFG_DP_IPA_TX_RING_CFG \
@@ -1958,6 +1958,8 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 		cfg_get(psoc, CFG_DP_TX_FLOW_START_QUEUE_OFFSET);
 	wlan_cfg_ctx->tx_flow_stop_queue_threshold =
 		cfg_get(psoc, CFG_DP_TX_FLOW_STOP_QUEUE_TH);
+	wlan_cfg_ctx->tx_aqm_target = cfg_get(psoc, CFG_DP_TX_AQM_TARGET);
+	wlan_cfg_ctx->tx_aqm_interval = cfg_get(psoc, CFG_DP_TX_AQM_INTERVAL);
 	wlan_cfg_ctx->disable_intra_bss_fwd =
 		cfg_get(psoc, CFG_DP_AP_STA_SECURITY_SEPERATION);
 	wlan_cfg_ctx->rx_sw_desc_weight = cfg_get(psoc,
@@ -1990,6 +1992,7 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 	wlan_cfg_ctx->is_poll_mode_enabled =
 			cfg_get(psoc, CFG_DP_POLL_MODE_ENABLE);
 	wlan_cfg_ctx->is_swlm_enabled = cfg_get(psoc, CFG_DP_SWLM_ENABLE);
+	wlan_cfg_ctx->swlm_latency_slo = cfg_get(psoc, CFG_DP_SWLM_LATENCY_SLO);
 	wlan_cfg_ctx->fst_in_cmem = cfg_get(psoc, CFG_DP_RX_FST_IN_CMEM);
 	wlan_cfg_ctx->tx_per_pkt_vdev_id_check =
 			cfg_get(psoc, CFG_DP_TX_PER_PKT_VDEV_ID_CHECK);
@@ -2007,6 +2010,18 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 					CFG_DP_RXDMA_MONITOR_BUF_RING);
 	wlan_cfg_ctx->tx_mon_buf_ring_size = cfg_get(psoc,
 					CFG_DP_TX_MONITOR_BUF_RING);
+	wlan_cfg_ctx->srng_service_policy =
+			cfg_get(psoc, CFG_DP_SRNG_SERVICE_POLICY);
+	wlan_cfg_ctx->srng_service_tx_weight =
+			cfg_get(psoc, CFG_DP_SRNG_SERVICE_TX_WEIGHT);
+	wlan_cfg_ctx->srng_service_rx_weight =
+			cfg_get(psoc, CFG_DP_SRNG_SERVICE_RX_WEIGHT);
+	wlan_cfg_ctx->intr_mod_enable =
+			cfg_get(psoc, CFG_DP_INTR_MOD_ENABLE);
+	wlan_cfg_ctx->intr_mod_timer_max =
+			cfg_get(psoc, CFG_DP_INTR_MOD_TIMER_MAX);
+	wlan_cfg_ctx->intr_mod_batch_max =
+			cfg_get(psoc, CFG_DP_INTR_MOD_BATCH_MAX);
 	wlan_soc_ipa_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_soc_hw_cc_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_soc_ppe_cfg_attach(psoc, wlan_cfg_ctx);
@@ -2818,6 +2833,16 @@ int wlan_cfg_get_tx_flow_start_queue_offset(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return cfg->tx_flow_start_queue_offset;
 }
+
+uint32_t wlan_cfg_get_tx_aqm_target(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->tx_aqm_target;
+}
+
+uint32_t wlan_cfg_get_tx_aqm_interval(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->tx_aqm_interval;
+}
 #endif /* QCA_LL_TX_FLOW_CONTROL_V2 */
 
 void wlan_cfg_set_rx_flow_tag_enabled(struct wlan_cfg_dp_soc_ctxt *cfg,
@@ -2958,12 +2983,52 @@ bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return (bool)(cfg->is_swlm_enabled);
 }
+
+uint32_t wlan_cfg_get_swlm_latency_slo(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->swlm_latency_slo;
+}
 #else
 bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return false;
 }
+
+uint32_t wlan_cfg_get_swlm_latency_slo(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return WLAN_CFG_SWLM_LATENCY_SLO;
+}
 #endif
+uint8_t wlan_cfg_get_srng_service_policy(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->srng_service_policy;
+}
+
+uint8_t wlan_cfg_get_srng_service_tx_weight(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->srng_service_tx_weight;
+}
+
+uint8_t wlan_cfg_get_srng_service_rx_weight(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->srng_service_rx_weight;
+}
+
+bool wlan_cfg_is_intr_mod_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_enable;
+}
+
+uint16_t wlan_cfg_get_intr_mod_timer_max(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_timer_max;
+}
+
+uint16_t wlan_cfg_get_intr_mod_batch_max(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->intr_mod_batch_max;
+}
+
 uint8_t wlan_cfg_radio0_default_reo_get(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return cfg->radio0_rx_default_reo;
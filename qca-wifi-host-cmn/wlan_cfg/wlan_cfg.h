@@ -179,6 +179,8 @@ struct wlan_srng_cfg {
  * @nan_tcp_udp_checksumoffload: enable/disable checksum offload for NAN mode
  * @tcp_udp_checksumoffload: enable/disable checksum offload
  * @nss_cfg: nss configuration
+ * @tx_aqm_target: tx sojourn AQM queueing delay target in ms
+ * @tx_aqm_interval: tx sojourn AQM observation interval in ms
  * @rx_defrag_min_timeout: rx defrag minimum timeout
  * @wbm_release_ring: wbm release ring size
  * @tcl_cmd_credit_ring: tcl command/credit ring size
@@ -228,6 +230,7 @@ struct wlan_srng_cfg {
  * @rx_pending_high_threshold: threshold of starting pkt drop
  * @rx_pending_low_threshold: threshold of stopping pkt drop
  * @is_swlm_enabled: flag to enable/disable SWLM
+ * @swlm_latency_slo: max delay in us SWLM may add to a TCL HP write
  * @tx_per_pkt_vdev_id_check: Enable tx perpkt vdev id check
  * @wow_check_rx_pending_enable: Enable RX frame pending check in WoW
  * @ipa_tx_ring_size: IPA tx ring size
@@ -247,6 +250,12 @@ struct wlan_srng_cfg {
  * @vdev_stats_hw_offload_config: HW vdev stats config
  * @vdev_stats_hw_offload_timer: HW vdev stats timer duration
  * @num_rxdma_status_rings_per_pdev: Num RXDMA status rings
+ * @srng_service_policy: TX completion/REO destination ring budget policy
+ * @srng_service_tx_weight: TX completion ring weight for the budget split
+ * @srng_service_rx_weight: REO destination ring weight for the budget split
+ * @intr_mod_enable: adaptive interrupt moderation of the DP rings enabled
+ * @intr_mod_timer_max: highest interrupt timer threshold in us
+ * @intr_mod_batch_max: highest interrupt batch threshold in entries
  */
 struct wlan_cfg_dp_soc_ctxt {
 	int num_int_ctxts;
@@ -314,6 +323,8 @@ struct wlan_cfg_dp_soc_ctxt {
 	int nss_cfg;
 	uint32_t tx_flow_stop_queue_threshold;
 	uint32_t tx_flow_start_queue_offset;
+	uint32_t tx_aqm_target;
+	uint32_t tx_aqm_interval;
 	int rx_defrag_min_timeout;
 	int reo_dst_ring_size;
 	int wbm_release_ring;
@@ -366,6 +377,7 @@ struct wlan_cfg_dp_soc_ctxt {
 	uint32_t rx_pending_low_threshold;
 	bool is_poll_mode_enabled;
 	uint8_t is_swlm_enabled;
+	uint32_t swlm_latency_slo;
 	bool fst_in_cmem;
 	bool tx_per_pkt_vdev_id_check;
 	uint8_t radio0_rx_default_reo;
@@ -406,6 +418,12 @@ struct wlan_cfg_dp_soc_ctxt {
 #endif
 	uint8_t num_rxdma_dst_rings_per_pdev;
 	uint8_t num_rxdma_status_rings_per_pdev;
+	uint8_t srng_service_policy;
+	uint8_t srng_service_tx_weight;
+	uint8_t srng_service_rx_weight;
+	bool intr_mod_enable;
+	uint16_t intr_mod_timer_max;
+	uint16_t intr_mod_batch_max;
 };
 
 /**
@@ -1490,6 +1508,22 @@ void wlan_set_srng_cfg(struct wlan_srng_cfg **wlan_cfg);
 int wlan_cfg_get_tx_flow_stop_queue_th(struct wlan_cfg_dp_soc_ctxt *cfg);
 
 int wlan_cfg_get_tx_flow_start_queue_offset(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_tx_aqm_target() - Get tx sojourn AQM target
+ * @cfg: soc configuration context
+ *
+ * Return: queueing delay target in ms
+ */
+uint32_t wlan_cfg_get_tx_aqm_target(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_tx_aqm_interval() - Get tx sojourn AQM interval
+ * @cfg: soc configuration context
+ *
+ * Return: observation interval in ms
+ */
+uint32_t wlan_cfg_get_tx_aqm_interval(struct wlan_cfg_dp_soc_ctxt *cfg);
 #endif /* QCA_LL_TX_FLOW_CONTROL_V2 */
 int wlan_cfg_get_rx_defrag_min_timeout(struct wlan_cfg_dp_soc_ctxt *cfg);
 
@@ -1731,6 +1765,14 @@ bool wlan_cfg_is_fst_in_cmem_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
  */
 bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/**
+ * wlan_cfg_get_swlm_latency_slo() - Get SWLM latency SLO
+ * @cfg: soc configuration context
+ *
+ * Return: max delay in us SWLM may add to a TCL HP register write
+ */
+uint32_t wlan_cfg_get_swlm_latency_slo(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 #ifdef IPA_OFFLOAD
 /*
  * wlan_cfg_ipa_tx_ring_size - Get Tx DMA ring size (TCL Data Ring)
@@ -1987,6 +2029,69 @@ wlan_cfg_get_vdev_stats_hw_offload_config(struct wlan_cfg_dp_soc_ctxt *cfg);
  */
 int wlan_cfg_get_vdev_stats_hw_offload_timer(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/**
+ * enum wlan_cfg_srng_service_policy - DP SRNG servicing policy
+ * @WLAN_CFG_SRNG_SERVICE_FIXED: TX completion rings first, full budget
+ * @WLAN_CFG_SRNG_SERVICE_WRR: budget split as per the ring class weights
+ * @WLAN_CFG_SRNG_SERVICE_DEFICIT: budget earned as per weight and backlog
+ */
+enum wlan_cfg_srng_service_policy {
+	WLAN_CFG_SRNG_SERVICE_FIXED,
+	WLAN_CFG_SRNG_SERVICE_WRR,
+	WLAN_CFG_SRNG_SERVICE_DEFICIT,
+};
+
+/**
+ * wlan_cfg_get_srng_service_policy() - Get the DP SRNG servicing policy
+ * @cfg: soc configuration context
+ *
+ * Return: enum wlan_cfg_srng_service_policy
+ */
+uint8_t wlan_cfg_get_srng_service_policy(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_srng_service_tx_weight() - Get the TX completion ring weight
+ * @cfg: soc configuration context
+ *
+ * Return: weight
+ */
+uint8_t wlan_cfg_get_srng_service_tx_weight(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_srng_service_rx_weight() - Get the REO destination ring weight
+ * @cfg: soc configuration context
+ *
+ * Return: weight
+ */
+uint8_t wlan_cfg_get_srng_service_rx_weight(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_is_intr_mod_enabled() - Check if adaptive interrupt moderation
+ *				    of the DP rings is enabled
+ * @cfg: soc configuration context
+ *
+ * Return: true if enabled
+ */
+bool wlan_cfg_is_intr_mod_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_intr_mod_timer_max() - Get the highest interrupt timer
+ *				       threshold of the interrupt moderation
+ * @cfg: soc configuration context
+ *
+ * Return: timer threshold in us
+ */
+uint16_t wlan_cfg_get_intr_mod_timer_max(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_intr_mod_batch_max() - Get the highest interrupt batch
+ *				       threshold of the interrupt moderation
+ * @cfg: soc configuration context
+ *
+ * Return: batch threshold in ring entries
+ */
+uint16_t wlan_cfg_get_intr_mod_batch_max(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 #if defined(WLAN_FEATURE_11BE_MLO) && defined(WLAN_MLO_MULTI_CHIP)
 /**
  * wlan_cfg_mlo_rx_ring_map_get_by_chip_id() - get rx ring map
@@ -230,6 +230,60 @@ void pkt_capture_mon(struct pkt_capture_cb_context *cb_ctx, qdf_nbuf_t msdu,
 QDF_STATUS pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 				  struct wlan_objmgr_vdev *vdev);
 
+/**
+ * pkt_capture_set_data_match() - Set packet capture data frame match
+ * @vdev: pointer to vdev
+ * @match: peer/tid/ethertype/port match, flags 0 clears it
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_set_data_match(struct wlan_objmgr_vdev *vdev,
+				      struct pkt_capture_data_match *match);
+
+/**
+ * pkt_capture_is_data_match() - Check 802.3 data frame against data match
+ * @vdev: pointer to vdev
+ * @eth_hdr: start of the 802.3 header
+ * @len: bytes available at @eth_hdr
+ *
+ * Only reads the frame, so it is meant to run on the original buffer
+ * before any copy is made for the mon thread.
+ *
+ * Return: true if the frame is to be captured
+ */
+bool pkt_capture_is_data_match(struct wlan_objmgr_vdev *vdev,
+			       uint8_t *eth_hdr, uint32_t len);
+
+#ifdef WLAN_PKT_CAPTURE_TEST
+/**
+ * pkt_capture_data_match_frame_test() - Check frame against a given match
+ * @match: data match to apply, flags 0 matches everything
+ * @eth_hdr: start of the 802.3 header
+ * @len: bytes available at @eth_hdr
+ *
+ * Runs the parser behind pkt_capture_is_data_match() without a vdev.
+ *
+ * Return: true if the frame is to be captured
+ */
+bool pkt_capture_data_match_frame_test(struct pkt_capture_data_match *match,
+				       uint8_t *eth_hdr, uint32_t len);
+#endif
+
+/**
+ * pkt_capture_nbuf_copy() - Copy data frame, truncated to the snap length
+ * @vdev: pointer to vdev
+ * @nbuf: buffer to copy
+ * @offset: bytes in front of the 802.3 header in @nbuf data
+ *
+ * Like qdf_nbuf_copy() the headroom and the nbuf cb are carried over, as
+ * the rx descriptor/TLVs in the headroom are read by the mon thread. Only
+ * @offset plus the configured snap length bytes of data are copied.
+ *
+ * Return: copied nbuf on success, NULL on failure
+ */
+qdf_nbuf_t pkt_capture_nbuf_copy(struct wlan_objmgr_vdev *vdev,
+				 qdf_nbuf_t nbuf, uint32_t offset);
+
 /**
  * pkt_capture_is_tx_mgmt_enable - Check if tx mgmt frames enabled
  * @pdev: pointer to pdev
@@ -23,6 +23,7 @@
 #ifndef _WLAN_PKT_CAPTURE_MON_THREAD_H_
 #define _WLAN_PKT_CAPTURE_MON_THREAD_H_
 
+#include "qdf_atomic.h"
 #include "wlan_pkt_capture_main.h"
 
 #define PKT_CAPTURE_RX_POST_EVENT 0x01
@@ -90,6 +91,9 @@ struct pkt_capture_mon_pkt {
  * @mon_pkt_freeq_lock: Lock to synchronize free buffer queue access
  * @mon_pkt_freeq: Free message queue for packet capture MON processing
  * @is_mon_thread_suspended: flag to check mon thread suspended or not
+ * @stats: mon thread queue and drop stats
+ * @filtered: data frames rejected by the data match, from rx and tx comp
+ * @snapped: data frames truncated to the snap length, from rx and tx comp
  */
 struct pkt_capture_mon_context {
 	/* MON thread lock */
@@ -112,6 +116,9 @@ struct pkt_capture_mon_context {
 
 	struct list_head mon_pkt_freeq;
 	bool is_mon_thread_suspended;
+	struct pkt_capture_mon_stats stats;
+	qdf_atomic_t filtered;
+	qdf_atomic_t snapped;
 };
 
 /**
@@ -156,6 +163,16 @@ void pkt_capture_resume_mon_thread(struct wlan_objmgr_vdev *vdev);
  */
 void pkt_capture_drop_monpkt(struct pkt_capture_mon_context *mon_ctx);
 
+/**
+ * pkt_capture_get_mon_stats() - get packet capture mon thread stats
+ * @vdev: pointer to vdev object manager
+ * @stats: buffer to copy the stats to
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_get_mon_stats(struct wlan_objmgr_vdev *vdev,
+				     struct pkt_capture_mon_stats *stats);
+
 /**
  * pkt_capture_indicate_monpkt() - API to Indicate rx data packet
  * @vdev: pointer to vdev object manager
@@ -568,11 +568,20 @@ void pkt_capture_msdu_process_pkts(
 {
 	qdf_nbuf_t loop_msdu, pktcapture_msdu;
 	qdf_nbuf_t msdu, prev = NULL;
+	struct wlan_objmgr_vdev *vdev;
+
+	vdev = pkt_capture_get_vdev();
+	if (qdf_unlikely(!vdev))
+		return;
 
 	pktcapture_msdu = NULL;
 	loop_msdu = head_msdu;
 	while (loop_msdu) {
-		msdu = qdf_nbuf_copy(loop_msdu);
+		if (pkt_capture_is_data_match(vdev, qdf_nbuf_data(loop_msdu),
+					      qdf_nbuf_len(loop_msdu)))
+			msdu = pkt_capture_nbuf_copy(vdev, loop_msdu, 0);
+		else
+			msdu = NULL;
 
 		if (msdu) {
 			qdf_nbuf_push_head(msdu,
@@ -607,11 +616,18 @@ void pkt_capture_msdu_process_pkts(
 {
 	qdf_nbuf_t loop_msdu, pktcapture_msdu, offload_msdu = NULL;
 	qdf_nbuf_t msdu, prev = NULL;
+	struct wlan_objmgr_vdev *vdev;
 
+	vdev = pkt_capture_get_vdev();
 	pktcapture_msdu = NULL;
 	loop_msdu = head_msdu;
 	while (loop_msdu) {
-		msdu = qdf_nbuf_copy(loop_msdu);
+		if (vdev &&
+		    pkt_capture_is_data_match(vdev, qdf_nbuf_data(loop_msdu),
+					      qdf_nbuf_len(loop_msdu)))
+			msdu = pkt_capture_nbuf_copy(vdev, loop_msdu, 0);
+		else
+			msdu = NULL;
 
 		if (msdu) {
 			qdf_nbuf_set_next(msdu, NULL);
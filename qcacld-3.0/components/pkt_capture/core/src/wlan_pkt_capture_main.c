@@ -34,6 +34,7 @@
 #include "cdp_txrx_ctrl.h"
 #include "wlan_pkt_capture_tgt_api.h"
 #include <cds_ieee80211_common.h>
+#include <enet.h>
 #include "wlan_vdev_mgr_utils_api.h"
 
 static struct wlan_objmgr_vdev *gp_pkt_capture_vdev;
@@ -160,15 +161,176 @@ pkt_capture_get_pktcap_mode_v2()
 #define RX_OFFLOAD_PKT 1
 #define PPDU_STATS_Q_MAX_SIZE 500
 
+/* L4 ports sit in the first four bytes of both TCP and UDP headers */
+#define PKT_CAPTURE_L4_PORTS_LEN 4
+/* Highest 802.1d user priority a DSCP precedence maps to */
+#define PKT_CAPTURE_MAX_USER_PRIO 7
+
+/**
+ * pkt_capture_data_match_frame() - Check 802.3 data frame against a match
+ * @match: data match to apply, with at least one field selected
+ * @eth_hdr: start of the 802.3 header
+ * @len: bytes available at @eth_hdr
+ *
+ * Frames too short to hold a header needed by a selected field do not
+ * match.
+ *
+ * Return: true if all fields selected in @match are found in the frame
+ */
+static bool
+pkt_capture_data_match_frame(const struct pkt_capture_data_match *match,
+			     const uint8_t *eth_hdr, uint32_t len)
+{
+	const struct ethernet_hdr_t *eth =
+				(const struct ethernet_hdr_t *)eth_hdr;
+	const uint8_t *l3_hdr;
+	uint32_t l3_len, l4_off;
+	uint16_t ether_type, src_port, dst_port;
+	uint8_t l4_proto, tos;
+
+	if (len < sizeof(*eth))
+		return false;
+
+	if ((match->flags & PKT_CAPTURE_DATA_MATCH_PEER) &&
+	    qdf_mem_cmp(eth->dest_addr, match->peer_mac.bytes,
+			QDF_MAC_ADDR_SIZE) &&
+	    qdf_mem_cmp(eth->src_addr, match->peer_mac.bytes,
+			QDF_MAC_ADDR_SIZE))
+		return false;
+
+	ether_type = (eth->ethertype[0] << 8) | eth->ethertype[1];
+	if ((match->flags & PKT_CAPTURE_DATA_MATCH_ETHER_TYPE) &&
+	    ether_type != match->ether_type)
+		return false;
+
+	if (!(match->flags & (PKT_CAPTURE_DATA_MATCH_TID |
+			      PKT_CAPTURE_DATA_MATCH_PORT)))
+		return true;
+
+	l3_hdr = eth_hdr + sizeof(*eth);
+	l3_len = len - sizeof(*eth);
+	if (ether_type == QDF_NBUF_TRAC_IPV4_ETH_TYPE) {
+		if (l3_len < QDF_NBUF_TRAC_IPV4_HEADER_SIZE)
+			return false;
+		tos = l3_hdr[1];
+		l4_proto = l3_hdr[9];
+		l4_off = (l3_hdr[0] & QDF_NBUF_TRAC_IPV4_HEADER_MASK) << 2;
+		if (l4_off < QDF_NBUF_TRAC_IPV4_HEADER_SIZE)
+			return false;
+	} else if (ether_type == QDF_NBUF_TRAC_IPV6_ETH_TYPE) {
+		if (l3_len < QDF_NBUF_TRAC_IPV6_HEADER_SIZE)
+			return false;
+		tos = (l3_hdr[0] << 4) | (l3_hdr[1] >> 4);
+		l4_proto = l3_hdr[6];
+		l4_off = QDF_NBUF_TRAC_IPV6_HEADER_SIZE;
+	} else {
+		return false;
+	}
+
+	/* Same DSCP precedence to user priority mapping the AP uses */
+	if ((match->flags & PKT_CAPTURE_DATA_MATCH_TID) &&
+	    (tos >> 5) != match->tid)
+		return false;
+
+	if (match->flags & PKT_CAPTURE_DATA_MATCH_PORT) {
+		if (l4_proto != QDF_NBUF_TRAC_TCP_TYPE &&
+		    l4_proto != QDF_NBUF_TRAC_UDP_TYPE)
+			return false;
+
+		if (l3_len < l4_off + PKT_CAPTURE_L4_PORTS_LEN)
+			return false;
+
+		src_port = (l3_hdr[l4_off] << 8) | l3_hdr[l4_off + 1];
+		dst_port = (l3_hdr[l4_off + 2] << 8) | l3_hdr[l4_off + 3];
+		if (src_port != match->port && dst_port != match->port)
+			return false;
+	}
+
+	return true;
+}
+
+#ifdef WLAN_PKT_CAPTURE_TEST
+bool pkt_capture_data_match_frame_test(struct pkt_capture_data_match *match,
+				       uint8_t *eth_hdr, uint32_t len)
+{
+	return !match->flags ||
+	       pkt_capture_data_match_frame(match, eth_hdr, len);
+}
+#endif
+
+bool pkt_capture_is_data_match(struct wlan_objmgr_vdev *vdev,
+			       uint8_t *eth_hdr, uint32_t len)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+	struct pkt_capture_data_match match;
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (qdf_unlikely(!vdev_priv))
+		return false;
+
+	/* Work on a snapshot, the match can be replaced from user space */
+	qdf_spin_lock_bh(&vdev_priv->data_match_lock);
+	match = vdev_priv->data_match;
+	qdf_spin_unlock_bh(&vdev_priv->data_match_lock);
+
+	if (!match.flags || pkt_capture_data_match_frame(&match, eth_hdr, len))
+		return true;
+
+	if (vdev_priv->mon_ctx)
+		qdf_atomic_inc(&vdev_priv->mon_ctx->filtered);
+
+	return false;
+}
+
+qdf_nbuf_t pkt_capture_nbuf_copy(struct wlan_objmgr_vdev *vdev,
+				 qdf_nbuf_t nbuf, uint32_t offset)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+	uint32_t snap_len, headroom, copy_len;
+	qdf_nbuf_t msdu;
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (qdf_unlikely(!vdev_priv))
+		return NULL;
+
+	snap_len = vdev_priv->cfg_params.snap_len;
+	if (!snap_len || qdf_nbuf_len(nbuf) <= offset + snap_len ||
+	    qdf_nbuf_is_nonlinear(nbuf))
+		return qdf_nbuf_copy(nbuf);
+
+	headroom = qdf_nbuf_headroom(nbuf);
+	copy_len = offset + snap_len;
+
+	msdu = qdf_nbuf_alloc(NULL, headroom + copy_len, headroom, 0, false);
+	if (!msdu)
+		return NULL;
+
+	qdf_nbuf_put_tail(msdu, copy_len);
+	qdf_mem_copy(qdf_nbuf_data(msdu) - headroom,
+		     qdf_nbuf_data(nbuf) - headroom, headroom + copy_len);
+	qdf_mem_copy(qdf_nbuf_get_cb(msdu), qdf_nbuf_get_cb(nbuf),
+		     sizeof(struct qdf_nbuf_cb));
+
+	if (vdev_priv->mon_ctx)
+		qdf_atomic_inc(&vdev_priv->mon_ctx->snapped);
+
+	return msdu;
+}
+
 static void
 pkt_capture_process_rx_data_no_peer(void *soc, uint16_t vdev_id, uint8_t *bssid,
 				    uint32_t status, qdf_nbuf_t nbuf)
 {
 	uint32_t pkt_len, l3_hdr_pad, nbuf_len;
 	struct dp_soc *psoc = soc;
+	struct wlan_objmgr_vdev *vdev;
 	qdf_nbuf_t msdu;
 	uint8_t *rx_tlv_hdr;
 
+	vdev = pkt_capture_get_vdev();
+	if (qdf_unlikely(!vdev))
+		goto drop_offload_pkt;
+
 	nbuf_len = QDF_NBUF_CB_RX_PKT_LEN(nbuf);
 	rx_tlv_hdr = qdf_nbuf_data(nbuf);
 	l3_hdr_pad = hal_rx_msdu_end_l3_hdr_padding_get(psoc->hal_soc,
@@ -176,6 +338,10 @@ pkt_capture_process_rx_data_no_peer(void *soc, uint16_t vdev_id, uint8_t *bssid,
 	pkt_len = nbuf_len + l3_hdr_pad + psoc->rx_pkt_tlv_size;
 	qdf_nbuf_set_pktlen(nbuf, pkt_len);
 
+	if (!pkt_capture_is_data_match(vdev, rx_tlv_hdr + l3_hdr_pad +
+				       psoc->rx_pkt_tlv_size, nbuf_len))
+		goto drop_offload_pkt;
+
 	/*
 	 * Offload rx packets are delivered only to pkt capture component, so
 	 * can modify the received nbuf, in other cases create a private copy
@@ -185,7 +351,8 @@ pkt_capture_process_rx_data_no_peer(void *soc, uint16_t vdev_id, uint8_t *bssid,
 	if (status == RX_OFFLOAD_PKT)
 		msdu = nbuf;
 	else
-		msdu = qdf_nbuf_copy(nbuf);
+		msdu = pkt_capture_nbuf_copy(vdev, nbuf, l3_hdr_pad +
+					     psoc->rx_pkt_tlv_size);
 
 	if (!msdu)
 		return;
@@ -198,6 +365,11 @@ pkt_capture_process_rx_data_no_peer(void *soc, uint16_t vdev_id, uint8_t *bssid,
 			TXRX_PROCESS_TYPE_DATA_RX, 0, 0,
 			TXRX_PKTCAPTURE_PKT_FORMAT_8023,
 			bssid, psoc, 0);
+	return;
+
+drop_offload_pkt:
+	if (status == RX_OFFLOAD_PKT)
+		qdf_nbuf_free(nbuf);
 }
 
 static void
@@ -267,8 +439,11 @@ pkt_capture_process_tx_data(void *soc, void *log_data, u_int16_t vdev_id,
 			sizeof(struct pkt_capture_tx_hdr_elem_t);
 
 	struct dp_tx_desc_s *desc = log_data;
+	struct pkt_capture_vdev_priv *vdev_priv;
+	struct wlan_objmgr_vdev *vdev;
 	qdf_nbuf_t netbuf;
 	int nbuf_len;
+	uint32_t snap_len;
 
 	hal_tx_comp_get_status(&desc->comp, &tx_comp_status,
 			       psoc->hal_soc);
@@ -297,13 +472,39 @@ pkt_capture_process_tx_data(void *soc, void *log_data, u_int16_t vdev_id,
 	tid = tx_comp_status.tid;
 	status = tx_comp_status.status;
 
+	vdev = pkt_capture_get_vdev();
+	if (qdf_unlikely(!vdev))
+		return;
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (qdf_unlikely(!vdev_priv))
+		return;
+
 	if (desc->frm_type == dp_tx_frm_tso) {
 		if (!desc->tso_desc)
 			return;
 		tso_seg = desc->tso_desc;
 		nbuf_len = tso_seg->seg.total_len;
+
+		/* First tso frag carries the 802.3/IP/TCP headers */
+		if (!pkt_capture_is_data_match(
+				vdev, tso_seg->seg.tso_frags[0].vaddr,
+				tso_seg->seg.tso_frags[0].length))
+			return;
 	} else {
 		nbuf_len = qdf_nbuf_len(desc->nbuf);
+
+		if (!pkt_capture_is_data_match(vdev,
+					       qdf_nbuf_data(desc->nbuf),
+					       nbuf_len))
+			return;
+	}
+
+	snap_len = vdev_priv->cfg_params.snap_len;
+	if (snap_len && nbuf_len > snap_len) {
+		nbuf_len = snap_len;
+		if (vdev_priv->mon_ctx)
+			qdf_atomic_inc(&vdev_priv->mon_ctx->snapped);
 	}
 
 	netbuf = qdf_nbuf_alloc(NULL,
@@ -338,13 +539,16 @@ pkt_capture_process_tx_data(void *soc, void *log_data, u_int16_t vdev_id,
 		ip_len = tso_seg->seg.tso_flags.ip_len;
 		ip_len = qdf_cpu_to_be16(ip_len);
 
-		for (frag_cnt = 0; frag_cnt <= num_frags; frag_cnt++) {
+		for (frag_cnt = 0; frag_cnt <= num_frags &&
+		     frag_len < nbuf_len; frag_cnt++) {
+			int len = qdf_min(
+				(int)tso_seg->seg.tso_frags[frag_cnt].length,
+				nbuf_len - frag_len);
+
 			qdf_mem_copy(
 			qdf_nbuf_data(netbuf) + frag_len,
-			tso_seg->seg.tso_frags[frag_cnt].vaddr,
-			tso_seg->seg.tso_frags[frag_cnt].length);
-			frag_len +=
-				tso_seg->seg.tso_frags[frag_cnt].length;
+			tso_seg->seg.tso_frags[frag_cnt].vaddr, len);
+			frag_len += len;
 		}
 
 		qdf_mem_copy((qdf_nbuf_data(netbuf) +
@@ -958,6 +1162,8 @@ pkt_capture_mon_context_create(struct pkt_capture_vdev_priv *vdev_priv)
 	if (!mon_context)
 		return QDF_STATUS_E_NOMEM;
 
+	qdf_atomic_init(&mon_context->filtered);
+	qdf_atomic_init(&mon_context->snapped);
 	vdev_priv->mon_ctx = mon_context;
 
 	return QDF_STATUS_SUCCESS;
@@ -1008,6 +1214,11 @@ pkt_capture_cfg_init(struct pkt_psoc_priv *psoc_priv)
 
 	cfg_param->pkt_capture_mode = cfg_get(psoc_priv->psoc,
 					      CFG_PKT_CAPTURE_MODE);
+	cfg_param->snap_len = cfg_get(psoc_priv->psoc,
+				      CFG_PKT_CAPTURE_SNAP_LEN);
+	if (cfg_param->snap_len &&
+	    cfg_param->snap_len < CFG_PKT_CAPTURE_SNAP_LEN_MIN)
+		cfg_param->snap_len = CFG_PKT_CAPTURE_SNAP_LEN_MIN;
 }
 
 QDF_STATUS
@@ -1015,6 +1226,7 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 {
 	struct pkt_capture_mon_context *mon_ctx;
 	struct pkt_capture_vdev_priv *vdev_priv;
+	struct pkt_psoc_priv *psoc_priv;
 	QDF_STATUS status;
 
 	if ((wlan_vdev_mlme_get_opmode(vdev) != QDF_STA_MODE) ||
@@ -1035,8 +1247,13 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	}
 
 	vdev_priv->vdev = vdev;
+	qdf_spinlock_create(&vdev_priv->data_match_lock);
 	gp_pkt_capture_vdev = vdev;
 
+	psoc_priv = pkt_capture_psoc_get_priv(wlan_vdev_get_psoc(vdev));
+	if (psoc_priv)
+		vdev_priv->cfg_params.snap_len = psoc_priv->cfg_param.snap_len;
+
 	status = pkt_capture_callback_ctx_create(vdev_priv);
 	if (!QDF_IS_STATUS_SUCCESS(status)) {
 		pkt_capture_err("Failed to create callback context");
@@ -1074,6 +1291,7 @@ destroy_mon_context:
 destroy_pkt_capture_cb_context:
 	pkt_capture_callback_ctx_destroy(vdev_priv);
 detach_vdev_priv:
+	qdf_spinlock_destroy(&vdev_priv->data_match_lock);
 	wlan_objmgr_vdev_component_obj_detach(vdev,
 					      WLAN_UMAC_COMP_PKT_CAPTURE,
 					      vdev_priv);
@@ -1108,6 +1326,7 @@ pkt_capture_vdev_destroy_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	}
 	qdf_list_destroy(&vdev_priv->ppdu_stats_q);
 	qdf_spinlock_destroy(&vdev_priv->lock_q);
+	qdf_spinlock_destroy(&vdev_priv->data_match_lock);
 
 	status = wlan_objmgr_vdev_component_obj_detach(
 					vdev,
@@ -1201,6 +1420,39 @@ void pkt_capture_record_channel(struct wlan_objmgr_vdev *vdev)
 				CDP_MONITOR_FREQUENCY, val);
 }
 
+QDF_STATUS pkt_capture_set_data_match(struct wlan_objmgr_vdev *vdev,
+				      struct pkt_capture_data_match *match)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+
+	if (!vdev) {
+		pkt_capture_err("vdev is NULL");
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv) {
+		pkt_capture_err("vdev_priv is NULL");
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if ((match->flags & PKT_CAPTURE_DATA_MATCH_TID) &&
+	    match->tid > PKT_CAPTURE_MAX_USER_PRIO) {
+		pkt_capture_err("invalid tid %u", match->tid);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_spin_lock_bh(&vdev_priv->data_match_lock);
+	vdev_priv->data_match = *match;
+	qdf_spin_unlock_bh(&vdev_priv->data_match_lock);
+
+	pkt_capture_debug("data match flags 0x%x tid %u ether type 0x%x port %u peer " QDF_MAC_ADDR_FMT,
+			  match->flags, match->tid, match->ether_type,
+			  match->port, QDF_MAC_ADDR_REF(match->peer_mac.bytes));
+
+	return QDF_STATUS_SUCCESS;
+}
+
 QDF_STATUS pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 				  struct wlan_objmgr_vdev *vdev)
 {
@@ -229,6 +229,7 @@ pkt_capture_alloc_mon_pkt(struct wlan_objmgr_vdev *vdev)
 
 	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
 	if (list_empty(&mon_ctx->mon_pkt_freeq)) {
+		mon_ctx->stats.freeq_empty++;
 		spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
 		return NULL;
 	}
@@ -261,11 +262,40 @@ void pkt_capture_indicate_monpkt(struct wlan_objmgr_vdev *vdev,
 
 	spin_lock_bh(&mon_ctx->mon_queue_lock);
 	list_add_tail(&pkt->list, &mon_ctx->mon_thread_queue);
+	if (++mon_ctx->stats.queue_depth > mon_ctx->stats.queue_depth_max)
+		mon_ctx->stats.queue_depth_max = mon_ctx->stats.queue_depth;
 	spin_unlock_bh(&mon_ctx->mon_queue_lock);
 	set_bit(PKT_CAPTURE_RX_POST_EVENT, &mon_ctx->mon_event_flag);
 	wake_up_interruptible(&mon_ctx->mon_wait_queue);
 }
 
+QDF_STATUS pkt_capture_get_mon_stats(struct wlan_objmgr_vdev *vdev,
+				     struct pkt_capture_mon_stats *stats)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+	struct pkt_capture_mon_context *mon_ctx;
+
+	if (!vdev) {
+		pkt_capture_err("vdev is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv || !vdev_priv->mon_ctx) {
+		pkt_capture_err("packet capture mon context is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+	mon_ctx = vdev_priv->mon_ctx;
+
+	spin_lock_bh(&mon_ctx->mon_queue_lock);
+	qdf_mem_copy(stats, &mon_ctx->stats, sizeof(*stats));
+	spin_unlock_bh(&mon_ctx->mon_queue_lock);
+	stats->filtered = qdf_atomic_read(&mon_ctx->filtered);
+	stats->snapped = qdf_atomic_read(&mon_ctx->snapped);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 void pkt_capture_wakeup_mon_thread(struct wlan_objmgr_vdev *vdev)
 {
 	struct pkt_capture_vdev_priv *vdev_priv;
@@ -308,6 +338,7 @@ pkt_capture_process_from_queue(struct pkt_capture_mon_context *mon_ctx)
 		pkt = list_first_entry(&mon_ctx->mon_thread_queue,
 				       struct pkt_capture_mon_pkt, list);
 		list_del(&pkt->list);
+		mon_ctx->stats.queue_depth--;
 		spin_unlock_bh(&mon_ctx->mon_queue_lock);
 		vdev_id = pkt->vdev_id;
 		tid = pkt->tid;
@@ -435,6 +466,13 @@ void pkt_capture_close_mon_thread(struct pkt_capture_mon_context *mon_ctx)
 	mon_ctx->mon_thread = NULL;
 	pkt_capture_drop_monpkt(mon_ctx);
 	pkt_capture_free_mon_pkt_freeq(mon_ctx);
+
+	pkt_capture_debug("mon q depth max %u freeq empty %u flushed %u filtered %u snapped %u",
+			  mon_ctx->stats.queue_depth_max,
+			  mon_ctx->stats.freeq_empty,
+			  mon_ctx->stats.flushed,
+			  qdf_atomic_read(&mon_ctx->filtered),
+			  qdf_atomic_read(&mon_ctx->snapped));
 }
 
 QDF_STATUS
@@ -474,6 +512,8 @@ void pkt_capture_drop_monpkt(struct pkt_capture_mon_context *mon_ctx)
 				 list)
 		list_move_tail(&pkt->list, &local_list);
 
+	mon_ctx->stats.flushed += mon_ctx->stats.queue_depth;
+	mon_ctx->stats.queue_depth = 0;
 	spin_unlock_bh(&mon_ctx->mon_queue_lock);
 
 	list_for_each_entry_safe(pkt, tmp, &local_list, list) {
@@ -55,8 +55,37 @@
 			CFG_VALUE_OR_DEFAULT, \
 			"Value for packet capture mode")
 
+/* Smallest non-zero snap length, enough for 802.3/IP/TCP headers */
+#define CFG_PKT_CAPTURE_SNAP_LEN_MIN	(64)
+
+/*
+ * <ini>
+ * packet_capture_snap_len - Packet capture data frame snap length
+ * @Min: 0
+ * @Max: 2048
+ * Default: 0 - Capture the whole frame
+ *
+ * This ini is used to limit how many bytes of each captured data frame,
+ * counted from the 802.3 header, are copied to the monitor interface.
+ * Non-zero values smaller than 64 are raised to 64.
+ *
+ * Supported Feature: packet capture
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_PKT_CAPTURE_SNAP_LEN \
+			CFG_INI_UINT("packet_capture_snap_len", \
+			0, \
+			2048, \
+			0, \
+			CFG_VALUE_OR_DEFAULT, \
+			"Packet capture data frame snap length")
+
 #define CFG_PKT_CAPTURE_MODE_ALL \
-	CFG(CFG_PKT_CAPTURE_MODE)
+	CFG(CFG_PKT_CAPTURE_MODE) \
+	CFG(CFG_PKT_CAPTURE_SNAP_LEN)
 #else
 #define CFG_PKT_CAPTURE_MODE_ALL
 #endif /* WLAN_FEATURE_PKT_CAPTURE */
@@ -20,6 +20,8 @@
 #ifndef _WLAN_PKT_CAPTURE_PUBLIC_STRUCTS_H_
 #define _WLAN_PKT_CAPTURE_PUBLIC_STRUCTS_H_
 
+#include "qdf_types.h"
+
 #define PACKET_CAPTURE_DATA_MAX_FILTER BIT(18)
 #define PACKET_CAPTURE_MGMT_MAX_FILTER BIT(5)
 #define PACKET_CAPTURE_CTRL_MAX_FILTER BIT(3)
@@ -254,4 +256,54 @@ struct pkt_capture_frame_filter {
 	uint32_t connected_beacon_interval;
 	uint8_t vendor_attr_to_set;
 };
+
+/**
+ * enum pkt_capture_data_match_flags - data frame match fields
+ * @PKT_CAPTURE_DATA_MATCH_PEER: match source or destination mac address
+ * @PKT_CAPTURE_DATA_MATCH_TID: match user priority taken from IP DSCP/TC
+ * @PKT_CAPTURE_DATA_MATCH_ETHER_TYPE: match 802.3 ethertype
+ * @PKT_CAPTURE_DATA_MATCH_PORT: match TCP/UDP source or destination port
+ */
+enum pkt_capture_data_match_flags {
+	PKT_CAPTURE_DATA_MATCH_PEER = BIT(0),
+	PKT_CAPTURE_DATA_MATCH_TID = BIT(1),
+	PKT_CAPTURE_DATA_MATCH_ETHER_TYPE = BIT(2),
+	PKT_CAPTURE_DATA_MATCH_PORT = BIT(3),
+};
+
+/**
+ * struct pkt_capture_data_match - match applied to data frames before copy
+ * @flags: bitmap of enum pkt_capture_data_match_flags, 0 matches everything
+ * @tid: tid to match
+ * @ether_type: ethertype to match, host byte order
+ * @port: TCP/UDP port to match, host byte order
+ * @peer_mac: peer mac address to match
+ *
+ * All fields selected in @flags have to match for a frame to be captured.
+ */
+struct pkt_capture_data_match {
+	uint8_t flags;
+	uint8_t tid;
+	uint16_t ether_type;
+	uint16_t port;
+	struct qdf_mac_addr peer_mac;
+};
+
+/**
+ * struct pkt_capture_mon_stats - packet capture mon thread stats
+ * @queue_depth: mon packets currently queued to the mon thread
+ * @queue_depth_max: high watermark of @queue_depth
+ * @freeq_empty: frames dropped as no free mon packet was available
+ * @flushed: queued mon packets dropped without being delivered
+ * @filtered: data frames rejected by the data match before copy
+ * @snapped: data frames truncated to the configured snap length
+ */
+struct pkt_capture_mon_stats {
+	uint32_t queue_depth;
+	uint32_t queue_depth_max;
+	uint32_t freeq_empty;
+	uint32_t flushed;
+	uint32_t filtered;
+	uint32_t snapped;
+};
 #endif /* _WLAN_PKT_CAPTURE_PUBLIC_STRUCTS_H_ */
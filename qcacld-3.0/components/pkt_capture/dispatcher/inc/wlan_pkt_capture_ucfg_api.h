@@ -297,6 +297,30 @@ QDF_STATUS
 ucfg_pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 			    struct wlan_objmgr_vdev *vdev);
 
+/**
+ * ucfg_pkt_capture_set_data_match() - ucfg API to set data frame match
+ * @vdev: pointer to vdev
+ * @match: peer/tid/ethertype/port match, flags 0 clears it
+ *
+ * Data frames that do not match are dropped before they are copied.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_set_data_match(struct wlan_objmgr_vdev *vdev,
+				struct pkt_capture_data_match *match);
+
+/**
+ * ucfg_pkt_capture_get_mon_stats() - ucfg API to get mon thread stats
+ * @vdev: pointer to vdev
+ * @stats: buffer to copy the stats to
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_get_mon_stats(struct wlan_objmgr_vdev *vdev,
+			       struct pkt_capture_mon_stats *stats);
+
 #else
 static inline
 QDF_STATUS ucfg_pkt_capture_init(void)
@@ -446,5 +470,19 @@ ucfg_pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 	return QDF_STATUS_SUCCESS;
 }
 
+static inline QDF_STATUS
+ucfg_pkt_capture_set_data_match(struct wlan_objmgr_vdev *vdev,
+				struct pkt_capture_data_match *match)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline QDF_STATUS
+ucfg_pkt_capture_get_mon_stats(struct wlan_objmgr_vdev *vdev,
+			       struct pkt_capture_mon_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
 #endif /* WLAN_FEATURE_PKT_CAPTURE */
 #endif /* _WLAN_PKT_CAPTURE_UCFG_API_H_ */
@@ -346,3 +346,17 @@ ucfg_pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 {
 	return pkt_capture_set_filter(frame_filter, vdev);
 }
+
+QDF_STATUS
+ucfg_pkt_capture_set_data_match(struct wlan_objmgr_vdev *vdev,
+				struct pkt_capture_data_match *match)
+{
+	return pkt_capture_set_data_match(vdev, match);
+}
+
+QDF_STATUS
+ucfg_pkt_capture_get_mon_stats(struct wlan_objmgr_vdev *vdev,
+			       struct pkt_capture_mon_stats *stats)
+{
+	return pkt_capture_get_mon_stats(vdev, stats);
+}
@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "wlan_pkt_capture_main.h"
+#include "wlan_pkt_capture_test.h"
+
+#define PKT_CAPTURE_UT_ETH_HLEN 14
+#define PKT_CAPTURE_UT_ETH_TYPE_ARP 0x0806
+#define PKT_CAPTURE_UT_ICMP_TYPE 1
+
+/* IPv4 header length with the IHL at its maximum of 15 words */
+#define PKT_CAPTURE_UT_IPV4_MAX_HLEN 60
+
+/* Longest frame built: 802.3 header, IPv4 options and the L4 ports */
+#define PKT_CAPTURE_UT_BUF_LEN (PKT_CAPTURE_UT_ETH_HLEN + \
+				PKT_CAPTURE_UT_IPV4_MAX_HLEN + 4)
+
+#define ut_check(cond) __ut_check(!!(cond), #cond, __func__, __LINE__)
+
+/**
+ * struct pkt_capture_ut_frame - Fields of a frame built by the test
+ * @da: destination mac address
+ * @sa: source mac address
+ * @ether_type: 802.3 ethertype
+ * @ihl: IPv4 header length in 32 bit words
+ * @tos: IPv4 TOS or IPv6 traffic class
+ * @l4_proto: IPv4 protocol or IPv6 next header
+ * @src_port: L4 source port
+ * @dst_port: L4 destination port
+ */
+struct pkt_capture_ut_frame {
+	uint8_t da[QDF_MAC_ADDR_SIZE];
+	uint8_t sa[QDF_MAC_ADDR_SIZE];
+	uint16_t ether_type;
+	uint8_t ihl;
+	uint8_t tos;
+	uint8_t l4_proto;
+	uint16_t src_port;
+	uint16_t dst_port;
+};
+
+static uint8_t pkt_capture_ut_buf[PKT_CAPTURE_UT_BUF_LEN];
+
+static const uint8_t pkt_capture_ut_peer[QDF_MAC_ADDR_SIZE] = {
+	0x00, 0x03, 0x7f, 0x12, 0x34, 0x56
+};
+
+static const uint8_t pkt_capture_ut_self[QDF_MAC_ADDR_SIZE] = {
+	0x02, 0x00, 0x00, 0xaa, 0xbb, 0xcc
+};
+
+static const uint8_t pkt_capture_ut_other[QDF_MAC_ADDR_SIZE] = {
+	0x02, 0x00, 0x00, 0xdd, 0xee, 0xff
+};
+
+static uint32_t
+__ut_check(bool pass, const char *expr, const char *func, uint32_t line)
+{
+	if (pass)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s:%u %s", func, line, expr);
+
+	return 1;
+}
+
+static void pkt_capture_ut_put_be16(uint8_t *p, uint16_t val)
+{
+	p[0] = val >> 8;
+	p[1] = val & 0xff;
+}
+
+/**
+ * pkt_capture_ut_build() - Build a frame into the test buffer
+ * @frame: fields of the frame
+ *
+ * Only the header fields read by the data match are filled in.
+ *
+ * Return: length of the frame up to and including the L4 ports
+ */
+static uint32_t pkt_capture_ut_build(const struct pkt_capture_ut_frame *frame)
+{
+	uint8_t *buf = pkt_capture_ut_buf;
+	uint8_t *l3_hdr = buf + PKT_CAPTURE_UT_ETH_HLEN;
+	uint32_t l4_off;
+
+	qdf_mem_zero(buf, sizeof(pkt_capture_ut_buf));
+	qdf_mem_copy(buf, frame->da, QDF_MAC_ADDR_SIZE);
+	qdf_mem_copy(buf + QDF_MAC_ADDR_SIZE, frame->sa, QDF_MAC_ADDR_SIZE);
+	pkt_capture_ut_put_be16(buf + 2 * QDF_MAC_ADDR_SIZE,
+				frame->ether_type);
+
+	switch (frame->ether_type) {
+	case QDF_NBUF_TRAC_IPV4_ETH_TYPE:
+		l3_hdr[0] = 0x40 | frame->ihl;
+		l3_hdr[1] = frame->tos;
+		l3_hdr[9] = frame->l4_proto;
+		/* IHL below 5 is malformed, still leave room for the ports */
+		l4_off = qdf_max((uint32_t)frame->ihl << 2,
+				 (uint32_t)QDF_NBUF_TRAC_IPV4_HEADER_SIZE);
+		break;
+	case QDF_NBUF_TRAC_IPV6_ETH_TYPE:
+		l3_hdr[0] = 0x60 | (frame->tos >> 4);
+		l3_hdr[1] = frame->tos << 4;
+		l3_hdr[6] = frame->l4_proto;
+		l4_off = QDF_NBUF_TRAC_IPV6_HEADER_SIZE;
+		break;
+	default:
+		/* e.g. ARP, pretend a 28 byte payload */
+		return PKT_CAPTURE_UT_ETH_HLEN + 28;
+	}
+
+	pkt_capture_ut_put_be16(l3_hdr + l4_off, frame->src_port);
+	pkt_capture_ut_put_be16(l3_hdr + l4_off + 2, frame->dst_port);
+
+	return PKT_CAPTURE_UT_ETH_HLEN + l4_off + 4;
+}
+
+static void pkt_capture_ut_ipv4_tcp(struct pkt_capture_ut_frame *frame)
+{
+	qdf_mem_copy(frame->da, pkt_capture_ut_peer, QDF_MAC_ADDR_SIZE);
+	qdf_mem_copy(frame->sa, pkt_capture_ut_self, QDF_MAC_ADDR_SIZE);
+	frame->ether_type = QDF_NBUF_TRAC_IPV4_ETH_TYPE;
+	frame->ihl = 5;
+	/* DSCP AF41, precedence 4 */
+	frame->tos = 0x88;
+	frame->l4_proto = QDF_NBUF_TRAC_TCP_TYPE;
+	frame->src_port = 49152;
+	frame->dst_port = 5001;
+}
+
+static void pkt_capture_ut_ipv6_udp(struct pkt_capture_ut_frame *frame)
+{
+	qdf_mem_copy(frame->da, pkt_capture_ut_self, QDF_MAC_ADDR_SIZE);
+	qdf_mem_copy(frame->sa, pkt_capture_ut_peer, QDF_MAC_ADDR_SIZE);
+	frame->ether_type = QDF_NBUF_TRAC_IPV6_ETH_TYPE;
+	frame->ihl = 0;
+	/* DSCP EF, precedence 5 */
+	frame->tos = 0xb8;
+	frame->l4_proto = QDF_NBUF_TRAC_UDP_TYPE;
+	frame->src_port = 5353;
+	frame->dst_port = 40000;
+}
+
+/**
+ * pkt_capture_ut_match() - Run the data match on the first bytes of a frame
+ * @match: data match to apply
+ * @len: bytes of the test buffer to pass
+ *
+ * The bytes are copied into an allocation of exactly @len bytes, so that
+ * reads past @len are caught by KASAN.
+ *
+ * Return: data match result
+ */
+static bool
+pkt_capture_ut_match(struct pkt_capture_data_match *match, uint32_t len)
+{
+	uint8_t *frame;
+	bool result;
+
+	if (!len)
+		return pkt_capture_data_match_frame_test(match,
+							 pkt_capture_ut_buf, 0);
+
+	frame = qdf_mem_malloc(len);
+	if (!frame)
+		return false;
+
+	qdf_mem_copy(frame, pkt_capture_ut_buf, len);
+	result = pkt_capture_data_match_frame_test(match, frame, len);
+	qdf_mem_free(frame);
+
+	return result;
+}
+
+static uint32_t pkt_capture_ut_no_flags(void)
+{
+	struct pkt_capture_data_match match = {0};
+	struct pkt_capture_ut_frame frame;
+	uint32_t errors = 0;
+
+	/* without any field selected every frame, even an empty one, ... */
+	pkt_capture_ut_ipv4_tcp(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match,
+						pkt_capture_ut_build(&frame)));
+	errors += ut_check(pkt_capture_ut_match(&match, 0));
+
+	return errors;
+}
+
+static uint32_t pkt_capture_ut_peer_ether_type(void)
+{
+	struct pkt_capture_data_match match = {0};
+	struct pkt_capture_ut_frame frame;
+	uint32_t errors = 0;
+	uint32_t len;
+
+	match.flags = PKT_CAPTURE_DATA_MATCH_PEER;
+	qdf_mem_copy(match.peer_mac.bytes, pkt_capture_ut_peer,
+		     QDF_MAC_ADDR_SIZE);
+
+	/* peer is matched as destination ... */
+	pkt_capture_ut_ipv4_tcp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	/* ... and as source */
+	pkt_capture_ut_ipv6_udp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	qdf_mem_copy(frame.sa, pkt_capture_ut_other, QDF_MAC_ADDR_SIZE);
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	/* ethertype alone also matches non IP frames */
+	match.flags = PKT_CAPTURE_DATA_MATCH_ETHER_TYPE;
+	match.ether_type = PKT_CAPTURE_UT_ETH_TYPE_ARP;
+	frame.ether_type = PKT_CAPTURE_UT_ETH_TYPE_ARP;
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	match.ether_type = QDF_NBUF_TRAC_IPV4_ETH_TYPE;
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	/* all selected fields have to match */
+	match.flags |= PKT_CAPTURE_DATA_MATCH_PEER;
+	pkt_capture_ut_ipv4_tcp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	qdf_mem_copy(frame.da, pkt_capture_ut_other, QDF_MAC_ADDR_SIZE);
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	return errors;
+}
+
+static uint32_t pkt_capture_ut_tid(void)
+{
+	struct pkt_capture_data_match match = {0};
+	struct pkt_capture_ut_frame frame;
+	uint32_t errors = 0;
+	uint32_t len;
+
+	match.flags = PKT_CAPTURE_DATA_MATCH_TID;
+
+	/* IPv4 TOS precedence ... */
+	pkt_capture_ut_ipv4_tcp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	match.tid = 4;
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+	match.tid = 5;
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	/* ... and IPv6 traffic class precedence, split over two bytes */
+	pkt_capture_ut_ipv6_udp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+	match.tid = 4;
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	frame.tos = 0;
+	len = pkt_capture_ut_build(&frame);
+	match.tid = 0;
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	/* non IP frames carry no tid */
+	frame.ether_type = PKT_CAPTURE_UT_ETH_TYPE_ARP;
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	return errors;
+}
+
+static uint32_t pkt_capture_ut_port(void)
+{
+	struct pkt_capture_data_match match = {0};
+	struct pkt_capture_ut_frame frame;
+	uint32_t errors = 0;
+	uint32_t len;
+
+	match.flags = PKT_CAPTURE_DATA_MATCH_PORT;
+
+	/* TCP destination and source port */
+	pkt_capture_ut_ipv4_tcp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	match.port = 5001;
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+	match.port = 49152;
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+	match.port = 5002;
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	/* ports follow the IPv4 options */
+	frame.ihl = 15;
+	match.port = 5001;
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	/*
+	 * a header length below the IPv4 header size is malformed, do not
+	 * take the zeroed IPv4 destination address for the ports
+	 */
+	frame.ihl = 4;
+	len = pkt_capture_ut_build(&frame);
+	match.port = 0;
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	/* UDP over IPv6 */
+	pkt_capture_ut_ipv6_udp(&frame);
+	len = pkt_capture_ut_build(&frame);
+	match.port = 5353;
+	errors += ut_check(pkt_capture_ut_match(&match, len));
+
+	/* protocols without ports never match */
+	frame.l4_proto = PKT_CAPTURE_UT_ICMP_TYPE;
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	frame.ether_type = PKT_CAPTURE_UT_ETH_TYPE_ARP;
+	len = pkt_capture_ut_build(&frame);
+	errors += ut_check(!pkt_capture_ut_match(&match, len));
+
+	return errors;
+}
+
+/**
+ * pkt_capture_ut_truncated_one() - Check a frame cut at every length
+ * @match: data match the full frame matches
+ * @frame: frame to build
+ * @min_len: shortest length holding every header read by @match
+ *
+ * Return: number of errors
+ */
+static uint32_t
+pkt_capture_ut_truncated_one(struct pkt_capture_data_match *match,
+			     const struct pkt_capture_ut_frame *frame,
+			     uint32_t min_len)
+{
+	uint32_t errors = 0;
+	uint32_t full_len, len;
+	bool result;
+
+	full_len = pkt_capture_ut_build(frame);
+	for (len = 0; len <= full_len; len++) {
+		result = pkt_capture_ut_match(match, len);
+		if (result != (len >= min_len)) {
+			qdf_nofl_alert("FAIL: flags 0x%x len %u/%u min %u result %d",
+				       match->flags, len, full_len, min_len,
+				       result);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static uint32_t pkt_capture_ut_truncated(void)
+{
+	struct pkt_capture_data_match match = {0};
+	struct pkt_capture_ut_frame frame;
+	uint32_t ipv4_ports = PKT_CAPTURE_UT_ETH_HLEN +
+			      QDF_NBUF_TRAC_IPV4_HEADER_SIZE + 4;
+	uint32_t ipv6_ports = PKT_CAPTURE_UT_ETH_HLEN +
+			      QDF_NBUF_TRAC_IPV6_HEADER_SIZE + 4;
+	uint32_t errors = 0;
+
+	qdf_mem_copy(match.peer_mac.bytes, pkt_capture_ut_peer,
+		     QDF_MAC_ADDR_SIZE);
+
+	/* the 802.3 header is needed for the peer and ethertype ... */
+	pkt_capture_ut_ipv4_tcp(&frame);
+	match.flags = PKT_CAPTURE_DATA_MATCH_PEER;
+	errors += pkt_capture_ut_truncated_one(&match, &frame,
+					       PKT_CAPTURE_UT_ETH_HLEN);
+
+	match.flags = PKT_CAPTURE_DATA_MATCH_ETHER_TYPE;
+	match.ether_type = QDF_NBUF_TRAC_IPV4_ETH_TYPE;
+	errors += pkt_capture_ut_truncated_one(&match, &frame,
+					       PKT_CAPTURE_UT_ETH_HLEN);
+
+	/* ... the whole IP header for the tid ... */
+	match.flags = PKT_CAPTURE_DATA_MATCH_TID;
+	match.tid = 4;
+	errors += pkt_capture_ut_truncated_one(&match, &frame,
+					       ipv4_ports - 4);
+
+	pkt_capture_ut_ipv6_udp(&frame);
+	match.tid = 5;
+	errors += pkt_capture_ut_truncated_one(&match, &frame,
+					       ipv6_ports - 4);
+
+	/* ... and the L4 ports for the port */
+	match.flags = PKT_CAPTURE_DATA_MATCH_PORT;
+	match.port = 40000;
+	errors += pkt_capture_ut_truncated_one(&match, &frame, ipv6_ports);
+
+	match.flags = PKT_CAPTURE_DATA_MATCH_PEER |
+		      PKT_CAPTURE_DATA_MATCH_TID |
+		      PKT_CAPTURE_DATA_MATCH_ETHER_TYPE |
+		      PKT_CAPTURE_DATA_MATCH_PORT;
+	match.ether_type = QDF_NBUF_TRAC_IPV6_ETH_TYPE;
+	errors += pkt_capture_ut_truncated_one(&match, &frame, ipv6_ports);
+
+	pkt_capture_ut_ipv4_tcp(&frame);
+	match.ether_type = QDF_NBUF_TRAC_IPV4_ETH_TYPE;
+	match.tid = 4;
+	match.port = 5001;
+	errors += pkt_capture_ut_truncated_one(&match, &frame, ipv4_ports);
+
+	/* IPv4 options move the ports further in */
+	frame.ihl = 8;
+	errors += pkt_capture_ut_truncated_one(&match, &frame,
+					       ipv4_ports + 12);
+
+	return errors;
+}
+
+uint32_t pkt_capture_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += pkt_capture_ut_no_flags();
+	errors += pkt_capture_ut_peer_ether_type();
+	errors += pkt_capture_ut_tid();
+	errors += pkt_capture_ut_port();
+	errors += pkt_capture_ut_truncated();
+
+	QDF_BUG(!errors);
+
+	return errors;
+}
@@ -625,6 +625,40 @@ int
 htt_rx_hash_list_insert(struct htt_pdev_t *pdev,
 			qdf_dma_addr_t paddr,
 			qdf_nbuf_t netbuf);
+
+/**
+ * htt_rx_hash_init() - allocate the rx buffer table of a pdev
+ * @pdev: HTT pdev handle, with rx_ring.size set
+ *
+ * Return: 0 on success, 1 on allocation failure
+ */
+int htt_rx_hash_init(struct htt_pdev_t *pdev);
+
+/**
+ * htt_rx_hash_deinit() - free the rx buffer table of a pdev along with the
+ *			  rx buffers still posted in it
+ * @pdev: HTT pdev handle
+ *
+ * Return: None
+ */
+void htt_rx_hash_deinit(struct htt_pdev_t *pdev);
+
+#ifdef WLAN_HTT_RX_HASH_TEST
+/**
+ * htt_rx_amsdu_rx_in_order_pop_ll_test() - pop the MSDUs of an rx in order
+ *					    indication, for the unit test
+ * @pdev: HTT pdev handle
+ * @rx_ind_msg: HTT_T2H_MSG_TYPE_RX_IN_ORD_PADDR_IND message
+ * @head_msdu: filled with the first MSDU of the list
+ * @tail_msdu: filled with the last MSDU of the list
+ *
+ * Return: 1 if the MSDUs were popped, 0 otherwise
+ */
+int htt_rx_amsdu_rx_in_order_pop_ll_test(htt_pdev_handle pdev,
+					 qdf_nbuf_t rx_ind_msg,
+					 qdf_nbuf_t *head_msdu,
+					 qdf_nbuf_t *tail_msdu);
+#endif
 #else
 static inline int
 htt_rx_hash_list_insert(struct htt_pdev_t *pdev,
@@ -1008,15 +1008,21 @@ htt_rx_offload_paddr_msdu_pop_ll(htt_pdev_handle pdev,
 
 #ifdef WLAN_FULL_REORDER_OFFLOAD
 
-/* Number of buckets in the hash table */
-#define RX_NUM_HASH_BUCKETS 1024        /* This should always be a power of 2 */
-#define RX_NUM_HASH_BUCKETS_MASK (RX_NUM_HASH_BUCKETS - 1)
-
-/* Number of hash entries allocated per bucket */
-#define RX_ENTRIES_SIZE 10
+/*
+ * The rx buffer table is an open addressed hash table of
+ * RX_HASH_TABLE_SCALE x rx ring size entries, keyed by the buffer paddr.
+ * The target only reports the paddr of a filled buffer, so it is the only
+ * key which can be carried with the buffer.
+ */
+#define RX_HASH_TABLE_SCALE 2
 
-#define RX_HASH_FUNCTION(a) \
-	((((a) >> 14) ^ ((a) >> 4)) & RX_NUM_HASH_BUCKETS_MASK)
+/*
+ * Fibonacci hashing of the paddr, keeping the top bits of the product.
+ * Rx buffers being at least 64 byte aligned, the low bits of the paddr do
+ * not carry any information.
+ */
+#define RX_HASH_FUNCTION(a, shift) \
+	(((uint32_t)((a) >> 6) * 0x9E3779B1u) >> (shift))
 
 #ifdef RX_HASH_DEBUG_LOG
 #define RX_HASH_LOG(x) x
@@ -1032,76 +1038,31 @@ htt_rx_offload_paddr_msdu_pop_ll(htt_pdev_handle pdev,
 
 #define RX_RING_REFILL_DEBT_MAX 128
 
-/* Initializes the circular linked list */
-static inline void htt_list_init(struct htt_list_node *head)
-{
-	head->prev = head;
-	head->next = head;
-}
-
-/* Adds entry to the end of the linked list */
-static inline void htt_list_add_tail(struct htt_list_node *head,
-				     struct htt_list_node *node)
-{
-	head->prev->next = node;
-	node->prev = head->prev;
-	node->next = head;
-	head->prev = node;
-}
-
-/* Removes the entry corresponding to the input node from the linked list */
-static inline void htt_list_remove(struct htt_list_node *node)
-{
-	node->prev->next = node->next;
-	node->next->prev = node->prev;
-}
-
-/* Helper macro to iterate through the linked list */
-#define HTT_LIST_ITER_FWD(iter, head) for (iter = (head)->next;		\
-					   (iter) != (head);		\
-					   (iter) = (iter)->next)	\
-
 #ifdef RX_HASH_DEBUG
-/* Hash cookie related macros */
-#define HTT_RX_HASH_COOKIE 0xDEED
-
-#define HTT_RX_HASH_COOKIE_SET(hash_element) \
-	((hash_element)->cookie = HTT_RX_HASH_COOKIE)
-
-#define HTT_RX_HASH_COOKIE_CHECK(hash_element) \
-	HTT_ASSERT_ALWAYS((hash_element)->cookie == HTT_RX_HASH_COOKIE)
-
 /* Hash count related macros */
-#define HTT_RX_HASH_COUNT_INCR(hash_bucket) \
-	((hash_bucket)->count++)
+#define HTT_RX_HASH_COUNT_INCR(pdev) \
+	((pdev)->rx_ring.hash_count++)
 
-#define HTT_RX_HASH_COUNT_DECR(hash_bucket) \
-	((hash_bucket)->count--)
+#define HTT_RX_HASH_COUNT_DECR(pdev) \
+	((pdev)->rx_ring.hash_count--)
 
-#define HTT_RX_HASH_COUNT_RESET(hash_bucket) ((hash_bucket)->count = 0)
+#define HTT_RX_HASH_COUNT_RESET(pdev) ((pdev)->rx_ring.hash_count = 0)
 
-#define HTT_RX_HASH_COUNT_PRINT(hash_bucket) \
-	RX_HASH_LOG(qdf_print(" count %d\n", (hash_bucket)->count))
+#define HTT_RX_HASH_COUNT_CHECK(pdev) \
+	HTT_ASSERT_ALWAYS((pdev)->rx_ring.hash_count <= \
+			  (pdev)->rx_ring.hash_mask + 1)
 #else                           /* RX_HASH_DEBUG */
-/* Hash cookie related macros */
-#define HTT_RX_HASH_COOKIE_SET(hash_element)    /* no-op */
-#define HTT_RX_HASH_COOKIE_CHECK(hash_element)  /* no-op */
 /* Hash count related macros */
-#define HTT_RX_HASH_COUNT_INCR(hash_bucket)     /* no-op */
-#define HTT_RX_HASH_COUNT_DECR(hash_bucket)     /* no-op */
-#define HTT_RX_HASH_COUNT_PRINT(hash_bucket)    /* no-op */
-#define HTT_RX_HASH_COUNT_RESET(hash_bucket)    /* no-op */
+#define HTT_RX_HASH_COUNT_INCR(pdev)     /* no-op */
+#define HTT_RX_HASH_COUNT_DECR(pdev)     /* no-op */
+#define HTT_RX_HASH_COUNT_RESET(pdev)    /* no-op */
+#define HTT_RX_HASH_COUNT_CHECK(pdev)    /* no-op */
 #endif /* RX_HASH_DEBUG */
 
 /*
  * Inserts the given "physical address - network buffer" pair into the
- * hash table for the given pdev. This function will do the following:
- * 1. Determine which bucket to insert the pair into
- * 2. First try to allocate the hash entry for this pair from the pre-allocated
- *    entries list
- * 3. If there are no more entries in the pre-allocated entries list, allocate
- *    the hash entry from the hash memory pool
- * Note: this function is not thread-safe
+ * rx buffer table for the given pdev, in the first free entry found by
+ * linear probing from the paddr hash.
  * Returns 0 - success, 1 - failure
  */
 int
@@ -1109,51 +1070,36 @@ htt_rx_hash_list_insert(struct htt_pdev_t *pdev,
 			qdf_dma_addr_t paddr,
 			qdf_nbuf_t netbuf)
 {
-	int i;
+	struct htt_rx_hash_entry *hash_entry;
+	uint32_t mask, i, probe;
 	int rc = 0;
-	struct htt_rx_hash_entry *hash_element = NULL;
 
 	qdf_spin_lock_bh(&pdev->rx_ring.rx_hash_lock);
 
 	/* get rid of the marking bits if they are available */
 	paddr = htt_paddr_trim_to_37(paddr);
 
-	i = RX_HASH_FUNCTION(paddr);
-
-	/* Check if there are any entries in the pre-allocated free list */
-	if (pdev->rx_ring.hash_table[i]->freepool.next !=
-	    &pdev->rx_ring.hash_table[i]->freepool) {
-		hash_element =
-			(struct htt_rx_hash_entry *)(
-				(char *)
-				pdev->rx_ring.hash_table[i]->freepool.next -
-				pdev->rx_ring.listnode_offset);
-		if (qdf_unlikely(!hash_element)) {
-			HTT_ASSERT_ALWAYS(0);
-			rc = 1;
-			goto hli_end;
-		}
+	mask = pdev->rx_ring.hash_mask;
+	i = RX_HASH_FUNCTION(paddr, pdev->rx_ring.hash_shift);
 
-		htt_list_remove(pdev->rx_ring.hash_table[i]->freepool.next);
-	} else {
-		hash_element = qdf_mem_malloc(sizeof(struct htt_rx_hash_entry));
-		if (qdf_unlikely(!hash_element)) {
-			HTT_ASSERT_ALWAYS(0);
-			rc = 1;
-			goto hli_end;
-		}
-		hash_element->fromlist = 0;
+	for (probe = 0; probe <= mask; probe++) {
+		hash_entry = &pdev->rx_ring.hash_table[(i + probe) & mask];
+		if (!hash_entry->netbuf)
+			break;
 	}
 
-	hash_element->netbuf = netbuf;
-	hash_element->paddr = paddr;
-	HTT_RX_HASH_COOKIE_SET(hash_element);
+	if (qdf_unlikely(probe > mask)) {
+		/* More buffers posted than the rx ring can hold */
+		HTT_ASSERT_ALWAYS(0);
+		rc = 1;
+		goto hli_end;
+	}
 
-	htt_list_add_tail(&pdev->rx_ring.hash_table[i]->listhead,
-			  &hash_element->listnode);
+	if (probe > pdev->rx_ring.hash_max_probe)
+		pdev->rx_ring.hash_max_probe = probe;
 
-	RX_HASH_LOG(qdf_print("rx hash: paddr 0x%x netbuf %pK bucket %d\n",
-			      paddr, netbuf, (int)i));
+	RX_HASH_LOG(qdf_print("rx hash: paddr 0x%x netbuf %pK entry %d\n",
+			      paddr, netbuf, (int)((i + probe) & mask)));
 
 	if (htt_rx_ring_smmu_mapped(pdev)) {
 		if (qdf_unlikely(qdf_nbuf_is_rx_ipa_smmu_map(netbuf))) {
@@ -1164,176 +1110,136 @@ htt_rx_hash_list_insert(struct htt_pdev_t *pdev,
 		qdf_nbuf_set_rx_ipa_smmu_map(netbuf, true);
 	}
 
-	HTT_RX_HASH_COUNT_INCR(pdev->rx_ring.hash_table[i]);
-	HTT_RX_HASH_COUNT_PRINT(pdev->rx_ring.hash_table[i]);
+	hash_entry->paddr = paddr;
+	hash_entry->netbuf = netbuf;
+
+	HTT_RX_HASH_COUNT_INCR(pdev);
+	HTT_RX_HASH_COUNT_CHECK(pdev);
 
 hli_end:
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 	return rc;
 }
 
+/**
+ * __htt_rx_hash_list_lookup() - find and release the rx buffer table entry
+ *				 of a paddr
+ * @pdev: HTT pdev handle
+ * @paddr: paddr of the rx buffer
+ *
+ * Must be called with rx_hash_lock held and the table allocated. The lock
+ * serializes the lookup against the reuse of released entries by
+ * htt_rx_hash_list_insert() and against htt_rx_hash_deinit() freeing the
+ * table.
+ *
+ * No insert has needed more than hash_max_probe probes since the table was
+ * allocated, so the lookup does not probe further.
+ *
+ * Return: netbuf of the entry, NULL if not found
+ */
+static qdf_nbuf_t __htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
+					    qdf_dma_addr_t paddr)
+{
+	struct htt_rx_hash_entry *hash_table = pdev->rx_ring.hash_table;
+	struct htt_rx_hash_entry *hash_entry;
+	uint32_t mask = pdev->rx_ring.hash_mask;
+	uint32_t max_probe = pdev->rx_ring.hash_max_probe;
+	uint32_t i, probe;
+	qdf_nbuf_t netbuf;
+
+	i = RX_HASH_FUNCTION(paddr, pdev->rx_ring.hash_shift);
+
+	for (probe = 0; probe <= max_probe; probe++) {
+		hash_entry = &hash_table[(i + probe) & mask];
+		netbuf = hash_entry->netbuf;
+		if (!netbuf || hash_entry->paddr != paddr)
+			continue;
+
+		/* set netbuf to NULL to release the entry */
+		hash_entry->netbuf = NULL;
+		HTT_RX_HASH_COUNT_DECR(pdev);
+
+		RX_HASH_LOG(qdf_print("rx hash: paddr 0x%llx, netbuf %pK, entry %d\n",
+				      (unsigned long long)paddr, netbuf,
+				      (int)((i + probe) & mask)));
+		return netbuf;
+	}
+
+	return NULL;
+}
+
 /*
  * Given a physical address this function will find the corresponding network
- *  buffer from the hash table.
+ *  buffer from the rx buffer table.
  *  paddr is already stripped off of higher marking bits.
  */
 qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
 				   qdf_dma_addr_t     paddr)
 {
-	uint32_t i;
-	struct htt_list_node *list_iter = NULL;
-	qdf_nbuf_t netbuf = NULL;
-	struct htt_rx_hash_entry *hash_entry;
+	qdf_nbuf_t netbuf;
 
 	qdf_spin_lock_bh(&pdev->rx_ring.rx_hash_lock);
 
+	/* Table already freed by htt_rx_hash_deinit() */
 	if (!pdev->rx_ring.hash_table) {
 		qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 		return NULL;
 	}
 
-	i = RX_HASH_FUNCTION(paddr);
-
-	HTT_LIST_ITER_FWD(list_iter, &pdev->rx_ring.hash_table[i]->listhead) {
-		hash_entry = (struct htt_rx_hash_entry *)
-			     ((char *)list_iter -
-			      pdev->rx_ring.listnode_offset);
-
-		HTT_RX_HASH_COOKIE_CHECK(hash_entry);
-
-		if (hash_entry->paddr == paddr) {
-			/* Found the entry corresponding to paddr */
-			netbuf = hash_entry->netbuf;
-			/* set netbuf to NULL to trace if freed entry
-			 * is getting unmapped in hash deinit.
-			 */
-			hash_entry->netbuf = NULL;
-			htt_list_remove(&hash_entry->listnode);
-			HTT_RX_HASH_COUNT_DECR(pdev->rx_ring.hash_table[i]);
-			/*
-			 * if the rx entry is from the pre-allocated list,
-			 * return it
-			 */
-			if (hash_entry->fromlist)
-				htt_list_add_tail(
-					&pdev->rx_ring.hash_table[i]->freepool,
-					&hash_entry->listnode);
-			else
-				qdf_mem_free(hash_entry);
-
-			htt_rx_dbg_rxbuf_reset(pdev, netbuf);
-			break;
-		}
-	}
-
+	netbuf = __htt_rx_hash_list_lookup(pdev, paddr);
 	if (netbuf && htt_rx_ring_smmu_mapped(pdev)) {
 		if (qdf_unlikely(!qdf_nbuf_is_rx_ipa_smmu_map(netbuf))) {
 			qdf_err("smmu not mapped nbuf: %pK", netbuf);
 			qdf_assert_always(0);
 		}
 	}
-
-	RX_HASH_LOG(qdf_print("rx hash: paddr 0x%llx, netbuf %pK, bucket %d\n",
-			      (unsigned long long)paddr, netbuf, (int)i));
-	HTT_RX_HASH_COUNT_PRINT(pdev->rx_ring.hash_table[i]);
-
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 
 	if (!netbuf) {
 		qdf_print("rx hash: no entry found for %llx!\n",
 			  (unsigned long long)paddr);
 		cds_trigger_recovery(QDF_RX_HASH_NO_ENTRY_FOUND);
+		return NULL;
 	}
 
+	htt_rx_dbg_rxbuf_reset(pdev, netbuf);
+
 	return netbuf;
 }
 
 /*
- * Initialization function of the rx buffer hash table. This function will
- * allocate a hash table of a certain pre-determined size and initialize all
- * the elements
+ * Initialization function of the rx buffer table. This function will
+ * allocate a table scaled to the rx ring size, so that the load factor
+ * stays under 1 / RX_HASH_TABLE_SCALE and probe sequences remain short.
  */
-static int htt_rx_hash_init(struct htt_pdev_t *pdev)
+int htt_rx_hash_init(struct htt_pdev_t *pdev)
 {
-	int i, j;
-	int rc = 0;
-	void *allocation;
+	uint32_t num_entries = pdev->rx_ring.size * RX_HASH_TABLE_SCALE;
 
-	HTT_ASSERT2(QDF_IS_PWR2(RX_NUM_HASH_BUCKETS));
+	HTT_ASSERT2(QDF_IS_PWR2(num_entries));
 
-	/* hash table is array of bucket pointers */
 	pdev->rx_ring.hash_table =
-		qdf_mem_malloc(RX_NUM_HASH_BUCKETS *
-			       sizeof(struct htt_rx_hash_bucket *));
-
+		qdf_mem_malloc(num_entries * sizeof(struct htt_rx_hash_entry));
 	if (!pdev->rx_ring.hash_table)
 		return 1;
 
+	pdev->rx_ring.hash_mask = num_entries - 1;
+	pdev->rx_ring.hash_shift = 32 - (qdf_fls(num_entries) - 1);
+	pdev->rx_ring.hash_max_probe = 0;
+	HTT_RX_HASH_COUNT_RESET(pdev);
 	qdf_spinlock_create(&pdev->rx_ring.rx_hash_lock);
-	qdf_spin_lock_bh(&pdev->rx_ring.rx_hash_lock);
 
-	for (i = 0; i < RX_NUM_HASH_BUCKETS; i++) {
-		qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
-		/* pre-allocate bucket and pool of entries for this bucket */
-		allocation = qdf_mem_malloc((sizeof(struct htt_rx_hash_bucket) +
-			(RX_ENTRIES_SIZE * sizeof(struct htt_rx_hash_entry))));
-		qdf_spin_lock_bh(&pdev->rx_ring.rx_hash_lock);
-		pdev->rx_ring.hash_table[i] = allocation;
-
-		HTT_RX_HASH_COUNT_RESET(pdev->rx_ring.hash_table[i]);
-
-		/* initialize the hash table buckets */
-		htt_list_init(&pdev->rx_ring.hash_table[i]->listhead);
-
-		/* initialize the hash table free pool per bucket */
-		htt_list_init(&pdev->rx_ring.hash_table[i]->freepool);
-
-		/* pre-allocate a pool of entries for this bucket */
-		pdev->rx_ring.hash_table[i]->entries =
-			(struct htt_rx_hash_entry *)
-			((uint8_t *)pdev->rx_ring.hash_table[i] +
-			sizeof(struct htt_rx_hash_bucket));
-
-		if (!pdev->rx_ring.hash_table[i]->entries) {
-			qdf_print("rx hash bucket %d entries alloc failed\n",
-				  (int)i);
-			while (i) {
-				i--;
-				qdf_mem_free(pdev->rx_ring.hash_table[i]);
-			}
-			qdf_mem_free(pdev->rx_ring.hash_table);
-			pdev->rx_ring.hash_table = NULL;
-			rc = 1;
-			goto hi_end;
-		}
-
-		/* initialize the free list with pre-allocated entries */
-		for (j = 0; j < RX_ENTRIES_SIZE; j++) {
-			pdev->rx_ring.hash_table[i]->entries[j].fromlist = 1;
-			htt_list_add_tail(
-				&pdev->rx_ring.hash_table[i]->freepool,
-				&pdev->rx_ring.hash_table[i]->entries[j].
-				listnode);
-		}
-	}
-
-	pdev->rx_ring.listnode_offset =
-		qdf_offsetof(struct htt_rx_hash_entry, listnode);
-hi_end:
-	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
-
-	return rc;
+	return 0;
 }
 
-/* De -initialization function of the rx buffer hash table. This function will
- *   free up the hash table which includes freeing all the pending rx buffers
+/* De -initialization function of the rx buffer table. This function will
+ *   free up the table which includes freeing all the pending rx buffers
  */
-static void htt_rx_hash_deinit(struct htt_pdev_t *pdev)
+void htt_rx_hash_deinit(struct htt_pdev_t *pdev)
 {
 	uint32_t i;
 	struct htt_rx_hash_entry *hash_entry;
-	struct htt_rx_hash_bucket **hash_table;
-	struct htt_list_node *list_iter = NULL;
+	struct htt_rx_hash_entry *hash_table;
 	qdf_mem_info_t mem_map_table = {0};
 	bool ipa_smmu = false;
 
@@ -1346,54 +1252,41 @@ static void htt_rx_hash_deinit(struct htt_pdev_t *pdev)
 	pdev->rx_ring.hash_table = NULL;
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 
-	for (i = 0; i < RX_NUM_HASH_BUCKETS; i++) {
-		/* Free the hash entries in hash bucket i */
-		list_iter = hash_table[i]->listhead.next;
-		while (list_iter != &hash_table[i]->listhead) {
-			hash_entry =
-				(struct htt_rx_hash_entry *)((char *)list_iter -
-							     pdev->rx_ring.
-							     listnode_offset);
-			if (hash_entry->netbuf) {
-				if (ipa_smmu) {
-					if (qdf_unlikely(
-						!qdf_nbuf_is_rx_ipa_smmu_map(
-							hash_entry->netbuf))) {
-						qdf_err("nbuf: %pK NOT mapped",
-							hash_entry->netbuf);
-						qdf_assert_always(0);
-					}
-					qdf_nbuf_set_rx_ipa_smmu_map(
-							hash_entry->netbuf,
-							false);
-					qdf_update_mem_map_table(pdev->osdev,
-						&mem_map_table,
-						QDF_NBUF_CB_PADDR(
+	for (i = 0; i <= pdev->rx_ring.hash_mask; i++) {
+		hash_entry = &hash_table[i];
+		if (!hash_entry->netbuf)
+			continue;
+
+		if (ipa_smmu) {
+			if (qdf_unlikely(
+				!qdf_nbuf_is_rx_ipa_smmu_map(
+					hash_entry->netbuf))) {
+				qdf_err("nbuf: %pK NOT mapped",
+					hash_entry->netbuf);
+				qdf_assert_always(0);
+			}
+			qdf_nbuf_set_rx_ipa_smmu_map(hash_entry->netbuf,
+						     false);
+			qdf_update_mem_map_table(pdev->osdev,
+						 &mem_map_table,
+						 QDF_NBUF_CB_PADDR(
 							hash_entry->netbuf),
-						HTT_RX_BUF_SIZE);
+						 HTT_RX_BUF_SIZE);
 
-					qdf_assert_always(
-						!cds_smmu_map_unmap(
-							false, 1,
-							&mem_map_table));
-				}
+			qdf_assert_always(
+				!cds_smmu_map_unmap(false, 1,
+						    &mem_map_table));
+		}
 #ifdef DEBUG_DMA_DONE
-				qdf_nbuf_unmap(pdev->osdev, hash_entry->netbuf,
-					       QDF_DMA_BIDIRECTIONAL);
+		qdf_nbuf_unmap(pdev->osdev, hash_entry->netbuf,
+			       QDF_DMA_BIDIRECTIONAL);
 #else
-				qdf_nbuf_unmap(pdev->osdev, hash_entry->netbuf,
-					       QDF_DMA_FROM_DEVICE);
+		qdf_nbuf_unmap(pdev->osdev, hash_entry->netbuf,
+			       QDF_DMA_FROM_DEVICE);
 #endif
-				qdf_nbuf_free(hash_entry->netbuf);
-				hash_entry->paddr = 0;
-			}
-			list_iter = list_iter->next;
-
-			if (!hash_entry->fromlist)
-				qdf_mem_free(hash_entry);
-		}
-
-		qdf_mem_free(hash_table[i]);
+		qdf_nbuf_free(hash_entry->netbuf);
+		hash_entry->netbuf = NULL;
+		hash_entry->paddr = 0;
 	}
 	qdf_mem_free(hash_table);
 
@@ -1732,6 +1625,19 @@ end:
 	return ret;
 }
 
+#ifdef WLAN_HTT_RX_HASH_TEST
+int htt_rx_amsdu_rx_in_order_pop_ll_test(htt_pdev_handle pdev,
+					 qdf_nbuf_t rx_ind_msg,
+					 qdf_nbuf_t *head_msdu,
+					 qdf_nbuf_t *tail_msdu)
+{
+	uint32_t replenish_cnt = 0;
+
+	return htt_rx_amsdu_rx_in_order_pop_ll(pdev, rx_ind_msg, head_msdu,
+					       tail_msdu, &replenish_cnt);
+}
+#endif
+
 static void *htt_rx_in_ord_mpdu_desc_list_next_ll(htt_pdev_handle pdev,
 						  qdf_nbuf_t netbuf)
 {
@@ -2343,9 +2249,7 @@ void htt_rx_detach(struct htt_pdev_t *pdev)
 static QDF_STATUS htt_rx_hash_smmu_map(bool map, struct htt_pdev_t *pdev)
 {
 	uint32_t i;
-	struct htt_rx_hash_entry *hash_entry;
-	struct htt_rx_hash_bucket **hash_table;
-	struct htt_list_node *list_iter = NULL;
+	struct htt_rx_hash_entry *hash_table;
 	qdf_mem_info_t mem_map_table = {0};
 	qdf_nbuf_t nbuf;
 	int ret;
@@ -2353,41 +2257,25 @@ static QDF_STATUS htt_rx_hash_smmu_map(bool map, struct htt_pdev_t *pdev)
 	qdf_spin_lock_bh(&pdev->rx_ring.rx_hash_lock);
 	hash_table = pdev->rx_ring.hash_table;
 
-	for (i = 0; i < RX_NUM_HASH_BUCKETS; i++) {
-		/* Free the hash entries in hash bucket i */
-		list_iter = hash_table[i]->listhead.next;
-		while (list_iter != &hash_table[i]->listhead) {
-			hash_entry =
-				(struct htt_rx_hash_entry *)((char *)list_iter -
-							     pdev->rx_ring.
-							     listnode_offset);
-			nbuf = hash_entry->netbuf;
-			if (nbuf) {
-				if (qdf_unlikely(map ==
-					qdf_nbuf_is_rx_ipa_smmu_map(nbuf))) {
-					qdf_err("map/unmap err:%d, nbuf:%pK",
-						map, nbuf);
-					list_iter = list_iter->next;
-					continue;
-				}
-				qdf_nbuf_set_rx_ipa_smmu_map(nbuf, map);
-				qdf_update_mem_map_table(pdev->osdev,
-						&mem_map_table,
-						QDF_NBUF_CB_PADDR(nbuf),
-						HTT_RX_BUF_SIZE);
-				ret = cds_smmu_map_unmap(map, 1,
-							 &mem_map_table);
-				if (ret) {
-					qdf_nbuf_set_rx_ipa_smmu_map(nbuf,
-								     !map);
-					qdf_err("map: %d failure, nbuf: %pK",
-						map, nbuf);
-					qdf_spin_unlock_bh(
-						&pdev->rx_ring.rx_hash_lock);
-					return QDF_STATUS_E_FAILURE;
-				}
-			}
-			list_iter = list_iter->next;
+	for (i = 0; i <= pdev->rx_ring.hash_mask; i++) {
+		nbuf = hash_table[i].netbuf;
+		if (!nbuf)
+			continue;
+
+		if (qdf_unlikely(map == qdf_nbuf_is_rx_ipa_smmu_map(nbuf))) {
+			qdf_err("map/unmap err:%d, nbuf:%pK", map, nbuf);
+			continue;
+		}
+		qdf_nbuf_set_rx_ipa_smmu_map(nbuf, map);
+		qdf_update_mem_map_table(pdev->osdev, &mem_map_table,
+					 QDF_NBUF_CB_PADDR(nbuf),
+					 HTT_RX_BUF_SIZE);
+		ret = cds_smmu_map_unmap(map, 1, &mem_map_table);
+		if (ret) {
+			qdf_nbuf_set_rx_ipa_smmu_map(nbuf, !map);
+			qdf_err("map: %d failure, nbuf: %pK", map, nbuf);
+			qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
+			return QDF_STATUS_E_FAILURE;
 		}
 	}
 
@@ -88,28 +88,14 @@ struct htt_tx_mgmt_desc_ctxt {
 	A_UINT32 pending_cnt;
 };
 
-struct htt_list_node {
-	struct htt_list_node *prev;
-	struct htt_list_node *next;
-};
-
+/*
+ * struct htt_rx_hash_entry - rx buffer table entry
+ * @paddr: paddr of the rx buffer, stripped of the marking bits
+ * @netbuf: rx buffer, NULL if the entry is free
+ */
 struct htt_rx_hash_entry {
 	qdf_dma_addr_t paddr;
 	qdf_nbuf_t netbuf;
-	A_UINT8 fromlist;
-	struct htt_list_node listnode;
-#ifdef RX_HASH_DEBUG
-	A_UINT32 cookie;
-#endif
-};
-
-struct htt_rx_hash_bucket {
-	struct htt_list_node listhead;
-	struct htt_rx_hash_entry *entries;
-	struct htt_list_node freepool;
-#ifdef RX_HASH_DEBUG
-	A_UINT32 count;
-#endif
 };
 
 /*
@@ -367,9 +353,25 @@ struct htt_pdev_t {
 		int rx_reset;
 		uint8_t htt_rx_restore;
 #endif
+		/*
+		 * rx buffer table, indexed by paddr hash with linear
+		 * probing; rx_hash_lock serializes inserts and lookups
+		 */
 		qdf_spinlock_t rx_hash_lock;
-		struct htt_rx_hash_bucket **hash_table;
-		uint32_t listnode_offset;
+		struct htt_rx_hash_entry *hash_table;
+		uint32_t hash_mask;
+		/* 32 - log2(number of entries), for the paddr hash */
+		uint8_t hash_shift;
+		/*
+		 * longest probe sequence any insert has needed since the
+		 * table was allocated, bounding the lookup probes. It is a
+		 * lifetime maximum, only reset by htt_rx_hash_init(), as
+		 * entries inserted that far may still be in the table.
+		 */
+		uint32_t hash_max_probe;
+#ifdef RX_HASH_DEBUG
+		uint32_t hash_count;
+#endif
 		bool smmu_map;
 	} rx_ring;
 
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "cds_api.h"
+#include "htt_internal.h"
+#include "htt_rx_hash_test.h"
+#include "htt_types.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+/* Rx ring size used by the tests, i.e. number of buffers in flight */
+#define HTT_RX_HASH_TEST_RING_SIZE 1024
+
+/* Number of times each ring slot is recycled by the benchmark */
+#define HTT_RX_HASH_TEST_ROUNDS 64
+
+/* MSDUs referenced by each rx in order indication of the pop benchmark */
+#define HTT_RX_HASH_TEST_POP_MSDUS 32
+
+/* Number of rx in order indications popped by the benchmark */
+#define HTT_RX_HASH_TEST_POP_INDS 2048
+
+/* MSDU length reported by the target for each popped buffer */
+#define HTT_RX_HASH_TEST_POP_MSDU_LEN 1500
+
+/*
+ * The entries are never handed to the network stack, so any distinct non
+ * NULL pointer can stand for the netbuf of a ring slot.
+ */
+static uint8_t htt_rx_hash_test_bufs[HTT_RX_HASH_TEST_RING_SIZE];
+
+/* paddr currently posted in each ring slot, too large for the stack */
+static qdf_dma_addr_t htt_rx_hash_test_posted[HTT_RX_HASH_TEST_RING_SIZE];
+
+#define htt_rx_hash_test_netbuf(slot) \
+	((qdf_nbuf_t)&htt_rx_hash_test_bufs[slot])
+
+/* rx buffers referenced by the indication being popped, in order */
+static qdf_nbuf_t htt_rx_hash_test_pop_posted[HTT_RX_HASH_TEST_POP_MSDUS];
+
+/* rx ring alloc and target indexes, only read by the pop sanity checks */
+static uint32_t htt_rx_hash_test_alloc_idx;
+static uint32_t htt_rx_hash_test_target_idx;
+
+/**
+ * htt_rx_hash_test_paddr() - Generate the paddr of a refilled rx buffer
+ * @seed: generator state
+ *
+ * Rx buffers are recycled through the kernel allocator, so their paddrs are
+ * scattered over memory. Produce 64 byte aligned paddrs within the 37 bits
+ * the target reports.
+ *
+ * Return: paddr
+ */
+static qdf_dma_addr_t htt_rx_hash_test_paddr(uint64_t *seed)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (qdf_dma_addr_t)((*seed >> 27) & 0x1FFFFFFFC0ULL);
+}
+
+static struct htt_pdev_t *htt_rx_hash_test_create(void)
+{
+	struct htt_pdev_t *pdev;
+
+	pdev = qdf_mem_malloc(sizeof(*pdev));
+	if (!pdev)
+		return NULL;
+
+	/* SMMU S1 is reported disabled, so the netbufs are not touched */
+	pdev->osdev = qdf_mem_malloc(sizeof(*pdev->osdev));
+	if (!pdev->osdev)
+		goto free_pdev;
+
+	pdev->rx_ring.size = HTT_RX_HASH_TEST_RING_SIZE;
+	if (htt_rx_hash_init(pdev))
+		goto free_osdev;
+
+	return pdev;
+
+free_osdev:
+	qdf_mem_free(pdev->osdev);
+free_pdev:
+	qdf_mem_free(pdev);
+
+	return NULL;
+}
+
+static void htt_rx_hash_test_destroy(struct htt_pdev_t *pdev)
+{
+	htt_rx_hash_deinit(pdev);
+	qdf_mem_free(pdev->osdev);
+	qdf_mem_free(pdev);
+}
+
+/**
+ * htt_rx_hash_test_empty() - Check that no entry is left in the table
+ * @pdev: HTT pdev handle
+ *
+ * Return: number of errors
+ */
+static uint32_t htt_rx_hash_test_empty(struct htt_pdev_t *pdev)
+{
+	uint32_t i;
+
+	for (i = 0; i <= pdev->rx_ring.hash_mask; i++)
+		QDF_BUG(!pdev->rx_ring.hash_table[i].netbuf);
+
+	return 0;
+}
+
+static uint32_t htt_rx_hash_test_insert_lookup(void)
+{
+	qdf_dma_addr_t *paddr = htt_rx_hash_test_posted;
+	struct htt_pdev_t *pdev;
+	uint64_t seed = 1;
+	uint32_t i;
+
+	pdev = htt_rx_hash_test_create();
+	QDF_BUG(pdev);
+	if (!pdev)
+		return 1;
+
+	/* a table filled up to the rx ring size should ... */
+	for (i = 0; i < HTT_RX_HASH_TEST_RING_SIZE; i++) {
+		paddr[i] = htt_rx_hash_test_paddr(&seed);
+		QDF_BUG(!htt_rx_hash_list_insert(pdev, paddr[i],
+						 htt_rx_hash_test_netbuf(i)));
+	}
+
+	/* ... keep the probe sequences well below the table size */
+	QDF_BUG(pdev->rx_ring.hash_max_probe < pdev->rx_ring.hash_mask / 2);
+
+	/* ... give back the netbuf of each paddr, in any order */
+	for (i = HTT_RX_HASH_TEST_RING_SIZE; i > 0; i--)
+		QDF_BUG(htt_rx_hash_list_lookup(pdev, paddr[i - 1]) ==
+			htt_rx_hash_test_netbuf(i - 1));
+
+	/* ... be empty once every buffer was handed back */
+	htt_rx_hash_test_empty(pdev);
+
+	htt_rx_hash_test_destroy(pdev);
+
+	return 0;
+}
+
+/**
+ * htt_rx_hash_test_recycle() - Benchmark the table under rx ring recycling
+ *
+ * Keeps the table at full rx ring occupancy and, like the in-order rx path
+ * followed by the refill, hands back the oldest buffer and posts a new one
+ * at a new paddr, so that released entries keep being reused.
+ *
+ * Return: number of errors
+ */
+static uint32_t htt_rx_hash_test_recycle(void)
+{
+	uint32_t steps = HTT_RX_HASH_TEST_RING_SIZE * HTT_RX_HASH_TEST_ROUNDS;
+	qdf_dma_addr_t *paddr = htt_rx_hash_test_posted;
+	struct htt_pdev_t *pdev;
+	uint64_t seed = 2;
+	int64_t start_ns;
+	uint64_t elapsed_ns;
+	uint32_t i, slot;
+
+	pdev = htt_rx_hash_test_create();
+	QDF_BUG(pdev);
+	if (!pdev)
+		return 1;
+
+	for (slot = 0; slot < HTT_RX_HASH_TEST_RING_SIZE; slot++) {
+		paddr[slot] = htt_rx_hash_test_paddr(&seed);
+		htt_rx_hash_list_insert(pdev, paddr[slot],
+					htt_rx_hash_test_netbuf(slot));
+	}
+
+	start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+	for (i = 0; i < steps; i++) {
+		slot = i % HTT_RX_HASH_TEST_RING_SIZE;
+		QDF_BUG(htt_rx_hash_list_lookup(pdev, paddr[slot]) ==
+			htt_rx_hash_test_netbuf(slot));
+
+		paddr[slot] = htt_rx_hash_test_paddr(&seed);
+		QDF_BUG(!htt_rx_hash_list_insert(pdev, paddr[slot],
+						 htt_rx_hash_test_netbuf(slot)));
+	}
+	elapsed_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+	qdf_nofl_info("htt rx hash: %u lookup + insert in %llu ns, %llu ns each, max probe %u",
+		      steps, elapsed_ns, qdf_do_div(elapsed_ns, steps),
+		      pdev->rx_ring.hash_max_probe);
+
+	for (slot = 0; slot < HTT_RX_HASH_TEST_RING_SIZE; slot++)
+		QDF_BUG(htt_rx_hash_list_lookup(pdev, paddr[slot]) ==
+			htt_rx_hash_test_netbuf(slot));
+
+	htt_rx_hash_test_empty(pdev);
+
+	htt_rx_hash_test_destroy(pdev);
+
+	return 0;
+}
+
+/**
+ * htt_rx_hash_test_pop_post() - Post an rx buffer as the rx ring refill does
+ * @pdev: HTT pdev handle
+ * @netbuf: filled with the posted rx buffer
+ *
+ * Return: paddr of the buffer as the target reports it, 0 on failure
+ */
+static qdf_dma_addr_t htt_rx_hash_test_pop_post(struct htt_pdev_t *pdev,
+						qdf_nbuf_t *netbuf)
+{
+	struct htt_host_rx_desc_base *rx_desc;
+	qdf_dma_addr_t paddr;
+	QDF_STATUS status;
+	qdf_nbuf_t nbuf;
+
+	nbuf = qdf_nbuf_alloc(pdev->osdev, HTT_RX_BUF_SIZE, 0, 4, false);
+	if (!nbuf)
+		return 0;
+
+	/* The target fills in the descriptor, report a frame without errors */
+	rx_desc = htt_rx_desc(nbuf);
+	qdf_mem_zero(rx_desc, sizeof(*rx_desc));
+	qdf_nbuf_push_head(nbuf, qdf_nbuf_data(nbuf) - (uint8_t *)rx_desc);
+
+#ifdef DEBUG_DMA_DONE
+	status = qdf_nbuf_map(pdev->osdev, nbuf, QDF_DMA_BIDIRECTIONAL);
+#else
+	status = qdf_nbuf_map(pdev->osdev, nbuf, QDF_DMA_FROM_DEVICE);
+#endif
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nbuf_free(nbuf);
+		return 0;
+	}
+
+	paddr = qdf_nbuf_get_frag_paddr(nbuf, 0);
+#ifdef ENABLE_DEBUG_ADDRESS_MARKING
+	/* The target hands back the paddr marked by the refill */
+	if (sizeof(qdf_dma_addr_t) > 4) {
+		paddr &= 0x01FFFFFFFFF;
+		paddr |= (((uint64_t)RX_PADDR_MAGIC_PATTERN) << 32);
+	}
+#endif
+
+	/* On failure the buffer is left to htt_rx_hash_deinit() */
+	if (htt_rx_hash_list_insert(pdev, paddr, nbuf))
+		return 0;
+
+	qdf_atomic_inc(&pdev->rx_ring.fill_cnt);
+	*netbuf = nbuf;
+
+	return paddr;
+}
+
+/**
+ * htt_rx_hash_test_pop_fill() - Post rx buffers and build the rx in order
+ *				 indication the target sends once they are
+ *				 filled
+ * @pdev: HTT pdev handle
+ * @rx_ind_msg: indication message, sized for HTT_RX_HASH_TEST_POP_MSDUS
+ *
+ * Return: number of errors
+ */
+static uint32_t htt_rx_hash_test_pop_fill(struct htt_pdev_t *pdev,
+					  qdf_nbuf_t rx_ind_msg)
+{
+	uint32_t *msg_word = (uint32_t *)qdf_nbuf_data(rx_ind_msg);
+	qdf_dma_addr_t paddr;
+	uint32_t i;
+
+	qdf_mem_zero(msg_word, qdf_nbuf_len(rx_ind_msg));
+	HTT_T2H_MSG_TYPE_SET(*msg_word, HTT_T2H_MSG_TYPE_RX_IN_ORD_PADDR_IND);
+	HTT_RX_IN_ORD_PADDR_IND_MSDU_CNT_SET(*(msg_word + 1),
+					     HTT_RX_HASH_TEST_POP_MSDUS);
+
+	msg_word = (uint32_t *)(qdf_nbuf_data(rx_ind_msg) +
+				HTT_RX_IN_ORD_PADDR_IND_HDR_BYTES);
+	for (i = 0; i < HTT_RX_HASH_TEST_POP_MSDUS; i++) {
+		paddr = htt_rx_hash_test_pop_post(
+					pdev, &htt_rx_hash_test_pop_posted[i]);
+		QDF_BUG(paddr);
+		if (!paddr)
+			return 1;
+
+		*msg_word = (uint32_t)paddr;
+#if HTT_PADDR64
+		*(msg_word + 1) = (uint32_t)((paddr >> 16) >> 16);
+#endif
+		HTT_RX_IN_ORD_PADDR_IND_MSDU_LEN_SET(
+				*(msg_word + NEXT_FIELD_OFFSET_IN32),
+				HTT_RX_HASH_TEST_POP_MSDU_LEN);
+		msg_word += HTT_RX_IN_ORD_PADDR_IND_MSDU_DWORDS;
+	}
+
+	return 0;
+}
+
+/**
+ * htt_rx_hash_test_pop_check() - Check and free the popped MSDU list
+ * @head: first MSDU popped
+ * @tail: last MSDU popped
+ *
+ * Return: number of errors
+ */
+static uint32_t htt_rx_hash_test_pop_check(qdf_nbuf_t head, qdf_nbuf_t tail)
+{
+	qdf_nbuf_t *posted = htt_rx_hash_test_pop_posted;
+	qdf_nbuf_t msdu, next;
+	uint32_t errors = 0;
+	uint32_t i = 0;
+
+	errors += tail != posted[HTT_RX_HASH_TEST_POP_MSDUS - 1];
+
+	/* MSDUs come back in the indication order */
+	for (msdu = head; msdu; msdu = next) {
+		next = qdf_nbuf_next(msdu);
+		if (i < HTT_RX_HASH_TEST_POP_MSDUS)
+			errors += msdu != posted[i];
+		i++;
+		qdf_nbuf_free(msdu);
+	}
+	errors += i != HTT_RX_HASH_TEST_POP_MSDUS;
+
+	QDF_BUG(!errors);
+
+	return errors;
+}
+
+/**
+ * htt_rx_hash_test_in_order_pop() - Benchmark htt_rx_amsdu_rx_in_order_pop_ll()
+ *
+ * Posts real rx buffers, mapped on the wlan device, and pops them through
+ * the in order rx path with the indications the target would send once
+ * they are filled. Only the pop itself is timed, including the unmap and
+ * the rx buffer table lookups. The rx indication histogram of the txrx
+ * pdev, if any, counts the indications.
+ *
+ * Return: number of errors
+ */
+static uint32_t htt_rx_hash_test_in_order_pop(void)
+{
+	qdf_device_t osdev = cds_get_context(QDF_MODULE_ID_QDF_DEVICE);
+	uint32_t msdus = HTT_RX_HASH_TEST_POP_MSDUS * HTT_RX_HASH_TEST_POP_INDS;
+	qdf_nbuf_t rx_ind_msg, head, tail;
+	struct htt_pdev_t *pdev;
+	qdf_device_t test_osdev;
+	uint64_t elapsed_ns = 0;
+	uint32_t errors = 0;
+	uint32_t msg_len;
+	int64_t start_ns;
+	uint32_t i;
+	int ret;
+
+	if (!osdev) {
+		qdf_nofl_info("htt rx in order pop: no wlan device, skipped");
+		return 0;
+	}
+
+	pdev = htt_rx_hash_test_create();
+	QDF_BUG(pdev);
+	if (!pdev)
+		return 1;
+
+	test_osdev = pdev->osdev;
+	pdev->osdev = osdev;
+	htt_rx_hash_test_alloc_idx = 1;
+	htt_rx_hash_test_target_idx = 0;
+	pdev->rx_ring.alloc_idx.vaddr = &htt_rx_hash_test_alloc_idx;
+	pdev->rx_ring.target_idx.vaddr = &htt_rx_hash_test_target_idx;
+	pdev->rx_ring.size_mask = HTT_RX_HASH_TEST_RING_SIZE - 1;
+
+	msg_len = HTT_RX_IN_ORD_PADDR_IND_HDR_BYTES +
+		  HTT_RX_HASH_TEST_POP_MSDUS *
+		  HTT_RX_IN_ORD_PADDR_IND_MSDU_BYTES;
+	rx_ind_msg = qdf_nbuf_alloc(osdev, msg_len, 0, 4, false);
+	QDF_BUG(rx_ind_msg);
+	if (!rx_ind_msg) {
+		errors++;
+		goto deinit;
+	}
+	qdf_nbuf_put_tail(rx_ind_msg, msg_len);
+
+	for (i = 0; i < HTT_RX_HASH_TEST_POP_INDS; i++) {
+		errors += htt_rx_hash_test_pop_fill(pdev, rx_ind_msg);
+		if (errors)
+			break;
+
+		start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+		ret = htt_rx_amsdu_rx_in_order_pop_ll_test(pdev, rx_ind_msg,
+							   &head, &tail);
+		elapsed_ns += qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+		QDF_BUG(ret == 1);
+		if (ret != 1) {
+			errors++;
+			break;
+		}
+
+		errors += htt_rx_hash_test_pop_check(head, tail);
+		if (errors)
+			break;
+	}
+
+	if (!errors)
+		qdf_nofl_info("htt rx in order pop: %u msdus in %llu ns, %llu ns each, %llu msdus/s, max probe %u",
+			      msdus, elapsed_ns, qdf_do_div(elapsed_ns, msdus),
+			      qdf_do_div((uint64_t)msdus * 1000000000ULL,
+					 QDF_MAX(elapsed_ns, 1)),
+			      pdev->rx_ring.hash_max_probe);
+
+	qdf_nbuf_free(rx_ind_msg);
+
+deinit:
+	/* Unmap and free any buffer left posted, on the wlan device */
+	htt_rx_hash_deinit(pdev);
+	pdev->osdev = test_osdev;
+	htt_rx_hash_test_destroy(pdev);
+
+	return errors;
+}
+
+uint32_t htt_rx_hash_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += htt_rx_hash_test_insert_lookup();
+	errors += htt_rx_hash_test_recycle();
+	errors += htt_rx_hash_test_in_order_pop();
+
+	return errors;
+}
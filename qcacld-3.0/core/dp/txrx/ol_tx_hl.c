@@ -1940,6 +1940,7 @@ void ol_txrx_vdev_txqs_init(struct ol_txrx_vdev_t *vdev)
 		vdev->txqs[i].flag = ol_tx_queue_empty;
 		/* aggregation is not applicable for vdev tx queues */
 		vdev->txqs[i].aggr_state = ol_tx_aggr_disabled;
+		ol_tx_queue_budget_init(&vdev->txqs[i]);
 		ol_tx_txq_set_group_ptr(&vdev->txqs[i], NULL);
 		ol_txrx_set_txq_peer(&vdev->txqs[i], NULL);
 	}
@@ -1985,6 +1986,7 @@ void ol_txrx_peer_txqs_init(struct ol_txrx_pdev_t *pdev,
 		peer->txqs[i].ext_tid = i;
 		peer->txqs[i].flag = ol_tx_queue_empty;
 		peer->txqs[i].aggr_state = ol_tx_aggr_untried;
+		ol_tx_queue_budget_init(&peer->txqs[i]);
 		ol_tx_set_peer_group_ptr(pdev, peer, vdev->vdev_id, i);
 		ol_txrx_set_txq_peer(&peer->txqs[i], peer);
 	}
@@ -248,6 +248,283 @@ is_ol_tx_discard_frames_success(struct ol_txrx_pdev_t *pdev,
 }
 #endif /* QCA_HL_NETDEV_FLOW_CONTROL */
 
+#ifdef QCA_HL_TX_QUEUE_BUDGET
+
+/* per tx queue byte budget of each access category */
+static const uint32_t ol_tx_queue_ac_budget[WME_AC_MAX] = {
+	[WME_AC_BE] = OL_TX_QUEUE_BUDGET_BE_BYTES,
+	[WME_AC_BK] = OL_TX_QUEUE_BUDGET_BK_BYTES,
+	[WME_AC_VI] = OL_TX_QUEUE_BUDGET_VI_BYTES,
+	[WME_AC_VO] = OL_TX_QUEUE_BUDGET_VO_BYTES,
+};
+
+void ol_tx_queue_budget_init(struct ol_tx_frms_queue_t *txq)
+{
+	qdf_mem_zero(&txq->budget, sizeof(txq->budget));
+}
+
+/**
+ * ol_tx_queue_isqrt() - integer square root
+ * @val: input value
+ *
+ * Return: floor of the square root of @val
+ */
+static uint32_t ol_tx_queue_isqrt(uint32_t val)
+{
+	uint32_t res = 0;
+	uint32_t bit = 1u << 30;
+
+	while (bit > val)
+		bit >>= 2;
+
+	while (bit) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return res;
+}
+
+/**
+ * ol_tx_queue_codel_next() - CoDel control law
+ * @now_ms: current time in msecs
+ * @count: drops in the current dropping state
+ *
+ * Return: time of the next drop, interval / sqrt(count) from now
+ */
+static inline uint32_t ol_tx_queue_codel_next(uint32_t now_ms, uint16_t count)
+{
+	return now_ms + OL_TX_QUEUE_CODEL_INTERVAL_MS /
+			ol_tx_queue_isqrt(count ? count : 1);
+}
+
+/**
+ * ol_tx_queue_codel_should_drop() - CoDel drop decision for a tx queue
+ * @txq: tx queue
+ * @now_ms: current time in msecs
+ *
+ * Return: true if the head frame of @txq should be dropped
+ */
+static bool
+ol_tx_queue_codel_should_drop(struct ol_tx_frms_queue_t *txq, uint32_t now_ms)
+{
+	struct ol_tx_queue_budget_t *budget = &txq->budget;
+	struct ol_tx_desc_t *head = TAILQ_FIRST(&txq->head);
+
+	if (!head)
+		return false;
+
+	if (now_ms - head->enqueue_ms < OL_TX_QUEUE_CODEL_TARGET_MS ||
+	    txq->bytes <= OL_TX_QUEUE_CODEL_MIN_BYTES) {
+		budget->first_above_ms = 0;
+		budget->dropping = false;
+		return false;
+	}
+
+	if (!budget->dropping) {
+		if (!budget->first_above_ms) {
+			budget->first_above_ms =
+				now_ms + OL_TX_QUEUE_CODEL_INTERVAL_MS;
+			return false;
+		}
+		if ((int32_t)(now_ms - budget->first_above_ms) < 0)
+			return false;
+
+		/* resume at the previous drop rate if it was recently left */
+		if (budget->drop_count > 2 &&
+		    (int32_t)(now_ms - budget->drop_next_ms) <
+		    16 * OL_TX_QUEUE_CODEL_INTERVAL_MS)
+			budget->drop_count -= 2;
+		else
+			budget->drop_count = 1;
+		budget->dropping = true;
+		budget->drop_next_ms =
+			ol_tx_queue_codel_next(now_ms, budget->drop_count);
+		return true;
+	}
+
+	if ((int32_t)(now_ms - budget->drop_next_ms) < 0)
+		return false;
+
+	if (budget->drop_count < 0xffff)
+		budget->drop_count++;
+	budget->drop_next_ms =
+		ol_tx_queue_codel_next(now_ms, budget->drop_count);
+	return true;
+}
+
+/**
+ * ol_tx_queue_peer_bytes() - bytes queued on all tx queues of a peer
+ * @txq: one of the peer tx queues
+ *
+ * Return: number of bytes
+ */
+static uint32_t ol_tx_queue_peer_bytes(struct ol_tx_frms_queue_t *txq)
+{
+	struct ol_txrx_peer_t *peer;
+	uint32_t bytes = 0;
+	int i;
+
+	peer = container_of(txq - txq->ext_tid, struct ol_txrx_peer_t,
+			    txqs[0]);
+	for (i = 0; i < OL_TX_NUM_TIDS; i++)
+		bytes += peer->txqs[i].bytes;
+
+	return bytes;
+}
+
+/**
+ * ol_tx_queue_budget_enforce() - apply CoDel and byte budgets to a txq
+ * @pdev: the physical device object
+ * @txq: tx queue a frame was just enqueued to
+ * @now_ms: current time in msecs
+ * @tx_descs: list the dropped tx descriptors are appended to
+ *
+ * Drops frames from the head of @txq, through the scheduler discard
+ * path, when CoDel decides the queue is standing or while the queue or
+ * its peer is over the byte budget. The frame just enqueued is kept.
+ * Management and vdev tx queues are exempt. The tx_queue_spinlock must
+ * be held by the caller.
+ *
+ * Return: number of frames dropped
+ */
+static u_int16_t
+ol_tx_queue_budget_enforce(struct ol_txrx_pdev_t *pdev,
+			   struct ol_tx_frms_queue_t *txq,
+			   uint32_t now_ms,
+			   ol_tx_desc_list *tx_descs)
+{
+	uint32_t ac_budget;
+	u_int16_t dropped, total = 0;
+
+	if (txq->ext_tid >= OL_TX_MGMT_TID)
+		return 0;
+
+	if (txq->frms > 1 && ol_tx_queue_codel_should_drop(txq, now_ms)) {
+		dropped = ol_tx_sched_discard_txq(pdev, txq, 1, tx_descs);
+		txq->budget.codel_drops += dropped;
+		total += dropped;
+	}
+
+	/* the non-QoS data TID maps to best effort */
+	ac_budget = ol_tx_queue_ac_budget[TID_TO_WME_AC(txq->ext_tid & 0x7)];
+	while (txq->frms > 1 &&
+	       (txq->bytes > ac_budget ||
+		ol_tx_queue_peer_bytes(txq) > OL_TX_QUEUE_BUDGET_PEER_BYTES)) {
+		dropped = ol_tx_sched_discard_txq(pdev, txq, 1, tx_descs);
+		if (!dropped)
+			break;
+
+		txq->budget.budget_drops += dropped;
+		total += dropped;
+	}
+
+	return total;
+}
+
+/**
+ * ol_tx_queue_budget_sojourn() - account the sojourn time of a frame
+ * @txq: tx queue the frame leaves
+ * @tx_desc: tx descriptor of the frame
+ * @now_ms: current time in msecs
+ *
+ * Return: None
+ */
+static inline void
+ol_tx_queue_budget_sojourn(struct ol_tx_frms_queue_t *txq,
+			   struct ol_tx_desc_t *tx_desc, uint32_t now_ms)
+{
+	struct ol_tx_queue_budget_t *budget = &txq->budget;
+	uint32_t sojourn = now_ms - tx_desc->enqueue_ms;
+
+	if (sojourn > budget->sojourn_max_ms)
+		budget->sojourn_max_ms = sojourn;
+	budget->sojourn_avg_ms = budget->sojourn_frms ?
+		(budget->sojourn_avg_ms * 7 + sojourn) / 8 : sojourn;
+	budget->sojourn_frms++;
+}
+
+static inline uint32_t ol_tx_queue_now_ms(void)
+{
+	return qdf_system_ticks_to_msecs(qdf_system_ticks());
+}
+
+/**
+ * ol_tx_queue_budget_display() - show sojourn stats of one tx queue
+ * @txq: tx queue
+ * @peer_id: peer id, or HTT_INVALID_PEER for vdev tx queues
+ * @vdev_id: vdev id
+ * @idx: queue index within the peer or vdev
+ *
+ * Return: None
+ */
+static void
+ol_tx_queue_budget_display(struct ol_tx_frms_queue_t *txq, uint16_t peer_id,
+			   uint8_t vdev_id, int idx)
+{
+	struct ol_tx_queue_budget_t *budget = &txq->budget;
+
+	if (!budget->sojourn_frms && !budget->codel_drops &&
+	    !budget->budget_drops)
+		return;
+
+	txrx_nofl_info("vdev %u peer %u txq %d: %u frms %u bytes sojourn avg %u max %u ms (%u frms) drops codel %u budget %u",
+		       vdev_id, peer_id, idx, txq->frms, txq->bytes,
+		       budget->sojourn_avg_ms, budget->sojourn_max_ms,
+		       budget->sojourn_frms, budget->codel_drops,
+		       budget->budget_drops);
+}
+
+void ol_tx_queue_budget_stats_display(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_txrx_vdev_t *vdev;
+	struct ol_txrx_peer_t *peer;
+	int i;
+
+	txrx_nofl_info("HL tx queue sojourn stats:");
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem) {
+		for (i = 0; i < QDF_ARRAY_SIZE(vdev->txqs); i++)
+			ol_tx_queue_budget_display(&vdev->txqs[i],
+						   HTT_INVALID_PEER,
+						   vdev->vdev_id, i);
+
+		qdf_spin_lock_bh(&pdev->peer_ref_mutex);
+		TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
+			for (i = 0; i < QDF_ARRAY_SIZE(peer->txqs); i++)
+				ol_tx_queue_budget_display(&peer->txqs[i],
+							   peer->peer_ids[0],
+							   vdev->vdev_id, i);
+		}
+		qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
+	}
+}
+#else
+static inline u_int16_t
+ol_tx_queue_budget_enforce(struct ol_txrx_pdev_t *pdev,
+			   struct ol_tx_frms_queue_t *txq,
+			   uint32_t now_ms,
+			   ol_tx_desc_list *tx_descs)
+{
+	return 0;
+}
+
+static inline void
+ol_tx_queue_budget_sojourn(struct ol_tx_frms_queue_t *txq,
+			   struct ol_tx_desc_t *tx_desc, uint32_t now_ms)
+{
+}
+
+static inline uint32_t ol_tx_queue_now_ms(void)
+{
+	return 0;
+}
+#endif /* QCA_HL_TX_QUEUE_BUDGET */
+
 void
 ol_tx_enqueue(
 	struct ol_txrx_pdev_t *pdev,
@@ -257,6 +534,9 @@ ol_tx_enqueue(
 {
 	int bytes;
 	struct ol_tx_sched_notify_ctx_t notify_ctx;
+	ol_tx_desc_list drop_descs;
+	u_int16_t dropped = 0;
+	uint32_t now_ms = ol_tx_queue_now_ms();
 
 	TX_SCHED_DEBUG_PRINT("Enter");
 
@@ -274,7 +554,12 @@ ol_tx_enqueue(
 		ol_tx_desc_frame_list_free(pdev, &tx_descs, 1 /* error */);
 	}
 
+	TAILQ_INIT(&drop_descs);
+
 	qdf_spin_lock_bh(&pdev->tx_queue_spinlock);
+#ifdef QCA_HL_TX_QUEUE_BUDGET
+	tx_desc->enqueue_ms = now_ms;
+#endif
 	TAILQ_INSERT_TAIL(&txq->head, tx_desc, tx_desc_list_elem);
 
 	bytes = qdf_nbuf_len(tx_desc->netbuf);
@@ -291,27 +576,49 @@ ol_tx_enqueue(
 		notify_ctx.info.tx_msdu_info = tx_msdu_info;
 		ol_tx_sched_notify(pdev, &notify_ctx);
 		txq->flag = ol_tx_queue_active;
+		dropped = ol_tx_queue_budget_enforce(pdev, txq, now_ms,
+						     &drop_descs);
 	}
 
 	if (!ETHERTYPE_IS_EAPOL_WAPI(tx_msdu_info->htt.info.ethertype))
 		OL_TX_QUEUE_ADDBA_CHECK(pdev, txq, tx_msdu_info);
 
 	qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
+
+	if (dropped) {
+		qdf_atomic_add(dropped, &pdev->tx_queue.rsrc_cnt);
+		ol_tx_desc_frame_list_free(pdev, &drop_descs, 1 /* error */);
+	}
 	TX_SCHED_DEBUG_PRINT("Leave");
 }
 
-u_int16_t
-ol_tx_dequeue(
+/**
+ * __ol_tx_dequeue() - remove frames from the head of a tx queue
+ * @pdev: the physical device object
+ * @txq: which tx queue to remove frames from
+ * @head: list the dequeued tx descriptors are appended to
+ * @max_frames: maximum number of frames to remove
+ * @credit: in: max credit the frames can consume, out: credit consumed
+ * @bytes: sum of the sizes of the dequeued frames
+ * @sojourn: whether the frames are sent, so that their sojourn time is
+ *	     accounted
+ *
+ * Return: number of frames dequeued
+ */
+static u_int16_t
+__ol_tx_dequeue(
 	struct ol_txrx_pdev_t *pdev,
 	struct ol_tx_frms_queue_t *txq,
 	ol_tx_desc_list *head,
 	u_int16_t max_frames,
 	u_int32_t *credit,
-	int *bytes)
+	int *bytes,
+	bool sojourn)
 {
 	u_int16_t num_frames;
 	int bytes_sum;
 	unsigned int credit_sum;
+	uint32_t now_ms = ol_tx_queue_now_ms();
 
 	TXRX_ASSERT2(txq->flag != ol_tx_queue_paused);
 	TX_SCHED_DEBUG_PRINT("Enter");
@@ -333,6 +640,8 @@ ol_tx_dequeue(
 
 		credit_sum += frame_credit;
 		bytes_sum += qdf_nbuf_len(tx_desc->netbuf);
+		if (sojourn)
+			ol_tx_queue_budget_sojourn(txq, tx_desc, now_ms);
 		TAILQ_REMOVE(&txq->head, tx_desc, tx_desc_list_elem);
 		TAILQ_INSERT_TAIL(head, tx_desc, tx_desc_list_elem);
 	}
@@ -352,6 +661,32 @@ ol_tx_dequeue(
 	return num_frames;
 }
 
+u_int16_t
+ol_tx_dequeue(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	ol_tx_desc_list *head,
+	u_int16_t max_frames,
+	u_int32_t *credit,
+	int *bytes)
+{
+	return __ol_tx_dequeue(pdev, txq, head, max_frames, credit, bytes,
+			       true);
+}
+
+u_int16_t
+ol_tx_dequeue_discard(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	ol_tx_desc_list *head,
+	u_int16_t max_frames,
+	u_int32_t *credit,
+	int *bytes)
+{
+	return __ol_tx_dequeue(pdev, txq, head, max_frames, credit, bytes,
+			       false);
+}
+
 void
 ol_tx_queue_free(
 	struct ol_txrx_pdev_t *pdev,
@@ -149,6 +149,30 @@ ol_tx_dequeue(
 	u_int32_t *credit,
 	int *bytes);
 
+/**
+ * ol_tx_dequeue_discard() - remove frames to be discarded from the head of
+ * a tx queue
+ * @pdev: the physical device object
+ * @txq: which tx queue to remove frames from
+ * @head: list the dequeued tx descriptors are appended to
+ * @num_frames: maximum number of frames to remove
+ * @credit: in: max credit the frames can consume, out: credit consumed
+ * @bytes: sum of the sizes of the dequeued frames
+ *
+ * Same as ol_tx_dequeue(), except that the frames are not accounted in the
+ * sojourn stats of the queue, since they are dropped rather than sent.
+ *
+ * Return: number of frames dequeued
+ */
+u_int16_t
+ol_tx_dequeue_discard(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	ol_tx_desc_list *head,
+	u_int16_t num_frames,
+	u_int32_t *credit,
+	int *bytes);
+
 /**
  * @brief - free all of frames from the tx queue while deletion
  * @details
@@ -210,6 +234,18 @@ ol_tx_dequeue(
 	return 0;
 }
 
+static inline u_int16_t
+ol_tx_dequeue_discard(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	ol_tx_desc_list *head,
+	u_int16_t num_frames,
+	u_int32_t *credit,
+	int *bytes)
+{
+	return 0;
+}
+
 static inline void
 ol_tx_queue_free(
 		struct ol_txrx_pdev_t *pdev,
@@ -663,4 +699,51 @@ ol_tx_txq_update_borrowed_group_credits(struct ol_txrx_pdev_t *pdev,
 	*  FEATURE_HL_DBS_GROUP_CREDIT_SHARING
 	*/
 
+#if defined(CONFIG_HL_SUPPORT) && defined(QCA_HL_TX_QUEUE_BUDGET)
+/*
+ * Byte budgets of a single peer-TID tx queue, per access category, and
+ * of all the tx queues of one peer. Frames over budget are dropped from
+ * the head of the queue being enqueued to.
+ */
+#define OL_TX_QUEUE_BUDGET_BE_BYTES	(128 * 1024)
+#define OL_TX_QUEUE_BUDGET_BK_BYTES	(64 * 1024)
+#define OL_TX_QUEUE_BUDGET_VI_BYTES	(128 * 1024)
+#define OL_TX_QUEUE_BUDGET_VO_BYTES	(32 * 1024)
+#define OL_TX_QUEUE_BUDGET_PEER_BYTES	(256 * 1024)
+
+/*
+ * CoDel parameters: queues whose head frame sojourn stays above the
+ * target for an interval are head dropped at an increasing rate. Queues
+ * holding no more than OL_TX_QUEUE_CODEL_MIN_BYTES are never dropped.
+ */
+#define OL_TX_QUEUE_CODEL_TARGET_MS	20
+#define OL_TX_QUEUE_CODEL_INTERVAL_MS	100
+#define OL_TX_QUEUE_CODEL_MIN_BYTES	1536
+
+/**
+ * ol_tx_queue_budget_init() - reset byte budget and CoDel state of a txq
+ * @txq: tx queue
+ *
+ * Return: None
+ */
+void ol_tx_queue_budget_init(struct ol_tx_frms_queue_t *txq);
+
+/**
+ * ol_tx_queue_budget_stats_display() - show per tx queue sojourn stats
+ * @pdev: the physical device object
+ *
+ * Return: None
+ */
+void ol_tx_queue_budget_stats_display(struct ol_txrx_pdev_t *pdev);
+#else
+static inline void ol_tx_queue_budget_init(struct ol_tx_frms_queue_t *txq)
+{
+}
+
+static inline void
+ol_tx_queue_budget_stats_display(struct ol_txrx_pdev_t *pdev)
+{
+}
+#endif /* CONFIG_HL_SUPPORT && QCA_HL_TX_QUEUE_BUDGET */
+
 #endif /* _OL_TX_QUEUE__H_ */
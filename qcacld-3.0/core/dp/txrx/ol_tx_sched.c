@@ -119,6 +119,7 @@ typedef TAILQ_HEAD(ol_tx_frms_queue_list_s, ol_tx_frms_queue_t)
 #define ol_tx_sched_category_info       ol_tx_sched_category_info_rr
 #define ol_tx_sched_discard_select_category \
 		ol_tx_sched_discard_select_category_rr
+#define ol_tx_sched_txq_category(pdev, txq) ((txq)->ext_tid)
 
 #elif OL_TX_SCHED == OL_TX_SCHED_WRR_ADV
 
@@ -141,6 +142,8 @@ typedef TAILQ_HEAD(ol_tx_frms_queue_list_s, ol_tx_frms_queue_t)
 #define ol_tx_sched_category_info       ol_tx_sched_category_info_wrr_adv
 #define ol_tx_sched_discard_select_category \
 		ol_tx_sched_discard_select_category_wrr_adv
+#define ol_tx_sched_txq_category(pdev, txq) \
+		((pdev)->tid_to_ac[(txq)->ext_tid])
 
 #else
 
@@ -605,6 +608,8 @@ OL_TX_SCHED_WRR_ADV_CAT_CFG_SPEC(MCAST_MGMT,   1,      1,     4,     0,  1);
 struct ol_tx_sched_wrr_adv_t {
 	int order[OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES];
 	int index;
+	/* bitmap of categories with queued frames, by category index */
+	u_int32_t active_mask;
 	struct ol_tx_sched_wrr_adv_category_info_t
 		categories[OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES];
 };
@@ -680,6 +685,91 @@ static void ol_tx_sched_wrr_adv_cat_stat_clear(
 
 #endif
 
+/**
+ * ol_tx_sched_wrr_adv_set_active() - update the active state of a category
+ * @scheduler: WRR adv scheduler
+ * @cat: category index
+ * @active: whether the category has frames queued
+ *
+ * Keeps the per-category active flag and the scheduler bitmap of active
+ * categories in step.
+ *
+ * Return: none
+ */
+static inline void
+ol_tx_sched_wrr_adv_set_active(struct ol_tx_sched_wrr_adv_t *scheduler,
+			       int cat, bool active)
+{
+	scheduler->categories[cat].state.active = active;
+	if (active)
+		scheduler->active_mask |= 1 << cat;
+	else
+		scheduler->active_mask &= ~(1 << cat);
+}
+
+/**
+ * ol_tx_sched_wrr_adv_skip_rounds() - fast forward whole WRR skip rounds
+ * @scheduler: WRR adv scheduler
+ * @index: position in the order list the selection starts from
+ *
+ * Every pass of the selection loop over the active categories from
+ * @index onwards bumps each one's wrr_count by one, and a category is
+ * served on the visit that takes its wrr_count to its skip weight. The
+ * number of complete passes that serve nobody is therefore one less than
+ * the smallest number of visits any of those categories still needs.
+ *
+ * When there is at least one such pass, apply what the selection loop
+ * would have done by then: the first pass leaves the inactive categories
+ * behind the selection position in the order they were met, followed by
+ * the active categories in their original order. Further passes rotate
+ * the active categories back to that same order. Each pass credits one
+ * visit to every active category. The selection loop then finds the
+ * category to serve within a single pass of the order list, with the
+ * same order list, WRR counts and position as without the fast forward.
+ *
+ * Return: position in the order list the selection continues from
+ */
+static int
+ol_tx_sched_wrr_adv_skip_rounds(struct ol_tx_sched_wrr_adv_t *scheduler,
+				int index)
+{
+	struct ol_tx_sched_wrr_adv_category_info_t *category;
+	int active[OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES];
+	int i, cat, visits, num_active = 0, rounds = -1;
+
+	for (i = index; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++) {
+		if (!(scheduler->active_mask & (1 << scheduler->order[i])))
+			continue;
+
+		category = &scheduler->categories[scheduler->order[i]];
+		visits = category->specs.wrr_skip_weight -
+			 category->state.wrr_count;
+		if (visits < 1)
+			visits = 1;
+		if (rounds < 0 || visits - 1 < rounds)
+			rounds = visits - 1;
+	}
+
+	if (rounds <= 0)
+		return index;
+
+	/* inactive categories stay behind, in the order they were met */
+	for (i = index; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++) {
+		cat = scheduler->order[i];
+		if (scheduler->active_mask & (1 << cat))
+			active[num_active++] = cat;
+		else
+			scheduler->order[index++] = cat;
+	}
+
+	for (i = 0; i < num_active; i++) {
+		scheduler->order[index + i] = active[i];
+		scheduler->categories[active[i]].state.wrr_count += rounds;
+	}
+
+	return index;
+}
+
 static void
 ol_tx_sched_select_init_wrr_adv(struct ol_txrx_pdev_t *pdev)
 {
@@ -724,6 +814,89 @@ ol_tx_sched_wrr_adv_credit_sanity_check(struct ol_txrx_pdev_t *pdev,
 	qdf_assert(okay);
 }
 
+/**
+ * ol_tx_sched_wrr_adv_select_category() - find the category to serve next
+ * @scheduler: WRR adv scheduler
+ *
+ * Walks the order list from the current selection position. An active
+ * category whose WRR turn is not due yet gets its wrr_count bumped and is
+ * moved to the back of the list.
+ *
+ * Return: position in the order list of the category to serve, or
+ *	OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES if no category is active
+ */
+static int
+ol_tx_sched_wrr_adv_select_category(struct ol_tx_sched_wrr_adv_t *scheduler)
+{
+	struct ol_tx_sched_wrr_adv_category_info_t *category;
+	int category_index;
+	int index;
+
+	if (!scheduler->active_mask)
+		return OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES;
+
+	index = ol_tx_sched_wrr_adv_skip_rounds(scheduler, scheduler->index);
+	while (index < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES) {
+		category_index = scheduler->order[index];
+		category = &scheduler->categories[category_index];
+		if (!(scheduler->active_mask & (1 << category_index))) {
+			/* move on to the next category */
+			index++;
+			continue;
+		}
+		if (++category->state.wrr_count <
+					category->specs.wrr_skip_weight) {
+			/* skip this cateogry (move it to the back) */
+			ol_tx_sched_wrr_adv_rotate_order_list_tail(scheduler,
+								   index);
+			/*
+			 * try again (iterate) on the new element
+			 * that was moved up
+			 */
+			continue;
+		}
+		/* found the first active category whose WRR turn is present */
+		break;
+	}
+
+	return index;
+}
+
+#ifdef WLAN_OL_TX_SCHED_TEST
+int ol_tx_sched_wrr_adv_test_select(int *order, int index,
+				    u_int32_t active_mask,
+				    const int *skip_weight, int *wrr_count)
+{
+	struct ol_tx_sched_wrr_adv_t *scheduler;
+	int i;
+
+	scheduler = qdf_mem_malloc(sizeof(*scheduler));
+	if (!scheduler)
+		return -ENOMEM;
+
+	scheduler->index = index;
+	scheduler->active_mask = active_mask;
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++) {
+		scheduler->order[i] = order[i];
+		scheduler->categories[i].specs.wrr_skip_weight =
+							skip_weight[i];
+		scheduler->categories[i].state.wrr_count = wrr_count[i];
+		scheduler->categories[i].state.active =
+						!!(active_mask & (1 << i));
+	}
+
+	index = ol_tx_sched_wrr_adv_select_category(scheduler);
+
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++) {
+		order[i] = scheduler->order[i];
+		wrr_count[i] = scheduler->categories[i].state.wrr_count;
+	}
+	qdf_mem_free(scheduler);
+
+	return index;
+}
+#endif /* WLAN_OL_TX_SCHED_TEST */
+
 /*
  * The scheduler sync spinlock has been acquired outside this function,
  * so there is no need to worry about mutex within this function.
@@ -754,33 +927,13 @@ ol_tx_sched_select_batch_wrr_adv(
 	}
 
 	/* choose the traffic category from the ordered list */
-	index = scheduler->index;
-	while (index < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES) {
-		category_index = scheduler->order[index];
-		category = &scheduler->categories[category_index];
-		if (!category->state.active) {
-			/* move on to the next category */
-			index++;
-			continue;
-		}
-		if (++category->state.wrr_count <
-					category->specs.wrr_skip_weight) {
-			/* skip this cateogry (move it to the back) */
-			ol_tx_sched_wrr_adv_rotate_order_list_tail(scheduler,
-								   index);
-			/*
-			 * try again (iterate) on the new element
-			 * that was moved up
-			 */
-			continue;
-		}
-		/* found the first active category whose WRR turn is present */
-		break;
-	}
+	index = ol_tx_sched_wrr_adv_select_category(scheduler);
 	if (index >= OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES) {
 		/* no categories are active */
 		return 0;
 	}
+	category_index = scheduler->order[index];
+	category = &scheduler->categories[category_index];
 
 	/* is there enough credit for the selected category? */
 	if (credit < category->specs.credit_threshold) {
@@ -842,7 +995,9 @@ ol_tx_sched_select_batch_wrr_adv(
 						  txq, list_elem);
 			} else {
 				if (category->state.frms == 0)
-					category->state.active = 0;
+					ol_tx_sched_wrr_adv_set_active(
+						scheduler, category_index,
+						false);
 			}
 			sctx->frms += frames;
 			ol_tx_txq_group_credit_update(pdev, txq, -credit, 0);
@@ -891,7 +1046,9 @@ ol_tx_sched_txq_enqueue_wrr_adv(
 	OL_TX_SCHED_WRR_ADV_CAT_STAT_INC_QUEUED(category, frms);
 	if (txq->flag != ol_tx_queue_active) {
 		TAILQ_INSERT_TAIL(&category->state.head, txq, list_elem);
-		category->state.active = 1; /* may have already been active */
+		/* may have already been active */
+		ol_tx_sched_wrr_adv_set_active(scheduler,
+					       pdev->tid_to_ac[tid], true);
 	}
 }
 
@@ -911,7 +1068,8 @@ ol_tx_sched_txq_deactivate_wrr_adv(
 	TAILQ_REMOVE(&category->state.head, txq, list_elem);
 
 	if (category->state.frms == 0 && category->state.active)
-		category->state.active = 0;
+		ol_tx_sched_wrr_adv_set_active(scheduler,
+					       pdev->tid_to_ac[tid], false);
 }
 
 static ol_tx_frms_queue_list *
@@ -971,7 +1129,7 @@ ol_tx_sched_txq_discard_wrr_adv(
 	category->state.bytes -= bytes;
 	OL_TX_SCHED_WRR_ADV_CAT_STAT_INC_DISCARD(category, frames);
 	if (category->state.frms == 0)
-		category->state.active = 0;
+		ol_tx_sched_wrr_adv_set_active(scheduler, cat, false);
 }
 
 static void
@@ -1079,6 +1237,7 @@ ol_tx_sched_init_wrr_adv(
 
 	ol_tx_sched_wrr_param_update(pdev, scheduler);
 
+	scheduler->active_mask = 0;
 	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++) {
 		scheduler->categories[i].state.active = 0;
 		scheduler->categories[i].state.frms = 0;
@@ -1280,7 +1439,8 @@ ol_tx_sched_discard_select(
 	 *     most relevant.
 	 */
 	credit = 10000; /* no credit limit */
-	frms = ol_tx_dequeue(pdev, txq, tx_descs, frms, &credit, &bytes);
+	frms = ol_tx_dequeue_discard(pdev, txq, tx_descs, frms, &credit,
+				     &bytes);
 
 	notify_ctx.event = OL_TX_DISCARD_FRAMES;
 	notify_ctx.frames = frms;
@@ -1293,6 +1453,37 @@ ol_tx_sched_discard_select(
 	return frms;
 }
 
+u_int16_t
+ol_tx_sched_discard_txq(
+		struct ol_txrx_pdev_t *pdev,
+		struct ol_tx_frms_queue_t *txq,
+		u_int16_t frms,
+		ol_tx_desc_list *tx_descs)
+{
+	int bytes;
+	u_int32_t credit;
+	struct ol_tx_sched_notify_ctx_t notify_ctx;
+
+	/* only frames the scheduler accounts for can be discarded here */
+	if (txq->flag != ol_tx_queue_active)
+		return 0;
+
+	/* discard from the head of the queue, as ol_tx_sched_discard_select */
+	credit = 10000; /* no credit limit */
+	frms = ol_tx_dequeue_discard(pdev, txq, tx_descs, frms, &credit,
+				     &bytes);
+
+	notify_ctx.event = OL_TX_DISCARD_FRAMES;
+	notify_ctx.frames = frms;
+	notify_ctx.bytes = bytes;
+	notify_ctx.txq = txq;
+	notify_ctx.info.ext_tid = ol_tx_sched_txq_category(pdev, txq);
+	ol_tx_sched_notify(pdev, &notify_ctx);
+
+	TX_SCHED_DEBUG_PRINT("Tx Drop : %d", frms);
+	return frms;
+}
+
 /*--- scheduler framework ---------------------------------------------------*/
 
 /*
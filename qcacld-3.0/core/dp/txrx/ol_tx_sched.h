@@ -61,6 +61,24 @@ ol_tx_sched_discard_select(
 		ol_tx_desc_list *tx_descs,
 		bool force);
 
+/**
+ * ol_tx_sched_discard_txq() - discard frames from the head of a tx queue
+ * @pdev: the physical device object
+ * @txq: active tx queue to discard from
+ * @frms: max number of frames to discard
+ * @tx_descs: list the discarded tx descriptors are appended to
+ *
+ * The scheduler tx_queue_spinlock must be held by the caller.
+ *
+ * Return: number of frames discarded
+ */
+u_int16_t
+ol_tx_sched_discard_txq(
+		struct ol_txrx_pdev_t *pdev,
+		struct ol_tx_frms_queue_t *txq,
+		u_int16_t frms,
+		ol_tx_desc_list *tx_descs);
+
 void *
 ol_tx_sched_attach(struct ol_txrx_pdev_t *pdev);
 
@@ -77,6 +95,27 @@ void
 ol_txrx_set_wmm_param(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 		      struct ol_tx_wmm_param_t wmm_param);
 
+#ifdef WLAN_OL_TX_SCHED_TEST
+/**
+ * ol_tx_sched_wrr_adv_test_select() - run the WRR adv category selection
+ * on a given scheduler state
+ * @order: order list of the categories, updated by the selection
+ * @index: position in @order the selection starts from
+ * @active_mask: bitmap of the categories with queued frames
+ * @skip_weight: WRR skip weight of each category
+ * @wrr_count: WRR count of each category, updated by the selection
+ *
+ * All arrays hold OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES entries, the weights
+ * and counts are indexed by category.
+ *
+ * Return: position in @order of the category to serve,
+ *	OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES if none or -ENOMEM
+ */
+int ol_tx_sched_wrr_adv_test_select(int *order, int index,
+				    u_int32_t active_mask,
+				    const int *skip_weight, int *wrr_count);
+#endif /* WLAN_OL_TX_SCHED_TEST */
+
 #else
 
 static inline void
@@ -101,6 +140,16 @@ ol_tx_sched_discard_select(
 	return 0;
 }
 
+static inline u_int16_t
+ol_tx_sched_discard_txq(
+		struct ol_txrx_pdev_t *pdev,
+		struct ol_tx_frms_queue_t *txq,
+		u_int16_t frms,
+		ol_tx_desc_list *tx_descs)
+{
+	return 0;
+}
+
 static inline void *
 ol_tx_sched_attach(struct ol_txrx_pdev_t *pdev)
 {
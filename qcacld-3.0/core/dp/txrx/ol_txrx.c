@@ -4845,6 +4845,7 @@ ol_txrx_display_stats(struct cdp_soc_t *soc_hdl, uint16_t value,
 		break;
 	case CDP_TX_QUEUE_STATS:
 		ol_tx_queue_log_display(pdev);
+		ol_tx_queue_budget_stats_display(pdev);
 		break;
 #ifdef FEATURE_HL_GROUP_CREDIT_FLOW_CONTROL
 	case CDP_CREDIT_STATS:
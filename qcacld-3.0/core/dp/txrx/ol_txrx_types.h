@@ -169,6 +169,11 @@ struct ol_tx_desc_t {
 	uint32_t entry_timestamp_ticks;
 #endif
 
+#ifdef QCA_HL_TX_QUEUE_BUDGET
+	/* time the frame was put on its HL tx queue, in msecs */
+	uint32_t enqueue_ms;
+#endif
+
 #ifdef DESC_TIMESTAMP_DEBUG_INFO
 	struct {
 		uint64_t prev_tx_ts;
@@ -336,6 +341,31 @@ enum {
 #define OL_TXQ_GROUP_MEMBERSHIP_GET(_vdev_mask, _ac_mask)     \
 	((_vdev_mask << 16) | _ac_mask)
 
+/**
+ * struct ol_tx_queue_budget_t - HL tx queue byte budget and CoDel state
+ * @first_above_ms: time the head sojourn first stayed above target for
+ *	an interval, 0 while below target
+ * @drop_next_ms: time of the next CoDel drop while in dropping state
+ * @drop_count: CoDel drops in the current dropping state
+ * @dropping: whether the queue is in CoDel dropping state
+ * @sojourn_max_ms: max sojourn time of a dequeued frame
+ * @sojourn_avg_ms: moving average sojourn time of dequeued frames
+ * @sojourn_frms: number of frames the sojourn stats cover
+ * @codel_drops: frames dropped by CoDel
+ * @budget_drops: frames dropped for exceeding the byte budgets
+ */
+struct ol_tx_queue_budget_t {
+	uint32_t first_above_ms;
+	uint32_t drop_next_ms;
+	uint16_t drop_count;
+	bool dropping;
+	uint32_t sojourn_max_ms;
+	uint32_t sojourn_avg_ms;
+	uint32_t sojourn_frms;
+	uint32_t codel_drops;
+	uint32_t budget_drops;
+};
+
 struct ol_tx_frms_queue_t {
 	/* list_elem -
 	 * Allow individual tx frame queues to be linked together into
@@ -357,6 +387,9 @@ struct ol_tx_frms_queue_t {
 #if defined(CONFIG_HL_SUPPORT) && defined(QCA_BAD_PEER_TX_FLOW_CL)
 	struct ol_txrx_peer_t *peer;
 #endif
+#ifdef QCA_HL_TX_QUEUE_BUDGET
+	struct ol_tx_queue_budget_t budget;
+#endif
 };
 
 enum {
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "ol_tx_sched.h"
+#include "ol_tx_sched_test.h"
+#include "ol_txrx_types.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+#define OL_TX_SCHED_TEST_NUM_CAT OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES
+
+/* Number of random scheduler states checked one selection each */
+#define OL_TX_SCHED_TEST_STATES 10000
+
+/* Number of scheduler runs and selections per run of the sequence test */
+#define OL_TX_SCHED_TEST_RUNS 100
+#define OL_TX_SCHED_TEST_STEPS 256
+
+/* Highest WRR skip weight used, above the largest one configured */
+#define OL_TX_SCHED_TEST_MAX_WEIGHT 16
+
+/**
+ * struct ol_tx_sched_test_state - WRR adv scheduler state under test
+ * @order: category order list
+ * @index: position in @order the next selection starts from
+ * @active_mask: bitmap of the categories with queued frames
+ * @skip_weight: WRR skip weight of each category
+ * @wrr_count: WRR count of each category
+ */
+struct ol_tx_sched_test_state {
+	int order[OL_TX_SCHED_TEST_NUM_CAT];
+	int index;
+	u_int32_t active_mask;
+	int skip_weight[OL_TX_SCHED_TEST_NUM_CAT];
+	int wrr_count[OL_TX_SCHED_TEST_NUM_CAT];
+};
+
+static uint32_t ol_tx_sched_test_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (uint32_t)(*seed >> 33) % range;
+}
+
+static void ol_tx_sched_test_rotate(int *order, int idx)
+{
+	int value = order[idx];
+
+	for (; idx < OL_TX_SCHED_TEST_NUM_CAT - 1; idx++)
+		order[idx] = order[idx + 1];
+	order[idx] = value;
+}
+
+/**
+ * ol_tx_sched_test_ref_select() - Reference WRR adv category selection
+ * @state: scheduler state, updated by the selection
+ *
+ * Takes one WRR turn at a time, as the scheduler did before the skip
+ * rounds were fast forwarded.
+ *
+ * Return: position in the order list of the category to serve, or
+ *	OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES if no category is active
+ */
+static int ol_tx_sched_test_ref_select(struct ol_tx_sched_test_state *state)
+{
+	int index = state->index;
+	int cat;
+
+	while (index < OL_TX_SCHED_TEST_NUM_CAT) {
+		cat = state->order[index];
+		if (!(state->active_mask & (1 << cat))) {
+			index++;
+			continue;
+		}
+		if (++state->wrr_count[cat] < state->skip_weight[cat]) {
+			ol_tx_sched_test_rotate(state->order, index);
+			continue;
+		}
+		break;
+	}
+
+	return index;
+}
+
+static int ol_tx_sched_test_select(struct ol_tx_sched_test_state *state)
+{
+	return ol_tx_sched_wrr_adv_test_select(state->order, state->index,
+					       state->active_mask,
+					       state->skip_weight,
+					       state->wrr_count);
+}
+
+static void ol_tx_sched_test_init(struct ol_tx_sched_test_state *state,
+				  uint64_t *seed)
+{
+	int i, j, tmp;
+
+	for (i = 0; i < OL_TX_SCHED_TEST_NUM_CAT; i++)
+		state->order[i] = i;
+
+	for (i = OL_TX_SCHED_TEST_NUM_CAT - 1; i > 0; i--) {
+		j = ol_tx_sched_test_rand(seed, i + 1);
+		tmp = state->order[i];
+		state->order[i] = state->order[j];
+		state->order[j] = tmp;
+	}
+
+	state->index = ol_tx_sched_test_rand(seed, OL_TX_SCHED_TEST_NUM_CAT);
+	state->active_mask =
+		ol_tx_sched_test_rand(seed, 1 << OL_TX_SCHED_TEST_NUM_CAT);
+
+	for (i = 0; i < OL_TX_SCHED_TEST_NUM_CAT; i++) {
+		state->skip_weight[i] = 1 + ol_tx_sched_test_rand(
+					seed, OL_TX_SCHED_TEST_MAX_WEIGHT);
+		state->wrr_count[i] = ol_tx_sched_test_rand(
+					seed, state->skip_weight[i] + 1);
+	}
+}
+
+/**
+ * ol_tx_sched_test_same() - Check that two scheduler states match
+ * @ref: state after the reference selection
+ * @dut: state after the scheduler selection
+ *
+ * Return: true if the order lists, positions and WRR counts are the same
+ */
+static bool ol_tx_sched_test_same(struct ol_tx_sched_test_state *ref,
+				  struct ol_tx_sched_test_state *dut)
+{
+	return ref->index == dut->index &&
+	       !qdf_mem_cmp(ref->order, dut->order, sizeof(ref->order)) &&
+	       !qdf_mem_cmp(ref->wrr_count, dut->wrr_count,
+			    sizeof(ref->wrr_count));
+}
+
+/**
+ * ol_tx_sched_test_select_states() - Compare one selection from random
+ * scheduler states against the reference
+ *
+ * Return: number of errors
+ */
+static uint32_t ol_tx_sched_test_select_states(void)
+{
+	struct ol_tx_sched_test_state ref, dut;
+	uint64_t seed = 1;
+	uint32_t errors = 0;
+	int i;
+
+	for (i = 0; i < OL_TX_SCHED_TEST_STATES; i++) {
+		ol_tx_sched_test_init(&ref, &seed);
+		dut = ref;
+
+		ref.index = ol_tx_sched_test_ref_select(&ref);
+		dut.index = ol_tx_sched_test_select(&dut);
+		QDF_BUG(dut.index >= 0);
+
+		if (!ol_tx_sched_test_same(&ref, &dut))
+			errors++;
+	}
+	QDF_BUG(!errors);
+
+	return errors;
+}
+
+/**
+ * ol_tx_sched_test_serve() - Apply the outcome of a selection
+ * @state: scheduler state
+ * @index: position in the order list returned by the selection
+ * @credit_ok: whether there is enough credit to serve the category
+ *
+ * Mirrors ol_tx_sched_select_batch_wrr_adv(): a served category gets its
+ * WRR count reset and moves to the back, and the next selection starts
+ * from the same position. Without enough credit, the WRR turn is given
+ * back and the position is left as is.
+ *
+ * Return: None
+ */
+static void ol_tx_sched_test_serve(struct ol_tx_sched_test_state *state,
+				   int index, bool credit_ok)
+{
+	int cat;
+
+	if (index >= OL_TX_SCHED_TEST_NUM_CAT)
+		return;
+
+	cat = state->order[index];
+	if (!credit_ok) {
+		state->wrr_count[cat]--;
+		return;
+	}
+
+	state->wrr_count[cat] = 0;
+	ol_tx_sched_test_rotate(state->order, index);
+	state->index = index;
+}
+
+/**
+ * ol_tx_sched_test_select_sequence() - Compare sequences of selections
+ * against the reference
+ *
+ * Categories become active and inactive between the selections, and some
+ * selections are not served for lack of credit, so that the order list and
+ * the selection position carry over from one selection to the next.
+ *
+ * Return: number of errors
+ */
+static uint32_t ol_tx_sched_test_select_sequence(void)
+{
+	struct ol_tx_sched_test_state ref, dut;
+	int ref_index, dut_index;
+	uint64_t seed = 2;
+	uint32_t errors = 0;
+	bool credit_ok;
+	int run, step;
+
+	for (run = 0; run < OL_TX_SCHED_TEST_RUNS; run++) {
+		ol_tx_sched_test_init(&ref, &seed);
+		ref.index = 0;
+		dut = ref;
+
+		for (step = 0; step < OL_TX_SCHED_TEST_STEPS; step++) {
+			/* frames get queued for or drained from a category */
+			if (!ol_tx_sched_test_rand(&seed, 4)) {
+				ref.active_mask ^= 1 << ol_tx_sched_test_rand(
+					&seed, OL_TX_SCHED_TEST_NUM_CAT);
+				dut.active_mask = ref.active_mask;
+			}
+
+			ref_index = ol_tx_sched_test_ref_select(&ref);
+			dut_index = ol_tx_sched_test_select(&dut);
+
+			if (ref_index != dut_index ||
+			    !ol_tx_sched_test_same(&ref, &dut)) {
+				errors++;
+				break;
+			}
+
+			credit_ok = ol_tx_sched_test_rand(&seed, 8);
+			ol_tx_sched_test_serve(&ref, ref_index, credit_ok);
+			ol_tx_sched_test_serve(&dut, dut_index, credit_ok);
+		}
+	}
+	QDF_BUG(!errors);
+
+	return errors;
+}
+
+uint32_t ol_tx_sched_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += ol_tx_sched_test_select_states();
+	errors += ol_tx_sched_test_select_sequence();
+
+	return errors;
+}
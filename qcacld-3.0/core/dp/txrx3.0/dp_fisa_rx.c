@@ -23,6 +23,10 @@
 #include <enet.h>
 #include <linux/skbuff.h>
 #include "hif.h"
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+#include <net/tcp.h>
+#include <net/ip6_checksum.h>
+#endif
 
 static void dp_rx_fisa_flush_flow_wrap(struct dp_fisa_rx_sw_ft *sw_ft);
 
@@ -192,6 +196,48 @@ dp_fisa_is_ipsec_connection(struct cdp_rx_flow_tuple_info *flow_tuple_info)
 	return false;
 }
 
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+/**
+ * dp_rx_fisa_is_proto_supported() - Check if FISA can handle the flow
+ * @proto_params: L3/L4 protocol info fetched from RX PKT TLV
+ *
+ * TCP flows are aggregated over IPv4 and IPv6, UDP flows over IPv4 only.
+ *
+ * Return: true if a flow entry can be set up for the protocol
+ */
+static inline bool
+dp_rx_fisa_is_proto_supported(struct hal_proto_params *proto_params)
+{
+	if (proto_params->ipv6_proto)
+		return proto_params->tcp_proto;
+
+	return proto_params->tcp_proto || proto_params->udp_proto;
+}
+
+/**
+ * dp_rx_fisa_bypass_tcp() - Check if TCP frame has to bypass FISA
+ * @nbuf: RX nbuf pointer
+ *
+ * Return: false, TCP frames are aggregated by FISA
+ */
+static inline bool dp_rx_fisa_bypass_tcp(qdf_nbuf_t nbuf)
+{
+	return false;
+}
+#else
+static inline bool
+dp_rx_fisa_is_proto_supported(struct hal_proto_params *proto_params)
+{
+	return !proto_params->ipv6_proto &&
+	       (proto_params->tcp_proto || proto_params->udp_proto);
+}
+
+static inline bool dp_rx_fisa_bypass_tcp(qdf_nbuf_t nbuf)
+{
+	return QDF_NBUF_CB_RX_TCP_PROTO(nbuf);
+}
+#endif
+
 /**
  * get_flow_tuple_from_nbuf() - Get the flow tuple from msdu
  * @soc: DP soc handle
@@ -224,17 +270,43 @@ get_flow_tuple_from_nbuf(struct dp_soc *soc,
 	tcph = (struct tcphdr *)(qdf_nbuf_data(nbuf) + ip_hdr_offset +
 						tcp_hdr_offset);
 
-	flow_tuple_info->dest_ip_31_0 = qdf_ntohl(iph->daddr);
-	flow_tuple_info->dest_ip_63_32 = 0;
-	flow_tuple_info->dest_ip_95_64 = 0;
-	flow_tuple_info->dest_ip_127_96 =
-		HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
-
-	flow_tuple_info->src_ip_31_0 = qdf_ntohl(iph->saddr);
-	flow_tuple_info->src_ip_63_32 = 0;
-	flow_tuple_info->src_ip_95_64 = 0;
-	flow_tuple_info->src_ip_127_96 =
-		HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+	if (iph->version == 6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)iph;
+
+		flow_tuple_info->dest_ip_31_0 =
+			qdf_ntohl(ip6h->daddr.s6_addr32[3]);
+		flow_tuple_info->dest_ip_63_32 =
+			qdf_ntohl(ip6h->daddr.s6_addr32[2]);
+		flow_tuple_info->dest_ip_95_64 =
+			qdf_ntohl(ip6h->daddr.s6_addr32[1]);
+		flow_tuple_info->dest_ip_127_96 =
+			qdf_ntohl(ip6h->daddr.s6_addr32[0]);
+
+		flow_tuple_info->src_ip_31_0 =
+			qdf_ntohl(ip6h->saddr.s6_addr32[3]);
+		flow_tuple_info->src_ip_63_32 =
+			qdf_ntohl(ip6h->saddr.s6_addr32[2]);
+		flow_tuple_info->src_ip_95_64 =
+			qdf_ntohl(ip6h->saddr.s6_addr32[1]);
+		flow_tuple_info->src_ip_127_96 =
+			qdf_ntohl(ip6h->saddr.s6_addr32[0]);
+
+		flow_tuple_info->l4_protocol = ip6h->nexthdr;
+	} else {
+		flow_tuple_info->dest_ip_31_0 = qdf_ntohl(iph->daddr);
+		flow_tuple_info->dest_ip_63_32 = 0;
+		flow_tuple_info->dest_ip_95_64 = 0;
+		flow_tuple_info->dest_ip_127_96 =
+			HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+
+		flow_tuple_info->src_ip_31_0 = qdf_ntohl(iph->saddr);
+		flow_tuple_info->src_ip_63_32 = 0;
+		flow_tuple_info->src_ip_95_64 = 0;
+		flow_tuple_info->src_ip_127_96 =
+			HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+
+		flow_tuple_info->l4_protocol = iph->protocol;
+	}
 
 	flow_tuple_info->dest_port = qdf_ntohs(tcph->dest);
 	flow_tuple_info->src_port = qdf_ntohs(tcph->source);
@@ -243,7 +315,6 @@ get_flow_tuple_from_nbuf(struct dp_soc *soc,
 	else
 		flow_tuple_info->is_exception = 0;
 
-	flow_tuple_info->l4_protocol = iph->protocol;
 	dp_fisa_debug("l4_protocol %d", flow_tuple_info->l4_protocol);
 
 	qdf_nbuf_push_head(nbuf, soc->rx_pkt_tlv_size + l2_hdr_offset);
@@ -397,6 +468,117 @@ dp_rx_fisa_release_ft_lock(struct dp_rx_fst *fisa_hdl, uint8_t reo_id)
 }
 #endif /* DP_FT_LOCK_HISTORY */
 
+/**
+ * dp_rx_fisa_flow_set_active() - Put flow on the active list of its REO
+ * @fisa_hdl: Handle to fisa context
+ * @sw_ft: SW flow entry which got aggregation state updated
+ *
+ * The active list is also walked by the vdev flush from outside of the
+ * REO NAPI context, so it is protected by the active flow lock of the REO
+ * and not by the SW FT lock, which is only taken with flow deletion
+ * support.
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_fisa_flow_set_active(struct dp_rx_fst *fisa_hdl,
+			   struct dp_fisa_rx_sw_ft *sw_ft)
+{
+	uint8_t reo_id = sw_ft->napi_id;
+
+	/* Unlocked peek, only the owning NAPI puts the flow on the list */
+	if (sw_ft->is_active || qdf_unlikely(reo_id >= MAX_REO_DEST_RINGS))
+		return;
+
+	qdf_spin_lock_bh(&fisa_hdl->active_flows_lock[reo_id]);
+	if (!sw_ft->is_active) {
+		TAILQ_INSERT_TAIL(&fisa_hdl->active_flows[reo_id], sw_ft,
+				  active_list_elem);
+		sw_ft->is_active = 1;
+	}
+	qdf_spin_unlock_bh(&fisa_hdl->active_flows_lock[reo_id]);
+}
+
+/**
+ * dp_rx_fisa_flow_clear_active() - Take flow off the active list of its REO
+ * @fisa_hdl: Handle to fisa context
+ * @sw_ft: SW flow entry which got flushed
+ *
+ * Takes the active flow lock of sw_ft->napi_id.
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_fisa_flow_clear_active(struct dp_rx_fst *fisa_hdl,
+			     struct dp_fisa_rx_sw_ft *sw_ft)
+{
+	uint8_t reo_id = sw_ft->napi_id;
+
+	if (qdf_unlikely(reo_id >= MAX_REO_DEST_RINGS))
+		return;
+
+	qdf_spin_lock_bh(&fisa_hdl->active_flows_lock[reo_id]);
+	if (sw_ft->is_active) {
+		TAILQ_REMOVE(&fisa_hdl->active_flows[reo_id], sw_ft,
+			     active_list_elem);
+		sw_ft->is_active = 0;
+	}
+	qdf_spin_unlock_bh(&fisa_hdl->active_flows_lock[reo_id]);
+}
+
+/**
+ * dp_rx_fisa_flow_pop_active() - Take the next flow off an active list
+ * @fisa_hdl: Handle to fisa context
+ * @reo_id: REO ring whose active list is walked
+ * @vdev: only return flows of this vdev, NULL for any vdev
+ * @visited: incremented by the number of list entries looked at
+ *
+ * The flow is unlinked under the active flow lock so that the caller can
+ * flush it without holding the lock, while the owning NAPI keeps adding
+ * flows to the list.
+ *
+ * Return: flow taken off the list, NULL if there is none left
+ */
+static struct dp_fisa_rx_sw_ft *
+dp_rx_fisa_flow_pop_active(struct dp_rx_fst *fisa_hdl, uint8_t reo_id,
+			   struct dp_vdev *vdev, uint32_t *visited)
+{
+	struct dp_fisa_rx_sw_ft *sw_ft;
+
+	qdf_spin_lock_bh(&fisa_hdl->active_flows_lock[reo_id]);
+	TAILQ_FOREACH(sw_ft, &fisa_hdl->active_flows[reo_id],
+		      active_list_elem) {
+		(*visited)++;
+		if (vdev && sw_ft->vdev != vdev)
+			continue;
+
+		TAILQ_REMOVE(&fisa_hdl->active_flows[reo_id], sw_ft,
+			     active_list_elem);
+		sw_ft->is_active = 0;
+		break;
+	}
+	qdf_spin_unlock_bh(&fisa_hdl->active_flows_lock[reo_id]);
+
+	return sw_ft;
+}
+
+/**
+ * dp_rx_fisa_record_flush_sweep() - Account a flush over active flow lists
+ * @fisa_hdl: Handle to fisa context
+ * @visited: number of flow entries visited by the flush
+ *
+ * A full FT scan would have visited max_entries flows for every sweep,
+ * the difference is reported as skipped entries in the FISA stats dump.
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_fisa_record_flush_sweep(struct dp_rx_fst *fisa_hdl, uint32_t visited)
+{
+	DP_STATS_INC(fisa_hdl, flush_sweeps, 1);
+	DP_STATS_INC(fisa_hdl, flush_entries_visited, visited);
+}
+
 /**
  * dp_rx_fisa_setup_cmem_fse() - Setup the flow search entry in HW CMEM
  * @fisa_hdl: Handle to fisa context
@@ -518,9 +700,8 @@ dp_rx_fisa_add_ft_entry(struct dp_vdev *vdev,
 				    &proto_params))
 		return NULL;
 
-	if (proto_params.ipv6_proto ||
-	    !(proto_params.tcp_proto || proto_params.udp_proto)) {
-		dp_fisa_debug("Not UDP or TCP IPV4 flow");
+	if (!dp_rx_fisa_is_proto_supported(&proto_params)) {
+		dp_fisa_debug("Not a FISA supported UDP or TCP flow");
 		return NULL;
 	}
 
@@ -738,6 +919,7 @@ dp_fisa_rx_delete_flow(struct dp_rx_fst *fisa_hdl,
 	sw_ft_entry->is_populated = true;
 	sw_ft_entry->napi_id = elem->reo_id;
 	sw_ft_entry->reo_dest_indication = elem->reo_dest_indication;
+	sw_ft_entry->flow_init_ts = qdf_get_log_timestamp();
 	qdf_mem_copy(&sw_ft_entry->rx_flow_tuple_info, &elem->flow_tuple_info,
 		     sizeof(struct cdp_rx_flow_tuple_info));
 
@@ -774,6 +956,52 @@ dp_fisa_rx_get_hw_ft_timestamp(struct dp_rx_fst *fisa_hdl,
 	return ((struct rx_flow_search_entry *)sw_ft_entry->hw_fse)->timestamp;
 }
 
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+/**
+ * dp_fisa_rx_fst_has_flows() - Check if any flow is populated in SW FST
+ * @fisa_hdl: handle to FISA context
+ *
+ * Only the SW FST is looked at, so no HW access is needed.
+ *
+ * Return: true if at least one flow is populated
+ */
+static bool dp_fisa_rx_fst_has_flows(struct dp_rx_fst *fisa_hdl)
+{
+	struct dp_fisa_rx_sw_ft *sw_ft_base =
+				(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
+	uint32_t i;
+
+	for (i = 0; i < fisa_hdl->max_entries; i++) {
+		if (sw_ft_base[i].is_populated)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * dp_fisa_rx_aging_arm() - Arm the FST aging timer if it is not running
+ * @fisa_hdl: handle to FISA context
+ *
+ * Called with dp_rx_fst_lock held, once a flow got added to the FST.
+ *
+ * Return: None
+ */
+static void dp_fisa_rx_aging_arm(struct dp_rx_fst *fisa_hdl)
+{
+	if (!fisa_hdl->flow_deletion_supported || fisa_hdl->aging_armed ||
+	    fisa_hdl->aging_stopped)
+		return;
+
+	fisa_hdl->aging_armed = true;
+	qdf_timer_mod(&fisa_hdl->aging_timer, DP_FISA_AGING_INTERVAL_MS);
+}
+#else
+static inline void dp_fisa_rx_aging_arm(struct dp_rx_fst *fisa_hdl)
+{
+}
+#endif
+
 /**
  * dp_fisa_rx_fst_update() - Core logic which helps in Addition/Deletion
  * of flows
@@ -871,6 +1099,9 @@ static void dp_fisa_rx_fst_update(struct dp_rx_fst *fisa_hdl,
 		is_fst_updated = true;
 	}
 
+	if (is_fst_updated)
+		dp_fisa_rx_aging_arm(fisa_hdl);
+
 	/**
 	 * Send HTT cache invalidation command to firmware to
 	 * reflect the flow update
@@ -922,6 +1153,313 @@ void dp_fisa_rx_fst_update_work(void *arg)
 	}
 }
 
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+/**
+ * dp_fisa_rx_evict_flow() - Evict an idle flow from SW and HW FST
+ * @fisa_hdl: handle to FISA context
+ * @hashed_flow_idx: hashed flow idx of the flow to be evicted
+ *
+ * HW FSE is invalidated first, so that new packets of the flow come with
+ * flow_invalid set and the flow gets added again through FST update work.
+ * Packets already carrying the old flow index are filtered by metadata.
+ *
+ * Return: None
+ */
+static void dp_fisa_rx_evict_flow(struct dp_rx_fst *fisa_hdl,
+				  uint32_t hashed_flow_idx)
+{
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	struct fisa_pkt_hist pkt_hist;
+	u8 reo_id;
+
+	sw_ft_entry = &(((struct dp_fisa_rx_sw_ft *)
+				fisa_hdl->base)[hashed_flow_idx]);
+	reo_id = sw_ft_entry->napi_id;
+
+	hal_rx_flow_invalidate_cmem_fse(fisa_hdl->soc_hdl->hal_soc,
+					sw_ft_entry->cmem_offset);
+
+	dp_rx_fisa_acquire_ft_lock(fisa_hdl, reo_id);
+
+	/* Flush the flow before eviction */
+	dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
+
+	dp_rx_fisa_save_pkt_hist(sw_ft_entry, &pkt_hist);
+	memset(sw_ft_entry, 0, sizeof(*sw_ft_entry));
+	dp_rx_fisa_restore_pkt_hist(sw_ft_entry, &pkt_hist);
+
+	fisa_hdl->del_flow_count++;
+
+	dp_rx_fisa_release_ft_lock(fisa_hdl, reo_id);
+}
+
+/**
+ * dp_fisa_rx_flow_last_hit() - Get the last time a flow was seen
+ * @sw_ft_entry: SW FT entry
+ *
+ * Return: latest of SW aggregation, HW FSE hit and flow setup timestamps
+ */
+static inline uint64_t
+dp_fisa_rx_flow_last_hit(struct dp_fisa_rx_sw_ft *sw_ft_entry)
+{
+	uint64_t last_hit = sw_ft_entry->flow_init_ts;
+
+	if (sw_ft_entry->last_accessed_ts > last_hit)
+		last_hit = sw_ft_entry->last_accessed_ts;
+
+	if (sw_ft_entry->aging_last_hit_ts > last_hit)
+		last_hit = sw_ft_entry->aging_last_hit_ts;
+
+	return last_hit;
+}
+
+/**
+ * dp_fisa_rx_record_aging() - Record stats of an aging pass
+ * @fisa_hdl: handle to FISA context
+ * @now: time at which the aging pass ran
+ * @occupancy: populated flow entries
+ * @idle: flow entries idle beyond the timeout
+ * @evicted: flow entries evicted
+ *
+ * Return: None
+ */
+static void dp_fisa_rx_record_aging(struct dp_rx_fst *fisa_hdl, uint64_t now,
+				    uint32_t occupancy, uint32_t idle,
+				    uint32_t evicted)
+{
+	struct dp_fisa_aging_record *rec;
+	uint64_t rx_msdus = 0, aggr_msdus = 0;
+	int i;
+
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++) {
+		rx_msdus += fisa_hdl->rx_msdus[i];
+		aggr_msdus += fisa_hdl->aggr_msdus[i];
+	}
+
+	rec = &fisa_hdl->aging_rec[fisa_hdl->aging_rec_idx++ %
+				   DP_FISA_AGING_HIST];
+	rec->timestamp = now;
+	rec->occupancy = occupancy;
+	rec->idle = idle;
+	rec->evicted = evicted;
+	rec->rx_msdus = rx_msdus - fisa_hdl->aging_rx_msdus;
+	rec->aggr_msdus = aggr_msdus - fisa_hdl->aging_aggr_msdus;
+
+	fisa_hdl->aging_rx_msdus = rx_msdus;
+	fisa_hdl->aging_aggr_msdus = aggr_msdus;
+	fisa_hdl->aging_evict_count += evicted;
+}
+
+/**
+ * dp_fisa_rx_fst_aging() - Evict idle flows from the FST, LRU first
+ * @fisa_hdl: handle to FISA context
+ *
+ * A flow is considered hit when FISA aggregated one of its packets or when
+ * the HW FSE timestamp moved since the previous pass. Flows idle beyond
+ * the idle timeout are evicted oldest first, at most DP_FISA_AGING_BATCH
+ * per pass. The timeout is shortened while the FST is 3/4th full.
+ *
+ * Return: None
+ */
+static void dp_fisa_rx_fst_aging(struct dp_rx_fst *fisa_hdl)
+{
+	struct dp_fisa_rx_sw_ft *sw_ft_base =
+				(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	uint32_t lru_idx[DP_FISA_AGING_BATCH];
+	uint64_t lru_ts[DP_FISA_AGING_BATCH];
+	uint32_t num_lru = 0, occupancy = 0, idle = 0;
+	uint64_t now = qdf_get_log_timestamp();
+	uint64_t idle_timeout_us, last_hit;
+	uint32_t hw_ts;
+	uint32_t i, j;
+
+	for (i = 0; i < fisa_hdl->max_entries; i++) {
+		sw_ft_entry = &sw_ft_base[i];
+		if (!sw_ft_entry->is_populated)
+			continue;
+
+		occupancy++;
+		hw_ts = dp_fisa_rx_get_hw_ft_timestamp(fisa_hdl, i);
+		if (hw_ts != sw_ft_entry->aging_hw_ts) {
+			sw_ft_entry->aging_hw_ts = hw_ts;
+			sw_ft_entry->aging_last_hit_ts = now;
+		}
+	}
+
+	if (occupancy * 4 >= fisa_hdl->max_entries * 3)
+		idle_timeout_us = DP_FISA_FLOW_IDLE_TIMEOUT_PRESSURE_MS * 1000;
+	else
+		idle_timeout_us = DP_FISA_FLOW_IDLE_TIMEOUT_MS * 1000;
+
+	for (i = 0; i < fisa_hdl->max_entries; i++) {
+		sw_ft_entry = &sw_ft_base[i];
+		if (!sw_ft_entry->is_populated)
+			continue;
+
+		last_hit = dp_fisa_rx_flow_last_hit(sw_ft_entry);
+		if (last_hit >= now ||
+		    qdf_log_timestamp_to_usecs(now - last_hit) <
+		    idle_timeout_us)
+			continue;
+
+		idle++;
+
+		/* Keep the DP_FISA_AGING_BATCH oldest flows, oldest first */
+		if (num_lru < DP_FISA_AGING_BATCH)
+			j = num_lru++;
+		else if (last_hit < lru_ts[DP_FISA_AGING_BATCH - 1])
+			j = DP_FISA_AGING_BATCH - 1;
+		else
+			continue;
+
+		for (; j > 0 && lru_ts[j - 1] > last_hit; j--) {
+			lru_ts[j] = lru_ts[j - 1];
+			lru_idx[j] = lru_idx[j - 1];
+		}
+		lru_ts[j] = last_hit;
+		lru_idx[j] = i;
+	}
+
+	for (j = 0; j < num_lru; j++)
+		dp_fisa_rx_evict_flow(fisa_hdl, lru_idx[j]);
+
+	dp_fisa_rx_record_aging(fisa_hdl, now, occupancy, idle, num_lru);
+
+	/**
+	 * Send HTT cache invalidation command to firmware to
+	 * reflect the flow update
+	 */
+	if (num_lru &&
+	    fisa_hdl->fse_cache_flush_allow &&
+	    (qdf_atomic_inc_return(&fisa_hdl->fse_cache_flush_posted) == 1)) {
+		qdf_timer_start(&fisa_hdl->fse_cache_flush_timer,
+				FSE_CACHE_FLUSH_TIME_OUT);
+	}
+}
+
+/**
+ * dp_fisa_rx_aging_rearm() - Re-arm the FST aging timer for the next pass
+ * @fisa_hdl: handle to FISA context
+ *
+ * Called with dp_rx_fst_lock held. The timer is left stopped once the FST
+ * is empty, FST update work arms it again when a flow gets added.
+ *
+ * Return: true if the timer is re-armed
+ */
+static bool dp_fisa_rx_aging_rearm(struct dp_rx_fst *fisa_hdl)
+{
+	if (fisa_hdl->aging_stopped || !dp_fisa_rx_fst_has_flows(fisa_hdl)) {
+		fisa_hdl->aging_armed = false;
+		return false;
+	}
+
+	qdf_timer_mod(&fisa_hdl->aging_timer, DP_FISA_AGING_INTERVAL_MS);
+	return true;
+}
+
+/**
+ * dp_fisa_rx_fst_aging_work() - Work function for FST aging
+ * @arg: argument passed to the work function
+ *
+ * Return: None
+ */
+void dp_fisa_rx_fst_aging_work(void *arg)
+{
+	struct dp_rx_fst *fisa_hdl = arg;
+	hal_soc_handle_t hal_soc_hdl = fisa_hdl->soc_hdl->hal_soc;
+	bool has_flows;
+
+	if (!fisa_hdl->flow_deletion_supported)
+		return;
+
+	/* Skip the HW access when there is no flow to age */
+	qdf_spin_lock_bh(&fisa_hdl->dp_rx_fst_lock);
+	has_flows = !fisa_hdl->aging_stopped &&
+		    dp_fisa_rx_fst_has_flows(fisa_hdl);
+	if (!has_flows)
+		fisa_hdl->aging_armed = false;
+	qdf_spin_unlock_bh(&fisa_hdl->dp_rx_fst_lock);
+
+	if (!has_flows)
+		return;
+
+	if (hif_force_wake_request(((struct hal_soc *)hal_soc_hdl)->hif_handle)) {
+		dp_err("Wake up request failed");
+		qdf_check_state_before_panic(__func__, __LINE__);
+		qdf_spin_lock_bh(&fisa_hdl->dp_rx_fst_lock);
+		dp_fisa_rx_aging_rearm(fisa_hdl);
+		qdf_spin_unlock_bh(&fisa_hdl->dp_rx_fst_lock);
+		return;
+	}
+
+	qdf_spin_lock_bh(&fisa_hdl->dp_rx_fst_lock);
+	dp_fisa_rx_fst_aging(fisa_hdl);
+	dp_fisa_rx_aging_rearm(fisa_hdl);
+	qdf_spin_unlock_bh(&fisa_hdl->dp_rx_fst_lock);
+
+	if (hif_force_wake_release(((struct hal_soc *)hal_soc_hdl)->hif_handle)) {
+		dp_err("Wake up release failed");
+		qdf_check_state_before_panic(__func__, __LINE__);
+		return;
+	}
+}
+
+/**
+ * dp_fisa_rx_aging_account() - Account msdu for aggregation hit rate
+ * @fisa_hdl: handle to FISA context
+ * @rx_ctx_id: Rx context id
+ * @aggregated: whether FISA aggregated the msdu
+ *
+ * Return: None
+ */
+static inline void dp_fisa_rx_aging_account(struct dp_rx_fst *fisa_hdl,
+					    uint8_t rx_ctx_id, bool aggregated)
+{
+	if (qdf_unlikely(rx_ctx_id >= MAX_REO_DEST_RINGS))
+		return;
+
+	fisa_hdl->rx_msdus[rx_ctx_id]++;
+	if (aggregated)
+		fisa_hdl->aggr_msdus[rx_ctx_id]++;
+}
+
+/**
+ * dp_rx_fisa_dump_aging_stats() - Dump FST aging stats
+ * @rx_fst: Handle to FISA context
+ *
+ * Return: None
+ */
+static void dp_rx_fisa_dump_aging_stats(struct dp_rx_fst *rx_fst)
+{
+	struct dp_fisa_aging_record *rec;
+	uint32_t i, idx;
+
+	dp_info("#aging passes %u evicted %u",
+		rx_fst->aging_rec_idx, rx_fst->aging_evict_count);
+
+	for (i = 0; i < DP_FISA_AGING_HIST && i < rx_fst->aging_rec_idx; i++) {
+		idx = (rx_fst->aging_rec_idx - 1 - i) % DP_FISA_AGING_HIST;
+		rec = &rx_fst->aging_rec[idx];
+		dp_info("aging[%u] ts %llu occupancy %u/%u idle %u evicted %u msdus %llu aggr %llu hit %llu%%",
+			i, rec->timestamp, rec->occupancy,
+			rx_fst->max_entries, rec->idle, rec->evicted,
+			rec->rx_msdus, rec->aggr_msdus,
+			rec->rx_msdus ?
+			qdf_do_div(rec->aggr_msdus * 100, rec->rx_msdus) : 0);
+	}
+}
+#else
+static inline void dp_fisa_rx_aging_account(struct dp_rx_fst *fisa_hdl,
+					    uint8_t rx_ctx_id, bool aggregated)
+{
+}
+
+static inline void dp_rx_fisa_dump_aging_stats(struct dp_rx_fst *rx_fst)
+{
+}
+#endif
+
 /**
  * dp_fisa_rx_is_fst_work_queued() - Check if work is already queued for
  * the flow
@@ -981,9 +1519,8 @@ dp_fisa_rx_queue_fst_update_work(struct dp_rx_fst *fisa_hdl, uint32_t flow_idx,
 				    &proto_params))
 		return NULL;
 
-	if (proto_params.ipv6_proto ||
-	    !(proto_params.tcp_proto || proto_params.udp_proto)) {
-		dp_fisa_debug("Not UDP or TCP IPV4 flow");
+	if (!dp_rx_fisa_is_proto_supported(&proto_params)) {
+		dp_fisa_debug("Not a FISA supported UDP or TCP flow");
 		return NULL;
 	}
 
@@ -1142,7 +1679,7 @@ dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
 	hal_soc_handle_t hal_soc_hdl = fisa_hdl->soc_hdl->hal_soc;
 	QDF_STATUS status;
 
-	if (QDF_NBUF_CB_RX_TCP_PROTO(nbuf))
+	if (dp_rx_fisa_bypass_tcp(nbuf))
 		return sw_ft_entry;
 
 	rx_tlv_hdr = qdf_nbuf_data(nbuf);
@@ -1183,55 +1720,270 @@ print_and_return:
 	return sw_ft_entry;
 }
 
-#ifdef NOT_YET
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+/* TCP flags which end the aggregation of a flow */
+#define DP_FISA_TCP_FLUSH_FLAGS (TCP_FLAG_SYN | TCP_FLAG_FIN | TCP_FLAG_RST | \
+				 TCP_FLAG_URG | TCP_FLAG_CWR | TCP_FLAG_ECE)
+
+/* NOP, NOP, TIMESTAMP option layout as sent by Linux and most stacks */
+#define DP_FISA_TCP_TS_OPT_HDR ((TCPOPT_NOP << 24) | (TCPOPT_NOP << 16) | \
+				(TCPOPT_TIMESTAMP << 8) | TCPOLEN_TIMESTAMP)
+
+bool dp_rx_fisa_tcp_parse_hdrs(uint8_t *l2_hdr, uint32_t len,
+			       struct dp_fisa_tcp_seg *seg)
+{
+	uint32_t l4_len, tcp_hdr_len;
+	uint8_t *l3_hdr;
+
+	if (seg->l3_hdr_offset + seg->l4_hdr_offset + sizeof(struct tcphdr) >
+	    len)
+		return false;
+
+	l3_hdr = l2_hdr + seg->l3_hdr_offset;
+	seg->is_ipv6 = ((struct iphdr *)l3_hdr)->version == 6;
+	if (seg->is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)l3_hdr;
+
+		/* Extension headers are not aggregated */
+		if (ip6h->nexthdr != IPPROTO_TCP ||
+		    seg->l4_hdr_offset != sizeof(*ip6h))
+			return false;
+
+		l4_len = qdf_ntohs(ip6h->payload_len);
+	} else {
+		struct iphdr *iph = (struct iphdr *)l3_hdr;
+
+		/* IP options and IP fragments are not aggregated */
+		if (iph->version != 4 || iph->ihl != 5 ||
+		    iph->protocol != IPPROTO_TCP ||
+		    seg->l4_hdr_offset != sizeof(*iph) ||
+		    (iph->frag_off & qdf_htons(IP_MF | IP_OFFSET)) ||
+		    qdf_ntohs(iph->tot_len) < sizeof(*iph))
+			return false;
+
+		l4_len = qdf_ntohs(iph->tot_len) - sizeof(*iph);
+	}
+
+	seg->tcph = (struct tcphdr *)(l3_hdr + seg->l4_hdr_offset);
+	tcp_hdr_len = seg->tcph->doff * 4;
+	if (tcp_hdr_len < sizeof(struct tcphdr) || l4_len < tcp_hdr_len)
+		return false;
+
+	seg->hdr_len = seg->l3_hdr_offset + seg->l4_hdr_offset + tcp_hdr_len;
+	seg->payload_len = l4_len - tcp_hdr_len;
+	if (seg->hdr_len + seg->payload_len > len)
+		return false;
+
+	seg->seq = qdf_ntohl(seg->tcph->seq);
+
+	return true;
+}
+
+/**
+ * dp_rx_fisa_tcp_parse() - Parse and validate headers of a TCP msdu
+ * @fisa_hdl: Handle to FISA context
+ * @nbuf: Incoming nbuf, data pointing to RX PKT TLVs
+ * @seg: return argument where the parsed headers are populated
+ *
+ * Headers are read in place, nbuf is not pulled so that it can still be
+ * delivered without FISA if it is not eligible for aggregation.
+ *
+ * Return: true if the msdu is a plain TCP segment with valid checksums
+ */
+static bool dp_rx_fisa_tcp_parse(struct dp_rx_fst *fisa_hdl, qdf_nbuf_t nbuf,
+				 struct dp_fisa_tcp_seg *seg)
+{
+	struct dp_soc *soc = fisa_hdl->soc_hdl;
+	uint8_t *rx_tlv_hdr = qdf_nbuf_data(nbuf);
+	uint32_t ip_csum_err, tcp_csum_err;
+
+	hal_rx_tlv_csum_err_get(soc->hal_soc, rx_tlv_hdr, &ip_csum_err,
+				&tcp_csum_err);
+	if (ip_csum_err || tcp_csum_err)
+		return false;
+
+	seg->tlv_len = soc->rx_pkt_tlv_size +
+		hal_rx_msdu_end_l3_hdr_padding_get(soc->hal_soc, rx_tlv_hdr);
+	if (seg->tlv_len >= qdf_nbuf_len(nbuf))
+		return false;
+
+	hal_rx_get_l3_l4_offsets(soc->hal_soc, rx_tlv_hdr,
+				 &seg->l3_hdr_offset, &seg->l4_hdr_offset);
+
+	return dp_rx_fisa_tcp_parse_hdrs(rx_tlv_hdr + seg->tlv_len,
+					 qdf_nbuf_len(nbuf) - seg->tlv_len,
+					 seg);
+}
+
+/**
+ * dp_rx_fisa_tcp_opts_match() - Compare TCP options against head segment
+ * @head_th: TCP header of the aggregate head
+ * @th: TCP header of the incoming segment
+ *
+ * Options have to be identical, except for the timestamp option where
+ * TSval is allowed to move forward while TSecr stays the same. The head
+ * carries the latest TSval, as the stack uses it for PAWS and RTT.
+ *
+ * Return: true if the segment can be merged into the aggregate
+ */
+static bool dp_rx_fisa_tcp_opts_match(struct tcphdr *head_th,
+				      struct tcphdr *th)
+{
+	uint32_t opt_len = th->doff * 4 - sizeof(*th);
+	__be32 *head_opt = (__be32 *)(head_th + 1);
+	__be32 *opt = (__be32 *)(th + 1);
+
+	if (head_th->doff != th->doff)
+		return false;
+
+	if (opt_len == TCPOLEN_TSTAMP_ALIGNED &&
+	    opt[0] == qdf_htonl(DP_FISA_TCP_TS_OPT_HDR) &&
+	    head_opt[0] == opt[0]) {
+		if ((int32_t)(qdf_ntohl(opt[1]) - qdf_ntohl(head_opt[1])) < 0 ||
+		    opt[2] != head_opt[2])
+			return false;
+
+		head_opt[1] = opt[1];
+		return true;
+	}
+
+	return !qdf_mem_cmp(head_opt, opt, opt_len);
+}
+
+bool dp_rx_fisa_tcp_can_merge(struct dp_fisa_rx_sw_ft *fisa_flow,
+			      struct dp_fisa_tcp_seg *seg)
+{
+	qdf_nbuf_t head_skb = fisa_flow->head_skb;
+	struct tcphdr *head_th;
+	uint32_t l4_len;
+
+	head_th = (struct tcphdr *)(qdf_nbuf_data(head_skb) +
+				    fisa_flow->head_skb_ip_hdr_offset +
+				    fisa_flow->head_skb_l4_hdr_offset);
+	l4_len = qdf_nbuf_len(head_skb) - fisa_flow->head_skb_ip_hdr_offset -
+		 fisa_flow->head_skb_l4_hdr_offset +
+		 fisa_flow->frags_cumulative_len + seg->payload_len;
+
+	if (seg->is_ipv6 != fisa_flow->head_skb_is_ipv6 ||
+	    seg->seq != fisa_flow->tcp_next_seq ||
+	    seg->tcph->ack_seq != head_th->ack_seq ||
+	    seg->payload_len > fisa_flow->tcp_mss ||
+	    fisa_flow->tcp_segs >= FISA_FLOW_MAX_AGGR_COUNT ||
+	    l4_len > DP_FISA_TCP_MAX_L4_LEN)
+		return false;
+
+	if (!dp_rx_fisa_tcp_opts_match(head_th, seg->tcph))
+		return false;
+
+	/* Advertise the latest window to the stack */
+	head_th->window = seg->tcph->window;
+
+	return true;
+}
+
 /**
  * dp_rx_fisa_aggr_tcp() - Aggregate incoming to TCP nbuf
+ * @fisa_hdl: Handle to FISA context
  * @fisa_flow: Handle to SW flow entry, which holds the aggregated nbuf
  * @nbuf: Incoming nbuf
  *
- * Return: FISA_AGGR_DONE on successful aggregation
+ * In-order segments of the flow carrying the same ACK, flags and options
+ * are chained in frag_list of the head segment and handed to the stack as
+ * a single GSO packet. Anything else flushes the ongoing aggregate first,
+ * so that the flow is delivered in order.
+ *
+ * Return: FISA_AGGR_DONE on successful aggregation,
+ *	   FISA_AGGR_NOT_ELIGIBLE if nbuf has to be delivered without FISA
  */
 static enum fisa_aggr_ret
-dp_rx_fisa_aggr_tcp(struct dp_fisa_rx_sw_ft *fisa_flow,	qdf_nbuf_t nbuf)
+dp_rx_fisa_aggr_tcp(struct dp_rx_fst *fisa_hdl,
+		    struct dp_fisa_rx_sw_ft *fisa_flow,	qdf_nbuf_t nbuf)
 {
-	qdf_nbuf_t head_skb = fisa_flow->head_skb;
-	struct iphdr *iph;
-	uint32_t tcp_data_len;
+	qdf_nbuf_t head_skb;
+	struct dp_fisa_tcp_seg seg;
+	struct tcphdr *head_th;
+	uint32_t flags;
 
-	fisa_flow->bytes_aggregated += qdf_nbuf_len(nbuf);
+	if (!dp_rx_fisa_tcp_parse(fisa_hdl, nbuf, &seg))
+		goto not_eligible;
+
+	flags = tcp_flag_word(seg.tcph);
+	if (!(flags & TCP_FLAG_ACK) || (flags & DP_FISA_TCP_FLUSH_FLAGS) ||
+	    !seg.payload_len)
+		goto not_eligible;
+
+	if (fisa_flow->head_skb && !dp_rx_fisa_tcp_can_merge(fisa_flow, &seg)) {
+		DP_STATS_INC(fisa_hdl, tcp_mismatch_flush, 1);
+		dp_rx_fisa_flush_flow_wrap(fisa_flow);
+	}
+
+	/* Strip the TLVs and the trailing L2 padding, if any */
+	qdf_nbuf_pull_head(nbuf, seg.tlv_len);
+	qdf_nbuf_trim_tail(nbuf, qdf_nbuf_len(nbuf) -
+			   (seg.hdr_len + seg.payload_len));
+
+	head_skb = fisa_flow->head_skb;
 	if (!head_skb) {
-		/* First nbuf for the flow */
-		dp_fisa_debug("first head skb");
+		dp_fisa_debug("first head skb nbuf %pK", nbuf);
 		fisa_flow->head_skb = nbuf;
-		return FISA_AGGR_DONE;
+		fisa_flow->last_skb = NULL;
+		fisa_flow->head_skb_ip_hdr_offset = seg.l3_hdr_offset;
+		fisa_flow->head_skb_l4_hdr_offset = seg.l4_hdr_offset;
+		fisa_flow->head_skb_is_ipv6 = seg.is_ipv6;
+		fisa_flow->frags_cumulative_len = 0;
+		fisa_flow->tcp_mss = seg.payload_len;
+		fisa_flow->tcp_segs = 1;
+		goto aggregated;
+	}
+
+	if (flags & TCP_FLAG_PSH) {
+		head_th = (struct tcphdr *)(qdf_nbuf_data(head_skb) +
+					    fisa_flow->head_skb_ip_hdr_offset +
+					    fisa_flow->head_skb_l4_hdr_offset);
+		head_th->psh = 1;
 	}
 
-	tcp_data_len = (ntohs(iph->tot_len) - sizeof(struct iphdr) -
-			sizeof(struct tcphdr));
-	qdf_nbuf_pull_head(nbuf, (nbuf->len - tcp_data_len));
+	qdf_nbuf_pull_head(nbuf, seg.hdr_len);
 
 	if (qdf_nbuf_get_ext_list(head_skb)) {
-		/* this is 3rd skb after head skb, 2nd skb */
-		fisa_flow->last_skb->next = nbuf;
+		qdf_nbuf_set_next(fisa_flow->last_skb, nbuf);
 	} else {
-		/* 1st skb after head skb */
-		qdf_nbuf_append_ext_list(head_skb, nbuf,
-					 fisa_flow->cumulative_ip_length);
-		qdf_nbuf_set_is_frag(head, 1);
+		skb_shinfo(head_skb)->frag_list = nbuf;
+		qdf_nbuf_set_is_frag(nbuf, 1);
 	}
+	head_skb->truesize += nbuf->truesize;
 
 	fisa_flow->last_skb = nbuf;
+	fisa_flow->frags_cumulative_len += seg.payload_len;
+	fisa_flow->tcp_segs++;
+
+aggregated:
+	fisa_flow->tcp_next_seq = seg.seq + seg.payload_len;
+	fisa_flow->bytes_aggregated += seg.payload_len;
 	fisa_flow->aggr_count++;
 
-	/* move it to while flushing the flow, that is update before flushing */
+	/**
+	 * Short segment or PSH ends the sender burst, hand the aggregate to
+	 * the stack right away instead of waiting for the NAPI flush.
+	 */
+	if (seg.payload_len < fisa_flow->tcp_mss || (flags & TCP_FLAG_PSH) ||
+	    fisa_flow->tcp_segs >= FISA_FLOW_MAX_AGGR_COUNT)
+		dp_rx_fisa_flush_flow_wrap(fisa_flow);
+
 	return FISA_AGGR_DONE;
+
+not_eligible:
+	DP_STATS_INC(fisa_hdl, tcp_not_eligible, 1);
+	dp_rx_fisa_flush_flow_wrap(fisa_flow);
+
+	return FISA_AGGR_NOT_ELIGIBLE;
 }
 #else
 static enum fisa_aggr_ret
 dp_rx_fisa_aggr_tcp(struct dp_rx_fst *fisa_hdl,
 		    struct dp_fisa_rx_sw_ft *fisa_flow,	qdf_nbuf_t nbuf)
 {
-	return FISA_AGGR_DONE;
+	return FISA_AGGR_NOT_ELIGIBLE;
 }
 #endif
 
@@ -1566,6 +2318,50 @@ out:
 	fisa_flow->flush_count++;
 }
 
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+void dp_rx_fisa_tcp_fixup_head(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	qdf_nbuf_t head_skb = fisa_flow->head_skb;
+	struct skb_shared_info *shinfo = skb_shinfo(head_skb);
+	struct tcphdr *head_th;
+	uint8_t *l3_hdr;
+	uint32_t l4_len;
+
+	l3_hdr = qdf_nbuf_data(head_skb) + fisa_flow->head_skb_ip_hdr_offset;
+	head_th = (struct tcphdr *)(l3_hdr + fisa_flow->head_skb_l4_hdr_offset);
+
+	/* data_len is total payload length of the frag_list nbufs */
+	head_skb->data_len = fisa_flow->frags_cumulative_len;
+	head_skb->len += head_skb->data_len;
+	l4_len = head_skb->len - fisa_flow->head_skb_ip_hdr_offset -
+		 fisa_flow->head_skb_l4_hdr_offset;
+
+	if (fisa_flow->head_skb_is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)l3_hdr;
+
+		ip6h->payload_len = qdf_htons(l4_len);
+		head_th->check = ~tcp_v6_check(l4_len, &ip6h->saddr,
+					       &ip6h->daddr, 0);
+		shinfo->gso_type = SKB_GSO_TCPV6;
+	} else {
+		struct iphdr *iph = (struct iphdr *)l3_hdr;
+
+		iph->tot_len = qdf_htons(l4_len +
+					 fisa_flow->head_skb_l4_hdr_offset);
+		iph->check = 0;
+		iph->check = ip_fast_csum((u8 *)iph, iph->ihl);
+		head_th->check = ~tcp_v4_check(l4_len, iph->saddr,
+					       iph->daddr, 0);
+		shinfo->gso_type = SKB_GSO_TCPV4;
+	}
+
+	head_skb->csum_start = (u8 *)head_th - head_skb->head;
+	head_skb->csum_offset = offsetof(struct tcphdr, check);
+	head_skb->ip_summed = CHECKSUM_PARTIAL;
+	shinfo->gso_size = fisa_flow->tcp_mss;
+	shinfo->gso_segs = fisa_flow->tcp_segs;
+}
+
 /**
  * dp_rx_fisa_flush_tcp_flow() - Flush all aggregated nbuf of the TCP flow
  * @vdev: handle to dp_vdev
@@ -1574,6 +2370,56 @@ out:
  * Return: None
  */
 static void
+dp_rx_fisa_flush_tcp_flow(struct dp_vdev *vdev,
+			  struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	qdf_nbuf_t head_skb = fisa_flow->head_skb;
+	struct dp_vdev *fisa_flow_vdev;
+
+	if (!head_skb) {
+		dp_fisa_debug("Already flushed");
+		return;
+	}
+
+	head_skb->hash = QDF_NBUF_CB_RX_FLOW_ID(head_skb);
+	head_skb->sw_hash = 1;
+
+	if (fisa_flow->tcp_segs > 1)
+		dp_rx_fisa_tcp_fixup_head(fisa_flow);
+
+	qdf_nbuf_set_next(head_skb, NULL);
+	QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head_skb) = 1;
+	if (fisa_flow->last_skb)
+		qdf_nbuf_set_next(fisa_flow->last_skb, NULL);
+
+	hex_dump_skb_data(head_skb, false);
+
+	fisa_flow_vdev = dp_vdev_get_ref_by_id(fisa_flow->soc_hdl,
+					       QDF_NBUF_CB_RX_VDEV_ID(head_skb),
+					       DP_MOD_ID_RX);
+	if (qdf_unlikely(!fisa_flow_vdev ||
+			 fisa_flow_vdev != fisa_flow->vdev)) {
+		qdf_nbuf_free(head_skb);
+		goto out;
+	}
+
+	if (!vdev->osif_rx || QDF_STATUS_SUCCESS !=
+	    vdev->osif_rx(vdev->osif_vdev, head_skb))
+		qdf_nbuf_free(head_skb);
+
+out:
+	if (fisa_flow_vdev)
+		dp_vdev_unref_delete(fisa_flow->soc_hdl, fisa_flow_vdev,
+				     DP_MOD_ID_RX);
+	fisa_flow->head_skb = NULL;
+	fisa_flow->last_skb = NULL;
+	fisa_flow->frags_cumulative_len = 0;
+	fisa_flow->tcp_segs = 0;
+
+	fisa_flow->flush_count++;
+}
+#else
+static void
 dp_rx_fisa_flush_tcp_flow(struct dp_vdev *vdev,
 			  struct dp_fisa_rx_sw_ft *fisa_flow)
 {
@@ -1609,6 +2455,7 @@ dp_rx_fisa_flush_tcp_flow(struct dp_vdev *vdev,
 
 	fisa_flow->flush_count++;
 }
+#endif
 
 /**
  * dp_rx_fisa_flush_flow() - Flush all aggregated nbuf of the flow
@@ -1695,6 +2542,7 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 	uint8_t napi_id = QDF_NBUF_CB_RX_CTX_ID(nbuf);
 	uint32_t fse_metadata;
 	bool cce_match;
+	int fisa_ret;
 
 	dump_tlvs(hal_soc_hdl, rx_tlv_hdr, QDF_TRACE_LEVEL_INFO_HIGH);
 	dp_fisa_debug("nbuf: %pK nbuf->next:%pK nbuf->data:%pK len %d data_len %d",
@@ -1723,6 +2571,17 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 		return FISA_AGGR_NOT_ELIGIBLE;
 	}
 
+	/* TCP is validated in SW per segment, HW cumulative length and
+	 * checksum assist are computed for UDP only.
+	 */
+	if (fisa_flow->is_flow_tcp) {
+		fisa_ret = dp_rx_fisa_aggr_tcp(fisa_hdl, fisa_flow, nbuf);
+		dp_rx_fisa_flow_set_active(fisa_hdl, fisa_flow);
+		dp_rx_fisa_release_ft_lock(fisa_hdl, napi_id);
+		fisa_flow->last_accessed_ts = qdf_get_log_timestamp();
+		return fisa_ret;
+	}
+
 	hal_cumulative_ip_len = hal_rx_get_fisa_cumulative_ip_length(
 								hal_soc_hdl,
 								rx_tlv_hdr);
@@ -1829,13 +2688,10 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 	dp_fisa_record_pkt(fisa_flow, nbuf, rx_tlv_hdr,
 			   fisa_hdl->soc_hdl->rx_pkt_tlv_size);
 
-	if (fisa_flow->is_flow_udp) {
+	if (fisa_flow->is_flow_udp)
 		dp_rx_fisa_aggr_udp(fisa_hdl, fisa_flow, nbuf);
-	} else if (fisa_flow->is_flow_tcp) {
-		qdf_assert(0);
-		dp_rx_fisa_aggr_tcp(fisa_hdl, fisa_flow, nbuf);
-	}
 
+	dp_rx_fisa_flow_set_active(fisa_hdl, fisa_flow);
 	dp_rx_fisa_release_ft_lock(fisa_hdl, napi_id);
 	fisa_flow->last_accessed_ts = qdf_get_log_timestamp();
 
@@ -1843,6 +2699,7 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 
 invalid_fisa_assist:
 	/* Not eligible aggregation deliver frame without FISA */
+	dp_rx_fisa_flow_set_active(fisa_hdl, fisa_flow);
 	dp_rx_fisa_release_ft_lock(fisa_hdl, napi_id);
 	return FISA_AGGR_NOT_ELIGIBLE;
 }
@@ -1856,7 +2713,7 @@ invalid_fisa_assist:
 static bool dp_is_nbuf_bypass_fisa(qdf_nbuf_t nbuf)
 {
 	/* RX frame from non-regular path or DHCP packet */
-	if (QDF_NBUF_CB_RX_TCP_PROTO(nbuf) ||
+	if (dp_rx_fisa_bypass_tcp(nbuf) ||
 	    qdf_nbuf_is_exc_frame(nbuf) ||
 	    qdf_nbuf_is_ipv4_dhcp_pkt(nbuf) ||
 	    qdf_nbuf_is_da_mcbc(nbuf))
@@ -1880,22 +2737,21 @@ QDF_STATUS dp_rx_fisa_flush_by_vdev_ctx_id(struct dp_soc *soc,
 					   uint8_t rx_ctx_id)
 {
 	struct dp_rx_fst *fisa_hdl = soc->rx_fst;
-	struct dp_fisa_rx_sw_ft *sw_ft_entry =
-		(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
-	int ft_size = fisa_hdl->max_entries;
-	int i;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	uint32_t visited = 0;
 
 	dp_rx_fisa_acquire_ft_lock(fisa_hdl, rx_ctx_id);
-	for (i = 0; i < ft_size; i++) {
-		if (sw_ft_entry[i].is_populated &&
-		    vdev == sw_ft_entry[i].vdev &&
-		    sw_ft_entry[i].napi_id == rx_ctx_id) {
-			dp_fisa_debug("flushing %d %pk vdev %pK napi id:%d", i,
-				      &sw_ft_entry[i], vdev, rx_ctx_id);
-			dp_rx_fisa_flush_flow_wrap(&sw_ft_entry[i]);
+	while ((sw_ft_entry = dp_rx_fisa_flow_pop_active(fisa_hdl, rx_ctx_id,
+							 vdev, &visited))) {
+		if (sw_ft_entry->is_populated) {
+			dp_fisa_debug("flushing %d %pk vdev %pK napi id:%d",
+				      sw_ft_entry->flow_id, sw_ft_entry, vdev,
+				      rx_ctx_id);
+			dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
 		}
 	}
 	dp_rx_fisa_release_ft_lock(fisa_hdl, rx_ctx_id);
+	dp_rx_fisa_record_flush_sweep(fisa_hdl, visited);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -2000,10 +2856,14 @@ QDF_STATUS dp_fisa_rx(struct dp_soc *soc, struct dp_vdev *vdev,
 
 		fisa_ret = dp_add_nbuf_to_fisa_flow(dp_fisa_rx_hdl, vdev,
 						    head_nbuf, fisa_flow);
-		if (fisa_ret == FISA_AGGR_DONE)
+		if (fisa_ret == FISA_AGGR_DONE) {
+			dp_fisa_rx_aging_account(dp_fisa_rx_hdl, rx_ctx_id,
+						 true);
 			goto next_msdu;
+		}
 
 pull_nbuf:
+		dp_fisa_rx_aging_account(dp_fisa_rx_hdl, rx_ctx_id, false);
 		nbuf_skip_rx_pkt_tlv(soc, head_nbuf);
 
 deliver_nbuf: /* Deliver without FISA */
@@ -2023,6 +2883,25 @@ next_msdu:
 /* Length of string to store tuple information for printing */
 #define DP_TUPLE_STR_LEN 512
 
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+/**
+ * dp_rx_fisa_dump_tcp_stats() - Dump TCP aggregation stats
+ * @rx_fst: Handle to FISA context
+ *
+ * Return: None
+ */
+static void dp_rx_fisa_dump_tcp_stats(struct dp_rx_fst *rx_fst)
+{
+	dp_info("#tcp mismatch flushes %u not eligible %u",
+		rx_fst->stats.tcp_mismatch_flush,
+		rx_fst->stats.tcp_not_eligible);
+}
+#else
+static inline void dp_rx_fisa_dump_tcp_stats(struct dp_rx_fst *rx_fst)
+{
+}
+#endif
+
 QDF_STATUS dp_rx_dump_fisa_stats(struct dp_soc *soc)
 {
 	int i;
@@ -2037,6 +2916,15 @@ QDF_STATUS dp_rx_dump_fisa_stats(struct dp_soc *soc)
 		rx_fst->del_flow_count,
 		rx_fst->hash_collision_cnt);
 
+	dp_info("#flush sweeps %u entries visited %llu skipped %llu",
+		rx_fst->stats.flush_sweeps,
+		rx_fst->stats.flush_entries_visited,
+		(uint64_t)rx_fst->stats.flush_sweeps * ft_size -
+		rx_fst->stats.flush_entries_visited);
+
+	dp_rx_fisa_dump_tcp_stats(rx_fst);
+	dp_rx_fisa_dump_aging_stats(rx_fst);
+
 	for (i = 0; i < ft_size; i++, sw_ft_entry++) {
 		if (!sw_ft_entry->is_populated)
 			continue;
@@ -2081,26 +2969,30 @@ static void dp_rx_fisa_flush_flow_wrap(struct dp_fisa_rx_sw_ft *sw_ft)
 	dp_rx_fisa_flush_flow(sw_ft->vdev,
 			      sw_ft);
 	sw_ft->cur_aggr = 0;
+	dp_rx_fisa_flow_clear_active(sw_ft->soc_hdl->rx_fst, sw_ft);
 }
 
 QDF_STATUS dp_rx_fisa_flush_by_ctx_id(struct dp_soc *soc, int napi_id)
 {
 	struct dp_rx_fst *fisa_hdl = soc->rx_fst;
-	struct dp_fisa_rx_sw_ft *sw_ft_entry =
-		(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
-	int ft_size = fisa_hdl->max_entries;
-	int i;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	uint32_t visited = 0;
+
+	if (qdf_unlikely(napi_id >= MAX_REO_DEST_RINGS))
+		return QDF_STATUS_E_INVAL;
 
 	dp_rx_fisa_acquire_ft_lock(fisa_hdl, napi_id);
-	for (i = 0; i < ft_size; i++) {
-		if (sw_ft_entry[i].napi_id == napi_id &&
-		    sw_ft_entry[i].is_populated) {
-			dp_fisa_debug("flushing %d %pK napi_id %d", i,
-				      &sw_ft_entry[i], napi_id);
-			dp_rx_fisa_flush_flow_wrap(&sw_ft_entry[i]);
+	while ((sw_ft_entry = dp_rx_fisa_flow_pop_active(fisa_hdl, napi_id,
+							 NULL, &visited))) {
+		if (sw_ft_entry->is_populated) {
+			dp_fisa_debug("flushing %d %pK napi_id %d",
+				      sw_ft_entry->flow_id, sw_ft_entry,
+				      napi_id);
+			dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
 		}
 	}
 	dp_rx_fisa_release_ft_lock(fisa_hdl, napi_id);
+	dp_rx_fisa_record_flush_sweep(fisa_hdl, visited);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -2108,12 +3000,10 @@ QDF_STATUS dp_rx_fisa_flush_by_ctx_id(struct dp_soc *soc, int napi_id)
 QDF_STATUS dp_rx_fisa_flush_by_vdev_id(struct dp_soc *soc, uint8_t vdev_id)
 {
 	struct dp_rx_fst *fisa_hdl = soc->rx_fst;
-	struct dp_fisa_rx_sw_ft *sw_ft_entry =
-		(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
-	int ft_size = fisa_hdl->max_entries;
-	int i;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
 	struct dp_vdev *vdev;
 	uint8_t reo_id;
+	uint32_t visited = 0;
 
 	vdev = dp_vdev_get_ref_by_id(soc, vdev_id, DP_MOD_ID_RX);
 	if (qdf_unlikely(!vdev)) {
@@ -2121,20 +3011,25 @@ QDF_STATUS dp_rx_fisa_flush_by_vdev_id(struct dp_soc *soc, uint8_t vdev_id)
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	for (i = 0; i < ft_size; i++) {
-		reo_id = sw_ft_entry[i].napi_id;
-		if (reo_id >= MAX_REO_DEST_RINGS)
-			continue;
+	/*
+	 * Called from the HDD flush callback outside of the REO NAPI
+	 * contexts, the active flow lock keeps the lists consistent against
+	 * the NAPIs adding flows to them meanwhile.
+	 */
+	for (reo_id = 0; reo_id < MAX_REO_DEST_RINGS; reo_id++) {
 		dp_rx_fisa_acquire_ft_lock(fisa_hdl, reo_id);
-		if (vdev == sw_ft_entry[i].vdev) {
-			dp_fisa_debug("flushing %d %pk vdev %pK", i,
-				      &sw_ft_entry[i], vdev);
+		while ((sw_ft_entry =
+			dp_rx_fisa_flow_pop_active(fisa_hdl, reo_id, vdev,
+						   &visited))) {
+			dp_fisa_debug("flushing %d %pk vdev %pK",
+				      sw_ft_entry->flow_id, sw_ft_entry, vdev);
 
-			dp_rx_fisa_flush_flow_wrap(&sw_ft_entry[i]);
+			dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
 		}
 		dp_rx_fisa_release_ft_lock(fisa_hdl, reo_id);
 	}
 	dp_vdev_unref_delete(soc, vdev, DP_MOD_ID_RX);
+	dp_rx_fisa_record_flush_sweep(fisa_hdl, visited);
 
 	return QDF_STATUS_SUCCESS;
 }
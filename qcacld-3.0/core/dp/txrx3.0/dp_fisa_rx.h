@@ -144,6 +144,79 @@ void dp_set_fisa_disallowed_for_vdev(struct cdp_soc_t *cdp_soc, uint8_t vdev_id,
  */
 void dp_fisa_rx_fst_update_work(void *arg);
 
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+/**
+ * dp_fisa_rx_fst_aging_work() - Work function for FST aging
+ * @arg: argument passed to the work function
+ *
+ * Return: None
+ */
+void dp_fisa_rx_fst_aging_work(void *arg);
+#endif
+
+#ifdef WLAN_SUPPORT_RX_FISA_TCP
+/* Largest L4 length an aggregate can advertise in the IPv4/IPv6 header */
+#define DP_FISA_TCP_MAX_L4_LEN 0xffff
+
+/**
+ * struct dp_fisa_tcp_seg - Headers of a TCP segment parsed from msdu
+ * @tlv_len: RX PKT TLV and L2 padding length ahead of the L2 header
+ * @l3_hdr_offset: offset of the IP header from the L2 header
+ * @l4_hdr_offset: length of the IP header
+ * @hdr_len: L2 + IP + TCP header length
+ * @payload_len: TCP payload length
+ * @seq: TCP sequence number in host order
+ * @tcph: pointer to the TCP header
+ * @is_ipv6: flag indicating whether the segment is IPv6
+ */
+struct dp_fisa_tcp_seg {
+	uint32_t tlv_len;
+	uint32_t l3_hdr_offset;
+	uint32_t l4_hdr_offset;
+	uint32_t hdr_len;
+	uint32_t payload_len;
+	uint32_t seq;
+	struct tcphdr *tcph;
+	bool is_ipv6;
+};
+
+/**
+ * dp_rx_fisa_tcp_parse_hdrs() - Parse and validate IP and TCP headers
+ * @l2_hdr: L2 header of the msdu
+ * @len: length of the msdu from @l2_hdr
+ * @seg: parsed headers, l3_hdr_offset and l4_hdr_offset are set by caller
+ *
+ * Return: true if the msdu is a plain TCP segment which fits in @len
+ */
+bool dp_rx_fisa_tcp_parse_hdrs(uint8_t *l2_hdr, uint32_t len,
+			       struct dp_fisa_tcp_seg *seg);
+
+/**
+ * dp_rx_fisa_tcp_can_merge() - Check if segment continues the aggregate
+ * @fisa_flow: Handle to SW flow entry, which holds the aggregated nbuf
+ * @seg: parsed headers of the incoming segment
+ *
+ * On success the head segment takes the TSval and window of @seg.
+ *
+ * Return: true if the segment can be appended to the aggregate
+ */
+bool dp_rx_fisa_tcp_can_merge(struct dp_fisa_rx_sw_ft *fisa_flow,
+			      struct dp_fisa_tcp_seg *seg);
+
+/**
+ * dp_rx_fisa_tcp_fixup_head() - Fix up the head of a TCP aggregate for the
+ * stack
+ * @fisa_flow: Handle to SW flow entry, holding more than one segment
+ *
+ * Accounts the frag_list payload in the head nbuf and sets the IPv4
+ * tot_len and check or the IPv6 payload_len. It then sets up the TCP
+ * pseudo header checksum with CHECKSUM_PARTIAL and the GSO info.
+ *
+ * Return: None
+ */
+void dp_rx_fisa_tcp_fixup_head(struct dp_fisa_rx_sw_ft *fisa_flow);
+#endif
+
 /**
  * dp_suspend_fse_cache_flush() - Suspend FSE cache flush
  * @soc: core txrx main context
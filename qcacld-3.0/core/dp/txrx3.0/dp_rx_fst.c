@@ -34,6 +34,9 @@
 
 #ifdef WLAN_SUPPORT_RX_FISA
 void dp_fisa_rx_fst_update_work(void *arg);
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+void dp_fisa_rx_fst_aging_work(void *arg);
+#endif
 
 void dp_rx_dump_fisa_table(struct dp_soc *soc)
 {
@@ -138,6 +141,70 @@ static void dp_fisa_fse_cache_flush_timer(void *arg)
 	qdf_atomic_set(&fisa_hdl->fse_cache_flush_posted, 0);
 }
 
+#ifdef WLAN_SUPPORT_RX_FISA_FLOW_AGING
+/**
+ * dp_fisa_fst_aging_timer() - FST aging timer handler
+ * @arg: DP FST
+ *
+ * The aging work re-arms the timer while flows are populated in the FST.
+ *
+ * Return: None
+ */
+static void dp_fisa_fst_aging_timer(void *arg)
+{
+	struct dp_rx_fst *fst = (struct dp_rx_fst *)arg;
+
+	if (fst->pm_suspended) {
+		qdf_timer_mod(&fst->aging_timer, DP_FISA_AGING_INTERVAL_MS);
+		return;
+	}
+
+	qdf_queue_work(fst->soc_hdl->osdev, fst->fst_update_wq,
+		       &fst->aging_work);
+}
+
+/**
+ * dp_rx_fst_aging_init() - Initialize FST aging timer and work
+ * @fst: Pointer to DP FST
+ *
+ * Return: None
+ */
+static void dp_rx_fst_aging_init(struct dp_rx_fst *fst)
+{
+	qdf_create_work(0, &fst->aging_work, dp_fisa_rx_fst_aging_work, fst);
+	qdf_timer_init(fst->soc_hdl->osdev, &fst->aging_timer,
+		       dp_fisa_fst_aging_timer, (void *)fst,
+		       QDF_TIMER_TYPE_SW);
+}
+
+/**
+ * dp_rx_fst_aging_deinit() - Stop FST aging and free timer and work
+ * @fst: Pointer to DP FST
+ *
+ * Return: None
+ */
+static void dp_rx_fst_aging_deinit(struct dp_rx_fst *fst)
+{
+	/* Keep the aging work and FST updates from re-arming the timer */
+	qdf_spin_lock_bh(&fst->dp_rx_fst_lock);
+	fst->aging_stopped = true;
+	qdf_spin_unlock_bh(&fst->dp_rx_fst_lock);
+
+	qdf_timer_sync_cancel(&fst->aging_timer);
+	qdf_cancel_work(&fst->aging_work);
+	qdf_flush_work(&fst->aging_work);
+	qdf_timer_free(&fst->aging_timer);
+}
+#else
+static inline void dp_rx_fst_aging_init(struct dp_rx_fst *fst)
+{
+}
+
+static inline void dp_rx_fst_aging_deinit(struct dp_rx_fst *fst)
+{
+}
+#endif
+
 /**
  * dp_rx_fst_cmem_deinit() - De-initialize CMEM parameters
  * @fst: Pointer to DP FST
@@ -150,6 +217,7 @@ static void dp_rx_fst_cmem_deinit(struct dp_rx_fst *fst)
 	qdf_list_node_t *node;
 	int i;
 
+	dp_rx_fst_aging_deinit(fst);
 	qdf_cancel_work(&fst->fst_update_work);
 	qdf_flush_work(&fst->fst_update_work);
 	qdf_flush_workqueue(0, fst->fst_update_wq);
@@ -190,6 +258,7 @@ static QDF_STATUS dp_rx_fst_cmem_init(struct dp_rx_fst *fst)
 
 	qdf_create_work(0, &fst->fst_update_work,
 			dp_fisa_rx_fst_update_work, fst);
+	dp_rx_fst_aging_init(fst);
 	qdf_list_create(&fst->fst_update_list, 128);
 	qdf_event_create(&fst->cmem_resp_event);
 
@@ -310,6 +379,9 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 	for (i = 0; i < fst->max_entries; i++)
 		ft_entry[i].napi_id = INVALID_NAPI;
 
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+		TAILQ_INIT(&fst->active_flows[i]);
+
 	status = dp_rx_sw_ft_hist_init(ft_entry, fst->max_entries,
 				       soc->rx_pkt_tlv_size);
 	if (QDF_IS_STATUS_ERROR(status))
@@ -328,6 +400,8 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 	}
 
 	qdf_spinlock_create(&fst->dp_rx_fst_lock);
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+		qdf_spinlock_create(&fst->active_flows_lock[i]);
 
 	status = qdf_timer_init(soc->osdev, &fst->fse_cache_flush_timer,
 				dp_fisa_fse_cache_flush_timer, (void *)soc,
@@ -353,6 +427,8 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 	return QDF_STATUS_SUCCESS;
 
 timer_init_fail:
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+		qdf_spinlock_destroy(&fst->active_flows_lock[i]);
 	qdf_spinlock_destroy(&fst->dp_rx_fst_lock);
 	hal_rx_fst_detach(fst->hal_rx_fst, soc->osdev);
 free_hist:
@@ -444,6 +520,7 @@ QDF_STATUS dp_rx_flow_send_fst_fw_setup(struct dp_soc *soc,
 void dp_rx_fst_detach(struct dp_soc *soc, struct dp_pdev *pdev)
 {
 	struct dp_rx_fst *dp_fst;
+	int i;
 
 	dp_fst = soc->rx_fst;
 	if (qdf_likely(dp_fst)) {
@@ -456,6 +533,8 @@ void dp_rx_fst_detach(struct dp_soc *soc, struct dp_pdev *pdev)
 		dp_rx_sw_ft_hist_deinit((struct dp_fisa_rx_sw_ft *)dp_fst->base,
 					dp_fst->max_entries);
 		dp_context_free_mem(soc, DP_FISA_RX_FT_TYPE, dp_fst->base);
+		for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+			qdf_spinlock_destroy(&dp_fst->active_flows_lock[i]);
 		qdf_spinlock_destroy(&dp_fst->dp_rx_fst_lock);
 		qdf_mem_free(dp_fst);
 	}
@@ -22,6 +22,99 @@
 #include <wlan_cfg.h>
 #include "dp_swlm.h"
 
+/* Upper bounds, in us, of all but the last added latency histogram bucket */
+static const uint32_t
+dp_swlm_tcl_latency_bucket[DP_SWLM_TCL_LATENCY_HIST_MAX - 1] = {
+	50, 100, 250, 500, 1000, 2000
+};
+
+/**
+ * dp_swlm_tcl_flush_timer_start() - Arm the backstop flush of a TCL ring
+ * @tcl: TCL params of the ring
+ *
+ * Returns: none
+ */
+static inline void
+dp_swlm_tcl_flush_timer_start(struct dp_swlm_tcl_params *tcl)
+{
+	qdf_hrtimer_start(&tcl->flush_timer,
+			  qdf_ns_to_ktime((uint64_t)tcl->time_flush_thresh *
+					  1000),
+			  QDF_HRTIMER_MODE_REL);
+}
+
+void dp_swlm_tcl_session_end(struct dp_soc *soc, uint8_t ring_id)
+{
+	struct dp_swlm *swlm = &soc->swlm;
+	struct dp_swlm_params *params = &swlm->params;
+	struct dp_swlm_tcl_params *tcl = &params->tcl[ring_id];
+	u64 curr_time = qdf_get_log_timestamp_usecs();
+	u64 latency = 0;
+	int i;
+
+	if (curr_time > tcl->session_start_time)
+		latency = curr_time - tcl->session_start_time;
+	tcl->session_start_time = 0;
+
+	for (i = 0; i < DP_SWLM_TCL_LATENCY_HIST_MAX - 1; i++) {
+		if (latency <= dp_swlm_tcl_latency_bucket[i])
+			break;
+	}
+	DP_STATS_INC(swlm, tcl[ring_id].added_latency_hist[i], 1);
+
+	/*
+	 * Back off multiplicatively when the session went past the SLO and
+	 * grow the limits additively while there is enough headroom left.
+	 */
+	if (latency > params->latency_slo) {
+		DP_STATS_INC(swlm, tcl[ring_id].slo_violation, 1);
+		tcl->time_flush_thresh =
+			qdf_max(tcl->time_flush_thresh >> 1,
+				(uint32_t)DP_SWLM_TCL_TIME_FLUSH_THRESH_MIN);
+		tcl->bytes_budget =
+			qdf_max(tcl->bytes_budget >> 1,
+				(uint32_t)DP_SWLM_TCL_BYTES_BUDGET_MIN);
+	} else if (latency < (params->latency_slo >> 1)) {
+		tcl->time_flush_thresh =
+			qdf_min(tcl->time_flush_thresh +
+				DP_SWLM_TCL_TIME_FLUSH_STEP,
+				params->latency_slo);
+		tcl->bytes_budget =
+			qdf_min(tcl->bytes_budget +
+				DP_SWLM_TCL_BYTES_BUDGET_STEP,
+				(uint32_t)DP_SWLM_TCL_BYTES_BUDGET_MAX);
+	}
+}
+
+/**
+ * dp_swlm_tcl_ring_occupancy_check() - Cut the coalescing budget if the
+ *					TCL ring is backing up
+ * @soc: Datapath global soc handle
+ * @rid: TCL ring id
+ *
+ * Descriptors pending with the HW already add latency, so holding back
+ * more of them behind a coalesced HP write only makes it worse.
+ *
+ * Returns: none
+ */
+static void dp_swlm_tcl_ring_occupancy_check(struct dp_soc *soc, uint8_t rid)
+{
+	struct dp_swlm *swlm = &soc->swlm;
+	struct dp_swlm_tcl_params *tcl = &swlm->params.tcl[rid];
+	hal_ring_handle_t hal_ring_hdl = soc->tcl_data_ring[rid].hal_srng;
+	uint32_t num_entries, pending;
+
+	num_entries = hal_srng_get_num_entries(soc->hal_soc, hal_ring_hdl);
+	pending = num_entries -
+		  hal_srng_src_num_avail(soc->hal_soc, hal_ring_hdl, 0);
+	if (pending <= (num_entries >> DP_SWLM_TCL_RING_OCCUPANCY_SHIFT))
+		return;
+
+	tcl->bytes_budget = qdf_max(tcl->bytes_budget >> 1,
+				    (uint32_t)DP_SWLM_TCL_BYTES_BUDGET_MIN);
+	DP_STATS_INC(swlm, tcl[rid].ring_backoff, 1);
+}
+
 /**
  * dp_swlm_is_tput_thresh_reached() - Calculate the current tx and rx TPUT
  *				      and check if it passes the pre-set
@@ -93,6 +186,7 @@ dp_swlm_can_tcl_wr_coalesce(struct dp_soc *soc,
 	if (curr_time >= params->tcl[rid].expire_time) {
 		params->tcl[rid].expire_time = qdf_get_log_timestamp_usecs() +
 			      params->sampling_time;
+		dp_swlm_tcl_ring_occupancy_check(soc, rid);
 		tput_level_pass = dp_swlm_is_tput_thresh_reached(soc, rid);
 		if (tput_level_pass) {
 			params->tcl[rid].tput_pass_cnt++;
@@ -123,7 +217,11 @@ coalescing_fail:
 		return 0;
 	}
 
-	qdf_timer_mod(&params->tcl[rid].flush_timer, 1);
+	if (!params->tcl[rid].session_start_time) {
+		params->tcl[rid].session_start_time = curr_time;
+		dp_swlm_tcl_flush_timer_start(&params->tcl[rid]);
+	}
+	DP_STATS_INC(swlm, tcl[rid].coalesced_bytes, tcl_data->pkt_len);
 
 	return 1;
 }
@@ -155,6 +253,24 @@ QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc)
 			swlm->stats.tcl[i].time_thresh_reached);
 		dp_info("Coalesce fail (TPUT sampling fail): %d",
 			swlm->stats.tcl[i].tput_criteria_fail);
+		dp_info("Coalesced bytes: %llu",
+			swlm->stats.tcl[i].coalesced_bytes);
+		dp_info("Latency SLO %u us violations: %u",
+			swlm->params.latency_slo,
+			swlm->stats.tcl[i].slo_violation);
+		dp_info("Ring occupancy backoff: %u",
+			swlm->stats.tcl[i].ring_backoff);
+		dp_info("Time thresh: %u us bytes budget: %u/16",
+			swlm->params.tcl[i].time_flush_thresh,
+			swlm->params.tcl[i].bytes_budget);
+		dp_info("Added latency hist (us) <=50: %u <=100: %u <=250: %u <=500: %u <=1000: %u <=2000: %u >2000: %u",
+			swlm->stats.tcl[i].added_latency_hist[0],
+			swlm->stats.tcl[i].added_latency_hist[1],
+			swlm->stats.tcl[i].added_latency_hist[2],
+			swlm->stats.tcl[i].added_latency_hist[3],
+			swlm->stats.tcl[i].added_latency_hist[4],
+			swlm->stats.tcl[i].added_latency_hist[5],
+			swlm->stats.tcl[i].added_latency_hist[6]);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -165,12 +281,12 @@ static struct dp_swlm_ops dp_latency_mgr_ops = {
 };
 
 /**
- * dp_swlm_tcl_flush_timer() - Timer handler for tcl register write coalescing
- * @arg: private data of the timer
+ * dp_swlm_tcl_flush_bh() - Flush the coalesced tcl register write
+ * @arg: TCL params of the ring to flush
  *
  * Returns: none
  */
-static void dp_swlm_tcl_flush_timer(void *arg)
+static void dp_swlm_tcl_flush_bh(void *arg)
 {
 	struct dp_swlm_tcl_params *tcl = arg;
 	struct dp_soc *soc = tcl->soc;
@@ -178,11 +294,23 @@ static void dp_swlm_tcl_flush_timer(void *arg)
 	hal_ring_handle_t hal_ring_hdl =
 				soc->tcl_data_ring[tcl->ring_id].hal_srng;
 
-	if (hal_srng_try_access_start(soc->hal_soc, hal_ring_hdl) < 0)
+	if (hal_srng_try_access_start(soc->hal_soc, hal_ring_hdl) < 0) {
+		/*
+		 * The lock holder may itself coalesce its write, retry so
+		 * that the session still gets flushed.
+		 */
+		dp_swlm_tcl_flush_timer_start(tcl);
 		goto fail;
+	}
 
 	if (hif_pm_runtime_get(soc->hif_handle, RTPM_ID_DW_TX_HW_ENQUEUE,
 			       true)) {
+		/*
+		 * The HP write is left to the ring flush event, close the
+		 * session while the ring is still held so that a write
+		 * coalesced after it does not get its start time cleared.
+		 */
+		tcl->session_start_time = 0;
 		hal_srng_access_end_reap(soc->hal_soc, hal_ring_hdl);
 		hal_srng_set_event(hal_ring_hdl, HAL_SRNG_FLUSH_EVENT);
 		hal_srng_inc_flush_cnt(hal_ring_hdl);
@@ -190,6 +318,8 @@ static void dp_swlm_tcl_flush_timer(void *arg)
 	}
 
 	DP_STATS_INC(swlm, tcl[tcl->ring_id].timer_flush_success, 1);
+	if (tcl->session_start_time)
+		dp_swlm_tcl_session_end(soc, tcl->ring_id);
 	hal_srng_access_end(soc->hal_soc, hal_ring_hdl);
 	hif_pm_runtime_put(soc->hif_handle, RTPM_ID_DW_TX_HW_ENQUEUE);
 
@@ -201,6 +331,26 @@ fail:
 	return;
 }
 
+/**
+ * dp_swlm_tcl_flush_timer() - Timer handler for tcl register write coalescing
+ * @timer: flush timer of the TCL ring
+ *
+ * The timer fires in hard irq context, the flush itself needs the ring lock
+ * and a runtime PM vote, so it is deferred to the ring flush bottom half.
+ *
+ * Returns: QDF_HRTIMER_NORESTART
+ */
+static enum qdf_hrtimer_restart_status
+dp_swlm_tcl_flush_timer(qdf_hrtimer_data_t *timer)
+{
+	struct dp_swlm_tcl_params *tcl =
+		qdf_container_of(timer, struct dp_swlm_tcl_params, flush_timer);
+
+	qdf_sched_bh(&tcl->flush_bh);
+
+	return QDF_HRTIMER_NORESTART;
+}
+
 /**
  * dp_soc_swlm_tcl_attach() - attach the TCL resources for the software
  *			      latency manager.
@@ -219,16 +369,28 @@ static inline QDF_STATUS dp_soc_swlm_tcl_attach(struct dp_soc *soc)
 	swlm->params.time_flush_thresh = DP_SWLM_TCL_TIME_FLUSH_THRESH;
 	swlm->params.tx_thresh_multiplier = DP_SWLM_TCL_TX_THRESH_MULTIPLIER;
 	swlm->params.tx_pkt_thresh = DP_SWLM_TCL_TX_PKT_THRESH;
+	swlm->params.latency_slo =
+		wlan_cfg_get_swlm_latency_slo(soc->wlan_cfg_ctx);
 
 	for (i = 0; i < soc->num_tcl_data_rings; i++) {
 		swlm->params.tcl[i].soc = soc;
 		swlm->params.tcl[i].ring_id = i;
 		swlm->params.tcl[i].bytes_flush_thresh = 0;
-		qdf_timer_init(soc->osdev,
-			       &swlm->params.tcl[i].flush_timer,
-			       dp_swlm_tcl_flush_timer,
-			       (void *)&swlm->params.tcl[i],
-			       QDF_TIMER_TYPE_WAKE_APPS);
+		swlm->params.tcl[i].session_start_time = 0;
+		swlm->params.tcl[i].time_flush_thresh =
+			qdf_min(swlm->params.time_flush_thresh,
+				swlm->params.latency_slo);
+		swlm->params.tcl[i].bytes_budget =
+			swlm->params.tx_thresh_multiplier <<
+			DP_SWLM_TCL_BYTES_BUDGET_SHIFT;
+		qdf_create_bh(&swlm->params.tcl[i].flush_bh,
+			      dp_swlm_tcl_flush_bh,
+			      (void *)&swlm->params.tcl[i]);
+		qdf_hrtimer_init(&swlm->params.tcl[i].flush_timer,
+				 dp_swlm_tcl_flush_timer,
+				 QDF_CLOCK_MONOTONIC,
+				 QDF_HRTIMER_MODE_REL,
+				 QDF_CONTEXT_HARDWARE);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -245,8 +407,10 @@ static inline QDF_STATUS dp_soc_swlm_tcl_attach(struct dp_soc *soc)
 static inline QDF_STATUS dp_soc_swlm_tcl_detach(struct dp_swlm *swlm,
 						uint8_t ring_id)
 {
-	qdf_timer_stop(&swlm->params.tcl[ring_id].flush_timer);
-	qdf_timer_free(&swlm->params.tcl[ring_id].flush_timer);
+	qdf_hrtimer_kill(&swlm->params.tcl[ring_id].flush_timer);
+	qdf_destroy_bh(&swlm->params.tcl[ring_id].flush_bh);
+	/* The bottom half re-arms the timer when it loses the ring lock */
+	qdf_hrtimer_kill(&swlm->params.tcl[ring_id].flush_timer);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -31,6 +31,16 @@
 #define DP_SWLM_TCL_TIME_FLUSH_THRESH 1000
 #define DP_SWLM_TCL_TX_THRESH_MULTIPLIER 2
 
+/* Adaptive coalescing limits, time in us and bytes budget in 1/16 units */
+#define DP_SWLM_TCL_TIME_FLUSH_THRESH_MIN 50
+#define DP_SWLM_TCL_TIME_FLUSH_STEP 50
+#define DP_SWLM_TCL_BYTES_BUDGET_SHIFT 4
+#define DP_SWLM_TCL_BYTES_BUDGET_MIN 4
+#define DP_SWLM_TCL_BYTES_BUDGET_MAX 128
+#define DP_SWLM_TCL_BYTES_BUDGET_STEP 2
+/* Budget is cut once more than 1/2 of the TCL ring is pending with HW */
+#define DP_SWLM_TCL_RING_OCCUPANCY_SHIFT 1
+
 /* Inline Functions */
 
 /**
@@ -59,6 +69,16 @@ bool dp_tx_is_special_frame(qdf_nbuf_t nbuf, uint32_t frame_mask)
 	return false;
 }
 
+/**
+ * dp_swlm_tcl_session_end() - Account the end of a TCL coalescing session
+ *			       and adapt the coalescing limits
+ * @soc: Datapath soc handle
+ * @ring_id: TCL ring id
+ *
+ * Returns: none
+ */
+void dp_swlm_tcl_session_end(struct dp_soc *soc, uint8_t ring_id);
+
 /**
  * dp_swlm_tcl_reset_session_data() -  Reset the TCL coalescing session data
  * @soc: DP soc handle
@@ -71,13 +91,17 @@ dp_swlm_tcl_reset_session_data(struct dp_soc *soc, uint8_t ring_id)
 {
 	struct dp_swlm_params *params = &soc->swlm.params;
 
+	if (params->tcl[ring_id].session_start_time)
+		dp_swlm_tcl_session_end(soc, ring_id);
+
 	params->tcl[ring_id].coalesce_end_time = qdf_get_log_timestamp_usecs() +
-		params->time_flush_thresh;
+		params->tcl[ring_id].time_flush_thresh;
 	params->tcl[ring_id].bytes_coalesced = 0;
 	params->tcl[ring_id].bytes_flush_thresh =
-				params->tcl[ring_id].sampling_session_tx_bytes *
-				params->tx_thresh_multiplier;
-	qdf_timer_sync_cancel(&params->tcl[ring_id].flush_timer);
+			(params->tcl[ring_id].sampling_session_tx_bytes *
+			 params->tcl[ring_id].bytes_budget) >>
+			DP_SWLM_TCL_BYTES_BUDGET_SHIFT;
+	qdf_hrtimer_cancel(&params->tcl[ring_id].flush_timer);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -0,0 +1,623 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <dp_types.h>
+#include <dp_fisa_rx.h>
+#include <linux/if_ether.h>
+#include <linux/skbuff.h>
+#include <net/ip.h>
+#include <net/ipv6.h>
+#include <net/ip6_checksum.h>
+#include <net/tcp.h>
+#include "dp_fisa_rx_tcp_test.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+/* TCP header with NOP, NOP, timestamp options, as sent by Linux peers */
+#define DP_FISA_TCP_UT_TCP_HLEN \
+	(sizeof(struct tcphdr) + TCPOLEN_TSTAMP_ALIGNED)
+
+/* Odd MSS, so that payload boundaries fall on odd checksum offsets */
+#define DP_FISA_TCP_UT_MSS 1001
+
+/* Largest frame built, with room for one byte of trailing L2 padding */
+#define DP_FISA_TCP_UT_BUF_LEN (ETH_HLEN + sizeof(struct ipv6hdr) + \
+				DP_FISA_TCP_UT_TCP_HLEN + \
+				DP_FISA_TCP_UT_MSS + 1)
+
+#define ut_check(cond) __ut_check(!!(cond), #cond, __func__, __LINE__)
+
+/**
+ * struct dp_fisa_tcp_ut_params - Fields of a TCP segment built by the test
+ * @is_ipv6: build an IPv6 frame instead of an IPv4 one
+ * @seq: TCP sequence number
+ * @ack: TCP acknowledgment number
+ * @tsval: timestamp option TSval
+ * @tsecr: timestamp option TSecr
+ * @window: TCP window
+ * @payload_len: TCP payload length
+ */
+struct dp_fisa_tcp_ut_params {
+	bool is_ipv6;
+	uint32_t seq;
+	uint32_t ack;
+	uint32_t tsval;
+	uint32_t tsecr;
+	uint16_t window;
+	uint32_t payload_len;
+};
+
+static uint8_t dp_fisa_tcp_ut_buf[DP_FISA_TCP_UT_BUF_LEN];
+static uint8_t dp_fisa_tcp_ut_stream[FISA_FLOW_MAX_AGGR_COUNT *
+				     DP_FISA_TCP_UT_MSS];
+static struct dp_fisa_rx_sw_ft dp_fisa_tcp_ut_flow;
+
+static uint32_t
+__ut_check(bool pass, const char *expr, const char *func, uint32_t line)
+{
+	if (pass)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s:%u %s", func, line, expr);
+
+	return 1;
+}
+
+static uint32_t dp_fisa_tcp_ut_l3_len(bool is_ipv6)
+{
+	return is_ipv6 ? sizeof(struct ipv6hdr) : sizeof(struct iphdr);
+}
+
+static void dp_fisa_tcp_ut_params_init(struct dp_fisa_tcp_ut_params *params,
+				       bool is_ipv6)
+{
+	params->is_ipv6 = is_ipv6;
+	params->seq = 0xfffffc00;
+	params->ack = 0x12345678;
+	params->tsval = 0x7ffffff0;
+	params->tsecr = 0x0badcafe;
+	params->window = 0x1000;
+	params->payload_len = DP_FISA_TCP_UT_MSS;
+}
+
+/**
+ * dp_fisa_tcp_ut_build() - Build an Ethernet TCP frame
+ * @buf: buffer of at least DP_FISA_TCP_UT_BUF_LEN bytes
+ * @params: fields of the segment
+ *
+ * Payload byte i of the segment is the low byte of seq + i, so that the
+ * aggregated stream can be checked byte for byte.
+ *
+ * Return: length of the frame
+ */
+static uint32_t dp_fisa_tcp_ut_build(uint8_t *buf,
+				     struct dp_fisa_tcp_ut_params *params)
+{
+	uint32_t l3_len = dp_fisa_tcp_ut_l3_len(params->is_ipv6);
+	uint32_t l4_len = DP_FISA_TCP_UT_TCP_HLEN + params->payload_len;
+	struct ethhdr *eth = (struct ethhdr *)buf;
+	struct tcphdr *th = (struct tcphdr *)(buf + ETH_HLEN + l3_len);
+	__be32 *opt = (__be32 *)(th + 1);
+	uint8_t *payload = (uint8_t *)th + DP_FISA_TCP_UT_TCP_HLEN;
+	uint32_t i;
+
+	qdf_mem_zero(buf, ETH_HLEN + l3_len + DP_FISA_TCP_UT_TCP_HLEN);
+
+	if (params->is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)(eth + 1);
+
+		eth->h_proto = qdf_htons(ETH_P_IPV6);
+		ip6h->version = 6;
+		ip6h->payload_len = qdf_htons(l4_len);
+		ip6h->nexthdr = IPPROTO_TCP;
+		ip6h->hop_limit = 64;
+		ip6h->saddr.s6_addr32[0] = qdf_htonl(0x20010db8);
+		ip6h->saddr.s6_addr32[3] = qdf_htonl(1);
+		ip6h->daddr.s6_addr32[0] = qdf_htonl(0x20010db8);
+		ip6h->daddr.s6_addr32[3] = qdf_htonl(2);
+	} else {
+		struct iphdr *iph = (struct iphdr *)(eth + 1);
+
+		eth->h_proto = qdf_htons(ETH_P_IP);
+		iph->version = 4;
+		iph->ihl = 5;
+		iph->tot_len = qdf_htons(l3_len + l4_len);
+		iph->frag_off = qdf_htons(IP_DF);
+		iph->ttl = 64;
+		iph->protocol = IPPROTO_TCP;
+		iph->saddr = qdf_htonl(0xc0a80101);
+		iph->daddr = qdf_htonl(0xc0a80102);
+		iph->check = ip_fast_csum((u8 *)iph, iph->ihl);
+	}
+
+	th->source = qdf_htons(5001);
+	th->dest = qdf_htons(40000);
+	th->seq = qdf_htonl(params->seq);
+	th->ack_seq = qdf_htonl(params->ack);
+	th->doff = DP_FISA_TCP_UT_TCP_HLEN / 4;
+	th->ack = 1;
+	th->window = qdf_htons(params->window);
+	opt[0] = qdf_htonl((TCPOPT_NOP << 24) | (TCPOPT_NOP << 16) |
+			   (TCPOPT_TIMESTAMP << 8) | TCPOLEN_TIMESTAMP);
+	opt[1] = qdf_htonl(params->tsval);
+	opt[2] = qdf_htonl(params->tsecr);
+
+	for (i = 0; i < params->payload_len; i++)
+		payload[i] = (uint8_t)(params->seq + i);
+
+	return ETH_HLEN + l3_len + l4_len;
+}
+
+static void dp_fisa_tcp_ut_set_l4_len(uint8_t *buf, bool is_ipv6,
+				      uint32_t l4_len)
+{
+	if (is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)(buf + ETH_HLEN);
+
+		ip6h->payload_len = qdf_htons(l4_len);
+	} else {
+		struct iphdr *iph = (struct iphdr *)(buf + ETH_HLEN);
+
+		iph->tot_len = qdf_htons(sizeof(*iph) + l4_len);
+	}
+}
+
+/**
+ * dp_fisa_tcp_ut_parse() - Parse a frame with the offsets reported by HAL
+ * @buf: frame starting with the L2 header
+ * @len: length of the msdu
+ * @l4_hdr_offset: IP header length reported by HAL
+ * @seg: parsed headers
+ *
+ * Return: result of dp_rx_fisa_tcp_parse_hdrs()
+ */
+static bool dp_fisa_tcp_ut_parse(uint8_t *buf, uint32_t len,
+				 uint32_t l4_hdr_offset,
+				 struct dp_fisa_tcp_seg *seg)
+{
+	qdf_mem_zero(seg, sizeof(*seg));
+	seg->l3_hdr_offset = ETH_HLEN;
+	seg->l4_hdr_offset = l4_hdr_offset;
+
+	return dp_rx_fisa_tcp_parse_hdrs(buf, len, seg);
+}
+
+static uint32_t dp_fisa_tcp_ut_parse_family(bool is_ipv6)
+{
+	uint8_t *buf = dp_fisa_tcp_ut_buf;
+	uint32_t l3_len = dp_fisa_tcp_ut_l3_len(is_ipv6);
+	struct tcphdr *th = (struct tcphdr *)(buf + ETH_HLEN + l3_len);
+	struct dp_fisa_tcp_ut_params params;
+	struct dp_fisa_tcp_seg seg;
+	uint32_t errors = 0;
+	uint32_t len;
+
+	dp_fisa_tcp_ut_params_init(&params, is_ipv6);
+	len = dp_fisa_tcp_ut_build(buf, &params);
+
+	errors += ut_check(dp_fisa_tcp_ut_parse(buf, len, l3_len, &seg));
+	errors += ut_check(seg.is_ipv6 == is_ipv6);
+	errors += ut_check(seg.hdr_len ==
+			   ETH_HLEN + l3_len + DP_FISA_TCP_UT_TCP_HLEN);
+	errors += ut_check(seg.payload_len == params.payload_len);
+	errors += ut_check(seg.seq == params.seq);
+	errors += ut_check(seg.tcph == th);
+
+	/* L2 padding after the datagram is not part of the payload */
+	errors += ut_check(dp_fisa_tcp_ut_parse(buf, len + 1, l3_len, &seg));
+	errors += ut_check(seg.payload_len == params.payload_len);
+
+	/* Truncated msdu */
+	errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len - 1, l3_len, &seg));
+	errors += ut_check(!dp_fisa_tcp_ut_parse(buf, ETH_HLEN + l3_len +
+						 sizeof(struct tcphdr) - 1,
+						 l3_len, &seg));
+
+	/* HAL reporting an IP header length other than the fixed one */
+	errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len + 8, &seg));
+
+	/* TCP header shorter than struct tcphdr */
+	th->doff = sizeof(struct tcphdr) / 4 - 1;
+	errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len, &seg));
+
+	/* IP length not covering the TCP header */
+	dp_fisa_tcp_ut_build(buf, &params);
+	dp_fisa_tcp_ut_set_l4_len(buf, is_ipv6, DP_FISA_TCP_UT_TCP_HLEN - 4);
+	errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len, &seg));
+
+	/* Pure ACK parses with an empty payload */
+	dp_fisa_tcp_ut_set_l4_len(buf, is_ipv6, DP_FISA_TCP_UT_TCP_HLEN);
+	errors += ut_check(dp_fisa_tcp_ut_parse(buf, len, l3_len, &seg));
+	errors += ut_check(!seg.payload_len);
+
+	dp_fisa_tcp_ut_build(buf, &params);
+	if (is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)(buf + ETH_HLEN);
+
+		ip6h->nexthdr = IPPROTO_UDP;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+
+		/* Extension headers */
+		ip6h->nexthdr = IPPROTO_HOPOPTS;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+		ip6h->nexthdr = IPPROTO_TCP;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len + 8,
+							 &seg));
+
+		ip6h->version = 4;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+	} else {
+		struct iphdr *iph = (struct iphdr *)(buf + ETH_HLEN);
+
+		iph->protocol = IPPROTO_UDP;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+		iph->protocol = IPPROTO_TCP;
+
+		/* IP options */
+		iph->ihl = 6;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len + 4,
+							 &seg));
+		iph->ihl = 5;
+
+		/* IP fragments, first and non-first */
+		iph->frag_off = qdf_htons(IP_MF);
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+		iph->frag_off = qdf_htons(1);
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+		iph->frag_off = 0;
+		errors += ut_check(dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							&seg));
+
+		iph->version = 5;
+		errors += ut_check(!dp_fisa_tcp_ut_parse(buf, len, l3_len,
+							 &seg));
+	}
+
+	return errors;
+}
+
+/**
+ * dp_fisa_tcp_ut_flow_init() - Start an aggregate the way
+ *	dp_rx_fisa_aggr_tcp() does for the first segment of a flow
+ * @flow: SW flow entry
+ * @head_skb: head nbuf, holding the frame built from @params
+ * @params: fields of the head segment
+ *
+ * Return: None
+ */
+static void dp_fisa_tcp_ut_flow_init(struct dp_fisa_rx_sw_ft *flow,
+				     qdf_nbuf_t head_skb,
+				     struct dp_fisa_tcp_ut_params *params)
+{
+	uint32_t len;
+
+	len = dp_fisa_tcp_ut_build(qdf_nbuf_data(head_skb), params);
+	qdf_nbuf_set_pktlen(head_skb, len);
+
+	qdf_mem_zero(flow, sizeof(*flow));
+	flow->head_skb = head_skb;
+	flow->head_skb_ip_hdr_offset = ETH_HLEN;
+	flow->head_skb_l4_hdr_offset = dp_fisa_tcp_ut_l3_len(params->is_ipv6);
+	flow->head_skb_is_ipv6 = params->is_ipv6;
+	flow->tcp_mss = params->payload_len;
+	flow->tcp_segs = 1;
+	flow->tcp_next_seq = params->seq + params->payload_len;
+}
+
+/**
+ * dp_fisa_tcp_ut_can_merge() - Check @next against an aggregate of @head
+ * @head_skb: head nbuf
+ * @head: fields of the head segment
+ * @next: fields of the incoming segment
+ * @tcp_segs: number of segments in the aggregate
+ * @frags_len: payload length already chained in frag_list
+ *
+ * Return: result of dp_rx_fisa_tcp_can_merge(), -1 if @next fails to parse
+ */
+static int dp_fisa_tcp_ut_can_merge(qdf_nbuf_t head_skb,
+				    struct dp_fisa_tcp_ut_params *head,
+				    struct dp_fisa_tcp_ut_params *next,
+				    uint16_t tcp_segs, uint16_t frags_len)
+{
+	struct dp_fisa_rx_sw_ft *flow = &dp_fisa_tcp_ut_flow;
+	struct dp_fisa_tcp_seg seg;
+	uint32_t len;
+
+	dp_fisa_tcp_ut_flow_init(flow, head_skb, head);
+	flow->tcp_segs = tcp_segs;
+	flow->frags_cumulative_len = frags_len;
+
+	len = dp_fisa_tcp_ut_build(dp_fisa_tcp_ut_buf, next);
+	if (!dp_fisa_tcp_ut_parse(dp_fisa_tcp_ut_buf, len,
+				  dp_fisa_tcp_ut_l3_len(next->is_ipv6), &seg))
+		return -1;
+
+	return dp_rx_fisa_tcp_can_merge(flow, &seg);
+}
+
+static uint32_t dp_fisa_tcp_ut_merge_family(bool is_ipv6)
+{
+	uint32_t l3_len = dp_fisa_tcp_ut_l3_len(is_ipv6);
+	struct dp_fisa_tcp_ut_params head, next;
+	uint16_t frags_len;
+	qdf_nbuf_t head_skb;
+	struct tcphdr *th;
+	__be32 *opt;
+	uint32_t errors = 0;
+
+	head_skb = qdf_nbuf_alloc(NULL, DP_FISA_TCP_UT_BUF_LEN, 0, 4, false);
+	if (!head_skb)
+		return ut_check(head_skb);
+
+	th = (struct tcphdr *)(qdf_nbuf_data(head_skb) + ETH_HLEN + l3_len);
+	opt = (__be32 *)(th + 1);
+
+	dp_fisa_tcp_ut_params_init(&head, is_ipv6);
+
+	/* Next in order segment, head takes its TSval and window */
+	next = head;
+	next.seq += head.payload_len;
+	next.tsval++;
+	next.window++;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 1);
+	errors += ut_check(th->window == qdf_htons(next.window));
+	errors += ut_check(opt[1] == qdf_htonl(next.tsval));
+	errors += ut_check(opt[2] == qdf_htonl(head.tsecr));
+
+	/* TSval is allowed to stay, not to go back */
+	next.tsval = head.tsval;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 1);
+	next.tsval = head.tsval - 1;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	errors += ut_check(opt[1] == qdf_htonl(head.tsval));
+	next.tsval = head.tsval + 1;
+
+	next.tsecr++;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	next.tsecr = head.tsecr;
+
+	/* Out of order, retransmitted and overlapping segments */
+	next.seq++;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	next.seq = head.seq;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	next.seq = head.seq + head.payload_len - 1;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	next.seq = head.seq + head.payload_len;
+
+	next.ack++;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	next.ack = head.ack;
+
+	/* Payload above the MSS of the head */
+	head.payload_len = DP_FISA_TCP_UT_MSS - 1;
+	next.seq = head.seq + head.payload_len;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+	next.payload_len = head.payload_len;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 1);
+	head.payload_len = DP_FISA_TCP_UT_MSS;
+	next.payload_len = DP_FISA_TCP_UT_MSS;
+	next.seq = head.seq + head.payload_len;
+
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(
+				head_skb, &head, &next,
+				FISA_FLOW_MAX_AGGR_COUNT - 1, 0) == 1);
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(
+				head_skb, &head, &next,
+				FISA_FLOW_MAX_AGGR_COUNT, 0) == 0);
+
+	/* IP length of the aggregate fits in 16 bits, sequence excluded */
+	frags_len = DP_FISA_TCP_MAX_L4_LEN - DP_FISA_TCP_UT_TCP_HLEN -
+		    head.payload_len - next.payload_len;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    2, frags_len) == 1);
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    2, frags_len + 1) == 0);
+
+	next.is_ipv6 = !is_ipv6;
+	errors += ut_check(dp_fisa_tcp_ut_can_merge(head_skb, &head, &next,
+						    1, 0) == 0);
+
+	qdf_nbuf_free(head_skb);
+
+	return errors;
+}
+
+/**
+ * dp_fisa_tcp_ut_fixup_family() - Aggregate @num_segs segments the way
+ *	dp_rx_fisa_aggr_tcp() does, fix up the head and check the result
+ * @is_ipv6: aggregate IPv6 segments instead of IPv4 ones
+ * @num_segs: number of segments, the last one is short
+ *
+ * Return: number of errors
+ */
+static uint32_t dp_fisa_tcp_ut_fixup_family(bool is_ipv6, uint16_t num_segs)
+{
+	struct dp_fisa_rx_sw_ft *flow = &dp_fisa_tcp_ut_flow;
+	uint32_t l3_len = dp_fisa_tcp_ut_l3_len(is_ipv6);
+	struct dp_fisa_tcp_ut_params params;
+	struct skb_shared_info *shinfo;
+	struct dp_fisa_tcp_seg seg;
+	qdf_nbuf_t head_skb, nbuf;
+	uint32_t total_len, l4_len, csum_off, i;
+	struct tcphdr *th;
+	uint8_t *l3_hdr;
+	uint32_t head_seq;
+	uint32_t errors = 0;
+	__wsum csum;
+
+	head_skb = qdf_nbuf_alloc(NULL, DP_FISA_TCP_UT_BUF_LEN, 0, 4, false);
+	if (!head_skb)
+		return ut_check(head_skb);
+
+	dp_fisa_tcp_ut_params_init(&params, is_ipv6);
+	dp_fisa_tcp_ut_flow_init(flow, head_skb, &params);
+	head_seq = params.seq;
+	total_len = params.payload_len;
+
+	for (i = 1; i < num_segs; i++) {
+		params.seq += params.payload_len;
+		params.tsval++;
+		if (i == num_segs - 1)
+			params.payload_len = DP_FISA_TCP_UT_MSS / 2;
+
+		nbuf = qdf_nbuf_alloc(NULL, DP_FISA_TCP_UT_BUF_LEN, 0, 4,
+				      false);
+		if (!nbuf) {
+			errors += ut_check(nbuf);
+			goto out;
+		}
+
+		qdf_nbuf_set_pktlen(nbuf, dp_fisa_tcp_ut_build(
+						qdf_nbuf_data(nbuf), &params));
+		if (!dp_fisa_tcp_ut_parse(qdf_nbuf_data(nbuf),
+					  qdf_nbuf_len(nbuf), l3_len, &seg) ||
+		    !dp_rx_fisa_tcp_can_merge(flow, &seg)) {
+			errors += ut_check(false);
+			qdf_nbuf_free(nbuf);
+			goto out;
+		}
+
+		qdf_nbuf_pull_head(nbuf, seg.hdr_len);
+		if (qdf_nbuf_get_ext_list(head_skb)) {
+			qdf_nbuf_set_next(flow->last_skb, nbuf);
+		} else {
+			skb_shinfo(head_skb)->frag_list = nbuf;
+			qdf_nbuf_set_is_frag(nbuf, 1);
+		}
+		head_skb->truesize += nbuf->truesize;
+
+		flow->last_skb = nbuf;
+		flow->frags_cumulative_len += seg.payload_len;
+		flow->tcp_segs++;
+		flow->tcp_next_seq = seg.seq + seg.payload_len;
+		total_len += seg.payload_len;
+	}
+
+	dp_rx_fisa_tcp_fixup_head(flow);
+
+	shinfo = skb_shinfo(head_skb);
+	l3_hdr = qdf_nbuf_data(head_skb) + ETH_HLEN;
+	th = (struct tcphdr *)(l3_hdr + l3_len);
+	l4_len = DP_FISA_TCP_UT_TCP_HLEN + total_len;
+
+	errors += ut_check(qdf_nbuf_len(head_skb) ==
+			   ETH_HLEN + l3_len + l4_len);
+	errors += ut_check(head_skb->data_len ==
+			   total_len - DP_FISA_TCP_UT_MSS);
+	errors += ut_check(shinfo->gso_size == DP_FISA_TCP_UT_MSS);
+	errors += ut_check(shinfo->gso_segs == num_segs);
+	errors += ut_check(head_skb->ip_summed == CHECKSUM_PARTIAL);
+	errors += ut_check(skb_checksum_start_offset(head_skb) ==
+			   ETH_HLEN + l3_len);
+	errors += ut_check(head_skb->csum_offset ==
+			   offsetof(struct tcphdr, check));
+
+	if (is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)l3_hdr;
+
+		errors += ut_check(shinfo->gso_type == SKB_GSO_TCPV6);
+		errors += ut_check(qdf_ntohs(ip6h->payload_len) == l4_len);
+	} else {
+		struct iphdr *iph = (struct iphdr *)l3_hdr;
+
+		errors += ut_check(shinfo->gso_type == SKB_GSO_TCPV4);
+		errors += ut_check(qdf_ntohs(iph->tot_len) ==
+				   sizeof(*iph) + l4_len);
+		errors += ut_check(!ip_fast_csum((u8 *)iph, iph->ihl));
+	}
+
+	/* TSval of the last segment is handed to the stack */
+	errors += ut_check(((__be32 *)(th + 1))[1] == qdf_htonl(params.tsval));
+
+	/* Payload reads back as one in order stream */
+	if (skb_copy_bits(head_skb, ETH_HLEN + l3_len + DP_FISA_TCP_UT_TCP_HLEN,
+			  dp_fisa_tcp_ut_stream, total_len)) {
+		errors += ut_check(false);
+		goto out;
+	}
+	for (i = 0; i < total_len; i++) {
+		if (dp_fisa_tcp_ut_stream[i] != (uint8_t)(head_seq + i)) {
+			errors += ut_check(false);
+			break;
+		}
+	}
+
+	/**
+	 * Complete the partial checksum the way a device would on segmenting
+	 * and verify it against the pseudo header of the aggregate.
+	 */
+	csum_off = skb_checksum_start_offset(head_skb);
+	th->check = csum_fold(skb_checksum(head_skb, csum_off, l4_len, 0));
+	csum = skb_checksum(head_skb, csum_off, l4_len, 0);
+	if (is_ipv6) {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)l3_hdr;
+
+		errors += ut_check(!csum_ipv6_magic(&ip6h->saddr,
+						    &ip6h->daddr, l4_len,
+						    IPPROTO_TCP, csum));
+	} else {
+		struct iphdr *iph = (struct iphdr *)l3_hdr;
+
+		errors += ut_check(!csum_tcpudp_magic(iph->saddr, iph->daddr,
+						      l4_len, IPPROTO_TCP,
+						      csum));
+	}
+
+out:
+	qdf_nbuf_free(head_skb);
+
+	return errors;
+}
+
+uint32_t dp_fisa_rx_tcp_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_fisa_tcp_ut_parse_family(false);
+	errors += dp_fisa_tcp_ut_parse_family(true);
+	errors += dp_fisa_tcp_ut_merge_family(false);
+	errors += dp_fisa_tcp_ut_merge_family(true);
+	errors += dp_fisa_tcp_ut_fixup_family(false, 2);
+	errors += dp_fisa_tcp_ut_fixup_family(true, 2);
+	errors += dp_fisa_tcp_ut_fixup_family(false, FISA_FLOW_MAX_AGGR_COUNT);
+	errors += dp_fisa_tcp_ut_fixup_family(true, FISA_FLOW_MAX_AGGR_COUNT);
+	QDF_BUG(!errors);
+
+	return errors;
+}
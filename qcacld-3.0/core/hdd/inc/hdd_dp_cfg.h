@@ -798,6 +798,131 @@
 		false, \
 		"Control to enable latency critical clients")
 
+#ifdef FEATURE_BUS_BW_GOVERNOR
+/*
+ * <ini>
+ * gBusBwGovEwmaWeight - weight of the newest sample in the bus bandwidth
+ *			  governor packet rate average
+ * @Min: 1
+ * @Max: 100
+ * @Default: 50
+ *
+ * This ini specifies, in percent, how much the packet count of the latest
+ * bus bandwidth compute interval contributes to the smoothed TX and RX
+ * packet rates the governor predicts from. 100 disables smoothing.
+ *
+ * Related: gBusBwGovTrendWeight, gBusBwGovHysteresis, gBusBwGovDownHold
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_EWMA_WEIGHT \
+		CFG_INI_UINT( \
+		"gBusBwGovEwmaWeight", \
+		1, \
+		100, \
+		50, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bw governor EWMA weight")
+
+/*
+ * <ini>
+ * gBusBwGovTrendWeight - weight of the newest slope in the bus bandwidth
+ *			   governor trend estimate
+ * @Min: 0
+ * @Max: 100
+ * @Default: 30
+ *
+ * This ini specifies, in percent, how much the latest change of the smoothed
+ * packet rate contributes to the trend used to project the next interval.
+ * 0 disables ramp prediction.
+ *
+ * Related: gBusBwGovEwmaWeight
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_TREND_WEIGHT \
+		CFG_INI_UINT( \
+		"gBusBwGovTrendWeight", \
+		0, \
+		100, \
+		30, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bw governor trend weight")
+
+/*
+ * <ini>
+ * gBusBwGovHysteresis - bus bandwidth governor step down margin
+ * @Min: 0
+ * @Max: 90
+ * @Default: 20
+ *
+ * This ini specifies, in percent of the threshold of the current throughput
+ * level, how far the predicted packet count has to fall below that threshold
+ * before the governor considers a lower level.
+ *
+ * Related: gBusBwGovDownHold
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_HYSTERESIS \
+		CFG_INI_UINT( \
+		"gBusBwGovHysteresis", \
+		0, \
+		90, \
+		20, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bw governor hysteresis")
+
+/*
+ * <ini>
+ * gBusBwGovDownHold - bus bandwidth governor step down hold time
+ * @Min: 1
+ * @Max: 50
+ * @Default: 3
+ *
+ * This ini specifies the number of consecutive bus bandwidth compute
+ * intervals the prediction has to stay below the step down margin before
+ * the governor lowers the throughput level. The hold time is doubled while
+ * latency critical clients or the low latency bus bw table are active.
+ *
+ * Related: gBusBwGovHysteresis
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_DOWN_HOLD \
+		CFG_INI_UINT( \
+		"gBusBwGovDownHold", \
+		1, \
+		50, \
+		3, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bw governor down hold")
+
+#define CFG_HDD_DP_BUS_BW_GOV \
+	CFG(CFG_DP_BUS_BW_GOV_EWMA_WEIGHT) \
+	CFG(CFG_DP_BUS_BW_GOV_TREND_WEIGHT) \
+	CFG(CFG_DP_BUS_BW_GOV_HYSTERESIS) \
+	CFG(CFG_DP_BUS_BW_GOV_DOWN_HOLD)
+#else
+#define CFG_HDD_DP_BUS_BW_GOV
+#endif /* FEATURE_BUS_BW_GOVERNOR */
+
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
@@ -1540,7 +1665,8 @@
 	CFG(CFG_DP_TCP_DELACK_TIMER_COUNT) \
 	CFG(CFG_DP_TCP_TX_HIGH_TPUT_THRESHOLD) \
 	CFG(CFG_DP_BUS_LOW_BW_CNT_THRESHOLD) \
-	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS)
+	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS) \
+	CFG_HDD_DP_BUS_BW_GOV
 
 #else
 #define CFG_HDD_DP_BUS_BANDWIDTH
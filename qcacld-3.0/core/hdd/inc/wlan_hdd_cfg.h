@@ -178,6 +178,12 @@ struct hdd_config {
 	bool     enable_tcp_param_update;
 	uint32_t bus_low_cnt_threshold;
 	bool enable_latency_crit_clients;
+#ifdef FEATURE_BUS_BW_GOVERNOR
+	uint32_t bus_bw_gov_ewma_weight;
+	uint32_t bus_bw_gov_trend_weight;
+	uint32_t bus_bw_gov_hysteresis;
+	uint32_t bus_bw_gov_down_hold;
+#endif
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef WLAN_FEATURE_MSCS
@@ -428,6 +428,23 @@ void hdd_adapter_set_rps(uint8_t vdev_id, bool enable)
 
 void wlan_hdd_classify_pkt(struct sk_buff *skb);
 
+/**
+ * hdd_tx_pkt_is_tcp() - check if a TX packet is an IPv4/IPv6 TCP packet
+ * @skb: sk buff, classified by wlan_hdd_classify_pkt()
+ *
+ * Uses the classification record in skb->cb when the platform keeps one
+ * and falls back to parsing the headers otherwise.
+ *
+ * Return: true if @skb is a TCP packet
+ */
+static inline bool hdd_tx_pkt_is_tcp(struct sk_buff *skb)
+{
+	if (qdf_nbuf_tx_cls_valid(skb))
+		return qdf_nbuf_tx_cls_is_tcp(skb);
+
+	return qdf_nbuf_is_ipv4_tcp_pkt(skb) || qdf_nbuf_is_ipv6_tcp_pkt(skb);
+}
+
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 void hdd_reset_tcp_delack(struct hdd_context *hdd_ctx);
 
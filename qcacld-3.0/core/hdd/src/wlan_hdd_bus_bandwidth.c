@@ -418,6 +418,236 @@ done:
 	qdf_mutex_release(&bbm_ctx->bbm_lock);
 }
 
+#ifdef FEATURE_BUS_BW_GOVERNOR
+#define BBM_GOV_PERCENT 100
+
+/**
+ * bbm_gov_pkts_to_level() - Map a per interval packet count to a throughput
+ *  level using the fixed bus bw thresholds
+ * @cfg: HDD config
+ * @pkts: packets per bus bw compute interval
+ *
+ * Returns: throughput level
+ */
+static enum tput_level
+bbm_gov_pkts_to_level(struct hdd_config *cfg, uint64_t pkts)
+{
+	if (pkts > cfg->bus_bw_ultra_high_threshold)
+		return TPUT_LEVEL_ULTRA_HIGH;
+	if (pkts > cfg->bus_bw_very_high_threshold)
+		return TPUT_LEVEL_VERY_HIGH;
+	if (pkts > cfg->bus_bw_high_threshold)
+		return TPUT_LEVEL_HIGH;
+	if (pkts > cfg->bus_bw_medium_threshold)
+		return TPUT_LEVEL_MEDIUM;
+	if (pkts > cfg->bus_bw_low_threshold)
+		return TPUT_LEVEL_LOW;
+
+	return TPUT_LEVEL_IDLE;
+}
+
+/**
+ * bbm_gov_level_floor() - Packet count threshold of a throughput level
+ * @cfg: HDD config
+ * @level: throughput level
+ *
+ * Returns: packets per interval above which @level is picked
+ */
+static uint64_t
+bbm_gov_level_floor(struct hdd_config *cfg, enum tput_level level)
+{
+	switch (level) {
+	case TPUT_LEVEL_ULTRA_HIGH:
+		return cfg->bus_bw_ultra_high_threshold;
+	case TPUT_LEVEL_VERY_HIGH:
+		return cfg->bus_bw_very_high_threshold;
+	case TPUT_LEVEL_HIGH:
+		return cfg->bus_bw_high_threshold;
+	case TPUT_LEVEL_MEDIUM:
+		return cfg->bus_bw_medium_threshold;
+	case TPUT_LEVEL_LOW:
+		return cfg->bus_bw_low_threshold;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * bbm_gov_pct() - Scale a signed value by a percentage
+ * @val: value to scale
+ * @pct: percentage
+ *
+ * Returns: @val * @pct / 100
+ */
+static inline int64_t bbm_gov_pct(int64_t val, uint32_t pct)
+{
+	if (val < 0)
+		return -(int64_t)qdf_do_div((uint64_t)(-val) * pct,
+					    BBM_GOV_PERCENT);
+
+	return qdf_do_div((uint64_t)val * pct, BBM_GOV_PERCENT);
+}
+
+/**
+ * bbm_gov_smooth() - Update the smoothed rate and trend with a new sample
+ * @cfg: HDD config
+ * @ewma: smoothed packet rate
+ * @trend: smoothed change of @ewma per interval
+ * @sample: packets in the latest interval
+ *
+ * Returns: packet count predicted for the next interval. Only a rising
+ *  trend is projected, a falling one is left to the step down hysteresis.
+ */
+static uint64_t bbm_gov_smooth(struct hdd_config *cfg, uint64_t *ewma,
+			       int64_t *trend, uint64_t sample)
+{
+	uint32_t alpha = cfg->bus_bw_gov_ewma_weight;
+	uint32_t beta = cfg->bus_bw_gov_trend_weight;
+	uint64_t prev = *ewma;
+
+	*ewma = qdf_do_div(sample * alpha + prev * (BBM_GOV_PERCENT - alpha),
+			   BBM_GOV_PERCENT);
+	*trend = bbm_gov_pct((int64_t)(*ewma - prev), beta) +
+		 bbm_gov_pct(*trend, BBM_GOV_PERCENT - beta);
+
+	return *trend > 0 ? *ewma + *trend : *ewma;
+}
+
+enum tput_level hdd_bbm_governor_update(struct hdd_context *hdd_ctx,
+					uint64_t tx_packets,
+					uint64_t rx_packets,
+					uint64_t diff_us,
+					enum tput_level raw_level,
+					bool latency_critical)
+{
+	struct bbm_context *bbm_ctx = hdd_ctx->bbm_ctx;
+	struct hdd_config *cfg = hdd_ctx->config;
+	struct bbm_governor *gov;
+	enum tput_level next_level, target_level;
+	uint64_t sample, pred, rate, floor;
+	uint32_t hold;
+
+	if (!bbm_ctx)
+		return raw_level;
+
+	gov = &bbm_ctx->gov;
+
+	sample = tx_packets + rx_packets;
+	pred = bbm_gov_smooth(cfg, &gov->ewma_tx, &gov->trend_tx, tx_packets) +
+	       bbm_gov_smooth(cfg, &gov->ewma_rx, &gov->trend_rx, rx_packets);
+
+	/*
+	 * Never step up later, nor down further, than the fixed thresholds
+	 * would: the level picked for the latest sample is a lower bound.
+	 */
+	rate = QDF_MAX(sample, pred);
+	target_level = bbm_gov_pkts_to_level(cfg, rate);
+
+	if (target_level > gov->cur_level) {
+		next_level = target_level;
+		gov->down_cnt = 0;
+	} else {
+		floor = bbm_gov_level_floor(cfg, gov->cur_level);
+		floor -= qdf_do_div(floor * cfg->bus_bw_gov_hysteresis,
+				    BBM_GOV_PERCENT);
+
+		hold = cfg->bus_bw_gov_down_hold;
+		if (latency_critical ||
+		    bbm_ctx->curr_bus_bw_lookup_table ==
+						&bus_bw_table_low_latency)
+			hold *= 2;
+
+		next_level = gov->cur_level;
+		if (gov->cur_level > TPUT_LEVEL_IDLE && rate <= floor) {
+			if (++gov->down_cnt >= hold) {
+				next_level = target_level;
+				gov->down_cnt = 0;
+			}
+		} else {
+			gov->down_cnt = 0;
+		}
+	}
+
+	gov->time_us[gov->cur_level] += diff_us;
+	if (raw_level != gov->raw_level) {
+		gov->raw_changes++;
+		if (raw_level > gov->raw_level)
+			gov->ramps++;
+	}
+	if (next_level < raw_level)
+		gov->lag_intervals++;
+	else if (next_level > raw_level && gov->trend_tx + gov->trend_rx > 0)
+		gov->lead_intervals++;
+	if (next_level != gov->cur_level)
+		gov->vote_changes++;
+
+	gov->raw_level = raw_level;
+	gov->cur_level = next_level;
+
+	return next_level;
+}
+
+void hdd_bbm_governor_reset(struct hdd_context *hdd_ctx)
+{
+	struct bbm_context *bbm_ctx = hdd_ctx->bbm_ctx;
+	struct bbm_governor *gov;
+
+	if (!bbm_ctx)
+		return;
+
+	gov = &bbm_ctx->gov;
+	gov->ewma_tx = 0;
+	gov->ewma_rx = 0;
+	gov->trend_tx = 0;
+	gov->trend_rx = 0;
+	gov->cur_level = TPUT_LEVEL_NONE;
+	gov->raw_level = TPUT_LEVEL_NONE;
+	gov->down_cnt = 0;
+}
+
+void hdd_bbm_governor_display_stats(struct hdd_context *hdd_ctx)
+{
+	struct bbm_context *bbm_ctx = hdd_ctx->bbm_ctx;
+	struct bbm_governor *gov;
+	uint32_t interval_ms = hdd_ctx->config->bus_bw_compute_interval;
+	enum tput_level level;
+
+	if (!bbm_ctx)
+		return;
+
+	gov = &bbm_ctx->gov;
+	hdd_nofl_debug("BW governor: level %d ewma tx %llu rx %llu trend tx %lld rx %lld",
+		       gov->cur_level, gov->ewma_tx, gov->ewma_rx,
+		       gov->trend_tx, gov->trend_rx);
+	hdd_nofl_debug("BW governor: vote changes %u (fixed thresholds %u) ramps %u lag %u lead %u intervals avg ramp latency %u ms",
+		       gov->vote_changes, gov->raw_changes, gov->ramps,
+		       gov->lag_intervals, gov->lead_intervals,
+		       gov->ramps ?
+		       gov->lag_intervals * interval_ms / gov->ramps : 0);
+
+	for (level = TPUT_LEVEL_IDLE; level < TPUT_LEVEL_MAX; level++)
+		hdd_nofl_debug("BW governor: level %d time %llu ms", level,
+			       qdf_do_div(gov->time_us[level], 1000));
+}
+
+void hdd_bbm_governor_clear_stats(struct hdd_context *hdd_ctx)
+{
+	struct bbm_context *bbm_ctx = hdd_ctx->bbm_ctx;
+	struct bbm_governor *gov;
+
+	if (!bbm_ctx)
+		return;
+
+	gov = &bbm_ctx->gov;
+	gov->vote_changes = 0;
+	gov->raw_changes = 0;
+	gov->ramps = 0;
+	gov->lag_intervals = 0;
+	gov->lead_intervals = 0;
+	qdf_mem_zero(gov->time_us, sizeof(gov->time_us));
+}
+#endif /* FEATURE_BUS_BW_GOVERNOR */
+
 int hdd_bbm_context_init(struct hdd_context *hdd_ctx)
 {
 	struct bbm_context *bbm_ctx;
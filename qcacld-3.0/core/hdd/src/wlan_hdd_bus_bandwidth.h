@@ -160,6 +160,43 @@ struct bbm_params {
 typedef const enum bus_bw_level
 	bus_bw_table_type[QCA_WLAN_802_11_MODE_INVALID][TPUT_LEVEL_MAX];
 
+#ifdef FEATURE_BUS_BW_GOVERNOR
+/**
+ * struct bbm_governor - predictive throughput level governor state
+ *
+ * @ewma_tx: smoothed TX packets per bus bw compute interval
+ * @ewma_rx: smoothed RX packets per bus bw compute interval
+ * @trend_tx: smoothed per interval change of @ewma_tx
+ * @trend_rx: smoothed per interval change of @ewma_rx
+ * @cur_level: throughput level currently picked by the governor
+ * @raw_level: level the fixed thresholds picked for the last interval
+ * @down_cnt: consecutive intervals spent below the step down margin
+ * @vote_changes: number of governor level changes
+ * @raw_changes: number of level changes the fixed thresholds would make
+ * @ramps: number of upward fixed threshold level changes
+ * @lag_intervals: intervals in which the governor level was below the
+ *  fixed threshold level
+ * @lead_intervals: intervals in which the governor level was above the
+ *  fixed threshold level while traffic was ramping up
+ * @time_us: time spent at each governor level
+ */
+struct bbm_governor {
+	uint64_t ewma_tx;
+	uint64_t ewma_rx;
+	int64_t trend_tx;
+	int64_t trend_rx;
+	enum tput_level cur_level;
+	enum tput_level raw_level;
+	uint32_t down_cnt;
+	uint32_t vote_changes;
+	uint32_t raw_changes;
+	uint32_t ramps;
+	uint32_t lag_intervals;
+	uint32_t lead_intervals;
+	uint64_t time_us[TPUT_LEVEL_MAX];
+};
+#endif
+
 /**
  * struct bbm_context: Bus Bandwidth Manager context
  *
@@ -167,12 +204,16 @@ typedef const enum bus_bw_level
  * @curr_vote_level: current vote level
  * @per_policy_vote: per BBM policy related vote
  * @bbm_lock: BBM API lock
+ * @gov: throughput level governor, only used from the bus bw work
  */
 struct bbm_context {
 	bus_bw_table_type *curr_bus_bw_lookup_table;
 	enum bus_bw_level curr_vote_level;
 	enum bus_bw_level per_policy_vote[BBM_MAX_POLICY];
 	qdf_mutex_t bbm_lock;
+#ifdef FEATURE_BUS_BW_GOVERNOR
+	struct bbm_governor gov;
+#endif
 };
 
 #ifdef FEATURE_BUS_BANDWIDTH_MGR
@@ -221,4 +262,83 @@ void hdd_bbm_apply_independent_policy(struct hdd_context *hdd_ctx,
 {
 }
 #endif
+
+#if defined(FEATURE_BUS_BANDWIDTH_MGR) && defined(FEATURE_BUS_BW_GOVERNOR)
+/**
+ * hdd_bbm_governor_update() - Feed one bus bw compute interval to the
+ *  throughput level governor
+ * @hdd_ctx: HDD context
+ * @tx_packets: TX packets in the interval, already normalised to one
+ *  bus bw compute interval by the bus bw work
+ * @rx_packets: RX packets in the interval, normalised as @tx_packets
+ * @diff_us: length of the interval, used for the time at level stats
+ * @raw_level: level picked by the fixed packet count thresholds
+ * @latency_critical: latency critical clients are active
+ *
+ * The governor smooths the TX and RX packet rates, projects them one
+ * interval ahead to catch ramps early and only steps the level down after
+ * both the prediction and the latest sample have stayed below the current
+ * level by a margin for a number of intervals. The returned level is never
+ * below the one the fixed thresholds pick for the latest sample.
+ *
+ * Returns: throughput level to vote for
+ */
+enum tput_level hdd_bbm_governor_update(struct hdd_context *hdd_ctx,
+					uint64_t tx_packets,
+					uint64_t rx_packets,
+					uint64_t diff_us,
+					enum tput_level raw_level,
+					bool latency_critical);
+
+/**
+ * hdd_bbm_governor_reset() - Reset the throughput level governor state
+ * @hdd_ctx: HDD context
+ *
+ * Drops the smoothed packet rates, trends and the current level, so that
+ * the governor does not resume from stale history when the bus bw work is
+ * restarted. The governor stats are left untouched.
+ *
+ * Returns: None
+ */
+void hdd_bbm_governor_reset(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_bbm_governor_display_stats() - Print throughput level governor stats
+ * @hdd_ctx: HDD context
+ *
+ * Returns: None
+ */
+void hdd_bbm_governor_display_stats(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_bbm_governor_clear_stats() - Clear throughput level governor stats
+ * @hdd_ctx: HDD context
+ *
+ * Returns: None
+ */
+void hdd_bbm_governor_clear_stats(struct hdd_context *hdd_ctx);
+#else
+static inline
+enum tput_level hdd_bbm_governor_update(struct hdd_context *hdd_ctx,
+					uint64_t tx_packets,
+					uint64_t rx_packets,
+					uint64_t diff_us,
+					enum tput_level raw_level,
+					bool latency_critical)
+{
+	return raw_level;
+}
+
+static inline void hdd_bbm_governor_reset(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_bbm_governor_display_stats(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_bbm_governor_clear_stats(struct hdd_context *hdd_ctx)
+{
+}
+#endif
 #endif
@@ -10608,6 +10608,32 @@ bool hdd_bus_bandwidth_work_tune_tx(struct hdd_context *hdd_ctx,
 	return tx_level_change;
 }
 
+/**
+ * hdd_tput_level_to_bus_width() - Map a throughput level to a bus vote
+ * @tput_level: throughput level
+ *
+ * Returns: PLD bus width vote for @tput_level
+ */
+static enum pld_bus_width_type
+hdd_tput_level_to_bus_width(enum tput_level tput_level)
+{
+	switch (tput_level) {
+	case TPUT_LEVEL_LOW:
+		return PLD_BUS_WIDTH_LOW;
+	case TPUT_LEVEL_MEDIUM:
+		return PLD_BUS_WIDTH_MEDIUM;
+	case TPUT_LEVEL_HIGH:
+		return PLD_BUS_WIDTH_HIGH;
+	case TPUT_LEVEL_VERY_HIGH:
+		return PLD_BUS_WIDTH_VERY_HIGH;
+	case TPUT_LEVEL_ULTRA_HIGH:
+	case TPUT_LEVEL_SUPER_HIGH:
+		return PLD_BUS_WIDTH_ULTRA_HIGH;
+	default:
+		return PLD_BUS_WIDTH_IDLE;
+	}
+}
+
 /**
  * hdd_pld_request_bus_bandwidth() - Function to control bus bandwidth
  * @hdd_ctx: handle to hdd context
@@ -10647,10 +10673,10 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 	if (!soc)
 		return;
 
-	if (hdd_ctx->high_bus_bw_request) {
-		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
-		tput_level = TPUT_LEVEL_VERY_HIGH;
-	} else if (total_pkts > hdd_ctx->config->bus_bw_ultra_high_threshold) {
+	if (qdf_atomic_read(&hdd_ctx->num_latency_critical_clients))
+		legacy_client = true;
+
+	if (total_pkts > hdd_ctx->config->bus_bw_ultra_high_threshold) {
 		next_vote_level = PLD_BUS_WIDTH_ULTRA_HIGH;
 		tput_level = TPUT_LEVEL_ULTRA_HIGH;
 	} else if (total_pkts > hdd_ctx->config->bus_bw_very_high_threshold) {
@@ -10670,6 +10696,16 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 		tput_level = TPUT_LEVEL_IDLE;
 	}
 
+	tput_level = hdd_bbm_governor_update(hdd_ctx, tx_packets, rx_packets,
+					     diff_us, tput_level,
+					     legacy_client);
+	next_vote_level = hdd_tput_level_to_bus_width(tput_level);
+
+	if (hdd_ctx->high_bus_bw_request) {
+		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
+		tput_level = TPUT_LEVEL_VERY_HIGH;
+	}
+
 	/*
 	 * DBS mode requires more DDR/SNOC resources, vote to ultra high
 	 * only when TPUT can reach VHT80 KPI and IPA is disabled,
@@ -10691,9 +10727,6 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 	dptrace_high_tput_req =
 			next_vote_level > PLD_BUS_WIDTH_IDLE ? true : false;
 
-	if (qdf_atomic_read(&hdd_ctx->num_latency_critical_clients))
-		legacy_client = true;
-
 	hdd_low_tput_gro_flush_skip_handler(hdd_ctx, next_vote_level,
 					    legacy_client);
 
@@ -11433,6 +11466,7 @@ void wlan_hdd_display_tx_rx_histogram(struct hdd_context *hdd_ctx)
 		       hdd_ctx->config->tcp_delack_thres_low);
 	hdd_nofl_debug("TCP TX HIGH TP TH: %d (Use to set tcp_output_bytes_limit)",
 		       hdd_ctx->config->tcp_tx_high_tput_thres);
+	hdd_bbm_governor_display_stats(hdd_ctx);
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 	hdd_nofl_debug("Total entries: %d Current index: %d",
@@ -11473,6 +11507,7 @@ void wlan_hdd_clear_tx_rx_histogram(struct hdd_context *hdd_ctx)
 		qdf_mem_zero(hdd_ctx->hdd_txrx_hist,
 			     (sizeof(struct hdd_tx_rx_histogram) *
 			     NUM_TX_RX_HISTOGRAM));
+	hdd_bbm_governor_clear_stats(hdd_ctx);
 }
 
 /* length of the netif queue log needed per adapter */
@@ -16685,6 +16720,13 @@ static void __hdd_bus_bw_compute_timer_stop(struct hdd_context *hdd_ctx)
 	hdd_ctx->bw_vote_time = 0;
 
 exit:
+	/*
+	 * The bus bw work is not running here. Drop the governor history so
+	 * that the idle vote below is not held back by the step down hold and
+	 * the next start does not resume from stale rates.
+	 */
+	hdd_bbm_governor_reset(hdd_ctx);
+
 	/**
 	 * This check if for the case where the bus bw timer is forcibly
 	 * stopped. We should remove the bus bw voting, if no adapter is
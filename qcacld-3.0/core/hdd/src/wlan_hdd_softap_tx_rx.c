@@ -195,8 +195,7 @@ static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
 			need_orphan = 1;
 #endif
 	} else if (hdd_ctx->config->tx_orphan_enable) {
-		if (qdf_nbuf_is_ipv4_tcp_pkt(skb) ||
-		    qdf_nbuf_is_ipv6_tcp_pkt(skb))
+		if (hdd_tx_pkt_is_tcp(skb))
 			need_orphan = 1;
 	}
 
@@ -40,6 +40,8 @@ __hdd_sysfs_dp_trace_store(struct hdd_context *hdd_ctx,
 	char *sptr, *token;
 	uint32_t val1;
 	uint8_t val2, val3;
+	uint8_t proto_type;
+	uint16_t sample_rate;
 	int ret;
 
 	if (!wlan_hdd_validate_modules_state(hdd_ctx))
@@ -80,6 +82,22 @@ __hdd_sysfs_dp_trace_store(struct hdd_context *hdd_ctx,
 
 	qdf_dp_trace_set_value(val1, val2, val3);
 
+	/* Optional per protocol sampling */
+	token = strsep(&sptr, " ");
+	if (!token)
+		return count;
+	if (kstrtou8(token, 0, &proto_type) ||
+	    proto_type >= QDF_PROTO_TYPE_MAX)
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token)
+		return -EINVAL;
+	if (kstrtou16(token, 0, &sample_rate))
+		return -EINVAL;
+
+	qdf_dp_set_proto_sample_rate(proto_type, sample_rate);
+
 	return count;
 }
 
@@ -42,12 +42,15 @@
  *            /sys/kernel/wifi/clear_dp_trace
  *
  * usage:
- *      echo [arg_0] [arg_1] [arg_2]> dp_trace
+ *      echo [arg_0] [arg_1] [arg_2] [proto_type] [sample_rate]> dp_trace
  *      echo [0/1] > dump_dp_trace
  *      echo 2 [count] > dump_dp_trace
  *      cat dump_dp_trace
  *      echo 1 > clear_dp_trace
  *
+ * The optional [proto_type] [sample_rate] pair records only one in
+ * sample_rate DP trace records of enum qdf_proto_type proto_type.
+ *
  * Return: 0 on success and errno on failure
  */
 int hdd_sysfs_dp_trace_create(struct kobject *driver_kobject);
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_sysfs_pkt_capture.c
+ *
+ * implementation for creating sysfs files pkt_capture_match and
+ * pkt_capture_stats
+ */
+
+#include <wlan_hdd_includes.h>
+#include "osif_vdev_sync.h"
+#include "wlan_hdd_object_manager.h"
+#include "wlan_hdd_sysfs.h"
+#include "wlan_hdd_sysfs_pkt_capture.h"
+#include "wlan_pkt_capture_ucfg_api.h"
+
+/* "flags tid ether_type port peer_mac", with all numbers in hex */
+#define MAX_USER_COMMAND_SIZE_PKT_CAPTURE_MATCH 64
+
+static ssize_t
+__hdd_sysfs_pkt_capture_match_store(struct net_device *net_dev,
+				    char const *buf, size_t count)
+{
+	struct hdd_adapter *adapter = netdev_priv(net_dev);
+	char buf_local[MAX_USER_COMMAND_SIZE_PKT_CAPTURE_MATCH + 1];
+	struct pkt_capture_data_match match = {0};
+	struct wlan_objmgr_vdev *vdev;
+	struct hdd_context *hdd_ctx;
+	char *sptr, *token;
+	QDF_STATUS status;
+	int ret;
+
+	if (hdd_validate_adapter(adapter))
+		return -EINVAL;
+
+	hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret != 0)
+		return ret;
+
+	if (!wlan_hdd_validate_modules_state(hdd_ctx))
+		return -EINVAL;
+
+	if (ucfg_pkt_capture_get_mode(hdd_ctx->psoc) ==
+	    PACKET_CAPTURE_MODE_DISABLE) {
+		hdd_err_rl("packet capture mode is disabled");
+		return -EINVAL;
+	}
+
+	ret = hdd_sysfs_validate_and_copy_buf(buf_local, sizeof(buf_local),
+					      buf, count);
+	if (ret) {
+		hdd_err_rl("invalid input");
+		return ret;
+	}
+
+	sptr = buf_local;
+	hdd_debug("pkt_capture_match: count %zu buf_local:(%s) net_devname %s",
+		  count, buf_local, net_dev->name);
+
+	/* Get flags */
+	token = strsep(&sptr, " ");
+	if (!token)
+		return -EINVAL;
+	if (kstrtou8(token, 0, &match.flags))
+		return -EINVAL;
+
+	/* Only flags 0 clearing the match can go without the other fields */
+	if (match.flags) {
+		token = strsep(&sptr, " ");
+		if (!token || kstrtou8(token, 0, &match.tid))
+			return -EINVAL;
+
+		token = strsep(&sptr, " ");
+		if (!token || kstrtou16(token, 0, &match.ether_type))
+			return -EINVAL;
+
+		token = strsep(&sptr, " ");
+		if (!token || kstrtou16(token, 0, &match.port))
+			return -EINVAL;
+	}
+
+	if (match.flags & PKT_CAPTURE_DATA_MATCH_PEER) {
+		token = strsep(&sptr, " ");
+		if (!token ||
+		    QDF_IS_STATUS_ERROR(qdf_mac_parse(token, &match.peer_mac)))
+			return -EINVAL;
+	}
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter, WLAN_PKT_CAPTURE_ID);
+	if (!vdev)
+		return -EINVAL;
+
+	status = ucfg_pkt_capture_set_data_match(vdev, &match);
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_PKT_CAPTURE_ID);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		hdd_err_rl("failed to set data match: %d", status);
+		return qdf_status_to_os_return(status);
+	}
+
+	return count;
+}
+
+static ssize_t
+hdd_sysfs_pkt_capture_match_store(struct device *dev,
+				  struct device_attribute *attr,
+				  char const *buf, size_t count)
+{
+	struct net_device *net_dev = container_of(dev, struct net_device, dev);
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t errno_size;
+
+	errno_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = __hdd_sysfs_pkt_capture_match_store(net_dev, buf, count);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return errno_size;
+}
+
+static ssize_t
+__hdd_sysfs_pkt_capture_stats_show(struct net_device *net_dev, char *buf)
+{
+	struct hdd_adapter *adapter = netdev_priv(net_dev);
+	struct pkt_capture_mon_stats stats;
+	struct wlan_objmgr_vdev *vdev;
+	struct hdd_context *hdd_ctx;
+	QDF_STATUS status;
+	int ret;
+
+	if (hdd_validate_adapter(adapter))
+		return -EINVAL;
+
+	hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret)
+		return ret;
+
+	if (!wlan_hdd_validate_modules_state(hdd_ctx))
+		return -EINVAL;
+
+	if (ucfg_pkt_capture_get_mode(hdd_ctx->psoc) ==
+	    PACKET_CAPTURE_MODE_DISABLE)
+		return -EINVAL;
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter, WLAN_PKT_CAPTURE_ID);
+	if (!vdev)
+		return -EINVAL;
+
+	status = ucfg_pkt_capture_get_mon_stats(vdev, &stats);
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_PKT_CAPTURE_ID);
+	if (QDF_IS_STATUS_ERROR(status))
+		return qdf_status_to_os_return(status);
+
+	return scnprintf(buf, PAGE_SIZE,
+			 "queue_depth %u\nqueue_depth_max %u\nfreeq_empty %u\nflushed %u\nfiltered %u\nsnapped %u\n",
+			 stats.queue_depth, stats.queue_depth_max,
+			 stats.freeq_empty, stats.flushed, stats.filtered,
+			 stats.snapped);
+}
+
+static ssize_t
+hdd_sysfs_pkt_capture_stats_show(struct device *dev,
+				 struct device_attribute *attr,
+				 char *buf)
+{
+	struct net_device *net_dev = container_of(dev, struct net_device, dev);
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t err_size;
+
+	err_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (err_size)
+		return err_size;
+
+	err_size = __hdd_sysfs_pkt_capture_stats_show(net_dev, buf);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return err_size;
+}
+
+static DEVICE_ATTR(pkt_capture_match, 0220,
+		   NULL, hdd_sysfs_pkt_capture_match_store);
+
+static DEVICE_ATTR(pkt_capture_stats, 0440,
+		   hdd_sysfs_pkt_capture_stats_show, NULL);
+
+void hdd_sysfs_pkt_capture_create(struct hdd_adapter *adapter)
+{
+	int error;
+
+	error = device_create_file(&adapter->dev->dev,
+				   &dev_attr_pkt_capture_match);
+	if (error)
+		hdd_err("could not create pkt_capture_match sysfs file");
+
+	error = device_create_file(&adapter->dev->dev,
+				   &dev_attr_pkt_capture_stats);
+	if (error)
+		hdd_err("could not create pkt_capture_stats sysfs file");
+}
+
+void hdd_sysfs_pkt_capture_destroy(struct hdd_adapter *adapter)
+{
+	device_remove_file(&adapter->dev->dev, &dev_attr_pkt_capture_stats);
+	device_remove_file(&adapter->dev->dev, &dev_attr_pkt_capture_match);
+}
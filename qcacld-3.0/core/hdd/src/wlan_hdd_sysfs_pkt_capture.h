@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_sysfs_pkt_capture.h
+ *
+ * implementation for creating sysfs files pkt_capture_match and
+ * pkt_capture_stats
+ */
+
+#ifndef _WLAN_HDD_SYSFS_PKT_CAPTURE_H
+#define _WLAN_HDD_SYSFS_PKT_CAPTURE_H
+
+#if defined(WLAN_SYSFS) && defined(WLAN_FEATURE_PKT_CAPTURE)
+/**
+ * hdd_sysfs_pkt_capture_create() - API to create packet capture sysfs
+ *  attributes
+ * @adapter: hdd adapter
+ *
+ * This API creates the following sysfs attributes:
+ * 1. pkt_capture_match
+ * 2. pkt_capture_stats
+ *
+ * pkt_capture_match: this file is created per adapter. It sets the match
+ * data frames have to pass before they are copied for the monitor
+ * interface, flags 0 clears it.
+ * file path: /sys/class/net/wlanxx/pkt_capture_match
+ *                (wlanxx is adapter name)
+ * usage:
+ *      echo [flags] [tid] [ether_type] [port] [peer_mac] > pkt_capture_match
+ *      flags: BIT(0) peer_mac, BIT(1) tid, BIT(2) ether_type, BIT(3) port
+ *      peer_mac is only given when BIT(0) is set
+ *
+ * pkt_capture_stats: this file is created per adapter.
+ * file path: /sys/class/net/wlanxx/pkt_capture_stats
+ *                (wlanxx is adapter name)
+ * usage:
+ *      cat pkt_capture_stats
+ *
+ * Return: None
+ */
+void hdd_sysfs_pkt_capture_create(struct hdd_adapter *adapter);
+
+/**
+ * hdd_sysfs_pkt_capture_destroy() -
+ *   API to destroy packet capture sysfs attributes
+ * @adapter: pointer to adapter
+ *
+ * Return: none
+ */
+void hdd_sysfs_pkt_capture_destroy(struct hdd_adapter *adapter);
+#else
+static inline void
+hdd_sysfs_pkt_capture_create(struct hdd_adapter *adapter)
+{
+}
+
+static inline void
+hdd_sysfs_pkt_capture_destroy(struct hdd_adapter *adapter)
+{
+}
+#endif
+#endif /* #ifndef _WLAN_HDD_SYSFS_PKT_CAPTURE_H */
@@ -314,8 +314,7 @@ static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
 			need_orphan = 1;
 #endif
 	} else if (hdd_ctx->config->tx_orphan_enable) {
-		if (qdf_nbuf_is_ipv4_tcp_pkt(skb) ||
-		    qdf_nbuf_is_ipv6_tcp_pkt(skb))
+		if (hdd_tx_pkt_is_tcp(skb))
 			need_orphan = 1;
 	}
 
@@ -556,34 +555,7 @@ int hdd_set_udp_qos_upgrade_config(struct hdd_adapter *adapter,
  */
 void wlan_hdd_classify_pkt(struct sk_buff *skb)
 {
-	struct ethhdr *eh = (struct ethhdr *)skb->data;
-
-	qdf_mem_zero(skb->cb, sizeof(skb->cb));
-
-	/* check destination mac address is broadcast/multicast */
-	if (is_broadcast_ether_addr((uint8_t *)eh))
-		QDF_NBUF_CB_GET_IS_BCAST(skb) = true;
-	else if (is_multicast_ether_addr((uint8_t *)eh))
-		QDF_NBUF_CB_GET_IS_MCAST(skb) = true;
-
-	if (qdf_nbuf_is_ipv4_arp_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_ARP;
-	else if (qdf_nbuf_is_ipv4_dhcp_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_DHCP;
-	else if (qdf_nbuf_is_ipv4_eapol_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_EAPOL;
-	else if (qdf_nbuf_is_ipv4_wapi_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_WAPI;
-	else if (qdf_nbuf_is_icmp_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_ICMP;
-	else if (qdf_nbuf_is_icmpv6_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_ICMPv6;
+	qdf_nbuf_tx_classify(skb);
 }
 
 /**
@@ -695,6 +667,51 @@ static bool hdd_tx_rx_is_dns_domain_name_match(struct sk_buff *skb,
 		return false;
 }
 
+/**
+ * hdd_tx_pkt_is_icmp() - check if a TX packet is an IPv4 ICMP packet
+ * @skb: sk buff, classified by wlan_hdd_classify_pkt()
+ *
+ * Return: true if @skb is an ICMP packet
+ */
+static bool hdd_tx_pkt_is_icmp(struct sk_buff *skb)
+{
+	if (qdf_nbuf_tx_cls_valid(skb))
+		return QDF_NBUF_CB_GET_PACKET_TYPE(skb) ==
+			QDF_NBUF_CB_PACKET_TYPE_ICMP;
+
+	return qdf_nbuf_is_icmp_pkt(skb);
+}
+
+/**
+ * hdd_tx_pkt_is_ipv4_tcp() - check if a TX packet is an IPv4 TCP packet
+ * @skb: sk buff, classified by wlan_hdd_classify_pkt()
+ *
+ * Return: true if @skb is an IPv4 TCP packet
+ */
+static bool hdd_tx_pkt_is_ipv4_tcp(struct sk_buff *skb)
+{
+	if (qdf_nbuf_tx_cls_valid(skb))
+		return qdf_nbuf_tx_cls_is_ipv4(skb) &&
+			qdf_nbuf_tx_cls_is_tcp(skb);
+
+	return qdf_nbuf_is_ipv4_tcp_pkt(skb);
+}
+
+/**
+ * hdd_tx_pkt_is_ipv4_udp() - check if a TX packet is an IPv4 UDP packet
+ * @skb: sk buff, classified by wlan_hdd_classify_pkt()
+ *
+ * Return: true if @skb is an IPv4 UDP packet
+ */
+static bool hdd_tx_pkt_is_ipv4_udp(struct sk_buff *skb)
+{
+	if (qdf_nbuf_tx_cls_valid(skb))
+		return qdf_nbuf_tx_cls_is_ipv4(skb) &&
+			qdf_nbuf_tx_cls_is_udp(skb);
+
+	return qdf_nbuf_is_ipv4_udp_pkt(skb);
+}
+
 void hdd_tx_rx_collect_connectivity_stats_info(struct sk_buff *skb,
 			void *context,
 			enum connectivity_stats_pkt_status action,
@@ -721,7 +738,7 @@ void hdd_tx_rx_collect_connectivity_stats_info(struct sk_buff *skb,
 	switch (action) {
 	case PKT_TYPE_REQ:
 	case PKT_TYPE_TX_HOST_FW_SENT:
-		if (qdf_nbuf_is_icmp_pkt(skb)) {
+		if (hdd_tx_pkt_is_icmp(skb)) {
 			if (qdf_nbuf_data_is_icmpv4_req(skb) &&
 			    (adapter->track_dest_ipv4 ==
 					qdf_nbuf_get_icmpv4_tgt_ip(skb))) {
@@ -738,7 +755,7 @@ void hdd_tx_rx_collect_connectivity_stats_info(struct sk_buff *skb,
 					++adapter->hdd_stats.hdd_icmpv4_stats.
 								tx_host_fw_sent;
 			}
-		} else if (qdf_nbuf_is_ipv4_tcp_pkt(skb)) {
+		} else if (hdd_tx_pkt_is_ipv4_tcp(skb)) {
 			if (qdf_nbuf_data_is_tcp_syn(skb) &&
 			    (adapter->track_dest_port ==
 					qdf_nbuf_data_get_tcp_dst_port(skb))) {
@@ -784,7 +801,7 @@ void hdd_tx_rx_collect_connectivity_stats_info(struct sk_buff *skb,
 							is_tcp_ack_sent = false;
 				}
 			}
-		} else if (qdf_nbuf_is_ipv4_udp_pkt(skb)) {
+		} else if (hdd_tx_pkt_is_ipv4_udp(skb)) {
 			if (qdf_nbuf_data_is_dns_query(skb) &&
 			    hdd_tx_rx_is_dns_domain_name_match(skb, adapter)) {
 				*pkt_type = CONNECTIVITY_CHECK_SET_DNS;
@@ -1041,9 +1058,12 @@ static void hdd_mark_icmp_req_to_fw(struct hdd_context *hdd_ctx,
 	if (!hdd_ctx->config->icmp_req_to_fw_mark_interval)
 		return;
 
-	if ((qdf_nbuf_get_icmp_subtype(skb) != QDF_PROTO_ICMP_REQ) &&
-	    (qdf_nbuf_get_icmpv6_subtype(skb) != QDF_PROTO_ICMPV6_REQ))
+	if (QDF_NBUF_CB_GET_PACKET_TYPE(skb) == QDF_NBUF_CB_PACKET_TYPE_ICMP) {
+		if (qdf_nbuf_get_icmp_subtype(skb) != QDF_PROTO_ICMP_REQ)
+			return;
+	} else if (qdf_nbuf_get_icmpv6_subtype(skb) != QDF_PROTO_ICMPV6_REQ) {
 		return;
+	}
 
 	/* Mark all ICMP request to be sent to FW */
 	if (time_interval_ms == WLAN_CFG_ICMP_REQ_TO_FW_MARK_ALL)
@@ -3700,6 +3720,33 @@ static inline void hdd_ini_mscs_params(struct hdd_config *config,
 #endif
 
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
+#ifdef FEATURE_BUS_BW_GOVERNOR
+/**
+ * hdd_ini_bus_bw_governor() - Initialize INIs of the bus bandwidth governor
+ * @config: pointer to hdd config
+ * @psoc: pointer to psoc obj
+ *
+ * Return: none
+ */
+static void hdd_ini_bus_bw_governor(struct hdd_config *config,
+				    struct wlan_objmgr_psoc *psoc)
+{
+	config->bus_bw_gov_ewma_weight =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_EWMA_WEIGHT);
+	config->bus_bw_gov_trend_weight =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_TREND_WEIGHT);
+	config->bus_bw_gov_hysteresis =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_HYSTERESIS);
+	config->bus_bw_gov_down_hold =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_DOWN_HOLD);
+}
+#else
+static inline void hdd_ini_bus_bw_governor(struct hdd_config *config,
+					   struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
 /**
  * hdd_ini_tx_flow_control() - Initialize INIs concerned about bus bandwidth
  * @config: pointer to hdd config
@@ -3728,6 +3775,7 @@ static void hdd_ini_bus_bandwidth(struct hdd_config *config,
 		cfg_get(psoc, CFG_DP_BUS_LOW_BW_CNT_THRESHOLD);
 	config->enable_latency_crit_clients =
 		cfg_get(psoc, CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS);
+	hdd_ini_bus_bw_governor(config, psoc);
 }
 
 /**
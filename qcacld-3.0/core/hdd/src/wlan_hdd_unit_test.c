@@ -23,8 +23,16 @@
  * debugfs unit_test_host
  */
 #include "wlan_hdd_main.h"
+#include "dfs_bindetects_test.h"
+#include "dp_fisa_rx_tcp_test.h"
+#include "dp_ring_perf_test.h"
+#include "dp_rx_defrag_test.h"
+#include "dp_tx_aqm_test.h"
+#include "htt_rx_hash_test.h"
+#include "ol_tx_sched_test.h"
 #include "qdf_delayed_work_test.h"
 #include "qdf_hashtable_test.h"
+#include "qdf_nbuf_test.h"
 #include "qdf_periodic_work_test.h"
 #include "qdf_ptr_hash_test.h"
 #include "qdf_slist_test.h"
@@ -33,8 +41,11 @@
 #include "qdf_trace.h"
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
+#include "target_if_spectral_test.h"
 #include "wlan_dsc_test.h"
+#include "wlan_hdd_bus_bandwidth_test.h"
 #include "wlan_hdd_unit_test.h"
+#include "wlan_pkt_capture_test.h"
 
 typedef uint32_t (*hdd_ut_callback)(void);
 
@@ -44,9 +55,19 @@ struct hdd_ut_entry {
 };
 
 struct hdd_ut_entry hdd_ut_entries[] = {
+	{ .name = "dfs_bindetects", .callback = dfs_bindetects_unit_test },
+	{ .name = "dp_fisa_rx_tcp", .callback = dp_fisa_rx_tcp_unit_test },
+	{ .name = "dp_ring_perf", .callback = dp_ring_perf_unit_test },
+	{ .name = "dp_rx_defrag", .callback = dp_rx_defrag_unit_test },
+	{ .name = "dp_tx_aqm", .callback = dp_tx_aqm_unit_test },
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "hdd_bbm_governor", .callback = hdd_bbm_governor_unit_test },
+	{ .name = "htt_rx_hash", .callback = htt_rx_hash_unit_test },
+	{ .name = "ol_tx_sched", .callback = ol_tx_sched_unit_test },
+	{ .name = "pkt_capture", .callback = pkt_capture_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
+	{ .name = "qdf_nbuf", .callback = qdf_nbuf_unit_test },
 	{ .name = "qdf_periodic_work",
 	  .callback = qdf_periodic_work_unit_test },
 	{ .name = "qdf_ptr_hash", .callback = qdf_ptr_hash_unit_test },
@@ -54,6 +75,8 @@ struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "target_if_spectral",
+	  .callback = target_if_spectral_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
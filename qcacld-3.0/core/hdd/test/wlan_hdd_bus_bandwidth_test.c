@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+#include "wlan_hdd_bus_bandwidth.h"
+#include "wlan_hdd_bus_bandwidth_test.h"
+#include "wlan_hdd_main.h"
+
+#define BBM_GOV_UT_MAX_INTERVALS 4096
+#define BBM_GOV_UT_INTERVAL_US 100000
+
+/* Default bus bw thresholds and governor ini values */
+#define BBM_GOV_UT_ULTRA_HIGH 12000
+#define BBM_GOV_UT_VERY_HIGH 9000
+#define BBM_GOV_UT_HIGH 2000
+#define BBM_GOV_UT_MEDIUM 500
+#define BBM_GOV_UT_LOW 150
+#define BBM_GOV_UT_EWMA_WEIGHT 50
+#define BBM_GOV_UT_TREND_WEIGHT 30
+#define BBM_GOV_UT_HYSTERESIS 20
+#define BBM_GOV_UT_DOWN_HOLD 3
+
+#define ut_check(cond) __ut_check(!!(cond), #cond, __func__, __LINE__)
+
+/**
+ * struct bbm_gov_ut_trace - Per interval packet counts replayed through the
+ *  governor, as sampled by the bus bw work
+ * @tx: TX packets of each interval
+ * @rx: RX packets of each interval
+ * @len: number of intervals
+ */
+struct bbm_gov_ut_trace {
+	uint64_t tx[BBM_GOV_UT_MAX_INTERVALS];
+	uint64_t rx[BBM_GOV_UT_MAX_INTERVALS];
+	uint32_t len;
+};
+
+static struct bbm_gov_ut_trace bbm_gov_ut_trace;
+
+static uint32_t
+__ut_check(bool pass, const char *expr, const char *func, uint32_t line)
+{
+	if (pass)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s:%u %s", func, line, expr);
+
+	return 1;
+}
+
+static uint32_t bbm_gov_ut_rand(uint64_t *seed, uint32_t range)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (*seed >> 33) % range;
+}
+
+/**
+ * bbm_gov_ut_raw_level() - Level picked by the fixed thresholds
+ * @cfg: HDD config
+ * @pkts: packets in the interval
+ *
+ * Mirrors hdd_pld_request_bus_bandwidth(), independently of the governor.
+ *
+ * Return: throughput level
+ */
+static enum tput_level
+bbm_gov_ut_raw_level(struct hdd_config *cfg, uint64_t pkts)
+{
+	if (pkts > cfg->bus_bw_ultra_high_threshold)
+		return TPUT_LEVEL_ULTRA_HIGH;
+	if (pkts > cfg->bus_bw_very_high_threshold)
+		return TPUT_LEVEL_VERY_HIGH;
+	if (pkts > cfg->bus_bw_high_threshold)
+		return TPUT_LEVEL_HIGH;
+	if (pkts > cfg->bus_bw_medium_threshold)
+		return TPUT_LEVEL_MEDIUM;
+	if (pkts > cfg->bus_bw_low_threshold)
+		return TPUT_LEVEL_LOW;
+
+	return TPUT_LEVEL_IDLE;
+}
+
+static struct hdd_context *bbm_gov_ut_create(void)
+{
+	struct hdd_context *hdd_ctx;
+	struct hdd_config *cfg;
+
+	hdd_ctx = qdf_mem_malloc(sizeof(*hdd_ctx));
+	if (!hdd_ctx)
+		return NULL;
+
+	cfg = qdf_mem_malloc(sizeof(*cfg));
+	hdd_ctx->bbm_ctx = qdf_mem_malloc(sizeof(*hdd_ctx->bbm_ctx));
+	if (!cfg || !hdd_ctx->bbm_ctx) {
+		qdf_mem_free(cfg);
+		qdf_mem_free(hdd_ctx->bbm_ctx);
+		qdf_mem_free(hdd_ctx);
+		return NULL;
+	}
+
+	cfg->bus_bw_ultra_high_threshold = BBM_GOV_UT_ULTRA_HIGH;
+	cfg->bus_bw_very_high_threshold = BBM_GOV_UT_VERY_HIGH;
+	cfg->bus_bw_high_threshold = BBM_GOV_UT_HIGH;
+	cfg->bus_bw_medium_threshold = BBM_GOV_UT_MEDIUM;
+	cfg->bus_bw_low_threshold = BBM_GOV_UT_LOW;
+	cfg->bus_bw_gov_ewma_weight = BBM_GOV_UT_EWMA_WEIGHT;
+	cfg->bus_bw_gov_trend_weight = BBM_GOV_UT_TREND_WEIGHT;
+	cfg->bus_bw_gov_hysteresis = BBM_GOV_UT_HYSTERESIS;
+	cfg->bus_bw_gov_down_hold = BBM_GOV_UT_DOWN_HOLD;
+	hdd_ctx->config = cfg;
+
+	return hdd_ctx;
+}
+
+static void bbm_gov_ut_destroy(struct hdd_context *hdd_ctx)
+{
+	qdf_mem_free(hdd_ctx->bbm_ctx);
+	qdf_mem_free(hdd_ctx->config);
+	qdf_mem_free(hdd_ctx);
+}
+
+/**
+ * bbm_gov_ut_fill() - Append intervals with a constant packet count
+ * @trace: trace to append to
+ * @pkts: packets per interval, split 1:3 between TX and RX
+ * @num: number of intervals
+ *
+ * Return: None
+ */
+static void bbm_gov_ut_fill(struct bbm_gov_ut_trace *trace, uint64_t pkts,
+			    uint32_t num)
+{
+	while (num-- && trace->len < BBM_GOV_UT_MAX_INTERVALS) {
+		trace->tx[trace->len] = pkts / 4;
+		trace->rx[trace->len] = pkts - pkts / 4;
+		trace->len++;
+	}
+}
+
+/**
+ * bbm_gov_ut_replay() - Replay a trace through the governor
+ * @hdd_ctx: HDD context
+ * @trace: per interval packet counts
+ * @latency_critical: replay with latency critical clients active
+ * @name: trace name for the report
+ *
+ * Starts from a reset governor and checks on every interval that the vote
+ * is not below the fixed threshold level and that it only steps down once
+ * the fixed threshold level has stayed below it for the hold time. Then
+ * reports the vote changes, time at each level and ramp latency, as the
+ * governor stats print them on live traffic.
+ *
+ * Return: number of errors
+ */
+static uint32_t bbm_gov_ut_replay(struct hdd_context *hdd_ctx,
+				  struct bbm_gov_ut_trace *trace,
+				  bool latency_critical, const char *name)
+{
+	struct hdd_config *cfg = hdd_ctx->config;
+	struct bbm_governor *gov = &hdd_ctx->bbm_ctx->gov;
+	enum tput_level raw, level, prev = TPUT_LEVEL_NONE;
+	uint32_t hold = cfg->bus_bw_gov_down_hold;
+	uint32_t below = 0;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	if (latency_critical)
+		hold *= 2;
+
+	hdd_bbm_governor_reset(hdd_ctx);
+	hdd_bbm_governor_clear_stats(hdd_ctx);
+
+	for (i = 0; i < trace->len; i++) {
+		raw = bbm_gov_ut_raw_level(cfg, trace->tx[i] + trace->rx[i]);
+		level = hdd_bbm_governor_update(hdd_ctx, trace->tx[i],
+						trace->rx[i],
+						BBM_GOV_UT_INTERVAL_US, raw,
+						latency_critical);
+
+		errors += ut_check(level > TPUT_LEVEL_NONE &&
+				   level < TPUT_LEVEL_SUPER_HIGH);
+		errors += ut_check(level >= raw);
+
+		below = raw < prev ? below + 1 : 0;
+		if (level < prev)
+			errors += ut_check(below >= hold);
+		if (level != prev)
+			below = 0;
+
+		prev = level;
+	}
+
+	qdf_nofl_info("bbm gov %s: %u intervals, %u vote changes (fixed thresholds %u), ramps %u lag %u lead %u intervals",
+		      name, trace->len, gov->vote_changes, gov->raw_changes,
+		      gov->ramps, gov->lag_intervals, gov->lead_intervals);
+	for (level = TPUT_LEVEL_IDLE; level < TPUT_LEVEL_MAX; level++)
+		if (gov->time_us[level])
+			qdf_nofl_info("bbm gov %s: level %d time %llu ms", name,
+				      level,
+				      qdf_do_div(gov->time_us[level], 1000));
+
+	return errors;
+}
+
+/**
+ * bbm_gov_ut_ramp() - Ramp up to ultra high, hold, then drop to idle
+ * @hdd_ctx: HDD context
+ *
+ * Return: number of errors
+ */
+static uint32_t bbm_gov_ut_ramp(struct hdd_context *hdd_ctx)
+{
+	struct bbm_gov_ut_trace *trace = &bbm_gov_ut_trace;
+	struct bbm_governor *gov = &hdd_ctx->bbm_ctx->gov;
+	uint32_t errors;
+	uint32_t i;
+
+	trace->len = 0;
+	bbm_gov_ut_fill(trace, 0, 16);
+	for (i = 1; i <= 32; i++)
+		bbm_gov_ut_fill(trace, i * 500, 1);
+	bbm_gov_ut_fill(trace, 16000, 32);
+	bbm_gov_ut_fill(trace, 0, 32);
+
+	errors = bbm_gov_ut_replay(hdd_ctx, trace, false, "ramp");
+
+	/* Traffic stopped long enough ago for the vote to reach idle */
+	errors += ut_check(gov->cur_level == TPUT_LEVEL_IDLE);
+	/* The governor never lags the fixed thresholds */
+	errors += ut_check(!gov->lag_intervals);
+
+	return errors;
+}
+
+/**
+ * bbm_gov_ut_edge() - Traffic sitting on the medium threshold
+ * @hdd_ctx: HDD context
+ *
+ * The fixed thresholds flap between low and medium every interval, the
+ * governor should hold medium.
+ *
+ * Return: number of errors
+ */
+static uint32_t bbm_gov_ut_edge(struct hdd_context *hdd_ctx)
+{
+	struct bbm_gov_ut_trace *trace = &bbm_gov_ut_trace;
+	struct bbm_governor *gov = &hdd_ctx->bbm_ctx->gov;
+	uint32_t errors;
+	uint32_t i;
+
+	trace->len = 0;
+	for (i = 0; i < 256; i++)
+		bbm_gov_ut_fill(trace, i & 1 ? BBM_GOV_UT_MEDIUM - 40 :
+				BBM_GOV_UT_MEDIUM + 40, 1);
+
+	errors = bbm_gov_ut_replay(hdd_ctx, trace, false, "edge");
+
+	errors += ut_check(gov->raw_changes >= 255);
+	errors += ut_check(gov->vote_changes <= 2);
+	errors += ut_check(gov->cur_level == TPUT_LEVEL_MEDIUM);
+
+	return errors;
+}
+
+/**
+ * bbm_gov_ut_step_down() - Step down hold time, doubled for latency
+ *  critical clients
+ * @hdd_ctx: HDD context
+ * @latency_critical: replay with latency critical clients active
+ * @intervals: filled with the intervals high was held once traffic stopped
+ *
+ * Return: number of errors
+ */
+static uint32_t bbm_gov_ut_step_down(struct hdd_context *hdd_ctx,
+				     bool latency_critical,
+				     uint32_t *intervals)
+{
+	struct bbm_gov_ut_trace *trace = &bbm_gov_ut_trace;
+	struct bbm_governor *gov = &hdd_ctx->bbm_ctx->gov;
+	uint32_t hold = hdd_ctx->config->bus_bw_gov_down_hold;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	if (latency_critical)
+		hold *= 2;
+
+	trace->len = 0;
+	bbm_gov_ut_fill(trace, BBM_GOV_UT_HIGH * 2, 16);
+	errors += bbm_gov_ut_replay(hdd_ctx, trace, latency_critical,
+				    latency_critical ? "step down lc" :
+				    "step down");
+	errors += ut_check(gov->cur_level == TPUT_LEVEL_HIGH);
+
+	/*
+	 * High is held for at least the hold time once traffic stops, and
+	 * no longer than it takes the smoothed rate to fall below the margin
+	 */
+	for (i = 1; i <= 4 * hold; i++) {
+		if (hdd_bbm_governor_update(hdd_ctx, 0, 0,
+					    BBM_GOV_UT_INTERVAL_US,
+					    TPUT_LEVEL_IDLE,
+					    latency_critical) < TPUT_LEVEL_HIGH)
+			break;
+	}
+
+	errors += ut_check(i >= hold);
+	errors += ut_check(i <= 4 * hold);
+	*intervals = i;
+
+	return errors;
+}
+
+/**
+ * bbm_gov_ut_burst() - Random on/off bursts of random size
+ * @hdd_ctx: HDD context
+ * @latency_critical: replay with latency critical clients active
+ *
+ * Bursts shorter than the hold time followed by idle periods are the case
+ * where the prediction lags a sudden sample the most.
+ *
+ * Return: number of errors
+ */
+static uint32_t bbm_gov_ut_burst(struct hdd_context *hdd_ctx,
+				 bool latency_critical)
+{
+	struct bbm_gov_ut_trace *trace = &bbm_gov_ut_trace;
+	uint64_t seed = latency_critical ? 2 : 1;
+	uint64_t pkts;
+
+	trace->len = 0;
+	while (trace->len < BBM_GOV_UT_MAX_INTERVALS) {
+		pkts = bbm_gov_ut_rand(&seed, 4) ?
+		       bbm_gov_ut_rand(&seed, BBM_GOV_UT_ULTRA_HIGH * 5 / 4) :
+		       0;
+		bbm_gov_ut_fill(trace, pkts, 1 + bbm_gov_ut_rand(&seed, 8));
+	}
+
+	return bbm_gov_ut_replay(hdd_ctx, trace, latency_critical,
+				 latency_critical ? "burst lc" : "burst");
+}
+
+/**
+ * bbm_gov_ut_reset() - Reset drops the history and the current level
+ * @hdd_ctx: HDD context
+ *
+ * Return: number of errors
+ */
+static uint32_t bbm_gov_ut_reset(struct hdd_context *hdd_ctx)
+{
+	struct bbm_governor *gov = &hdd_ctx->bbm_ctx->gov;
+	uint32_t vote_changes;
+	uint32_t errors = 0;
+
+	hdd_bbm_governor_reset(hdd_ctx);
+	hdd_bbm_governor_update(hdd_ctx, BBM_GOV_UT_ULTRA_HIGH,
+				BBM_GOV_UT_ULTRA_HIGH, BBM_GOV_UT_INTERVAL_US,
+				TPUT_LEVEL_ULTRA_HIGH, false);
+	errors += ut_check(gov->cur_level == TPUT_LEVEL_ULTRA_HIGH);
+
+	vote_changes = gov->vote_changes;
+	hdd_bbm_governor_reset(hdd_ctx);
+	errors += ut_check(gov->cur_level == TPUT_LEVEL_NONE);
+	errors += ut_check(!gov->ewma_tx && !gov->ewma_rx);
+	errors += ut_check(!gov->trend_tx && !gov->trend_rx);
+	/* Stats survive a reset */
+	errors += ut_check(gov->vote_changes == vote_changes);
+
+	/* No step down hold after a reset */
+	errors += ut_check(hdd_bbm_governor_update(hdd_ctx, 0, 0,
+						   BBM_GOV_UT_INTERVAL_US,
+						   TPUT_LEVEL_IDLE, false) ==
+			   TPUT_LEVEL_IDLE);
+
+	return errors;
+}
+
+uint32_t hdd_bbm_governor_unit_test(void)
+{
+	struct hdd_context *hdd_ctx;
+	uint32_t hold, hold_lc;
+	uint32_t errors = 0;
+
+	hdd_ctx = bbm_gov_ut_create();
+	QDF_BUG(hdd_ctx);
+	if (!hdd_ctx)
+		return 1;
+
+	errors += bbm_gov_ut_ramp(hdd_ctx);
+	errors += bbm_gov_ut_edge(hdd_ctx);
+	errors += bbm_gov_ut_step_down(hdd_ctx, false, &hold);
+	errors += bbm_gov_ut_step_down(hdd_ctx, true, &hold_lc);
+	errors += ut_check(hold_lc > hold);
+	errors += bbm_gov_ut_burst(hdd_ctx, false);
+	errors += bbm_gov_ut_burst(hdd_ctx, true);
+	errors += bbm_gov_ut_reset(hdd_ctx);
+
+	bbm_gov_ut_destroy(hdd_ctx);
+
+	QDF_BUG(!errors);
+
+	return errors;
+}